@@ -4,12 +4,30 @@ final class ConfigData {
   final String? biometricPromptTitle;
   final String? biometricPromptSubtitle;
   final String? windowsDataToSign;
+
+  /// Seconds a Windows Hello derived key stays cached; `null` or `0` disables the cache.
+  final int? windowsKeyCacheTtlSeconds;
+
+  /// Maximum number of tags whose derived keys are cached at the same time on Windows.
+  final int? windowsKeyCacheMaxEntries;
+
+  /// Seconds the Windows Hello availability status stays cached; `null` keeps the default
+  /// of 5 seconds and `0` disables the cache.
+  final int? windowsBiometryStatusCacheTtlSeconds;
+
+  /// File the Windows `exportTrace` call also writes its trace to; `null` for none.
+  final String? windowsTraceFilePath;
+
   final AndroidConfig? androidConfig;
 
   const ConfigData({
     this.biometricPromptTitle,
     this.biometricPromptSubtitle,
     this.windowsDataToSign,
+    this.windowsKeyCacheTtlSeconds,
+    this.windowsKeyCacheMaxEntries,
+    this.windowsBiometryStatusCacheTtlSeconds,
+    this.windowsTraceFilePath,
     this.androidConfig,
   });
 
@@ -17,6 +35,10 @@ final class ConfigData {
     biometricPromptTitle: map['biometricPromptTitle'],
     biometricPromptSubtitle: map['biometricPromptSubtitle'],
     windowsDataToSign: map['windowsDataToSign'],
+    windowsKeyCacheTtlSeconds: map['windowsKeyCacheTtlSeconds'],
+    windowsKeyCacheMaxEntries: map['windowsKeyCacheMaxEntries'],
+    windowsBiometryStatusCacheTtlSeconds: map['windowsBiometryStatusCacheTtlSeconds'],
+    windowsTraceFilePath: map['windowsTraceFilePath'],
     androidConfig: AndroidConfig.fromMap(map['androidConfig']),
   );
 
@@ -24,6 +46,10 @@ final class ConfigData {
     'biometricPromptTitle': biometricPromptTitle,
     'biometricPromptSubtitle': biometricPromptSubtitle,
     'windowsDataToSign': windowsDataToSign,
+    'windowsKeyCacheTtlSeconds': windowsKeyCacheTtlSeconds,
+    'windowsKeyCacheMaxEntries': windowsKeyCacheMaxEntries,
+    'windowsBiometryStatusCacheTtlSeconds': windowsBiometryStatusCacheTtlSeconds,
+    'windowsTraceFilePath': windowsTraceFilePath,
     'androidConfig': androidConfig?.toMap(),
   };
 }
@@ -1,94 +1,270 @@
 #include "include/biometric_cipher/common/argument_parser.h"
-#include "include/biometric_cipher/common/string_util.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
 
+#include <limits>
 #include <sstream>
-#include <winrt/base.h>
-
-
-using namespace winrt;
-using namespace winrt::impl;
 
 using biometric_cipher::ArgumentParser;
-using biometric_cipher::ParsedArguments;
-using biometric_cipher::GetArgumentName;
 
 namespace biometric_cipher
 {
-	std::unordered_map<ArgumentName, ParsedArguments>
-		ArgumentParser::Parse(const MethodName methodName, const flutter::EncodableValue* args) const
+	ArgumentValues ArgumentParser::ParseArguments(MethodName method, const flutter::EncodableValue* args) const
+	{
+		const auto* schema = GetMethodSchema(method);
+		if (schema == nullptr) {
+			throw BiometricCipherException(error_invalid_argument, "Not implemented method name");
+		}
+
+		const auto& argumentMap = GetArgumentMap(args);
+
+		ArgumentValues values;
+		for (const auto& argument : schema->GetArguments()) {
+			auto argName = GetArgumentName(argument.name);
+			const auto* value = FindArgument(argumentMap, argName);
+			auto& result = values[static_cast<size_t>(argument.name)];
+
+			switch (argument.type) {
+			case ArgumentType::kString:
+				result.data.stringArgument = FetchAndValidateArgument(value, argName);
+				break;
+
+			case ArgumentType::kStringOrBinary:
+				result.data = FetchAndValidateStringOrBinaryArgument(value, argName);
+				break;
+
+			case ArgumentType::kStringList:
+				result.list = FetchAndValidateListArgument(value, argName);
+				break;
+
+			case ArgumentType::kOptionalUInt:
+				result.number = FetchOptionalUIntArgument(value, argName);
+				break;
+
+			case ArgumentType::kOptionalString:
+				result.data.stringArgument = FetchOptionalStringArgument(value, argName);
+				break;
+
+			case ArgumentType::kUInt:
+				result.number = FetchAndValidateUIntArgument(value, argName);
+				break;
+			}
+		}
+
+		return values;
+	}
+
+	ConfigureArguments ArgumentParser::ParseConfigureArguments(const flutter::EncodableValue* args) const
+	{
+		auto values = ParseArguments(MethodName::kConfigure, args);
+
+		ConfigureArguments result;
+		result.windowsDataToSign = Get(values, ArgumentName::kWindowsDataToSign).data.stringArgument;
+		result.windowsKeyCacheTtlSeconds = Get(values, ArgumentName::kWindowsKeyCacheTtlSeconds).number;
+		result.windowsKeyCacheMaxEntries = Get(values, ArgumentName::kWindowsKeyCacheMaxEntries).number;
+		result.windowsBiometryStatusCacheTtlSeconds = Get(values, ArgumentName::kWindowsBiometryStatusCacheTtlSeconds).number;
+		result.windowsTraceFilePath = Get(values, ArgumentName::kWindowsTraceFilePath).data.stringArgument;
+
+		return result;
+	}
+
+	Sha256Arguments ArgumentParser::ParseSha256Arguments(const flutter::EncodableValue* args) const
 	{
-		std::unordered_map<ArgumentName, ParsedArguments> result;
+		auto values = ParseArguments(MethodName::kSha256, args);
+
+		Sha256Arguments result;
+		result.data = Get(values, ArgumentName::kData).data;
 
+		return result;
+	}
+
+	HmacSha256Arguments ArgumentParser::ParseHmacSha256Arguments(const flutter::EncodableValue* args) const
+	{
+		auto values = ParseArguments(MethodName::kHmacSha256, args);
+
+		HmacSha256Arguments result;
+		result.key = Get(values, ArgumentName::kKey).data;
+		result.data = Get(values, ArgumentName::kData).data;
+
+		return result;
+	}
+
+	const flutter::EncodableMap& ArgumentParser::GetArgumentMap(const flutter::EncodableValue* args)
+	{
 		if (args == nullptr) {
-			throw hresult_error(error_invalid_argument, L"Arguments are null.");
+			throw BiometricCipherException(error_invalid_argument, "Arguments are null.");
 		}
 
 		const auto* argumentMap = std::get_if<flutter::EncodableMap>(args);
 		if (argumentMap == nullptr) {
-			throw hresult_error(error_invalid_argument, L"Arguments must be a map.");
+			throw BiometricCipherException(error_invalid_argument, "Arguments must be a map.");
 		}
 
-		switch (methodName)
-		{
-		case MethodName::kEncrypt:
-		case MethodName::kDecrypt:
-			result[ArgumentName::kTag] = FetchAndValidateArgument(*argumentMap, ArgumentName::kTag);
-			result[ArgumentName::kData] = FetchAndValidateArgument(*argumentMap, ArgumentName::kData);
-			break;
+		return *argumentMap;
+	}
 
+	const flutter::EncodableValue* ArgumentParser::FindArgument(const flutter::EncodableMap& argumentMap, std::string_view argName)
+	{
+		// The maps hold a handful of entries, so a scan beats a lookup that needs a key built.
+		for (const auto& [key, value] : argumentMap) {
+			const auto* keyStr = std::get_if<std::string>(&key);
+			if (keyStr != nullptr && *keyStr == argName) {
+				return &value;
+			}
+		}
 
-		case MethodName::kGenerateKey:
-		case MethodName::kDeleteKey:
-			result[ArgumentName::kTag] = FetchAndValidateArgument(*argumentMap, ArgumentName::kTag);
-			break;
+		return nullptr;
+	}
 
-		case MethodName::kConfigure:
-			result[ArgumentName::kWindowsDataToSign] = FetchAndValidateArgument(*argumentMap, ArgumentName::kWindowsDataToSign);
-			break;
+	std::string_view ArgumentParser::FetchAndValidateArgument(const flutter::EncodableValue* value, std::string_view argName)
+	{
+		if (value == nullptr) {
+			auto message = CreateMissingArgumentMessage(argName);
+			throw BiometricCipherException(error_invalid_argument, message);
+		}
 
-		default:
-			throw hresult_error(error_invalid_argument, L"Not implemented method name");
+		const auto* argStr = std::get_if<std::string>(value);
+		if (argStr == nullptr) {
+			auto message = CreateMissingArgumentMessage(argName);
+			throw BiometricCipherException(error_invalid_argument, message);
 		}
 
-		return result;
+		return *argStr;
 	}
 
-	ParsedArguments ArgumentParser::FetchAndValidateArgument(const flutter::EncodableMap& argumentMap, ArgumentName argumentName)
+	DataArgument ArgumentParser::FetchAndValidateStringOrBinaryArgument(const flutter::EncodableValue* value, std::string_view argName)
 	{
-		ParsedArguments argument;
-
-		auto argName = GetArgumentName(argumentName);
-		auto it = argumentMap.find(flutter::EncodableValue(argName));
-		if (it == argumentMap.end()) {
+		if (value == nullptr) {
 			auto message = CreateMissingArgumentMessage(argName);
-			throw hresult_error(error_invalid_argument, message.c_str());			
+			throw BiometricCipherException(error_invalid_argument, message);
 		}
-		if (const auto* argStr = std::get_if<std::string>(&it->second)) {
+
+		DataArgument argument;
+		if (const auto* argStr = std::get_if<std::string>(value)) {
 			argument.stringArgument = *argStr;
 		}
+		else if (const auto* argBytes = std::get_if<std::vector<uint8_t>>(value)) {
+			argument.binaryArgument = *argBytes;
+			argument.isBinary = true;
+		}
 		else {
-			auto message = CreateMissingArgumentMessage(argName);
-			throw hresult_error(error_invalid_argument, message.c_str());
+			auto message = CreateInvalidStringOrBinaryArgumentTypeMessage(argName);
+			throw BiometricCipherException(error_invalid_argument, message);
 		}
 
 		return argument;
 	}
 
-	std::wstring ArgumentParser::CreateMissingArgumentMessage(const std::string& argName)
+	const flutter::EncodableList* ArgumentParser::FetchAndValidateListArgument(const flutter::EncodableValue* value, std::string_view argName)
+	{
+		if (value == nullptr) {
+			auto message = CreateMissingArgumentMessage(argName);
+			throw BiometricCipherException(error_invalid_argument, message);
+		}
+
+		const auto* argList = std::get_if<flutter::EncodableList>(value);
+		if (argList == nullptr) {
+			auto message = CreateInvalidListArgumentTypeMessage(argName);
+			throw BiometricCipherException(error_invalid_argument, message);
+		}
+
+		for (const auto& item : *argList) {
+			if (!std::holds_alternative<std::string>(item)) {
+				auto message = CreateInvalidListArgumentTypeMessage(argName);
+				throw BiometricCipherException(error_invalid_argument, message);
+			}
+		}
+
+		return argList;
+	}
+
+	uint32_t ArgumentParser::FetchAndValidateUIntArgument(const flutter::EncodableValue* value, std::string_view argName)
+	{
+		if (value == nullptr || value->IsNull()) {
+			auto message = CreateMissingArgumentMessage(argName);
+			throw BiometricCipherException(error_invalid_argument, message);
+		}
+
+		return *FetchOptionalUIntArgument(value, argName);
+	}
+
+	std::optional<uint32_t> ArgumentParser::FetchOptionalUIntArgument(const flutter::EncodableValue* value, std::string_view argName)
+	{
+		if (value == nullptr || value->IsNull()) {
+			return std::nullopt;
+		}
+
+		int64_t number = 0;
+		if (const auto* argInt32 = std::get_if<int32_t>(value)) {
+			number = *argInt32;
+		}
+		else if (const auto* argInt64 = std::get_if<int64_t>(value)) {
+			number = *argInt64;
+		}
+		else {
+			auto message = CreateInvalidUIntArgumentMessage(argName);
+			throw BiometricCipherException(error_invalid_argument, message);
+		}
+
+		if (number < 0 || number > static_cast<int64_t>((std::numeric_limits<uint32_t>::max)())) {
+			auto message = CreateInvalidUIntArgumentMessage(argName);
+			throw BiometricCipherException(error_invalid_argument, message);
+		}
+
+		return static_cast<uint32_t>(number);
+	}
+
+	std::string_view ArgumentParser::FetchOptionalStringArgument(const flutter::EncodableValue* value, std::string_view argName)
+	{
+		if (value == nullptr || value->IsNull()) {
+			return {};
+		}
+
+		const auto* argStr = std::get_if<std::string>(value);
+		if (argStr == nullptr) {
+			auto message = CreateMissingArgumentTypeMessage(argName);
+			throw BiometricCipherException(error_invalid_argument, message);
+		}
+
+		return *argStr;
+	}
+
+	std::string ArgumentParser::CreateMissingArgumentMessage(std::string_view argName)
+	{
+		std::ostringstream oss;
+		oss << "Argument " << argName << " is missing.";
+
+		return oss.str();
+	}
+
+	std::string ArgumentParser::CreateMissingArgumentTypeMessage(std::string_view argName)
+	{
+		std::ostringstream oss;
+		oss << "Argument " << argName << " must be a string.";
+
+		return oss.str();
+	}
+
+	std::string ArgumentParser::CreateInvalidStringOrBinaryArgumentTypeMessage(std::string_view argName)
+	{
+		std::ostringstream oss;
+		oss << "Argument " << argName << " must be a string or a byte array.";
+
+		return oss.str();
+	}
+
+	std::string ArgumentParser::CreateInvalidListArgumentTypeMessage(std::string_view argName)
 	{
-		std::wostringstream woss;
-		auto message = StringUtil::ConvertStringToWideString(argName);
-		woss << L"Argument " << message << L" is missing.";
+		std::ostringstream oss;
+		oss << "Argument " << argName << " must be a list of strings.";
 
-		return woss.str();
+		return oss.str();
 	}
 
-	std::wstring ArgumentParser::CreateMissingArgumentTypeMessage(const std::string& argName)
+	std::string ArgumentParser::CreateInvalidUIntArgumentMessage(std::string_view argName)
 	{
-		std::wostringstream woss;
-		auto message = StringUtil::ConvertStringToWideString(argName);
-		woss << L"Argument " << message << L" must be a string.";
+		std::ostringstream oss;
+		oss << "Argument " << argName << " must be a non-negative integer.";
 
-		return woss.str();
+		return oss.str();
 	}
 }
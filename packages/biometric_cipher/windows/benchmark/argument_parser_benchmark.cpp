@@ -0,0 +1,84 @@
+#include "benchmark_util.h"
+
+#include "include/biometric_cipher/common/argument_parser.h"
+
+#include <benchmark/benchmark.h>
+
+#include <flutter/encodable_value.h>
+
+#include <string>
+#include <vector>
+
+namespace biometric_cipher {
+	namespace benchmarks {
+		namespace {
+			void BM_ArgumentParser_Parse_Encrypt(::benchmark::State& state)
+			{
+				ArgumentParser parser;
+				flutter::EncodableValue args(flutter::EncodableMap{
+					{ flutter::EncodableValue("tag"), flutter::EncodableValue("benchmark") },
+					{ flutter::EncodableValue("data"), flutter::EncodableValue(std::string(static_cast<size_t>(state.range(0)), 'a')) },
+				});
+
+				for (auto _ : state) {
+					auto parsed = parser.ParseDataArguments<MethodName::kEncrypt>(&args);
+					::benchmark::DoNotOptimize(parsed);
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_ArgumentParser_Parse_Encrypt)->Apply(PayloadSizes);
+
+			void BM_ArgumentParser_Parse_EncryptBinary(::benchmark::State& state)
+			{
+				ArgumentParser parser;
+				flutter::EncodableValue args(flutter::EncodableMap{
+					{ flutter::EncodableValue("tag"), flutter::EncodableValue("benchmark") },
+					{ flutter::EncodableValue("data"), flutter::EncodableValue(std::vector<uint8_t>(static_cast<size_t>(state.range(0)), 0x5A)) },
+				});
+
+				for (auto _ : state) {
+					auto parsed = parser.ParseDataArguments<MethodName::kEncrypt>(&args);
+					::benchmark::DoNotOptimize(parsed);
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_ArgumentParser_Parse_EncryptBinary)->Apply(PayloadSizes);
+
+			// Parsing plus the one copy that the handler moves into the operation.
+			void BM_ArgumentParser_ParseAndCopy_EncryptBinary(::benchmark::State& state)
+			{
+				ArgumentParser parser;
+				flutter::EncodableValue args(flutter::EncodableMap{
+					{ flutter::EncodableValue("tag"), flutter::EncodableValue("benchmark") },
+					{ flutter::EncodableValue("data"), flutter::EncodableValue(std::vector<uint8_t>(static_cast<size_t>(state.range(0)), 0x5A)) },
+				});
+
+				for (auto _ : state) {
+					auto parsed = parser.ParseDataArguments<MethodName::kEncrypt>(&args);
+					auto data = parsed.data.CopyBytes();
+					::benchmark::DoNotOptimize(data.data());
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_ArgumentParser_ParseAndCopy_EncryptBinary)->Apply(PayloadSizes);
+
+			void BM_ArgumentParser_Parse_Configure(::benchmark::State& state)
+			{
+				ArgumentParser parser;
+				flutter::EncodableValue args(flutter::EncodableMap{
+					{ flutter::EncodableValue("windowsDataToSign"), flutter::EncodableValue("benchmark data to sign") },
+					{ flutter::EncodableValue("windowsKeyCacheTtlSeconds"), flutter::EncodableValue(int32_t{ 60 }) },
+				});
+
+				for (auto _ : state) {
+					auto parsed = parser.ParseConfigureArguments(&args);
+					::benchmark::DoNotOptimize(parsed);
+				}
+			}
+			BENCHMARK(BM_ArgumentParser_Parse_Configure);
+		}
+	}  // namespace benchmarks
+}  // namespace biometric_cipher
@@ -0,0 +1,71 @@
+#include "benchmark_util.h"
+
+#include "include/biometric_cipher/repositories/winrt_encrypt_repository_impl.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+namespace biometric_cipher {
+	namespace benchmarks {
+		namespace {
+			// End-to-end cost of a call with real AES-GCM and a zero-latency signer, i.e.
+			// everything except the Windows Hello prompt itself.
+			void BM_WinrtService_EncryptAsync(::benchmark::State& state)
+			{
+				auto service = CreateServiceWithFakeSigner(std::make_shared<WinrtEncryptRepositoryImpl>());
+				auto payload = MakeTextPayload<SecureString>(static_cast<size_t>(state.range(0)));
+
+				for (auto _ : state) {
+					auto encrypted = service->EncryptAsync("benchmark", payload).get();
+					::benchmark::DoNotOptimize(encrypted);
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_WinrtService_EncryptAsync)->Apply(PayloadSizes);
+
+			void BM_WinrtService_DecryptAsync(::benchmark::State& state)
+			{
+				auto service = CreateServiceWithFakeSigner(std::make_shared<WinrtEncryptRepositoryImpl>());
+				auto encrypted = service->EncryptAsync("benchmark", MakeTextPayload<SecureString>(static_cast<size_t>(state.range(0)))).get();
+
+				for (auto _ : state) {
+					auto decrypted = service->DecryptAsync("benchmark", encrypted).get();
+					::benchmark::DoNotOptimize(decrypted);
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_WinrtService_DecryptAsync)->Apply(PayloadSizes);
+
+			void BM_WinrtService_EncryptBinaryAsync(::benchmark::State& state)
+			{
+				auto service = CreateServiceWithFakeSigner(std::make_shared<WinrtEncryptRepositoryImpl>());
+				auto payload = MakeBinaryPayload<SecureBuffer>(static_cast<size_t>(state.range(0)));
+
+				for (auto _ : state) {
+					auto encrypted = service->EncryptBinaryAsync("benchmark", payload).get();
+					::benchmark::DoNotOptimize(encrypted);
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_WinrtService_EncryptBinaryAsync)->Apply(PayloadSizes);
+
+			void BM_WinrtService_DecryptBinaryAsync(::benchmark::State& state)
+			{
+				auto service = CreateServiceWithFakeSigner(std::make_shared<WinrtEncryptRepositoryImpl>());
+				auto encrypted = service->EncryptBinaryAsync("benchmark", MakeBinaryPayload<SecureBuffer>(static_cast<size_t>(state.range(0)))).get();
+
+				for (auto _ : state) {
+					auto decrypted = service->DecryptBinaryAsync("benchmark", encrypted).get();
+					::benchmark::DoNotOptimize(decrypted);
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_WinrtService_DecryptBinaryAsync)->Apply(PayloadSizes);
+		}
+	}  // namespace benchmarks
+}  // namespace biometric_cipher
@@ -0,0 +1,65 @@
+#include "benchmark_util.h"
+
+#include "include/biometric_cipher/common/string_util.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+namespace biometric_cipher {
+	namespace benchmarks {
+		namespace {
+			void BM_StringUtil_ConvertStringToHString(::benchmark::State& state)
+			{
+				auto payload = MakeTextPayload(static_cast<size_t>(state.range(0)));
+
+				for (auto _ : state) {
+					auto converted = StringUtil::ConvertStringToHString(payload);
+					::benchmark::DoNotOptimize(converted);
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_StringUtil_ConvertStringToHString)->Apply(PayloadSizes);
+
+			void BM_StringUtil_ConvertHStringToString(::benchmark::State& state)
+			{
+				auto payload = StringUtil::ConvertStringToHString(MakeTextPayload(static_cast<size_t>(state.range(0))));
+
+				for (auto _ : state) {
+					auto converted = StringUtil::ConvertHStringToString(payload);
+					::benchmark::DoNotOptimize(converted);
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_StringUtil_ConvertHStringToString)->Apply(PayloadSizes);
+
+			void BM_StringUtil_ConvertStringToWideString(::benchmark::State& state)
+			{
+				auto payload = MakeTextPayload(static_cast<size_t>(state.range(0)));
+
+				for (auto _ : state) {
+					auto converted = StringUtil::ConvertStringToWideString(payload);
+					::benchmark::DoNotOptimize(converted);
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_StringUtil_ConvertStringToWideString)->Apply(PayloadSizes);
+
+			void BM_StringUtil_ConvertWideStringToString(::benchmark::State& state)
+			{
+				auto payload = StringUtil::ConvertStringToWideString(MakeTextPayload(static_cast<size_t>(state.range(0))));
+
+				for (auto _ : state) {
+					auto converted = StringUtil::ConvertWideStringToString(payload);
+					::benchmark::DoNotOptimize(converted);
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_StringUtil_ConvertWideStringToString)->Apply(PayloadSizes);
+		}
+	}  // namespace benchmarks
+}  // namespace biometric_cipher
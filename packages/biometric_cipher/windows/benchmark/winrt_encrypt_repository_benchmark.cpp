@@ -0,0 +1,158 @@
+#include "benchmark_util.h"
+
+#include "include/biometric_cipher/common/base64.h"
+#include "include/biometric_cipher/common/string_util.h"
+#include "include/biometric_cipher/common/winrt_interop.h"
+#include "include/biometric_cipher/repositories/winrt_encrypt_repository_impl.h"
+
+#include <benchmark/benchmark.h>
+
+#include <winrt/windows.security.cryptography.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace winrt;
+using namespace winrt::Windows::Security::Cryptography;
+using namespace winrt::Windows::Storage::Streams;
+
+namespace biometric_cipher {
+	namespace benchmarks {
+		namespace {
+			// Windows Hello signatures are 256-byte RSA-2048 signatures.
+			const size_t kSignatureLength = 256;
+
+			void BM_WinrtEncryptRepository_CreateAESKey(::benchmark::State& state)
+			{
+				WinrtEncryptRepositoryImpl repository;
+				auto signature = MakeBinaryPayload<SecureBuffer>(kSignatureLength);
+
+				for (auto _ : state) {
+					auto key = repository.CreateAESKey(signature);
+					::benchmark::DoNotOptimize(key);
+				}
+			}
+			BENCHMARK(BM_WinrtEncryptRepository_CreateAESKey);
+
+			void BM_WinrtEncryptRepository_Encrypt(::benchmark::State& state)
+			{
+				WinrtEncryptRepositoryImpl repository;
+				auto key = repository.CreateAESKey(MakeBinaryPayload<SecureBuffer>(kSignatureLength));
+				auto payload = MakeTextPayload<SecureString>(static_cast<size_t>(state.range(0)));
+
+				for (auto _ : state) {
+					auto encrypted = repository.Encrypt(key, payload);
+					::benchmark::DoNotOptimize(encrypted);
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_WinrtEncryptRepository_Encrypt)->Apply(PayloadSizes);
+
+			void BM_WinrtEncryptRepository_Decrypt(::benchmark::State& state)
+			{
+				WinrtEncryptRepositoryImpl repository;
+				auto key = repository.CreateAESKey(MakeBinaryPayload<SecureBuffer>(kSignatureLength));
+				auto encrypted = repository.Encrypt(key, MakeTextPayload<SecureString>(static_cast<size_t>(state.range(0))));
+
+				for (auto _ : state) {
+					auto decrypted = repository.Decrypt(key, encrypted);
+					::benchmark::DoNotOptimize(decrypted);
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_WinrtEncryptRepository_Decrypt)->Apply(PayloadSizes);
+
+			void BM_WinrtEncryptRepository_EncryptBinary(::benchmark::State& state)
+			{
+				WinrtEncryptRepositoryImpl repository;
+				auto key = repository.CreateAESKey(MakeBinaryPayload<SecureBuffer>(kSignatureLength));
+				auto payload = MakeBinaryPayload<SecureBuffer>(static_cast<size_t>(state.range(0)));
+
+				for (auto _ : state) {
+					auto encrypted = repository.EncryptBinary(key, payload);
+					::benchmark::DoNotOptimize(encrypted);
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_WinrtEncryptRepository_EncryptBinary)->Apply(PayloadSizes);
+
+			void BM_WinrtEncryptRepository_DecryptBinary(::benchmark::State& state)
+			{
+				WinrtEncryptRepositoryImpl repository;
+				auto key = repository.CreateAESKey(MakeBinaryPayload<SecureBuffer>(kSignatureLength));
+				auto encrypted = repository.EncryptBinary(key, MakeBinaryPayload<SecureBuffer>(static_cast<size_t>(state.range(0))));
+
+				for (auto _ : state) {
+					auto decrypted = repository.DecryptBinary(key, encrypted);
+					::benchmark::DoNotOptimize(decrypted);
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_WinrtEncryptRepository_DecryptBinary)->Apply(PayloadSizes);
+
+			// The Base64 step of the string envelope on its own (header | nonce | ciphertext | tag).
+			void BM_Base64Envelope_Encode(::benchmark::State& state)
+			{
+				auto envelope = WinrtInterop::ConvertVectorToBuffer(MakeBinaryPayload(static_cast<size_t>(state.range(0))));
+
+				for (auto _ : state) {
+					auto encoded = StringUtil::ConvertHStringToString(CryptographicBuffer::EncodeToBase64String(envelope));
+					::benchmark::DoNotOptimize(encoded);
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_Base64Envelope_Encode)->Apply(PayloadSizes);
+
+			void BM_Base64Envelope_Decode(::benchmark::State& state)
+			{
+				auto envelope = WinrtInterop::ConvertVectorToBuffer(MakeBinaryPayload(static_cast<size_t>(state.range(0))));
+				auto encoded = StringUtil::ConvertHStringToString(CryptographicBuffer::EncodeToBase64String(envelope));
+
+				for (auto _ : state) {
+					auto decoded = CryptographicBuffer::DecodeFromBase64String(StringUtil::ConvertStringToHString(encoded));
+					::benchmark::DoNotOptimize(decoded);
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_Base64Envelope_Decode)->Apply(PayloadSizes);
+
+			// The same steps with the native codec, which the repository uses now.
+			void BM_Base64Envelope_EncodeNative(::benchmark::State& state)
+			{
+				auto envelope = WinrtInterop::ConvertVectorToBuffer(MakeBinaryPayload(static_cast<size_t>(state.range(0))));
+
+				for (auto _ : state) {
+					auto encoded = Base64::Encode(envelope.data(), envelope.Length());
+					::benchmark::DoNotOptimize(encoded);
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_Base64Envelope_EncodeNative)->Apply(PayloadSizes);
+
+			void BM_Base64Envelope_DecodeNative(::benchmark::State& state)
+			{
+				auto payload = MakeBinaryPayload(static_cast<size_t>(state.range(0)));
+				auto encoded = Base64::Encode(payload.data(), payload.size());
+
+				for (auto _ : state) {
+					Buffer decoded(static_cast<uint32_t>(payload.size()));
+					bool isValid = Base64::Decode(encoded, decoded.data());
+					decoded.Length(static_cast<uint32_t>(payload.size()));
+					::benchmark::DoNotOptimize(isValid);
+					::benchmark::DoNotOptimize(decoded);
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_Base64Envelope_DecodeNative)->Apply(PayloadSizes);
+		}
+	}  // namespace benchmarks
+}  // namespace biometric_cipher
@@ -1,10 +1,15 @@
 #include "biometric_cipher_plugin.h"
 #include "include/biometric_cipher/enums/method_name.h"
-#include "include/biometric_cipher/common/string_util.h"
+#include "include/biometric_cipher/enums/method_schema.h"
 #include "include/biometric_cipher/repositories/windows_tpm_repository_impl.h"
 #include "include/biometric_cipher/repositories/windows_hello_repository_impl.h"
 #include "include/biometric_cipher/repositories/winrt_encrypt_repository_impl.h"
-#include "include/biometric_cipher/errors/error_codes.h"
+#include "include/biometric_cipher/common/aead_suite_selector.h"
+#include "include/biometric_cipher/common/secure_memory.h"
+#include "include/biometric_cipher/common/sha256.h"
+#include "include/biometric_cipher/common/tracer.h"
+#include "include/biometric_cipher/common/winrt_interop.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
 
 
 // This must be included before many other Windows headers.
@@ -14,18 +19,20 @@
 #include <flutter/plugin_registrar_windows.h>
 #include <flutter/standard_method_codec.h>
 
+#include <exception>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <winrt/windows.foundation.h>
 #include <winrt/windows.system.threading.h>
 #include <winrt/windows.foundation.collections.h>
+#include <winrt/windows.storage.streams.h>
 
 using namespace winrt;
 using namespace Windows::Foundation;
 using namespace Windows::System::Threading;
 
 using biometric_cipher::MethodName;
-using biometric_cipher::ArgumentName;
 
 namespace biometric_cipher {
 
@@ -49,17 +56,46 @@ void BiometricCipherPlugin::RegisterWithRegistrar(
 }
 
 BiometricCipherPlugin::BiometricCipherPlugin() : 
-	m_ConfigStorage(std::make_shared<ConfigStorage>())
+	m_ConfigStorage(std::make_shared<ConfigStorage>()),
+	m_Metrics(std::make_shared<MetricsRegistry>()),
+	m_PlatformThread(std::make_unique<PlatformThreadExecutor>()),
+	m_WorkerPool(std::make_unique<ThreadPoolExecutor>(
+		0,
+		[] { winrt::init_apartment(winrt::apartment_type::multi_threaded); },
+		[] { winrt::uninit_apartment(); }))
 {
+	// Shared so that the availability checked before each sign and the one reported by
+	// getCachedBiometryStatus are the same.
+	auto biometryStatusCache = std::make_shared<BiometryStatusCache>();
 	auto windowsTpmRepository = std::make_shared<WindowsTpmRepositoryImpl>();
-	auto windowsHelloRepository = std::make_shared<WindowsHelloRepositoryImpl>();
-	auto winrtEncryptRepository = std::make_shared<WinrtEncryptRepositoryImpl>();
+	auto windowsHelloRepository = std::make_shared<WindowsHelloRepositoryImpl>(
+		nullptr,
+		biometryStatusCache,
+		m_Metrics,
+		m_PlatformThread.get(),
+		m_WorkerPool.get());
+	// Segment sealing is pure computation, so its pool gets every core rather than the handful
+	// that m_WorkerPool is capped at; the thread that calls into a stream works as well.
+	std::shared_ptr<ParallelRunner> segmentRunner;
+	auto segmentHelperCount = ParallelRunner::GetDefaultHelperCount();
+	if (segmentHelperCount > 0) {
+		segmentRunner = std::make_shared<ParallelRunner>(
+			std::make_shared<ThreadPoolExecutor>(segmentHelperCount),
+			segmentHelperCount);
+	}
+	auto winrtEncryptRepository = std::make_shared<WinrtEncryptRepositoryImpl>(nullptr, m_Metrics, segmentRunner);
 	m_SecureService = std::make_shared<BiometricCipherService>(
 		m_ConfigStorage, 
 		windowsHelloRepository, 
 		windowsTpmRepository,
-		winrtEncryptRepository
+		winrtEncryptRepository,
+		nullptr,
+		biometryStatusCache
 	);
+
+	// Picks the envelope suite while the app starts up, so that the first encrypt does not
+	// pay for the measurement.
+	m_WorkerPool->Post([] { AeadSuiteSelector::GetPreferredSuite(); });
 }
 
 
@@ -69,205 +105,644 @@ void BiometricCipherPlugin::HandleMethodCall(
     const flutter::MethodCall<flutter::EncodableValue> &methodCall,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) 
 {
-
+	auto start = MetricsRegistry::Clock::now();
 	auto method = biometric_cipher::GetMethodName(methodCall.method_name());
     switch (method) {
 	case MethodName::kGetTPMStatus:
 	{
-		GetTPMStatus(std::move(result));
+		RunOperation(method, start, [this] { return GetTPMStatus(); }, std::move(result));
+		break;
+	}
+
+	case MethodName::kRefreshTPMStatus:
+	{
+		RunOperation(method, start, [this] { return RefreshTPMStatus(); }, std::move(result));
 		break;
 	}
 
 	case MethodName::kGetBiometryStatus:
 	{
-		GetBiometryStatus(std::move(result));
+		RunOperation(method, start, [this] { return GetBiometryStatus(false); }, std::move(result));
+		break;
+	}
+
+	case MethodName::kGetCachedBiometryStatus:
+	{
+		RunOperation(method, start, [this] { return GetBiometryStatus(true); }, std::move(result));
 		break;
 	}
 
 	case MethodName::kGenerateKey:
 	{
-		auto arguments = m_Argument_parser.Parse(method, methodCall.arguments());
-		const std::string tag = arguments[ArgumentName::kTag].stringArgument;
+		auto arguments = m_Argument_parser.ParseTagArguments<MethodName::kGenerateKey>(methodCall.arguments());
 
-		GenerateKeyCoroutine(tag, std::move(result));
+		RunOperation(
+			method,
+			start,
+			[this, tag = std::string(arguments.tag)]() mutable { return GenerateKeyCoroutine(std::move(tag)); },
+			std::move(result));
 		break;
 	}
 
     case MethodName::kEncrypt:
     {
-		auto arguments = m_Argument_parser.Parse(method, methodCall.arguments());
-		const std::string tag = arguments[ArgumentName::kTag].stringArgument;
-		const std::string data = arguments[ArgumentName::kData].stringArgument;
+		auto arguments = m_Argument_parser.ParseDataArguments<MethodName::kEncrypt>(methodCall.arguments());
+		if (arguments.data.isBinary) {
+			RunOperation(
+				method,
+				start,
+				[this, tag = std::string(arguments.tag), data = arguments.data.CopyBytes<SecureBuffer>(), context = std::string(arguments.context)]() mutable {
+					return EncryptBinaryCoroutine(std::move(tag), std::move(data), std::move(context));
+				},
+				std::move(result));
+			break;
+		}
 
-		EncryptCoroutine(tag, data, std::move(result));
+		RunOperation(
+			method,
+			start,
+			[this, tag = std::string(arguments.tag), data = SecureString(arguments.data.stringArgument), context = std::string(arguments.context)]() mutable {
+				return EncryptCoroutine(std::move(tag), std::move(data), std::move(context));
+			},
+			std::move(result));
         break;
     }
 
 	case MethodName::kDecrypt:
     {
-		auto arguments = m_Argument_parser.Parse(method, methodCall.arguments());
-		const std::string tag = arguments[ArgumentName::kTag].stringArgument;
-		const std::string data = arguments[ArgumentName::kData].stringArgument;
+		auto arguments = m_Argument_parser.ParseDataArguments<MethodName::kDecrypt>(methodCall.arguments());
+		if (arguments.data.isBinary) {
+			RunOperation(
+				method,
+				start,
+				[this, tag = std::string(arguments.tag), data = arguments.data.CopyBytes(), context = std::string(arguments.context)]() mutable {
+					return DecryptBinaryCoroutine(std::move(tag), std::move(data), std::move(context));
+				},
+				std::move(result));
+			break;
+		}
 
-		DecryptCoroutine(tag, data, std::move(result));
+		RunOperation(
+			method,
+			start,
+			[this, tag = std::string(arguments.tag), data = std::string(arguments.data.stringArgument), context = std::string(arguments.context)]() mutable {
+				return DecryptCoroutine(std::move(tag), std::move(data), std::move(context));
+			},
+			std::move(result));
         break;
 
     }
 
+	case MethodName::kEncryptBatch:
+	{
+		auto arguments = m_Argument_parser.ParseBatchArguments<MethodName::kEncryptBatch>(methodCall.arguments());
+
+		RunOperation(
+			method,
+			start,
+			[this, tag = std::string(arguments.tag), data = arguments.CopyData<SecureString>(), context = std::string(arguments.context)]() mutable {
+				return EncryptBatchCoroutine(std::move(tag), std::move(data), std::move(context));
+			},
+			std::move(result));
+		break;
+	}
+
+	case MethodName::kDecryptBatch:
+	{
+		auto arguments = m_Argument_parser.ParseBatchArguments<MethodName::kDecryptBatch>(methodCall.arguments());
+
+		RunOperation(
+			method,
+			start,
+			[this, tag = std::string(arguments.tag), data = arguments.CopyData(), context = std::string(arguments.context)]() mutable {
+				return DecryptBatchCoroutine(std::move(tag), std::move(data), std::move(context));
+			},
+			std::move(result));
+		break;
+	}
+
+	case MethodName::kEncryptStreamBegin:
+	{
+		auto arguments = m_Argument_parser.ParseTagArguments<MethodName::kEncryptStreamBegin>(methodCall.arguments());
+
+		RunOperation(
+			method,
+			start,
+			[this, tag = std::string(arguments.tag), context = std::string(arguments.context)]() mutable {
+				return EncryptStreamBeginCoroutine(std::move(tag), std::move(context));
+			},
+			std::move(result));
+		break;
+	}
+
+	case MethodName::kEncryptStreamChunk:
+	{
+		auto arguments = m_Argument_parser.ParseStreamChunkArguments<MethodName::kEncryptStreamChunk>(methodCall.arguments());
+
+		RunOperation(
+			method,
+			start,
+			[this, streamId = arguments.streamId, chunkIndex = arguments.chunkIndex, data = arguments.data.CopyBytes<SecureBuffer>()]() mutable {
+				return EncryptStreamChunkCoroutine(streamId, chunkIndex, std::move(data));
+			},
+			std::move(result));
+		break;
+	}
+
+	case MethodName::kEncryptStreamEnd:
+	{
+		auto arguments = m_Argument_parser.ParseStreamArguments<MethodName::kEncryptStreamEnd>(methodCall.arguments());
+
+		RunOperation(
+			method,
+			start,
+			[this, streamId = arguments.streamId, chunkIndex = arguments.chunkIndex] {
+				return EncryptStreamEndCoroutine(streamId, chunkIndex);
+			},
+			std::move(result));
+		break;
+	}
+
+	case MethodName::kDecryptStreamBegin:
+	{
+		auto arguments = m_Argument_parser.ParseDataArguments<MethodName::kDecryptStreamBegin>(methodCall.arguments());
+
+		RunOperation(
+			method,
+			start,
+			[this, tag = std::string(arguments.tag), header = arguments.data.CopyBytes(), context = std::string(arguments.context)]() mutable {
+				return DecryptStreamBeginCoroutine(std::move(tag), std::move(header), std::move(context));
+			},
+			std::move(result));
+		break;
+	}
+
+	case MethodName::kDecryptStreamChunk:
+	{
+		auto arguments = m_Argument_parser.ParseStreamChunkArguments<MethodName::kDecryptStreamChunk>(methodCall.arguments());
+
+		RunOperation(
+			method,
+			start,
+			[this, streamId = arguments.streamId, chunkIndex = arguments.chunkIndex, data = arguments.data.CopyBytes()]() mutable {
+				return DecryptStreamChunkCoroutine(streamId, chunkIndex, std::move(data));
+			},
+			std::move(result));
+		break;
+	}
+
+	case MethodName::kDecryptStreamEnd:
+	{
+		auto arguments = m_Argument_parser.ParseStreamArguments<MethodName::kDecryptStreamEnd>(methodCall.arguments());
+
+		RunOperation(
+			method,
+			start,
+			[this, streamId = arguments.streamId, chunkIndex = arguments.chunkIndex] {
+				return DecryptStreamEndCoroutine(streamId, chunkIndex);
+			},
+			std::move(result));
+		break;
+	}
+
+	case MethodName::kSha256:
+	{
+		auto arguments = m_Argument_parser.ParseSha256Arguments(methodCall.arguments());
+
+		RunOperation(
+			method,
+			start,
+			[this, data = arguments.data.CopyBytes()]() mutable { return Sha256Coroutine(std::move(data)); },
+			std::move(result));
+		break;
+	}
+
+	case MethodName::kHmacSha256:
+	{
+		auto arguments = m_Argument_parser.ParseHmacSha256Arguments(methodCall.arguments());
+
+		RunOperation(
+			method,
+			start,
+			[this, key = arguments.key.CopyBytes(), data = arguments.data.CopyBytes()]() mutable {
+				return HmacSha256Coroutine(std::move(key), std::move(data));
+			},
+			std::move(result));
+		break;
+	}
+
 	case MethodName::kDeleteKey:
     {
-		auto arguments = m_Argument_parser.Parse(method, methodCall.arguments());
-		const std::string tag = arguments[ArgumentName::kTag].stringArgument;
+		auto arguments = m_Argument_parser.ParseTagArguments<MethodName::kDeleteKey>(methodCall.arguments());
 
-		DeleteKeyCoroutine(tag, std::move(result));
+		RunOperation(
+			method,
+			start,
+			[this, tag = std::string(arguments.tag)]() mutable { return DeleteKeyCoroutine(std::move(tag)); },
+			std::move(result));
 		break;
     }            
 
     case MethodName::kConfigure:
     {
 		try {
-			auto arguments = m_Argument_parser.Parse(method, methodCall.arguments());
-			ConfigData configData(arguments[ArgumentName::kWindowsDataToSign].stringArgument);
-			m_ConfigStorage->SetConfigData(configData);
+			auto arguments = m_Argument_parser.ParseConfigureArguments(methodCall.arguments());
+			ConfigData configData(arguments.windowsDataToSign);
+			if (arguments.windowsKeyCacheTtlSeconds) {
+				configData.keyCacheTtlSeconds = *arguments.windowsKeyCacheTtlSeconds;
+			}
+			if (arguments.windowsKeyCacheMaxEntries) {
+				configData.keyCacheMaxEntries = *arguments.windowsKeyCacheMaxEntries;
+			}
+			if (arguments.windowsBiometryStatusCacheTtlSeconds) {
+				configData.biometryStatusCacheTtlSeconds = *arguments.windowsBiometryStatusCacheTtlSeconds;
+			}
+			configData.traceFilePath = std::string(arguments.windowsTraceFilePath);
+			m_SecureService->Configure(configData);
 
             result->Success(NULL);
         }
-		catch (const hresult_error& e) {
-			auto hr = e.code();
-			auto message = e.message();
-			auto errorMessage = StringUtil::ConvertHStringToString(message);
-			OutputException(hr, errorMessage);
-
-			result->Error(GetErrorCodeString(hr), errorMessage);
+		catch (...) {
+			ReplyWithCurrentException(method, *result);
 		}
+		m_Metrics->RecordCall(method, MetricsRegistry::Clock::now() - start);
 		break;
     }
 
+	case MethodName::kInvalidateKeyCache:
+	{
+		try {
+			auto arguments = m_Argument_parser.ParseTagArguments<MethodName::kInvalidateKeyCache>(methodCall.arguments());
+			m_SecureService->InvalidateKeyCache(std::string(arguments.tag));
+
+			result->Success(NULL);
+		}
+		catch (...) {
+			ReplyWithCurrentException(method, *result);
+		}
+		m_Metrics->RecordCall(method, MetricsRegistry::Clock::now() - start);
+		break;
+	}
+
+	case MethodName::kLockKeyCache:
+	{
+		m_SecureService->LockKeyCache();
+
+		result->Success(NULL);
+		m_Metrics->RecordCall(method, MetricsRegistry::Clock::now() - start);
+		break;
+	}
+
+	case MethodName::kGetMetrics:
+	{
+		// Served on the platform thread: a snapshot only reads a few thousand counters.
+		result->Success(ConvertMetrics(m_Metrics->GetSnapshot()));
+		m_Metrics->RecordCall(method, MetricsRegistry::Clock::now() - start);
+		break;
+	}
+
+	case MethodName::kExportTrace:
+	{
+		auto configData = m_ConfigStorage->GetConfig();
+		auto path = configData ? configData->traceFilePath : std::string();
+
+		RunOperation(
+			method,
+			start,
+			[this, path = std::move(path)]() mutable { return ExportTraceCoroutine(std::move(path)); },
+			std::move(result));
+		break;
+	}
+
 	case MethodName::kNotImplemented:
 	default:
 		result->NotImplemented();
+		m_Metrics->RecordCall(MethodName::kNotImplemented, MetricsRegistry::Clock::now() - start);
 		break;
     }
 }
 
-winrt::fire_and_forget BiometricCipherPlugin::GetTPMStatus(std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result)
+winrt::fire_and_forget BiometricCipherPlugin::RunOperation(
+	MethodName method,
+	MetricsRegistry::Clock::time_point start,
+	Operation operation,
+	std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result)
 {
+	m_Metrics->RecordPhase(MetricsPhase::kArgumentParsing, MetricsRegistry::Clock::now() - start);
+
+	// The schema names are string literals, so they outlive the trace.
+	TraceAsyncScope trace(GetMethodSchema(method)->name.data());
+
+	{
+		TraceAwait hop("ResumeOnWorkerPool");
+		auto toWorkerPool = ResumeOn(*m_WorkerPool);
+		co_await toWorkerPool;
+	}
+
+	std::optional<flutter::EncodableValue> reply;
+	std::exception_ptr exception;
 	try {
-		auto tpmStatus = co_await m_SecureService->GetTPMStatusAsync();
+		auto task = operation();
+		reply.emplace(co_await task);
+	}
+	catch (...) {
+		exception = std::current_exception();
+	}
+
+	MetricsRegistry::PhaseTimer replyTimer(m_Metrics.get(), MetricsPhase::kEncodingAndReply);
 
-		result->Success(tpmStatus);
+	// MethodResult may only be used on the platform thread.
+	{
+		TraceAwait hop("ResumeOnPlatformThread");
+		auto toPlatformThread = ResumeOn(*m_PlatformThread);
+		co_await toPlatformThread;
 	}
-	catch (const hresult_error& e) {
-		auto hr = e.code();
-		auto message = e.message();
-		auto errorMessage = StringUtil::ConvertHStringToString(message);
-		OutputException(hr, errorMessage);
 
-		result->Error(GetErrorCodeString(hr), errorMessage);
+	if (exception) {
+		try {
+			std::rethrow_exception(exception);
+		}
+		catch (...) {
+			ReplyWithCurrentException(method, *result);
+		}
+	}
+	else {
+		result->Success(std::move(*reply));
 	}
+
+	m_Metrics->RecordCall(method, MetricsRegistry::Clock::now() - start);
 }
 
-winrt::fire_and_forget BiometricCipherPlugin::GetBiometryStatus(std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result)
+Task<flutter::EncodableValue> BiometricCipherPlugin::GetTPMStatus()
 {
-	try {
-		auto biometryStatus = co_await m_SecureService->GetBiometryStatusAsync();
+	auto tpmStatus = co_await m_SecureService->GetTPMStatusAsync();
 
-		result->Success(biometryStatus);
-	}
-	catch (const hresult_error& e) {
-		auto hr = e.code();
-		auto message = e.message();
-		auto errorMessage = StringUtil::ConvertHStringToString(message);
-		OutputException(hr, errorMessage);
+	co_return flutter::EncodableValue(tpmStatus);
+}
+
+Task<flutter::EncodableValue> BiometricCipherPlugin::RefreshTPMStatus()
+{
+	auto tpmStatus = co_await m_SecureService->RefreshTPMStatusAsync();
 
-		result->Error(GetErrorCodeString(hr), errorMessage);
+	co_return flutter::EncodableValue(tpmStatus);
+}
+
+Task<flutter::EncodableValue> BiometricCipherPlugin::GetBiometryStatus(const bool allowCached)
+{
+	int biometryStatus = 0;
+	if (allowCached) {
+		biometryStatus = co_await m_SecureService->GetCachedBiometryStatusAsync();
 	}
+	else {
+		biometryStatus = co_await m_SecureService->GetBiometryStatusAsync();
+	}
+
+	co_return flutter::EncodableValue(biometryStatus);
 }
 
-winrt::fire_and_forget BiometricCipherPlugin::GenerateKeyCoroutine(
-	const std::string& tag,
-	std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) 
+Task<flutter::EncodableValue> BiometricCipherPlugin::GenerateKeyCoroutine(std::string tag)
 {
-	try {
-		co_await m_SecureService->GenerateKeyAsync(tag);
+	co_await m_SecureService->GenerateKeyAsync(std::move(tag));
 
-		result->Success(NULL);
-	}
-	catch (const hresult_error& e) {
-		auto hr = e.code();
-		auto message = e.message();
-		auto errorMessage = StringUtil::ConvertHStringToString(message);
-		OutputException(hr, errorMessage);
+	co_return flutter::EncodableValue(NULL);
+}
+
+Task<flutter::EncodableValue> BiometricCipherPlugin::DeleteKeyCoroutine(std::string tag)
+{
+	co_await m_SecureService->DeleteKeyAsync(std::move(tag));
+
+	co_return flutter::EncodableValue(NULL);
+}
+
+Task<flutter::EncodableValue> BiometricCipherPlugin::EncryptCoroutine(std::string tag, SecureString data, std::string context)
+{
+	auto encryptedString = co_await m_SecureService->EncryptAsync(std::move(tag), std::move(data), std::move(context));
+
+	co_return flutter::EncodableValue(std::move(encryptedString));
+}
+
+Task<flutter::EncodableValue> BiometricCipherPlugin::DecryptCoroutine(std::string tag, std::string data, std::string context)
+{
+	auto decryptedString = co_await m_SecureService->DecryptAsync(std::move(tag), std::move(data), std::move(context));
+
+	// The reply has to be an ordinary string: from here on the plaintext belongs to Flutter.
+	co_return flutter::EncodableValue(std::string(decryptedString));
+}
+
+Task<flutter::EncodableValue> BiometricCipherPlugin::EncryptBinaryCoroutine(std::string tag, SecureBuffer data, std::string context)
+{
+	auto encryptedData = co_await m_SecureService->EncryptBinaryAsync(std::move(tag), std::move(data), std::move(context));
+
+	co_return flutter::EncodableValue(std::move(encryptedData));
+}
+
+Task<flutter::EncodableValue> BiometricCipherPlugin::DecryptBinaryCoroutine(std::string tag, std::vector<uint8_t> data, std::string context)
+{
+	auto decryptedData = co_await m_SecureService->DecryptBinaryAsync(std::move(tag), std::move(data), std::move(context));
+
+	co_return flutter::EncodableValue(std::vector<uint8_t>(decryptedData.begin(), decryptedData.end()));
+}
 
-		result->Error(GetErrorCodeString(hr), errorMessage);
+Task<flutter::EncodableValue> BiometricCipherPlugin::EncryptBatchCoroutine(std::string tag, std::vector<SecureString> data, std::string context)
+{
+	auto encryptedStrings = co_await m_SecureService->EncryptBatchAsync(std::move(tag), std::move(data), std::move(context));
+
+	flutter::EncodableList encryptedList;
+	encryptedList.reserve(encryptedStrings.size());
+	for (auto& encryptedString : encryptedStrings) {
+		encryptedList.emplace_back(std::move(encryptedString));
 	}
+
+	co_return flutter::EncodableValue(std::move(encryptedList));
 }
 
-winrt::fire_and_forget BiometricCipherPlugin::DeleteKeyCoroutine(
-	const std::string& tag, 
-	std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) 
+Task<flutter::EncodableValue> BiometricCipherPlugin::DecryptBatchCoroutine(std::string tag, std::vector<std::string> data, std::string context)
 {
-	try {
-		co_await m_SecureService->DeleteKeyAsync(tag);
+	auto decryptedStrings = co_await m_SecureService->DecryptBatchAsync(std::move(tag), std::move(data), std::move(context));
 
-		result->Success(NULL);
+	flutter::EncodableList decryptedList;
+	decryptedList.reserve(decryptedStrings.size());
+	for (auto& decryptedString : decryptedStrings) {
+		decryptedList.emplace_back(std::string(decryptedString));
 	}
-	catch (const hresult_error& e) {
-		auto hr = e.code();
-		auto message = e.message();
-		auto errorMessage = StringUtil::ConvertHStringToString(message);
-		OutputException(hr, errorMessage);
 
-		result->Error(GetErrorCodeString(hr), errorMessage);
+	co_return flutter::EncodableValue(std::move(decryptedList));
+}
+
+Task<flutter::EncodableValue> BiometricCipherPlugin::EncryptStreamBeginCoroutine(std::string tag, std::string context)
+{
+	auto stream = co_await m_SecureService->BeginEncryptStreamAsync(std::move(tag), std::move(context));
+
+	const auto& header = stream->GetHeader();
+	std::vector<uint8_t> headerBytes(header.begin(), header.end());
+	auto streamId = m_EncryptStreams.Add(std::move(stream));
+
+	co_return flutter::EncodableValue(flutter::EncodableMap{
+		{ flutter::EncodableValue("streamId"), flutter::EncodableValue(static_cast<int64_t>(streamId)) },
+		{ flutter::EncodableValue("header"), flutter::EncodableValue(std::move(headerBytes)) },
+	});
+}
+
+Task<flutter::EncodableValue> BiometricCipherPlugin::EncryptStreamChunkCoroutine(uint32_t streamId, uint32_t chunkIndex, SecureBuffer data)
+{
+	co_await m_EncryptStreams.WaitForTurn(streamId, chunkIndex);
+
+	std::vector<uint8_t> output;
+	m_EncryptStreams.Use(streamId, chunkIndex, [&](EncryptStream& stream) { stream.Update(data, output); });
+
+	co_return flutter::EncodableValue(std::move(output));
+}
+
+Task<flutter::EncodableValue> BiometricCipherPlugin::EncryptStreamEndCoroutine(uint32_t streamId, uint32_t chunkCount)
+{
+	co_await m_EncryptStreams.WaitForTurn(streamId, chunkCount);
+
+	auto stream = m_EncryptStreams.Remove(streamId, chunkCount);
+
+	std::vector<uint8_t> output;
+	stream->Finish(output);
+
+	co_return flutter::EncodableValue(std::move(output));
+}
+
+Task<flutter::EncodableValue> BiometricCipherPlugin::DecryptStreamBeginCoroutine(std::string tag, std::vector<uint8_t> header, std::string context)
+{
+	auto stream = co_await m_SecureService->BeginDecryptStreamAsync(std::move(tag), std::move(header), std::move(context));
+	auto streamId = m_DecryptStreams.Add(std::move(stream));
+
+	co_return flutter::EncodableValue(static_cast<int64_t>(streamId));
+}
+
+Task<flutter::EncodableValue> BiometricCipherPlugin::DecryptStreamChunkCoroutine(uint32_t streamId, uint32_t chunkIndex, std::vector<uint8_t> data)
+{
+	co_await m_DecryptStreams.WaitForTurn(streamId, chunkIndex);
+
+	SecureBuffer output;
+	m_DecryptStreams.Use(streamId, chunkIndex, [&](DecryptStream& stream) { stream.Update(data, output); });
+
+	// The reply has to be an ordinary buffer: from here on the plaintext belongs to Flutter.
+	co_return flutter::EncodableValue(std::vector<uint8_t>(output.begin(), output.end()));
+}
+
+Task<flutter::EncodableValue> BiometricCipherPlugin::DecryptStreamEndCoroutine(uint32_t streamId, uint32_t chunkCount)
+{
+	co_await m_DecryptStreams.WaitForTurn(streamId, chunkCount);
+
+	auto stream = m_DecryptStreams.Remove(streamId, chunkCount);
+
+	SecureBuffer output;
+	stream->Finish(output);
+
+	co_return flutter::EncodableValue(std::vector<uint8_t>(output.begin(), output.end()));
+}
+
+Task<flutter::EncodableValue> BiometricCipherPlugin::Sha256Coroutine(std::vector<uint8_t> data)
+{
+	std::vector<uint8_t> digest(Sha256::DIGEST_LENGTH);
+	Sha256::Hash(data.data(), data.size(), digest.data());
+
+	co_return flutter::EncodableValue(std::move(digest));
+}
+
+Task<flutter::EncodableValue> BiometricCipherPlugin::HmacSha256Coroutine(std::vector<uint8_t> key, std::vector<uint8_t> data)
+{
+	std::vector<uint8_t> mac(HmacSha256::MAC_LENGTH);
+	HmacSha256::Compute(key.data(), key.size(), data.data(), data.size(), mac.data());
+	SecureMemory::Zero(key.data(), key.size());
+
+	co_return flutter::EncodableValue(std::move(mac));
+}
+
+Task<flutter::EncodableValue> BiometricCipherPlugin::ExportTraceCoroutine(std::string path)
+{
+	auto trace = Tracer::Get().ExportChromeTrace();
+	if (!path.empty()) {
+		Tracer::Get().WriteChromeTrace(path);
 	}
+
+	co_return flutter::EncodableValue(std::move(trace));
 }
 
-winrt::fire_and_forget BiometricCipherPlugin::EncryptCoroutine(
-	const std::string& tag,
-	const std::string& data,
-	std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) 
+flutter::EncodableValue BiometricCipherPlugin::ConvertMetrics(const MetricsSnapshot& snapshot)
 {
-	try {
-		auto encryptedHString = co_await m_SecureService->EncryptAsync(tag, data);
-		std::string encryptedString = StringUtil::ConvertHStringToString(encryptedHString);
+	flutter::EncodableMap methods;
+	for (const auto& method : snapshot.methods) {
+		const auto* schema = GetMethodSchema(method.method);
+		std::string name = schema ? std::string(schema->name) : "notImplemented";
+
+		methods[flutter::EncodableValue(std::move(name))] = flutter::EncodableValue(flutter::EncodableMap{
+			{ flutter::EncodableValue("calls"), flutter::EncodableValue(static_cast<int64_t>(method.calls)) },
+			{ flutter::EncodableValue("errors"), flutter::EncodableValue(static_cast<int64_t>(method.errors)) },
+			{ flutter::EncodableValue("latency"), ConvertLatency(method.latency) },
+		});
+	}
 
-		result->Success(encryptedString);
+	flutter::EncodableMap errors;
+	for (const auto& [code, count] : snapshot.errors) {
+		errors[flutter::EncodableValue(code)] = flutter::EncodableValue(static_cast<int64_t>(count));
 	}
-	catch (const hresult_error& e) {
-		auto hr = e.code();
-		auto message = e.message();
-		auto errorMessage = StringUtil::ConvertHStringToString(message);
-		OutputException(hr, errorMessage);
 
-		result->Error(GetErrorCodeString(hr), errorMessage);
+	flutter::EncodableMap phases;
+	for (size_t i = 0; i < METRICS_PHASE_COUNT; ++i) {
+		auto name = GetMetricsPhaseName(static_cast<MetricsPhase>(i));
+		phases[flutter::EncodableValue(std::string(name))] = ConvertLatency(snapshot.phases[i]);
 	}
+
+	return flutter::EncodableValue(flutter::EncodableMap{
+		{ flutter::EncodableValue("methods"), flutter::EncodableValue(std::move(methods)) },
+		{ flutter::EncodableValue("errors"), flutter::EncodableValue(std::move(errors)) },
+		{ flutter::EncodableValue("phases"), flutter::EncodableValue(std::move(phases)) },
+	});
 }
 
-winrt::fire_and_forget BiometricCipherPlugin::DecryptCoroutine(
-	const std::string& tag, 
-	const std::string& data, 
-	std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result)
+flutter::EncodableValue BiometricCipherPlugin::ConvertLatency(const LatencyHistogramSnapshot& latency)
+{
+	return flutter::EncodableValue(flutter::EncodableMap{
+		{ flutter::EncodableValue("count"), flutter::EncodableValue(static_cast<int64_t>(latency.count)) },
+		{ flutter::EncodableValue("totalNs"), flutter::EncodableValue(static_cast<int64_t>(latency.total.count())) },
+		{ flutter::EncodableValue("maxNs"), flutter::EncodableValue(static_cast<int64_t>(latency.max.count())) },
+		{ flutter::EncodableValue("p50Ns"), flutter::EncodableValue(static_cast<int64_t>(latency.p50.count())) },
+		{ flutter::EncodableValue("p90Ns"), flutter::EncodableValue(static_cast<int64_t>(latency.p90.count())) },
+		{ flutter::EncodableValue("p99Ns"), flutter::EncodableValue(static_cast<int64_t>(latency.p99.count())) },
+	});
+}
+
+void BiometricCipherPlugin::ReplyWithCurrentException(MethodName method, flutter::MethodResult<flutter::EncodableValue>& result)
 {
 	try {
-		auto decryptedData = co_await m_SecureService->DecryptAsync(tag, data);
-		std::string decryptedString = StringUtil::ConvertHStringToString(decryptedData);
+		throw;
+	}
+	catch (const BiometricCipherException& e) {
+		m_Metrics->RecordError(method, e.Code());
+		OutputException(e.Code(), e.what());
 
-		result->Success(decryptedString);
+		result.Error(GetErrorCodeString(e.Code()), e.what());
 	}
 	catch (const hresult_error& e) {
-		auto hr = e.code();
-		auto message = e.message();
-		auto errorMessage = StringUtil::ConvertHStringToString(message);
-		OutputException(hr, errorMessage);
+		auto exception = WinrtInterop::ConvertHResultError(e);
+		m_Metrics->RecordError(method, exception.Code());
+		OutputException(exception.Code(), exception.what());
+
+		result.Error(GetErrorCodeString(exception.Code()), exception.what());
+	}
+	catch (const std::exception& e) {
+		m_Metrics->RecordError(method, error_fail);
+		OutputException(error_fail, e.what());
+
+		result.Error(GetErrorCodeString(error_fail), e.what());
+	}
+	catch (...) {
+		m_Metrics->RecordError(method, error_fail);
+		OutputException(error_fail, "Unknown error occurred.");
 
-		result->Error(GetErrorCodeString(hr), errorMessage);
+		result.Error(GetErrorCodeString(error_fail), "Unknown error occurred.");
 	}
 }
 
-void BiometricCipherPlugin::OutputException(hresult hr, std::string& errorMessage)
+void BiometricCipherPlugin::OutputException(ErrorCode code, const std::string& errorMessage)
 {
 	std::ostringstream ss;
-	ss << "Error code: 0x" << std::hex << std::uppercase << hr.value;
+	ss << "Error code: 0x" << std::hex << std::uppercase << static_cast<uint32_t>(code);
 	ss << " Message: " << errorMessage;
 #ifdef DEBUG
 	OutputDebugStringA(ss.str().c_str());
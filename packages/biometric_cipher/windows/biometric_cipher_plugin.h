@@ -1,7 +1,14 @@
 #ifndef FLUTTER_PLUGIN_BIOMETRIC_CIPHER_PLUGIN_H_
 #define FLUTTER_PLUGIN_BIOMETRIC_CIPHER_PLUGIN_H_
 
+#include "include/biometric_cipher/common/aes_gcm_stream.h"
 #include "include/biometric_cipher/common/argument_parser.h"
+#include "include/biometric_cipher/common/metrics_registry.h"
+#include "include/biometric_cipher/common/platform_thread_executor.h"
+#include "include/biometric_cipher/common/stream_registry.h"
+#include "include/biometric_cipher/common/task.h"
+#include "include/biometric_cipher/common/thread_pool_executor.h"
+#include "include/biometric_cipher/errors/error_codes.h"
 #include "include/biometric_cipher/services/biometric_cipher_service.h"
 #include "include/biometric_cipher/storages/config_storage.h"
 
@@ -10,8 +17,10 @@
 #include <flutter/plugin_registrar_windows.h>
 
 #include <windows.h>
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 #include <winrt/base.h>
 #include <winrt/windows.foundation.h>
 #include <winrt/windows.system.threading.h>
@@ -36,35 +45,99 @@ class BiometricCipherPlugin : public flutter::Plugin {
       std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
 
 private:
-	winrt::fire_and_forget GetTPMStatus(
+	using Operation = std::function<Task<flutter::EncodableValue>()>;
+
+	// Threading model: HandleMethodCall runs on the platform thread and only parses the
+	// arguments. The operation itself starts on the worker pool (key storage queries,
+	// hashing, AES, Base64 and string conversion never run on the platform thread) and may
+	// continue on whichever thread completes a WinRT call. Windows Hello prompts are the
+	// exception: the repository shows them from the platform thread, which owns the app's
+	// windows, and goes back to the pool afterwards. The reply is always sent from the
+	// platform thread.
+	//
+	// The time from start to RunOperation is recorded as argument parsing, and the time from
+	// the end of the operation to the reply as encoding and reply.
+	winrt::fire_and_forget RunOperation(
+		MethodName method,
+		MetricsRegistry::Clock::time_point start,
+		Operation operation,
 		std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
 
-	winrt::fire_and_forget GetBiometryStatus(
-		std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+	Task<flutter::EncodableValue> GetTPMStatus();
 
-	winrt::fire_and_forget GenerateKeyCoroutine(
-		const std::string& tag,
-		std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+	Task<flutter::EncodableValue> RefreshTPMStatus();
 
-	winrt::fire_and_forget DeleteKeyCoroutine(
-		const std::string& tag,
-		std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+	Task<flutter::EncodableValue> GetBiometryStatus(const bool allowCached);
 
-	winrt::fire_and_forget EncryptCoroutine(
-		const std::string& tag,
-		const std::string& data,
-		std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+	// The coroutines take their arguments by value: the handler copies them out of the method
+	// call once and moves them in, and the coroutine frame owns them from then on. context is
+	// empty unless the call selects a subkey of tag.
+	Task<flutter::EncodableValue> GenerateKeyCoroutine(std::string tag);
 
-	winrt::fire_and_forget DecryptCoroutine(
-		const std::string& tag,
-		const std::string& data,
-		std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+	Task<flutter::EncodableValue> DeleteKeyCoroutine(std::string tag);
+
+	Task<flutter::EncodableValue> EncryptCoroutine(std::string tag, SecureString data, std::string context);
+
+	Task<flutter::EncodableValue> DecryptCoroutine(std::string tag, std::string data, std::string context);
+
+	Task<flutter::EncodableValue> EncryptBinaryCoroutine(std::string tag, SecureBuffer data, std::string context);
+
+	Task<flutter::EncodableValue> DecryptBinaryCoroutine(std::string tag, std::vector<uint8_t> data, std::string context);
+
+	Task<flutter::EncodableValue> EncryptBatchCoroutine(std::string tag, std::vector<SecureString> data, std::string context);
+
+	Task<flutter::EncodableValue> DecryptBatchCoroutine(std::string tag, std::vector<std::string> data, std::string context);
+
+	// Streams: begin derives the key once and registers the stream under an id, each chunk
+	// returns the output its data completes, and end returns the rest and drops the stream.
+	// encryptStreamBegin returns {"streamId", "header"}; the header goes before the chunks.
+	// The pool may start the calls of a stream in any order, so each names its place in it
+	// and waits in StreamRegistry until the calls before it have finished.
+	Task<flutter::EncodableValue> EncryptStreamBeginCoroutine(std::string tag, std::string context);
+
+	Task<flutter::EncodableValue> EncryptStreamChunkCoroutine(uint32_t streamId, uint32_t chunkIndex, SecureBuffer data);
+
+	Task<flutter::EncodableValue> EncryptStreamEndCoroutine(uint32_t streamId, uint32_t chunkCount);
+
+	Task<flutter::EncodableValue> DecryptStreamBeginCoroutine(std::string tag, std::vector<uint8_t> header, std::string context);
+
+	Task<flutter::EncodableValue> DecryptStreamChunkCoroutine(uint32_t streamId, uint32_t chunkIndex, std::vector<uint8_t> data);
+
+	Task<flutter::EncodableValue> DecryptStreamEndCoroutine(uint32_t streamId, uint32_t chunkCount);
+
+	// Strings are hashed as their UTF-8 bytes.
+	Task<flutter::EncodableValue> Sha256Coroutine(std::vector<uint8_t> data);
+
+	Task<flutter::EncodableValue> HmacSha256Coroutine(std::vector<uint8_t> key, std::vector<uint8_t> data);
+
+	// The trace as Chrome trace-event JSON; also written to path unless it is empty.
+	Task<flutter::EncodableValue> ExportTraceCoroutine(std::string path);
+
+	// {"methods": {name: {"calls", "errors", "latency"}}, "errors": {code: count},
+	// "phases": {name: latency}}, where each latency is a map of "count", "totalNs", "maxNs",
+	// "p50Ns", "p90Ns" and "p99Ns".
+	static flutter::EncodableValue ConvertMetrics(const MetricsSnapshot& snapshot);
+
+	static flutter::EncodableValue ConvertLatency(const LatencyHistogramSnapshot& latency);
+
+	// Must be called from a catch block: reports the exception being handled to Dart and
+	// counts it against the method.
+	void ReplyWithCurrentException(MethodName method, flutter::MethodResult<flutter::EncodableValue>& result);
 
-	void OutputException(winrt::hresult hr, std::string& errorMessage);
+	void OutputException(ErrorCode code, const std::string& errorMessage);
 
 	biometric_cipher::ArgumentParser m_Argument_parser;
 	std::shared_ptr<biometric_cipher::ConfigStorage> m_ConfigStorage;
 	std::shared_ptr<biometric_cipher::BiometricCipherService> m_SecureService;
+	// Shared with the repositories, which time the phases of each call.
+	std::shared_ptr<biometric_cipher::MetricsRegistry> m_Metrics;
+	biometric_cipher::StreamRegistry<biometric_cipher::EncryptStream> m_EncryptStreams;
+	biometric_cipher::StreamRegistry<biometric_cipher::DecryptStream> m_DecryptStreams;
+
+	// The pool is declared last so that it is destroyed first: work it still runs may post
+	// replies to the platform thread.
+	std::unique_ptr<biometric_cipher::PlatformThreadExecutor> m_PlatformThread;
+	std::unique_ptr<biometric_cipher::ThreadPoolExecutor> m_WorkerPool;
 };
 
 }  // namespace biometric_cipher
@@ -0,0 +1,73 @@
+#include "include/biometric_cipher/common/aead_key.h"
+#include "include/biometric_cipher/common/chacha20_poly1305.h"
+#include "include/biometric_cipher/common/secure_memory.h"
+#include "include/biometric_cipher/common/sha256.h"
+
+#include <algorithm>
+
+namespace biometric_cipher
+{
+	static_assert(AeadKey::KEY_LENGTH == AesGcm::KEY_LENGTH && AeadKey::KEY_LENGTH == ChaCha20Poly1305::KEY_LENGTH);
+	static_assert(AeadKey::NONCE_LENGTH == AesGcm::NONCE_LENGTH && AeadKey::NONCE_LENGTH == ChaCha20Poly1305::NONCE_LENGTH);
+	static_assert(AeadKey::TAG_LENGTH == AesGcm::TAG_LENGTH && AeadKey::TAG_LENGTH == ChaCha20Poly1305::TAG_LENGTH);
+
+	AeadKey::AeadKey(const uint8_t* key)
+		: m_AesGcmKey(key)
+	{
+		std::copy(key, key + KEY_LENGTH, m_Key.begin());
+	}
+
+	AeadKey::~AeadKey()
+	{
+		SecureMemory::Zero(m_Key.data(), m_Key.size());
+	}
+
+	void AeadKey::DeriveKey(const uint8_t* info, size_t infoLength, uint8_t* output) const
+	{
+		HkdfSha256::Derive(nullptr, 0, m_Key.data(), m_Key.size(), info, infoLength, output, KEY_LENGTH);
+	}
+
+	void AeadKey::Seal(
+		AeadSuite suite,
+		const uint8_t* nonce,
+		const uint8_t* aad,
+		size_t aadLength,
+		const uint8_t* input,
+		size_t length,
+		uint8_t* output,
+		uint8_t* tag) const
+	{
+		switch (suite)
+		{
+		case AeadSuite::kAes256Gcm:
+			AesGcm::Encrypt(m_AesGcmKey, nonce, aad, aadLength, input, length, output, tag);
+			break;
+
+		case AeadSuite::kChaCha20Poly1305:
+			ChaCha20Poly1305::Encrypt(m_Key.data(), nonce, aad, aadLength, input, length, output, tag);
+			break;
+		}
+	}
+
+	bool AeadKey::Open(
+		AeadSuite suite,
+		const uint8_t* nonce,
+		const uint8_t* aad,
+		size_t aadLength,
+		const uint8_t* input,
+		size_t length,
+		const uint8_t* tag,
+		uint8_t* output) const
+	{
+		switch (suite)
+		{
+		case AeadSuite::kAes256Gcm:
+			return AesGcm::Decrypt(m_AesGcmKey, nonce, aad, aadLength, input, length, tag, output);
+
+		case AeadSuite::kChaCha20Poly1305:
+			return ChaCha20Poly1305::Decrypt(m_Key.data(), nonce, aad, aadLength, input, length, tag, output);
+		}
+
+		return false;
+	}
+}  // namespace biometric_cipher
@@ -0,0 +1,16 @@
+#include "include/biometric_cipher/enums/aead_suite.h"
+
+namespace biometric_cipher
+{
+	std::optional<AeadSuite> ByteToAeadSuite(uint8_t value)
+	{
+		switch (static_cast<AeadSuite>(value))
+		{
+		case AeadSuite::kAes256Gcm:
+		case AeadSuite::kChaCha20Poly1305:
+			return static_cast<AeadSuite>(value);
+		}
+
+		return std::nullopt;
+	}
+} // namespace biometric_cipher
@@ -0,0 +1,64 @@
+#include "include/biometric_cipher/common/aead_suite_selector.h"
+#include "include/biometric_cipher/common/aead_key.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace biometric_cipher
+{
+	namespace
+	{
+		// The best of a few runs, so that a preemption does not decide the suite.
+		const int SAMPLE_RUN_COUNT = 5;
+
+		std::chrono::nanoseconds TimeSuite(const AeadKey& key, AeadSuite suite, std::vector<uint8_t>& buffer)
+		{
+			uint8_t nonce[AeadKey::NONCE_LENGTH] = {};
+			uint8_t tag[AeadKey::TAG_LENGTH];
+
+			auto best = std::chrono::nanoseconds::max();
+			for (int i = 0; i < SAMPLE_RUN_COUNT; ++i) {
+				auto start = std::chrono::steady_clock::now();
+				key.Seal(suite, nonce, nullptr, 0, buffer.data(), buffer.size(), buffer.data(), tag);
+				auto elapsed = std::chrono::steady_clock::now() - start;
+				best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed));
+				++nonce[0];
+			}
+
+			return best;
+		}
+	}
+
+	AeadSuite AeadSuiteSelector::GetPreferredSuite()
+	{
+		static const AeadSuite suite = MeasureFastestSuite();
+
+		return suite;
+	}
+
+	AeadSuite AeadSuiteSelector::MeasureFastestSuite()
+	{
+		// Neither the key nor the data is secret.
+		const uint8_t keyBytes[AeadKey::KEY_LENGTH] = {};
+		AeadKey key(keyBytes);
+		std::vector<uint8_t> buffer(SAMPLE_LENGTH);
+
+		// A first untimed pass for each suite warms the caches and the branch predictors.
+		TimeSuite(key, AeadSuite::kAes256Gcm, buffer);
+		TimeSuite(key, AeadSuite::kChaCha20Poly1305, buffer);
+
+		auto aesGcmTime = TimeSuite(key, AeadSuite::kAes256Gcm, buffer);
+		auto chaChaTime = TimeSuite(key, AeadSuite::kChaCha20Poly1305, buffer);
+
+		return Choose(aesGcmTime, chaChaTime);
+	}
+
+	AeadSuite AeadSuiteSelector::Choose(std::chrono::nanoseconds aesGcmTime, std::chrono::nanoseconds chaChaTime)
+	{
+		if (static_cast<double>(chaChaTime.count()) * CHACHA_MIN_SPEEDUP < static_cast<double>(aesGcmTime.count())) {
+			return AeadSuite::kChaCha20Poly1305;
+		}
+
+		return AeadSuite::kAes256Gcm;
+	}
+}  // namespace biometric_cipher
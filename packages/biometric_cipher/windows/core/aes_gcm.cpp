@@ -0,0 +1,998 @@
+#include "include/biometric_cipher/common/aes_gcm.h"
+#include "include/biometric_cipher/common/cpu_features.h"
+#include "include/biometric_cipher/common/secure_memory.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#if defined(BIOMETRIC_CIPHER_X86)
+#include <immintrin.h>
+#endif
+
+namespace biometric_cipher
+{
+	namespace
+	{
+		constexpr size_t kBlockLength = 16;
+
+		constexpr int kRounds = 14;
+
+		// GHASH over the AAD and the ciphertext is aggregated over up to 16 blocks.
+		constexpr size_t kHashKeyPowerCount = 16;
+
+		// Encryption runs CTR and then GHASH over chunks of this size, so that the
+		// ciphertext is still in L1 when it is hashed.
+		constexpr size_t kChunkLength = 4096;
+	}
+
+	struct AesGcmKeySchedule
+	{
+		alignas(64) uint8_t roundKeys[kRounds + 1][kBlockLength];
+
+		// H^16, H^15, ..., H^1, byte-reflected for the carry-less multiplication paths.
+		alignas(64) uint8_t hashKeyPowers[kHashKeyPowerCount][kBlockLength];
+
+		uint8_t hashKey[kBlockLength];
+
+		~AesGcmKeySchedule()
+		{
+			SecureMemory::Zero(this, sizeof(*this));
+		}
+	};
+
+	namespace
+	{
+		using KeySchedule = AesGcmKeySchedule;
+
+		uint64_t LoadBigEndian64(const uint8_t* bytes)
+		{
+			uint64_t value = 0;
+			for (int i = 0; i < 8; ++i) {
+				value = (value << 8) | bytes[i];
+			}
+
+			return value;
+		}
+
+		void StoreBigEndian64(uint64_t value, uint8_t* bytes)
+		{
+			for (int i = 7; i >= 0; --i) {
+				bytes[i] = static_cast<uint8_t>(value);
+				value >>= 8;
+			}
+		}
+
+		void StoreBigEndian32(uint32_t value, uint8_t* bytes)
+		{
+			bytes[0] = static_cast<uint8_t>(value >> 24);
+			bytes[1] = static_cast<uint8_t>(value >> 16);
+			bytes[2] = static_cast<uint8_t>(value >> 8);
+			bytes[3] = static_cast<uint8_t>(value);
+		}
+
+		void MakeCounterBlock(const uint8_t* nonce, uint32_t counter, uint8_t* block)
+		{
+			std::memcpy(block, nonce, AesGcm::NONCE_LENGTH);
+			StoreBigEndian32(counter, block + AesGcm::NONCE_LENGTH);
+		}
+
+		// === Portable implementation ===
+		//
+		// Table lookups indexed by secret bytes leak the key through the cache, so the S-box
+		// is computed: 64 bytes are transposed into eight bit planes, inverted in GF(2^8) with
+		// an addition chain and put through the affine transform with bitwise operations only.
+
+		using BitPlanes = uint64_t[8];
+
+		// Transposes an 8x8 bit matrix: bit c of byte r becomes bit r of byte c.
+		uint64_t Transpose8x8(uint64_t x)
+		{
+			uint64_t t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAull;
+			x ^= t ^ (t << 7);
+			t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCull;
+			x ^= t ^ (t << 14);
+			t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ull;
+			x ^= t ^ (t << 28);
+
+			return x;
+		}
+
+		// Reduces a product of up to 15 planes modulo x^8 + x^4 + x^3 + x + 1.
+		void Reduce(uint64_t (&product)[15], BitPlanes& result)
+		{
+			for (int k = 14; k >= 8; --k) {
+				product[k - 8] ^= product[k];
+				product[k - 7] ^= product[k];
+				product[k - 5] ^= product[k];
+				product[k - 4] ^= product[k];
+			}
+			for (int k = 0; k < 8; ++k) {
+				result[k] = product[k];
+			}
+		}
+
+		void Multiply(const BitPlanes& a, const BitPlanes& b, BitPlanes& result)
+		{
+			uint64_t product[15] = {};
+			for (int i = 0; i < 8; ++i) {
+				for (int j = 0; j < 8; ++j) {
+					product[i + j] ^= a[i] & b[j];
+				}
+			}
+			Reduce(product, result);
+		}
+
+		void Square(const BitPlanes& a, BitPlanes& result)
+		{
+			uint64_t product[15] = {};
+			for (int i = 0; i < 8; ++i) {
+				product[2 * i] = a[i];
+			}
+			Reduce(product, result);
+		}
+
+		void SubstitutePlanes(BitPlanes& planes)
+		{
+			// x^254 is the inverse of x (and maps 0 to 0): x^2, x^3, x^6, x^7, ..., x^127, x^254.
+			BitPlanes power;
+			BitPlanes squared;
+			std::memcpy(power, planes, sizeof(power));
+			for (int step = 0; step < 6; ++step) {
+				Square(power, squared);
+				Multiply(squared, planes, power);
+			}
+			Square(power, squared);
+
+			// Affine transform: b[i] ^ b[i + 4] ^ b[i + 5] ^ b[i + 6] ^ b[i + 7] ^ bit i of 0x63.
+			for (int i = 0; i < 8; ++i) {
+				uint64_t constant = ((0x63 >> i) & 1) != 0 ? ~0ull : 0;
+				planes[i] = squared[i] ^ squared[(i + 4) % 8] ^ squared[(i + 5) % 8]
+					^ squared[(i + 6) % 8] ^ squared[(i + 7) % 8] ^ constant;
+			}
+
+			SecureMemory::Zero(power, sizeof(power));
+			SecureMemory::Zero(squared, sizeof(squared));
+		}
+
+		// Puts each of the 64 bytes through the AES S-box.
+		void SubBytes64(uint8_t* bytes)
+		{
+			BitPlanes planes = {};
+			for (int group = 0; group < 8; ++group) {
+				uint64_t word = 0;
+				for (int i = 0; i < 8; ++i) {
+					word |= static_cast<uint64_t>(bytes[group * 8 + i]) << (8 * i);
+				}
+				word = Transpose8x8(word);
+				for (int bit = 0; bit < 8; ++bit) {
+					planes[bit] |= ((word >> (8 * bit)) & 0xFF) << (8 * group);
+				}
+			}
+
+			SubstitutePlanes(planes);
+
+			for (int group = 0; group < 8; ++group) {
+				uint64_t word = 0;
+				for (int bit = 0; bit < 8; ++bit) {
+					word |= ((planes[bit] >> (8 * group)) & 0xFF) << (8 * bit);
+				}
+				word = Transpose8x8(word);
+				for (int i = 0; i < 8; ++i) {
+					bytes[group * 8 + i] = static_cast<uint8_t>(word >> (8 * i));
+				}
+			}
+
+			SecureMemory::Zero(planes, sizeof(planes));
+		}
+
+		uint8_t MultiplyByX(uint8_t value)
+		{
+			return static_cast<uint8_t>((value << 1) ^ (0x1B & (0 - (value >> 7))));
+		}
+
+		void ShiftRows(uint8_t* block)
+		{
+			uint8_t shifted[kBlockLength];
+			for (int column = 0; column < 4; ++column) {
+				for (int row = 0; row < 4; ++row) {
+					shifted[column * 4 + row] = block[((column + row) % 4) * 4 + row];
+				}
+			}
+			std::memcpy(block, shifted, kBlockLength);
+		}
+
+		void MixColumns(uint8_t* block)
+		{
+			for (int column = 0; column < 4; ++column) {
+				uint8_t* a = block + column * 4;
+				uint8_t all = a[0] ^ a[1] ^ a[2] ^ a[3];
+				uint8_t first = a[0];
+				a[0] ^= all ^ MultiplyByX(a[0] ^ a[1]);
+				a[1] ^= all ^ MultiplyByX(a[1] ^ a[2]);
+				a[2] ^= all ^ MultiplyByX(a[2] ^ a[3]);
+				a[3] ^= all ^ MultiplyByX(a[3] ^ first);
+			}
+		}
+
+		void AddRoundKey(uint8_t* block, const uint8_t* roundKey)
+		{
+			for (size_t i = 0; i < kBlockLength; ++i) {
+				block[i] ^= roundKey[i];
+			}
+		}
+
+		void ExpandKey(const uint8_t* key, KeySchedule& schedule)
+		{
+			static const uint8_t kRoundConstants[] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40 };
+
+			uint8_t* words = &schedule.roundKeys[0][0];
+			std::memcpy(words, key, AesGcm::KEY_LENGTH);
+
+			uint8_t substituted[64] = {};
+			for (int i = 8; i < 4 * (kRounds + 1); ++i) {
+				uint8_t temp[4];
+				std::memcpy(temp, words + (i - 1) * 4, 4);
+				if (i % 8 == 0 || i % 8 == 4) {
+					std::memcpy(substituted, temp, 4);
+					SubBytes64(substituted);
+					if (i % 8 == 0) {
+						temp[0] = substituted[1] ^ kRoundConstants[i / 8 - 1];
+						temp[1] = substituted[2];
+						temp[2] = substituted[3];
+						temp[3] = substituted[0];
+					}
+					else {
+						std::memcpy(temp, substituted, 4);
+					}
+				}
+				for (int j = 0; j < 4; ++j) {
+					words[i * 4 + j] = words[(i - 8) * 4 + j] ^ temp[j];
+				}
+				SecureMemory::Zero(temp, sizeof(temp));
+			}
+
+			SecureMemory::Zero(substituted, sizeof(substituted));
+		}
+
+		// Encrypts up to four blocks; the S-box always works on 64 bytes.
+		void EncryptBlocksPortable(const KeySchedule& schedule, const uint8_t* input, uint8_t* output, size_t blockCount)
+		{
+			uint8_t state[4 * kBlockLength] = {};
+			std::memcpy(state, input, blockCount * kBlockLength);
+
+			for (size_t block = 0; block < blockCount; ++block) {
+				AddRoundKey(state + block * kBlockLength, schedule.roundKeys[0]);
+			}
+			for (int round = 1; round <= kRounds; ++round) {
+				SubBytes64(state);
+				for (size_t block = 0; block < blockCount; ++block) {
+					uint8_t* current = state + block * kBlockLength;
+					ShiftRows(current);
+					if (round != kRounds) {
+						MixColumns(current);
+					}
+					AddRoundKey(current, schedule.roundKeys[round]);
+				}
+			}
+
+			std::memcpy(output, state, blockCount * kBlockLength);
+			SecureMemory::Zero(state, sizeof(state));
+		}
+
+		void Ctr32Portable(
+			const KeySchedule& schedule,
+			const uint8_t* nonce,
+			uint32_t counter,
+			const uint8_t* input,
+			uint8_t* output,
+			size_t length)
+		{
+			uint8_t counterBlocks[4 * kBlockLength];
+			uint8_t keystream[4 * kBlockLength];
+			while (length > 0) {
+				size_t chunkLength = std::min(length, sizeof(keystream));
+				size_t blockCount = (chunkLength + kBlockLength - 1) / kBlockLength;
+				for (size_t block = 0; block < blockCount; ++block) {
+					MakeCounterBlock(nonce, counter++, counterBlocks + block * kBlockLength);
+				}
+				EncryptBlocksPortable(schedule, counterBlocks, keystream, blockCount);
+				for (size_t i = 0; i < chunkLength; ++i) {
+					output[i] = input[i] ^ keystream[i];
+				}
+
+				input += chunkLength;
+				output += chunkLength;
+				length -= chunkLength;
+			}
+
+			SecureMemory::Zero(keystream, sizeof(keystream));
+		}
+
+		// X * H in GF(2^128) with the GCM bit order, without secret-dependent branches.
+		void GhashMultiplyPortable(uint64_t& high, uint64_t& low, uint64_t hashKeyHigh, uint64_t hashKeyLow)
+		{
+			uint64_t resultHigh = 0;
+			uint64_t resultLow = 0;
+			uint64_t valueHigh = hashKeyHigh;
+			uint64_t valueLow = hashKeyLow;
+			for (int i = 0; i < 128; ++i) {
+				uint64_t bit = i < 64 ? (high >> (63 - i)) & 1 : (low >> (127 - i)) & 1;
+				uint64_t mask = 0 - bit;
+				resultHigh ^= valueHigh & mask;
+				resultLow ^= valueLow & mask;
+
+				uint64_t carry = 0 - (valueLow & 1);
+				valueLow = (valueLow >> 1) | (valueHigh << 63);
+				valueHigh = (valueHigh >> 1) ^ (0xE100000000000000ull & carry);
+			}
+
+			high = resultHigh;
+			low = resultLow;
+		}
+
+		void GhashPortable(const KeySchedule& schedule, uint8_t* state, const uint8_t* data, size_t length)
+		{
+			uint64_t hashKeyHigh = LoadBigEndian64(schedule.hashKey);
+			uint64_t hashKeyLow = LoadBigEndian64(schedule.hashKey + 8);
+			uint64_t high = LoadBigEndian64(state);
+			uint64_t low = LoadBigEndian64(state + 8);
+
+			while (length > 0) {
+				uint8_t block[kBlockLength] = {};
+				size_t blockLength = std::min(length, kBlockLength);
+				std::memcpy(block, data, blockLength);
+
+				high ^= LoadBigEndian64(block);
+				low ^= LoadBigEndian64(block + 8);
+				GhashMultiplyPortable(high, low, hashKeyHigh, hashKeyLow);
+
+				data += blockLength;
+				length -= blockLength;
+			}
+
+			StoreBigEndian64(high, state);
+			StoreBigEndian64(low, state + 8);
+		}
+
+#if defined(BIOMETRIC_CIPHER_X86)
+		// === AES-NI and PCLMULQDQ ===
+		//
+		// GHASH works on byte-reflected values as in Intel's "Carry-Less Multiplication and
+		// Its Usage for Computing the GCM Mode" white paper: products of up to eight blocks
+		// with the matching powers of H are summed unreduced and reduced once.
+
+		BIOMETRIC_CIPHER_TARGET("aes,pclmul,ssse3,sse4.1")
+		__m128i GetByteSwapMask()
+		{
+			return _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+		}
+
+		BIOMETRIC_CIPHER_TARGET("aes,pclmul,ssse3,sse4.1")
+		void ClmulAccumulate(__m128i a, __m128i b, __m128i& low, __m128i& middle, __m128i& high)
+		{
+			low = _mm_xor_si128(low, _mm_clmulepi64_si128(a, b, 0x00));
+			middle = _mm_xor_si128(middle, _mm_clmulepi64_si128(a, b, 0x10));
+			middle = _mm_xor_si128(middle, _mm_clmulepi64_si128(a, b, 0x01));
+			high = _mm_xor_si128(high, _mm_clmulepi64_si128(a, b, 0x11));
+		}
+
+		BIOMETRIC_CIPHER_TARGET("aes,pclmul,ssse3,sse4.1")
+		__m128i ReduceClmul(__m128i low, __m128i middle, __m128i high)
+		{
+			low = _mm_xor_si128(low, _mm_slli_si128(middle, 8));
+			high = _mm_xor_si128(high, _mm_srli_si128(middle, 8));
+
+			// Shift the 256-bit product left by one bit to account for the reflected order.
+			__m128i lowCarry = _mm_srli_epi32(low, 31);
+			__m128i highCarry = _mm_srli_epi32(high, 31);
+			low = _mm_slli_epi32(low, 1);
+			high = _mm_slli_epi32(high, 1);
+			__m128i crossCarry = _mm_srli_si128(lowCarry, 12);
+			highCarry = _mm_slli_si128(highCarry, 4);
+			lowCarry = _mm_slli_si128(lowCarry, 4);
+			low = _mm_or_si128(low, lowCarry);
+			high = _mm_or_si128(high, highCarry);
+			high = _mm_or_si128(high, crossCarry);
+
+			// Reduce modulo x^128 + x^7 + x^2 + x + 1.
+			__m128i a = _mm_slli_epi32(low, 31);
+			__m128i b = _mm_slli_epi32(low, 30);
+			__m128i c = _mm_slli_epi32(low, 25);
+			a = _mm_xor_si128(a, b);
+			a = _mm_xor_si128(a, c);
+			b = _mm_srli_si128(a, 4);
+			a = _mm_slli_si128(a, 12);
+			low = _mm_xor_si128(low, a);
+
+			__m128i d = _mm_srli_epi32(low, 1);
+			__m128i e = _mm_srli_epi32(low, 2);
+			__m128i f = _mm_srli_epi32(low, 7);
+			d = _mm_xor_si128(d, e);
+			d = _mm_xor_si128(d, f);
+			d = _mm_xor_si128(d, b);
+			low = _mm_xor_si128(low, d);
+
+			return _mm_xor_si128(high, low);
+		}
+
+		BIOMETRIC_CIPHER_TARGET("aes,pclmul,ssse3,sse4.1")
+		__m128i GhashMultiplyClmul(__m128i a, __m128i b)
+		{
+			__m128i low = _mm_setzero_si128();
+			__m128i middle = _mm_setzero_si128();
+			__m128i high = _mm_setzero_si128();
+			ClmulAccumulate(a, b, low, middle, high);
+
+			return ReduceClmul(low, middle, high);
+		}
+
+		BIOMETRIC_CIPHER_TARGET("aes,pclmul,ssse3,sse4.1")
+		void PrepareHashKeyPowersClmul(KeySchedule& schedule)
+		{
+			const __m128i byteSwap = GetByteSwapMask();
+			__m128i hashKey = _mm_shuffle_epi8(
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(schedule.hashKey)), byteSwap);
+
+			__m128i power = hashKey;
+			for (size_t i = 1; i <= kHashKeyPowerCount; ++i) {
+				_mm_store_si128(reinterpret_cast<__m128i*>(schedule.hashKeyPowers[kHashKeyPowerCount - i]), power);
+				power = GhashMultiplyClmul(power, hashKey);
+			}
+		}
+
+		BIOMETRIC_CIPHER_TARGET("aes,pclmul,ssse3,sse4.1")
+		__m128i XorShiftedWords(__m128i key)
+		{
+			key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+			key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+
+			return _mm_xor_si128(key, _mm_slli_si128(key, 4));
+		}
+
+		template <int RoundConstant>
+		BIOMETRIC_CIPHER_TARGET("aes,pclmul,ssse3,sse4.1")
+		void ExpandRoundKeyPairAesNi(__m128i* roundKeys, int index)
+		{
+			__m128i assist = _mm_shuffle_epi32(_mm_aeskeygenassist_si128(roundKeys[index - 1], RoundConstant), 0xFF);
+			roundKeys[index] = _mm_xor_si128(XorShiftedWords(roundKeys[index - 2]), assist);
+			if (index < kRounds) {
+				assist = _mm_shuffle_epi32(_mm_aeskeygenassist_si128(roundKeys[index], 0), 0xAA);
+				roundKeys[index + 1] = _mm_xor_si128(XorShiftedWords(roundKeys[index - 1]), assist);
+			}
+		}
+
+		// Same schedule as ExpandKey, without the cost of the computed S-box.
+		BIOMETRIC_CIPHER_TARGET("aes,pclmul,ssse3,sse4.1")
+		void ExpandKeyAesNi(const uint8_t* key, KeySchedule& schedule)
+		{
+			__m128i roundKeys[kRounds + 1];
+			roundKeys[0] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+			roundKeys[1] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key + kBlockLength));
+			ExpandRoundKeyPairAesNi<0x01>(roundKeys, 2);
+			ExpandRoundKeyPairAesNi<0x02>(roundKeys, 4);
+			ExpandRoundKeyPairAesNi<0x04>(roundKeys, 6);
+			ExpandRoundKeyPairAesNi<0x08>(roundKeys, 8);
+			ExpandRoundKeyPairAesNi<0x10>(roundKeys, 10);
+			ExpandRoundKeyPairAesNi<0x20>(roundKeys, 12);
+			ExpandRoundKeyPairAesNi<0x40>(roundKeys, 14);
+
+			for (int round = 0; round <= kRounds; ++round) {
+				_mm_store_si128(reinterpret_cast<__m128i*>(schedule.roundKeys[round]), roundKeys[round]);
+				roundKeys[round] = _mm_setzero_si128();
+			}
+		}
+
+		BIOMETRIC_CIPHER_TARGET("aes,pclmul,ssse3,sse4.1")
+		void LoadRoundKeys(const KeySchedule& schedule, __m128i* roundKeys)
+		{
+			for (int round = 0; round <= kRounds; ++round) {
+				roundKeys[round] = _mm_load_si128(reinterpret_cast<const __m128i*>(schedule.roundKeys[round]));
+			}
+		}
+
+		BIOMETRIC_CIPHER_TARGET("aes,pclmul,ssse3,sse4.1")
+		__m128i EncryptBlockAesNi(const __m128i* roundKeys, __m128i block)
+		{
+			block = _mm_xor_si128(block, roundKeys[0]);
+			for (int round = 1; round < kRounds; ++round) {
+				block = _mm_aesenc_si128(block, roundKeys[round]);
+			}
+
+			return _mm_aesenclast_si128(block, roundKeys[kRounds]);
+		}
+
+		BIOMETRIC_CIPHER_TARGET("aes,pclmul,ssse3,sse4.1")
+		void EncryptBlockAesNi(const KeySchedule& schedule, const uint8_t* input, uint8_t* output)
+		{
+			__m128i roundKeys[kRounds + 1];
+			LoadRoundKeys(schedule, roundKeys);
+			__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(output), EncryptBlockAesNi(roundKeys, block));
+		}
+
+		BIOMETRIC_CIPHER_TARGET("aes,pclmul,ssse3,sse4.1")
+		void Ctr32AesNi(
+			const KeySchedule& schedule,
+			const uint8_t* nonce,
+			uint32_t counter,
+			const uint8_t* input,
+			uint8_t* output,
+			size_t length)
+		{
+			const __m128i byteSwap = GetByteSwapMask();
+			__m128i roundKeys[kRounds + 1];
+			LoadRoundKeys(schedule, roundKeys);
+
+			// Byte-reflected, the 32-bit big-endian counter is the lowest dword and wraps
+			// around on its own with _mm_add_epi32, as inc32 requires.
+			uint8_t counterBlock[kBlockLength];
+			MakeCounterBlock(nonce, counter, counterBlock);
+			__m128i counterReflected = _mm_shuffle_epi8(
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(counterBlock)), byteSwap);
+
+			size_t offset = 0;
+			for (; offset + 8 * kBlockLength <= length; offset += 8 * kBlockLength) {
+				__m128i blocks[8];
+				for (int i = 0; i < 8; ++i) {
+					blocks[i] = _mm_shuffle_epi8(_mm_add_epi32(counterReflected, _mm_set_epi32(0, 0, 0, i)), byteSwap);
+					blocks[i] = _mm_xor_si128(blocks[i], roundKeys[0]);
+				}
+				counterReflected = _mm_add_epi32(counterReflected, _mm_set_epi32(0, 0, 0, 8));
+
+				for (int round = 1; round < kRounds; ++round) {
+					for (int i = 0; i < 8; ++i) {
+						blocks[i] = _mm_aesenc_si128(blocks[i], roundKeys[round]);
+					}
+				}
+				for (int i = 0; i < 8; ++i) {
+					blocks[i] = _mm_aesenclast_si128(blocks[i], roundKeys[kRounds]);
+					__m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + offset + i * kBlockLength));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(output + offset + i * kBlockLength), _mm_xor_si128(data, blocks[i]));
+				}
+			}
+
+			for (; offset < length; offset += kBlockLength) {
+				__m128i keystream = EncryptBlockAesNi(roundKeys, _mm_shuffle_epi8(counterReflected, byteSwap));
+				counterReflected = _mm_add_epi32(counterReflected, _mm_set_epi32(0, 0, 0, 1));
+
+				if (offset + kBlockLength <= length) {
+					__m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + offset));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(output + offset), _mm_xor_si128(data, keystream));
+				}
+				else {
+					uint8_t keystreamBytes[kBlockLength];
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(keystreamBytes), keystream);
+					for (size_t i = 0; offset + i < length; ++i) {
+						output[offset + i] = input[offset + i] ^ keystreamBytes[i];
+					}
+					SecureMemory::Zero(keystreamBytes, sizeof(keystreamBytes));
+				}
+			}
+		}
+
+		BIOMETRIC_CIPHER_TARGET("aes,pclmul,ssse3,sse4.1")
+		void GhashClmul(const KeySchedule& schedule, uint8_t* state, const uint8_t* data, size_t length)
+		{
+			const __m128i byteSwap = GetByteSwapMask();
+			const auto* powers = reinterpret_cast<const __m128i*>(schedule.hashKeyPowers);
+			const __m128i hashKey = _mm_load_si128(powers + kHashKeyPowerCount - 1);
+			__m128i value = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), byteSwap);
+
+			size_t offset = 0;
+			for (; offset + 8 * kBlockLength <= length; offset += 8 * kBlockLength) {
+				__m128i low = _mm_setzero_si128();
+				__m128i middle = _mm_setzero_si128();
+				__m128i high = _mm_setzero_si128();
+				for (int i = 0; i < 8; ++i) {
+					__m128i block = _mm_shuffle_epi8(
+						_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset + i * kBlockLength)), byteSwap);
+					if (i == 0) {
+						block = _mm_xor_si128(block, value);
+					}
+					// H^8 for the first block down to H^1 for the last one.
+					ClmulAccumulate(block, _mm_load_si128(powers + kHashKeyPowerCount - 8 + i), low, middle, high);
+				}
+				value = ReduceClmul(low, middle, high);
+			}
+
+			for (; offset < length; offset += kBlockLength) {
+				__m128i block;
+				if (offset + kBlockLength <= length) {
+					block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+				}
+				else {
+					uint8_t padded[kBlockLength] = {};
+					std::memcpy(padded, data + offset, length - offset);
+					block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(padded));
+				}
+				value = GhashMultiplyClmul(_mm_xor_si128(value, _mm_shuffle_epi8(block, byteSwap)), hashKey);
+			}
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi8(value, byteSwap));
+		}
+
+		// === VAES and VPCLMULQDQ ===
+		//
+		// Four blocks per 512-bit register and four registers per iteration; the tails are
+		// left to the AES-NI code.
+
+#if defined(__GNUC__) && !defined(__clang__)
+		// GCC 12's AVX-512 headers pass _mm512_undefined_* values to the masked builtins.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+		BIOMETRIC_CIPHER_TARGET("avx512f,avx512bw,vaes,vpclmulqdq,aes,pclmul,ssse3,sse4.1")
+		void Ctr32Vaes(
+			const KeySchedule& schedule,
+			const uint8_t* nonce,
+			uint32_t counter,
+			const uint8_t* input,
+			uint8_t* output,
+			size_t length)
+		{
+			const size_t kStride = 16 * kBlockLength;
+			const __m512i byteSwap = _mm512_broadcast_i32x4(GetByteSwapMask());
+			__m512i roundKeys[kRounds + 1];
+			for (int round = 0; round <= kRounds; ++round) {
+				roundKeys[round] = _mm512_broadcast_i32x4(
+					_mm_load_si128(reinterpret_cast<const __m128i*>(schedule.roundKeys[round])));
+			}
+
+			uint8_t counterBlock[kBlockLength];
+			MakeCounterBlock(nonce, counter, counterBlock);
+			__m512i counters = _mm512_add_epi32(
+				_mm512_shuffle_epi8(
+					_mm512_broadcast_i32x4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(counterBlock))), byteSwap),
+				_mm512_set_epi32(0, 0, 0, 3, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 0));
+			const __m512i increment = _mm512_set_epi32(0, 0, 0, 4, 0, 0, 0, 4, 0, 0, 0, 4, 0, 0, 0, 4);
+
+			size_t offset = 0;
+			for (; offset + kStride <= length; offset += kStride) {
+				__m512i blocks[4];
+				for (int i = 0; i < 4; ++i) {
+					blocks[i] = _mm512_xor_si512(_mm512_shuffle_epi8(counters, byteSwap), roundKeys[0]);
+					counters = _mm512_add_epi32(counters, increment);
+				}
+				for (int round = 1; round < kRounds; ++round) {
+					for (int i = 0; i < 4; ++i) {
+						blocks[i] = _mm512_aesenc_epi128(blocks[i], roundKeys[round]);
+					}
+				}
+				for (int i = 0; i < 4; ++i) {
+					blocks[i] = _mm512_aesenclast_epi128(blocks[i], roundKeys[kRounds]);
+					__m512i data = _mm512_loadu_si512(input + offset + i * 4 * kBlockLength);
+					_mm512_storeu_si512(output + offset + i * 4 * kBlockLength, _mm512_xor_si512(data, blocks[i]));
+				}
+			}
+
+			if (offset < length) {
+				uint32_t processedBlocks = static_cast<uint32_t>(offset / kBlockLength);
+				Ctr32AesNi(schedule, nonce, counter + processedBlocks, input + offset, output + offset, length - offset);
+			}
+		}
+
+		BIOMETRIC_CIPHER_TARGET("avx512f,avx512bw,vaes,vpclmulqdq,aes,pclmul,ssse3,sse4.1")
+		__m128i FoldLanes(__m512i value)
+		{
+			__m128i result = _mm512_castsi512_si128(value);
+			result = _mm_xor_si128(result, _mm512_extracti32x4_epi32(value, 1));
+			result = _mm_xor_si128(result, _mm512_extracti32x4_epi32(value, 2));
+
+			return _mm_xor_si128(result, _mm512_extracti32x4_epi32(value, 3));
+		}
+
+		BIOMETRIC_CIPHER_TARGET("avx512f,avx512bw,vaes,vpclmulqdq,aes,pclmul,ssse3,sse4.1")
+		void GhashVaes(const KeySchedule& schedule, uint8_t* state, const uint8_t* data, size_t length)
+		{
+			const size_t kStride = 16 * kBlockLength;
+			if (length < kStride) {
+				GhashClmul(schedule, state, data, length);
+				return;
+			}
+
+			const __m128i byteSwap128 = GetByteSwapMask();
+			const __m512i byteSwap = _mm512_broadcast_i32x4(byteSwap128);
+			// H^16..H^13, H^12..H^9, H^8..H^5, H^4..H^1.
+			__m512i powers[4];
+			for (int i = 0; i < 4; ++i) {
+				powers[i] = _mm512_load_si512(schedule.hashKeyPowers[i * 4]);
+			}
+			__m128i value = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), byteSwap128);
+
+			size_t offset = 0;
+			for (; offset + kStride <= length; offset += kStride) {
+				__m512i low = _mm512_setzero_si512();
+				__m512i middle = _mm512_setzero_si512();
+				__m512i high = _mm512_setzero_si512();
+				for (int i = 0; i < 4; ++i) {
+					__m512i blocks = _mm512_shuffle_epi8(_mm512_loadu_si512(data + offset + i * 4 * kBlockLength), byteSwap);
+					if (i == 0) {
+						blocks = _mm512_xor_si512(blocks, _mm512_inserti32x4(_mm512_setzero_si512(), value, 0));
+					}
+					low = _mm512_xor_si512(low, _mm512_clmulepi64_epi128(blocks, powers[i], 0x00));
+					middle = _mm512_xor_si512(middle, _mm512_clmulepi64_epi128(blocks, powers[i], 0x10));
+					middle = _mm512_xor_si512(middle, _mm512_clmulepi64_epi128(blocks, powers[i], 0x01));
+					high = _mm512_xor_si512(high, _mm512_clmulepi64_epi128(blocks, powers[i], 0x11));
+				}
+				value = ReduceClmul(FoldLanes(low), FoldLanes(middle), FoldLanes(high));
+			}
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi8(value, byteSwap128));
+			if (offset < length) {
+				GhashClmul(schedule, state, data + offset, length - offset);
+			}
+		}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+		// === Dispatch ===
+
+		bool HasAesNi(const CpuFeatures& features)
+		{
+			return features.aesni && features.pclmulqdq && features.ssse3 && features.sse41;
+		}
+
+		bool HasVaes(const CpuFeatures& features)
+		{
+			return HasAesNi(features) && features.avx512f && features.avx512bw
+				&& features.vaes && features.vpclmulqdq;
+		}
+
+		void EncryptBlock(AesGcm::Implementation implementation, const KeySchedule& schedule, const uint8_t* input, uint8_t* output)
+		{
+#if defined(BIOMETRIC_CIPHER_X86)
+			if (implementation != AesGcm::Implementation::kPortable) {
+				EncryptBlockAesNi(schedule, input, output);
+				return;
+			}
+#endif
+			(void)implementation;
+			EncryptBlocksPortable(schedule, input, output, 1);
+		}
+
+		void Ctr32(
+			AesGcm::Implementation implementation,
+			const KeySchedule& schedule,
+			const uint8_t* nonce,
+			uint32_t counter,
+			const uint8_t* input,
+			uint8_t* output,
+			size_t length)
+		{
+			switch (implementation) {
+#if defined(BIOMETRIC_CIPHER_X86)
+			case AesGcm::Implementation::kVaes:
+				Ctr32Vaes(schedule, nonce, counter, input, output, length);
+				return;
+			case AesGcm::Implementation::kAesNi:
+				Ctr32AesNi(schedule, nonce, counter, input, output, length);
+				return;
+#endif
+			default:
+				Ctr32Portable(schedule, nonce, counter, input, output, length);
+				return;
+			}
+		}
+
+		void Ghash(AesGcm::Implementation implementation, const KeySchedule& schedule, uint8_t* state, const uint8_t* data, size_t length)
+		{
+			switch (implementation) {
+#if defined(BIOMETRIC_CIPHER_X86)
+			case AesGcm::Implementation::kVaes:
+				GhashVaes(schedule, state, data, length);
+				return;
+			case AesGcm::Implementation::kAesNi:
+				GhashClmul(schedule, state, data, length);
+				return;
+#endif
+			default:
+				GhashPortable(schedule, state, data, length);
+				return;
+			}
+		}
+
+		void PrepareKeySchedule(AesGcm::Implementation implementation, const uint8_t* key, KeySchedule& schedule)
+		{
+#if defined(BIOMETRIC_CIPHER_X86)
+			if (implementation != AesGcm::Implementation::kPortable) {
+				ExpandKeyAesNi(key, schedule);
+			}
+			else {
+				ExpandKey(key, schedule);
+			}
+#else
+			ExpandKey(key, schedule);
+#endif
+
+			const uint8_t zeroBlock[kBlockLength] = {};
+			EncryptBlock(implementation, schedule, zeroBlock, schedule.hashKey);
+
+			std::memset(schedule.hashKeyPowers, 0, sizeof(schedule.hashKeyPowers));
+#if defined(BIOMETRIC_CIPHER_X86)
+			if (implementation != AesGcm::Implementation::kPortable) {
+				PrepareHashKeyPowersClmul(schedule);
+			}
+#endif
+		}
+
+		// Hashes the AAD and writes the encrypted J0 block, which masks the tag. The payload
+		// counter starts right after J0.
+		void BeginMessage(
+			AesGcm::Implementation implementation,
+			const KeySchedule& schedule,
+			const uint8_t* nonce,
+			const uint8_t* aad,
+			size_t aadLength,
+			uint8_t* ghashState,
+			uint8_t* tagMask)
+		{
+			uint8_t initialCounterBlock[kBlockLength];
+			MakeCounterBlock(nonce, 1, initialCounterBlock);
+			EncryptBlock(implementation, schedule, initialCounterBlock, tagMask);
+
+			std::memset(ghashState, 0, kBlockLength);
+			if (aadLength > 0) {
+				Ghash(implementation, schedule, ghashState, aad, aadLength);
+			}
+		}
+
+		void FinishTag(
+			AesGcm::Implementation implementation,
+			const KeySchedule& schedule,
+			size_t aadLength,
+			size_t length,
+			uint8_t* ghashState,
+			const uint8_t* tagMask,
+			uint8_t* tag)
+		{
+			uint8_t lengthBlock[kBlockLength];
+			StoreBigEndian64(static_cast<uint64_t>(aadLength) * 8, lengthBlock);
+			StoreBigEndian64(static_cast<uint64_t>(length) * 8, lengthBlock + 8);
+			Ghash(implementation, schedule, ghashState, lengthBlock, kBlockLength);
+
+			for (size_t i = 0; i < AesGcm::TAG_LENGTH; ++i) {
+				tag[i] = ghashState[i] ^ tagMask[i];
+			}
+		}
+	}
+
+	AesGcm::Implementation AesGcm::GetBestImplementation()
+	{
+		const auto& features = CpuFeatures::Get();
+		if (HasVaes(features)) {
+			return Implementation::kVaes;
+		}
+		if (HasAesNi(features)) {
+			return Implementation::kAesNi;
+		}
+
+		return Implementation::kPortable;
+	}
+
+	AesGcm::Implementation AesGcm::Clamp(Implementation requested)
+	{
+		return std::min(requested, GetBestImplementation());
+	}
+
+	void AesGcm::Encrypt(
+		const AesGcmKey& key,
+		const uint8_t* nonce,
+		const uint8_t* aad,
+		size_t aadLength,
+		const uint8_t* input,
+		size_t length,
+		uint8_t* output,
+		uint8_t* tag)
+	{
+		auto implementation = key.GetImplementation();
+		const auto& schedule = key.GetSchedule();
+
+		uint8_t ghashState[kBlockLength];
+		uint8_t tagMask[kBlockLength];
+		BeginMessage(implementation, schedule, nonce, aad, aadLength, ghashState, tagMask);
+
+		for (size_t offset = 0; offset < length; offset += kChunkLength) {
+			size_t chunkLength = std::min(kChunkLength, length - offset);
+			uint32_t counter = static_cast<uint32_t>(2 + offset / kBlockLength);
+			Ctr32(implementation, schedule, nonce, counter, input + offset, output + offset, chunkLength);
+			Ghash(implementation, schedule, ghashState, output + offset, chunkLength);
+		}
+
+		FinishTag(implementation, schedule, aadLength, length, ghashState, tagMask, tag);
+		SecureMemory::Zero(tagMask, sizeof(tagMask));
+	}
+
+	bool AesGcm::Decrypt(
+		const AesGcmKey& key,
+		const uint8_t* nonce,
+		const uint8_t* aad,
+		size_t aadLength,
+		const uint8_t* input,
+		size_t length,
+		const uint8_t* tag,
+		uint8_t* output)
+	{
+		auto implementation = key.GetImplementation();
+		const auto& schedule = key.GetSchedule();
+
+		uint8_t ghashState[kBlockLength];
+		uint8_t tagMask[kBlockLength];
+		BeginMessage(implementation, schedule, nonce, aad, aadLength, ghashState, tagMask);
+		if (length > 0) {
+			Ghash(implementation, schedule, ghashState, input, length);
+		}
+
+		uint8_t expectedTag[TAG_LENGTH];
+		FinishTag(implementation, schedule, aadLength, length, ghashState, tagMask, expectedTag);
+		SecureMemory::Zero(tagMask, sizeof(tagMask));
+
+		uint8_t difference = 0;
+		for (size_t i = 0; i < TAG_LENGTH; ++i) {
+			difference |= expectedTag[i] ^ tag[i];
+		}
+		SecureMemory::Zero(expectedTag, sizeof(expectedTag));
+		if (difference != 0) {
+			return false;
+		}
+
+		Ctr32(implementation, schedule, nonce, 2, input, output, length);
+
+		return true;
+	}
+
+	void AesGcm::Encrypt(
+		const uint8_t* key,
+		const uint8_t* nonce,
+		const uint8_t* aad,
+		size_t aadLength,
+		const uint8_t* input,
+		size_t length,
+		uint8_t* output,
+		uint8_t* tag,
+		Implementation implementation)
+	{
+		AesGcmKey preparedKey(key, implementation);
+		Encrypt(preparedKey, nonce, aad, aadLength, input, length, output, tag);
+	}
+
+	bool AesGcm::Decrypt(
+		const uint8_t* key,
+		const uint8_t* nonce,
+		const uint8_t* aad,
+		size_t aadLength,
+		const uint8_t* input,
+		size_t length,
+		const uint8_t* tag,
+		uint8_t* output,
+		Implementation implementation)
+	{
+		AesGcmKey preparedKey(key, implementation);
+
+		return Decrypt(preparedKey, nonce, aad, aadLength, input, length, tag, output);
+	}
+
+	AesGcmKey::AesGcmKey(const uint8_t* key, AesGcm::Implementation implementation)
+		: m_Implementation(AesGcm::Clamp(implementation)),
+		m_Schedule(std::make_unique<AesGcmKeySchedule>())
+	{
+		PrepareKeySchedule(m_Implementation, key, *m_Schedule);
+	}
+
+	AesGcmKey::~AesGcmKey() = default;
+
+	AesGcm::Implementation AesGcmKey::GetImplementation() const
+	{
+		return m_Implementation;
+	}
+
+	const AesGcmKeySchedule& AesGcmKey::GetSchedule() const
+	{
+		return *m_Schedule;
+	}
+}  // namespace biometric_cipher
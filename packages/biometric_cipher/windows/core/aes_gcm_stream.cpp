@@ -0,0 +1,313 @@
+#include "include/biometric_cipher/common/aes_gcm_stream.h"
+#include "include/biometric_cipher/common/secure_memory.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace biometric_cipher
+{
+	namespace
+	{
+		const size_t SEGMENT_LENGTH_OFFSET = 1;
+
+		const size_t BASE_NONCE_OFFSET = SEGMENT_LENGTH_OFFSET + 4;
+
+		// Segment indices are 32 bits in the nonce.
+		const uint64_t MAX_SEGMENT_COUNT = uint64_t{ 1 } << 32;
+
+		// Fewer whole segments are sealed on the calling thread: waking helpers costs about as
+		// much as sealing a segment.
+		const size_t MIN_PARALLEL_SEGMENT_COUNT = 4;
+
+		const uint8_t* GetBaseNonce(const AesGcmStream::Header& header)
+		{
+			return header.data() + BASE_NONCE_OFFSET;
+		}
+	}
+
+	uint64_t AesGcmStream::GetEncryptedLength(uint64_t plaintextLength, uint32_t segmentLength)
+	{
+		return HEADER_LENGTH + plaintextLength + (plaintextLength / segmentLength + 1) * AesGcm::TAG_LENGTH;
+	}
+
+	void AesGcmStream::DeriveSegmentNonce(const uint8_t* baseNonce, uint32_t index, bool isLast, uint8_t* nonce)
+	{
+		std::memcpy(nonce, baseNonce, AesGcm::NONCE_LENGTH);
+		nonce[7] ^= static_cast<uint8_t>(index >> 24);
+		nonce[8] ^= static_cast<uint8_t>(index >> 16);
+		nonce[9] ^= static_cast<uint8_t>(index >> 8);
+		nonce[10] ^= static_cast<uint8_t>(index);
+		nonce[11] ^= isLast ? 1 : 0;
+	}
+
+	EncryptStream::EncryptStream(
+		std::shared_ptr<const AesGcmKey> key,
+		const uint8_t* baseNonce,
+		uint32_t segmentLength,
+		std::shared_ptr<const ParallelRunner> runner)
+		: m_Key(std::move(key)),
+		m_SegmentLength(segmentLength),
+		m_Runner(std::move(runner))
+	{
+		if (segmentLength == 0 || segmentLength > AesGcmStream::MAX_SEGMENT_LENGTH) {
+			throw BiometricCipherException(error_invalid_argument, "Invalid stream segment length.");
+		}
+
+		m_Header[0] = AesGcmStream::VERSION;
+		m_Header[SEGMENT_LENGTH_OFFSET] = static_cast<uint8_t>(segmentLength >> 24);
+		m_Header[SEGMENT_LENGTH_OFFSET + 1] = static_cast<uint8_t>(segmentLength >> 16);
+		m_Header[SEGMENT_LENGTH_OFFSET + 2] = static_cast<uint8_t>(segmentLength >> 8);
+		m_Header[SEGMENT_LENGTH_OFFSET + 3] = static_cast<uint8_t>(segmentLength);
+		std::memcpy(m_Header.data() + BASE_NONCE_OFFSET, baseNonce, AesGcm::NONCE_LENGTH);
+
+		// Reserved once, so the held-back plaintext never moves.
+		m_Pending.reserve(segmentLength);
+	}
+
+	void EncryptStream::Update(std::span<const uint8_t> data, std::vector<uint8_t>& output)
+	{
+		ThrowIfFinished();
+
+		// Grown once for all the segments data completes rather than once per segment.
+		auto segmentCount = (m_Pending.size() + data.size()) / m_SegmentLength;
+		output.reserve(output.size() + segmentCount * (m_SegmentLength + AesGcm::TAG_LENGTH));
+
+		if (!m_Pending.empty()) {
+			auto count = std::min(data.size(), m_SegmentLength - m_Pending.size());
+			m_Pending.insert(m_Pending.end(), data.begin(), data.begin() + count);
+			data = data.subspan(count);
+			if (m_Pending.size() < m_SegmentLength) {
+				return;
+			}
+
+			SealSegment(m_Pending.data(), m_Pending.size(), false, output);
+			m_Pending.clear();
+		}
+
+		// Whole segments are sealed straight from the caller's buffer.
+		auto wholeSegmentCount = data.size() / m_SegmentLength;
+		if (m_Runner && wholeSegmentCount >= MIN_PARALLEL_SEGMENT_COUNT) {
+			SealSegments(data.first(wholeSegmentCount * m_SegmentLength), output);
+			data = data.subspan(wholeSegmentCount * m_SegmentLength);
+		}
+
+		while (data.size() >= m_SegmentLength) {
+			SealSegment(data.data(), m_SegmentLength, false, output);
+			data = data.subspan(m_SegmentLength);
+		}
+
+		m_Pending.insert(m_Pending.end(), data.begin(), data.end());
+	}
+
+	void EncryptStream::Finish(std::vector<uint8_t>& output)
+	{
+		ThrowIfFinished();
+
+		SealSegment(m_Pending.data(), m_Pending.size(), true, output);
+		m_IsFinished = true;
+		m_Pending = SecureBuffer();
+	}
+
+	void EncryptStream::SealSegment(const uint8_t* data, size_t length, bool isLast, std::vector<uint8_t>& output)
+	{
+		if (m_SegmentIndex >= MAX_SEGMENT_COUNT) {
+			throw BiometricCipherException(error_encrypt, "The stream is too long.");
+		}
+
+		auto offset = output.size();
+		output.resize(offset + length + AesGcm::TAG_LENGTH);
+		SealSegmentTo(data, length, m_SegmentIndex, isLast, output.data() + offset);
+		++m_SegmentIndex;
+	}
+
+	void EncryptStream::SealSegments(std::span<const uint8_t> data, std::vector<uint8_t>& output)
+	{
+		size_t segmentCount = data.size() / m_SegmentLength;
+		if (m_SegmentIndex + segmentCount > MAX_SEGMENT_COUNT) {
+			throw BiometricCipherException(error_encrypt, "The stream is too long.");
+		}
+
+		// Each segment has a fixed place in the output, so the threads write the ciphertext
+		// where it belongs and nothing is reassembled afterwards.
+		size_t encryptedSegmentLength = m_SegmentLength + AesGcm::TAG_LENGTH;
+		auto offset = output.size();
+		output.resize(offset + segmentCount * encryptedSegmentLength);
+
+		auto firstIndex = m_SegmentIndex;
+		uint8_t* segments = output.data() + offset;
+		m_Runner->Run(segmentCount, [&](size_t i) {
+			SealSegmentTo(data.data() + i * m_SegmentLength, m_SegmentLength, firstIndex + i, false, segments + i * encryptedSegmentLength);
+		});
+		m_SegmentIndex += segmentCount;
+	}
+
+	void EncryptStream::SealSegmentTo(const uint8_t* data, size_t length, uint64_t index, bool isLast, uint8_t* output) const
+	{
+		uint8_t nonce[AesGcm::NONCE_LENGTH];
+		AesGcmStream::DeriveSegmentNonce(GetBaseNonce(m_Header), static_cast<uint32_t>(index), isLast, nonce);
+
+		AesGcm::Encrypt(
+			*m_Key,
+			nonce,
+			m_Header.data(),
+			m_Header.size(),
+			data,
+			length,
+			output,
+			output + length);
+	}
+
+	void EncryptStream::ThrowIfFinished() const
+	{
+		if (m_IsFinished) {
+			throw BiometricCipherException(error_invalid_argument, "The stream is already finished.");
+		}
+	}
+
+	DecryptStream::DecryptStream(
+		std::shared_ptr<const AesGcmKey> key,
+		std::span<const uint8_t> header,
+		std::shared_ptr<const ParallelRunner> runner)
+		: m_Key(std::move(key)),
+		m_Runner(std::move(runner))
+	{
+		if (header.size() != AesGcmStream::HEADER_LENGTH || header[0] != AesGcmStream::VERSION) {
+			throw BiometricCipherException(error_decrypt, "Stream header is invalid or of an unknown version.");
+		}
+
+		std::copy(header.begin(), header.end(), m_Header.begin());
+		m_SegmentLength = (static_cast<uint32_t>(header[SEGMENT_LENGTH_OFFSET]) << 24)
+			| (static_cast<uint32_t>(header[SEGMENT_LENGTH_OFFSET + 1]) << 16)
+			| (static_cast<uint32_t>(header[SEGMENT_LENGTH_OFFSET + 2]) << 8)
+			| static_cast<uint32_t>(header[SEGMENT_LENGTH_OFFSET + 3]);
+		if (m_SegmentLength == 0 || m_SegmentLength > AesGcmStream::MAX_SEGMENT_LENGTH) {
+			throw BiometricCipherException(error_decrypt, "Stream header is invalid or of an unknown version.");
+		}
+
+		m_Pending.reserve(m_SegmentLength + AesGcm::TAG_LENGTH);
+	}
+
+	void DecryptStream::Update(std::span<const uint8_t> data, SecureBuffer& output)
+	{
+		ThrowIfFinished();
+
+		// A full segment is never the last one, so it can be opened as soon as it is complete.
+		size_t encryptedSegmentLength = m_SegmentLength + AesGcm::TAG_LENGTH;
+		auto segmentCount = (m_Pending.size() + data.size()) / encryptedSegmentLength;
+		output.reserve(output.size() + segmentCount * m_SegmentLength);
+
+		if (!m_Pending.empty()) {
+			auto count = std::min(data.size(), encryptedSegmentLength - m_Pending.size());
+			m_Pending.insert(m_Pending.end(), data.begin(), data.begin() + count);
+			data = data.subspan(count);
+			if (m_Pending.size() < encryptedSegmentLength) {
+				return;
+			}
+
+			OpenSegment(m_Pending.data(), m_Pending.size(), false, output);
+			m_Pending.clear();
+		}
+
+		auto wholeSegmentCount = data.size() / encryptedSegmentLength;
+		if (m_Runner && wholeSegmentCount >= MIN_PARALLEL_SEGMENT_COUNT) {
+			OpenSegments(data.first(wholeSegmentCount * encryptedSegmentLength), output);
+			data = data.subspan(wholeSegmentCount * encryptedSegmentLength);
+		}
+
+		while (data.size() >= encryptedSegmentLength) {
+			OpenSegment(data.data(), encryptedSegmentLength, false, output);
+			data = data.subspan(encryptedSegmentLength);
+		}
+
+		m_Pending.insert(m_Pending.end(), data.begin(), data.end());
+	}
+
+	void DecryptStream::Finish(SecureBuffer& output)
+	{
+		ThrowIfFinished();
+
+		if (m_Pending.size() < AesGcm::TAG_LENGTH) {
+			m_IsFinished = true;
+			throw BiometricCipherException(error_decrypt, "Encrypted stream is truncated.");
+		}
+
+		OpenSegment(m_Pending.data(), m_Pending.size(), true, output);
+		m_IsFinished = true;
+	}
+
+	void DecryptStream::OpenSegment(const uint8_t* data, size_t length, bool isLast, SecureBuffer& output)
+	{
+		// Anything after the last possible segment cannot authenticate either.
+		if (m_SegmentIndex >= MAX_SEGMENT_COUNT) {
+			m_IsFinished = true;
+			throw BiometricCipherException(error_decrypt, "Encrypted stream is too long.");
+		}
+
+		auto offset = output.size();
+		output.resize(offset + length - AesGcm::TAG_LENGTH);
+		if (!OpenSegmentTo(data, length, m_SegmentIndex, isLast, output.data() + offset)) {
+			output.resize(offset);
+			m_IsFinished = true;
+			throw BiometricCipherException(error_decrypt, "Encrypted stream could not be authenticated.");
+		}
+		++m_SegmentIndex;
+	}
+
+	void DecryptStream::OpenSegments(std::span<const uint8_t> data, SecureBuffer& output)
+	{
+		size_t encryptedSegmentLength = m_SegmentLength + AesGcm::TAG_LENGTH;
+		size_t segmentCount = data.size() / encryptedSegmentLength;
+		if (m_SegmentIndex + segmentCount > MAX_SEGMENT_COUNT) {
+			m_IsFinished = true;
+			throw BiometricCipherException(error_decrypt, "Encrypted stream is too long.");
+		}
+
+		auto offset = output.size();
+		output.resize(offset + segmentCount * m_SegmentLength);
+
+		auto firstIndex = m_SegmentIndex;
+		uint8_t* plaintext = output.data() + offset;
+		try {
+			m_Runner->Run(segmentCount, [&](size_t i) {
+				if (!OpenSegmentTo(data.data() + i * encryptedSegmentLength, encryptedSegmentLength, firstIndex + i, false, plaintext + i * m_SegmentLength)) {
+					throw BiometricCipherException(error_decrypt, "Encrypted stream could not be authenticated.");
+				}
+			});
+		}
+		catch (...) {
+			// The segments that did authenticate must not be released either.
+			SecureMemory::Zero(plaintext, segmentCount * m_SegmentLength);
+			output.resize(offset);
+			m_IsFinished = true;
+			throw;
+		}
+		m_SegmentIndex += segmentCount;
+	}
+
+	bool DecryptStream::OpenSegmentTo(const uint8_t* data, size_t length, uint64_t index, bool isLast, uint8_t* output) const
+	{
+		uint8_t nonce[AesGcm::NONCE_LENGTH];
+		AesGcmStream::DeriveSegmentNonce(GetBaseNonce(m_Header), static_cast<uint32_t>(index), isLast, nonce);
+
+		auto plaintextLength = length - AesGcm::TAG_LENGTH;
+
+		return AesGcm::Decrypt(
+			*m_Key,
+			nonce,
+			m_Header.data(),
+			m_Header.size(),
+			data,
+			plaintextLength,
+			data + plaintextLength,
+			output);
+	}
+
+	void DecryptStream::ThrowIfFinished() const
+	{
+		if (m_IsFinished) {
+			throw BiometricCipherException(error_invalid_argument, "The stream is already finished.");
+		}
+	}
+}  // namespace biometric_cipher
@@ -0,0 +1,15 @@
+#include "include/biometric_cipher/enums/argument_name.h"
+#include "include/biometric_cipher/enums/method_schema.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+
+namespace biometric_cipher {
+	std::string_view GetArgumentName(ArgumentName argumentName)
+	{
+		auto index = static_cast<size_t>(argumentName);
+		if (index >= ARGUMENT_NAME_COUNT) {
+			throw BiometricCipherException(error_invalid_argument, "Invalid argument name");
+		}
+
+		return ARGUMENT_NAMES[index].second;
+	}
+}
@@ -0,0 +1,415 @@
+#include "include/biometric_cipher/common/base64.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+
+#include <array>
+
+#if defined(BIOMETRIC_CIPHER_X86)
+#include <immintrin.h>
+#endif
+
+namespace biometric_cipher
+{
+	namespace
+	{
+		constexpr char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+		// Any value with one of the two high bits set is invalid.
+		constexpr uint8_t kInvalid = 0xFF;
+
+		constexpr std::array<uint8_t, 256> MakeDecodeTable()
+		{
+			std::array<uint8_t, 256> table{};
+			for (auto& value : table) {
+				value = kInvalid;
+			}
+			for (uint8_t i = 0; i < 64; ++i) {
+				table[static_cast<uint8_t>(kAlphabet[i])] = i;
+			}
+
+			return table;
+		}
+
+		constexpr std::array<uint8_t, 256> kDecodeTable = MakeDecodeTable();
+
+		// Encodes whole 3-byte groups; returns the number of bytes consumed.
+		size_t EncodeScalar(const uint8_t* data, size_t length, char* output)
+		{
+			size_t i = 0;
+			for (; i + 3 <= length; i += 3) {
+				uint32_t group = (static_cast<uint32_t>(data[i]) << 16)
+					| (static_cast<uint32_t>(data[i + 1]) << 8)
+					| data[i + 2];
+				*output++ = kAlphabet[(group >> 18) & 0x3F];
+				*output++ = kAlphabet[(group >> 12) & 0x3F];
+				*output++ = kAlphabet[(group >> 6) & 0x3F];
+				*output++ = kAlphabet[group & 0x3F];
+			}
+
+			return i;
+		}
+
+		void EncodeTail(const uint8_t* data, size_t length, char* output)
+		{
+			if (length == 0) {
+				return;
+			}
+
+			uint32_t group = static_cast<uint32_t>(data[0]) << 16;
+			if (length == 2) {
+				group |= static_cast<uint32_t>(data[1]) << 8;
+			}
+
+			output[0] = kAlphabet[(group >> 18) & 0x3F];
+			output[1] = kAlphabet[(group >> 12) & 0x3F];
+			output[2] = length == 2 ? kAlphabet[(group >> 6) & 0x3F] : '=';
+			output[3] = '=';
+		}
+
+		// Decodes whole unpadded quartets; returns false on an invalid character.
+		bool DecodeScalar(const char* encoded, size_t length, uint8_t* output)
+		{
+			for (size_t i = 0; i < length; i += 4) {
+				uint32_t a = kDecodeTable[static_cast<uint8_t>(encoded[i])];
+				uint32_t b = kDecodeTable[static_cast<uint8_t>(encoded[i + 1])];
+				uint32_t c = kDecodeTable[static_cast<uint8_t>(encoded[i + 2])];
+				uint32_t d = kDecodeTable[static_cast<uint8_t>(encoded[i + 3])];
+				if (((a | b | c | d) & 0xC0) != 0) {
+					return false;
+				}
+
+				uint32_t group = (a << 18) | (b << 12) | (c << 6) | d;
+				*output++ = static_cast<uint8_t>(group >> 16);
+				*output++ = static_cast<uint8_t>(group >> 8);
+				*output++ = static_cast<uint8_t>(group);
+			}
+
+			return true;
+		}
+
+		// The last quartet, which may be padded. Returns false if it is not canonical.
+		bool DecodeLastQuartet(const char* encoded, uint8_t* output)
+		{
+			uint32_t a = kDecodeTable[static_cast<uint8_t>(encoded[0])];
+			uint32_t b = kDecodeTable[static_cast<uint8_t>(encoded[1])];
+			if (((a | b) & 0xC0) != 0) {
+				return false;
+			}
+
+			if (encoded[2] == '=') {
+				if (encoded[3] != '=' || (b & 0x0F) != 0) {
+					return false;
+				}
+
+				output[0] = static_cast<uint8_t>((a << 2) | (b >> 4));
+				return true;
+			}
+
+			uint32_t c = kDecodeTable[static_cast<uint8_t>(encoded[2])];
+			if ((c & 0xC0) != 0) {
+				return false;
+			}
+
+			if (encoded[3] == '=') {
+				if ((c & 0x03) != 0) {
+					return false;
+				}
+
+				output[0] = static_cast<uint8_t>((a << 2) | (b >> 4));
+				output[1] = static_cast<uint8_t>((b << 4) | (c >> 2));
+				return true;
+			}
+
+			return DecodeScalar(encoded, 4, output);
+		}
+
+#if defined(BIOMETRIC_CIPHER_X86)
+		// The vector code follows W. Muła and D. Lemire, "Faster Base64 Encoding and Decoding
+		// Using AVX2 Instructions" (2018).
+
+		// Maps 6-bit indices to alphabet characters by adding a per-range offset.
+		BIOMETRIC_CIPHER_TARGET("ssse3,sse4.1")
+		__m128i LookupSse(__m128i indices)
+		{
+			__m128i reduced = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+			__m128i isUpper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+			reduced = _mm_or_si128(reduced, _mm_and_si128(isUpper, _mm_set1_epi8(13)));
+
+			const __m128i offsets = _mm_setr_epi8(
+				'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+				'0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+			return _mm_add_epi8(_mm_shuffle_epi8(offsets, reduced), indices);
+		}
+
+		// Spreads 3 bytes per 32-bit lane (already shuffled into b a c b order) into four
+		// 6-bit indices.
+		BIOMETRIC_CIPHER_TARGET("ssse3,sse4.1")
+		__m128i SplitSse(__m128i input)
+		{
+			__m128i ac = _mm_mulhi_epu16(_mm_and_si128(input, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+			__m128i bd = _mm_mullo_epi16(_mm_and_si128(input, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+
+			return _mm_or_si128(ac, bd);
+		}
+
+		// 12 bytes per iteration; reads 16, so it stops 4 bytes early.
+		BIOMETRIC_CIPHER_TARGET("ssse3,sse4.1")
+		size_t EncodeSse(const uint8_t* data, size_t length, char* output)
+		{
+			const __m128i shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+
+			size_t i = 0;
+			for (; i + 16 <= length; i += 12) {
+				__m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+				__m128i indices = SplitSse(_mm_shuffle_epi8(input, shuffle));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(output), LookupSse(indices));
+				output += 16;
+			}
+
+			return i;
+		}
+
+		// Returns false if any of the 16 characters is not in the alphabet.
+		BIOMETRIC_CIPHER_TARGET("ssse3,sse4.1")
+		bool DecodeBlockSse(__m128i input, __m128i& decoded)
+		{
+			const __m128i lowNibbleClasses = _mm_setr_epi8(
+				0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+				0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+			const __m128i highNibbleClasses = _mm_setr_epi8(
+				0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+				0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+			const __m128i offsets = _mm_setr_epi8(
+				0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+
+			__m128i highNibbles = _mm_and_si128(_mm_srli_epi32(input, 4), _mm_set1_epi8(0x0F));
+			__m128i lowNibbles = _mm_and_si128(input, _mm_set1_epi8(0x0F));
+			__m128i low = _mm_shuffle_epi8(lowNibbleClasses, lowNibbles);
+			__m128i high = _mm_shuffle_epi8(highNibbleClasses, highNibbles);
+			if (!_mm_testz_si128(low, high)) {
+				return false;
+			}
+
+			__m128i isSlash = _mm_cmpeq_epi8(input, _mm_set1_epi8('/'));
+			__m128i values = _mm_add_epi8(input, _mm_shuffle_epi8(offsets, _mm_add_epi8(isSlash, highNibbles)));
+
+			__m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+			decoded = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+
+			return true;
+		}
+
+		// 12 bytes per iteration, but writes 16: the caller keeps 20 characters in reserve.
+		BIOMETRIC_CIPHER_TARGET("ssse3,sse4.1")
+		size_t DecodeSse(const char* encoded, size_t length, uint8_t* output, bool& isValid)
+		{
+			const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+			size_t i = 0;
+			for (; i + 20 <= length; i += 16) {
+				__m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(encoded + i));
+				__m128i decoded;
+				if (!DecodeBlockSse(input, decoded)) {
+					isValid = false;
+					return i;
+				}
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_shuffle_epi8(decoded, pack));
+				output += 12;
+			}
+
+			return i;
+		}
+
+		BIOMETRIC_CIPHER_TARGET("avx2")
+		__m256i LookupAvx2(__m256i indices)
+		{
+			__m256i reduced = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+			__m256i isUpper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+			reduced = _mm256_or_si256(reduced, _mm256_and_si256(isUpper, _mm256_set1_epi8(13)));
+
+			const __m256i offsets = _mm256_setr_epi8(
+				'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+				'0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+				'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+				'0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+			return _mm256_add_epi8(_mm256_shuffle_epi8(offsets, reduced), indices);
+		}
+
+		// 24 bytes per iteration, 12 per 128-bit lane; reads 28, so it stops 4 bytes early.
+		BIOMETRIC_CIPHER_TARGET("avx2")
+		size_t EncodeAvx2(const uint8_t* data, size_t length, char* output)
+		{
+			const __m256i shuffle = _mm256_set_epi8(
+				10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+				10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+
+			size_t i = 0;
+			for (; i + 28 <= length; i += 24) {
+				__m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+				__m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 12));
+				__m256i input = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+				input = _mm256_shuffle_epi8(input, shuffle);
+
+				__m256i ac = _mm256_mulhi_epu16(
+					_mm256_and_si256(input, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+				__m256i bd = _mm256_mullo_epi16(
+					_mm256_and_si256(input, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(output), LookupAvx2(_mm256_or_si256(ac, bd)));
+				output += 32;
+			}
+
+			return i;
+		}
+
+		// 24 bytes per iteration, but writes 32: the caller keeps 44 characters in reserve.
+		BIOMETRIC_CIPHER_TARGET("avx2")
+		size_t DecodeAvx2(const char* encoded, size_t length, uint8_t* output, bool& isValid)
+		{
+			const __m256i lowNibbleClasses = _mm256_setr_epi8(
+				0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+				0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+				0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+				0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+			const __m256i highNibbleClasses = _mm256_setr_epi8(
+				0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+				0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+				0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+				0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+			const __m256i offsets = _mm256_setr_epi8(
+				0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+				0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+			const __m256i pack = _mm256_setr_epi8(
+				2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+				2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+			const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+
+			size_t i = 0;
+			for (; i + 44 <= length; i += 32) {
+				__m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(encoded + i));
+
+				__m256i highNibbles = _mm256_and_si256(_mm256_srli_epi32(input, 4), _mm256_set1_epi8(0x0F));
+				__m256i lowNibbles = _mm256_and_si256(input, _mm256_set1_epi8(0x0F));
+				__m256i low = _mm256_shuffle_epi8(lowNibbleClasses, lowNibbles);
+				__m256i high = _mm256_shuffle_epi8(highNibbleClasses, highNibbles);
+				if (!_mm256_testz_si256(low, high)) {
+					isValid = false;
+					return i;
+				}
+
+				__m256i isSlash = _mm256_cmpeq_epi8(input, _mm256_set1_epi8('/'));
+				__m256i values = _mm256_add_epi8(
+					input, _mm256_shuffle_epi8(offsets, _mm256_add_epi8(isSlash, highNibbles)));
+
+				__m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+				__m256i decoded = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+				decoded = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(decoded, pack), lanes);
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(output), decoded);
+				output += 24;
+			}
+
+			return i;
+		}
+#endif
+	}
+
+	size_t Base64::GetEncodedLength(size_t length)
+	{
+		return (length + 2) / 3 * 4;
+	}
+
+	std::optional<size_t> Base64::GetDecodedLength(std::string_view encoded)
+	{
+		if (encoded.size() % 4 != 0) {
+			return std::nullopt;
+		}
+		if (encoded.empty()) {
+			return 0;
+		}
+
+		size_t padding = 0;
+		if (encoded[encoded.size() - 1] == '=') {
+			padding = encoded[encoded.size() - 2] == '=' ? 2 : 1;
+		}
+
+		return encoded.size() / 4 * 3 - padding;
+	}
+
+	void Base64::Encode(const uint8_t* data, size_t length, char* output, SimdLevel level)
+	{
+		level = CpuFeatures::Clamp(level);
+
+		size_t consumed = 0;
+#if defined(BIOMETRIC_CIPHER_X86)
+		if (level >= SimdLevel::kAvx2) {
+			consumed += EncodeAvx2(data, length, output);
+		}
+		if (level >= SimdLevel::kSse41) {
+			consumed += EncodeSse(data + consumed, length - consumed, output + consumed / 3 * 4);
+		}
+#endif
+		consumed += EncodeScalar(data + consumed, length - consumed, output + consumed / 3 * 4);
+
+		EncodeTail(data + consumed, length - consumed, output + consumed / 3 * 4);
+	}
+
+	std::string Base64::Encode(const uint8_t* data, size_t length, SimdLevel level)
+	{
+		std::string encoded(GetEncodedLength(length), '\0');
+		Encode(data, length, encoded.data(), level);
+
+		return encoded;
+	}
+
+	bool Base64::Decode(std::string_view encoded, uint8_t* output, SimdLevel level)
+	{
+		if (!GetDecodedLength(encoded)) {
+			return false;
+		}
+		if (encoded.empty()) {
+			return true;
+		}
+
+		level = CpuFeatures::Clamp(level);
+
+		// Everything but the last quartet, which is the only one that may be padded.
+		size_t bodyLength = encoded.size() - 4;
+		size_t consumed = 0;
+		bool isValid = true;
+#if defined(BIOMETRIC_CIPHER_X86)
+		if (level >= SimdLevel::kAvx2) {
+			consumed += DecodeAvx2(encoded.data(), bodyLength, output, isValid);
+		}
+		if (isValid && level >= SimdLevel::kSse41) {
+			consumed += DecodeSse(encoded.data() + consumed, bodyLength - consumed, output + consumed / 4 * 3, isValid);
+		}
+#endif
+		if (!isValid) {
+			return false;
+		}
+
+		if (!DecodeScalar(encoded.data() + consumed, bodyLength - consumed, output + consumed / 4 * 3)) {
+			return false;
+		}
+
+		return DecodeLastQuartet(encoded.data() + bodyLength, output + bodyLength / 4 * 3);
+	}
+
+	std::vector<uint8_t> Base64::Decode(std::string_view encoded, SimdLevel level)
+	{
+		auto decodedLength = GetDecodedLength(encoded);
+		if (!decodedLength) {
+			throw BiometricCipherException(error_invalid_argument, "Data is not valid Base64.");
+		}
+
+		std::vector<uint8_t> decoded(*decodedLength);
+		if (!Decode(encoded, decoded.data(), level)) {
+			throw BiometricCipherException(error_invalid_argument, "Data is not valid Base64.");
+		}
+
+		return decoded;
+	}
+}  // namespace biometric_cipher
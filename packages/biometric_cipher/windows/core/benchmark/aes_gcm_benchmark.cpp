@@ -0,0 +1,130 @@
+#include "benchmark_util.h"
+
+#include "include/biometric_cipher/common/aes_gcm.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+namespace biometric_cipher {
+	namespace benchmarks {
+		namespace {
+			// The second argument is the AesGcm::Implementation; the ones the CPU does not have
+			// are skipped. The portable one is only measured up to 32 KiB.
+			void Implementations(::benchmark::internal::Benchmark* benchmark)
+			{
+				for (auto implementation : {
+					AesGcm::Implementation::kPortable,
+					AesGcm::Implementation::kAesNi,
+					AesGcm::Implementation::kVaes }) {
+					int64_t maxSize = implementation == AesGcm::Implementation::kPortable ? (32 << 10) : (16 << 20);
+					for (int64_t size = 64; size <= maxSize; size *= 8) {
+						benchmark->Args({ size, static_cast<int64_t>(implementation) });
+					}
+				}
+				benchmark->ArgNames({ "size", "implementation" });
+			}
+
+			bool SkipUnsupportedImplementation(::benchmark::State& state, AesGcm::Implementation implementation)
+			{
+				if (AesGcm::Clamp(implementation) != implementation) {
+					state.SkipWithError("Not supported by this CPU");
+					return true;
+				}
+
+				return false;
+			}
+
+			void BM_AesGcm_Encrypt(::benchmark::State& state)
+			{
+				auto implementation = static_cast<AesGcm::Implementation>(state.range(1));
+				if (SkipUnsupportedImplementation(state, implementation)) {
+					return;
+				}
+
+				auto key = MakeBinaryPayload(AesGcm::KEY_LENGTH);
+				auto nonce = MakeBinaryPayload(AesGcm::NONCE_LENGTH);
+				auto payload = MakeBinaryPayload(static_cast<size_t>(state.range(0)));
+				std::vector<uint8_t> ciphertext(payload.size());
+				std::vector<uint8_t> tag(AesGcm::TAG_LENGTH);
+
+				for (auto _ : state) {
+					AesGcm::Encrypt(key.data(), nonce.data(), nullptr, 0,
+						payload.data(), payload.size(), ciphertext.data(), tag.data(), implementation);
+					::benchmark::DoNotOptimize(ciphertext.data());
+					::benchmark::ClobberMemory();
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_AesGcm_Encrypt)->Apply(Implementations);
+
+			// Same as above with the key prepared once, as the repository does.
+			void BM_AesGcm_EncryptPreparedKey(::benchmark::State& state)
+			{
+				auto implementation = static_cast<AesGcm::Implementation>(state.range(1));
+				if (SkipUnsupportedImplementation(state, implementation)) {
+					return;
+				}
+
+				auto key = MakeBinaryPayload(AesGcm::KEY_LENGTH);
+				AesGcmKey preparedKey(key.data(), implementation);
+				auto nonce = MakeBinaryPayload(AesGcm::NONCE_LENGTH);
+				auto payload = MakeBinaryPayload(static_cast<size_t>(state.range(0)));
+				std::vector<uint8_t> ciphertext(payload.size());
+				std::vector<uint8_t> tag(AesGcm::TAG_LENGTH);
+
+				for (auto _ : state) {
+					AesGcm::Encrypt(preparedKey, nonce.data(), nullptr, 0,
+						payload.data(), payload.size(), ciphertext.data(), tag.data());
+					::benchmark::DoNotOptimize(ciphertext.data());
+					::benchmark::ClobberMemory();
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_AesGcm_EncryptPreparedKey)->Apply(Implementations);
+
+			void BM_AesGcm_PrepareKey(::benchmark::State& state)
+			{
+				auto implementation = static_cast<AesGcm::Implementation>(state.range(0));
+				if (SkipUnsupportedImplementation(state, implementation)) {
+					return;
+				}
+
+				auto key = MakeBinaryPayload(AesGcm::KEY_LENGTH);
+				for (auto _ : state) {
+					AesGcmKey preparedKey(key.data(), implementation);
+					::benchmark::DoNotOptimize(&preparedKey.GetSchedule());
+				}
+			}
+			BENCHMARK(BM_AesGcm_PrepareKey)->Arg(0)->Arg(1)->Arg(2)->ArgName("implementation");
+
+			void BM_AesGcm_Decrypt(::benchmark::State& state)
+			{
+				auto implementation = static_cast<AesGcm::Implementation>(state.range(1));
+				if (SkipUnsupportedImplementation(state, implementation)) {
+					return;
+				}
+
+				auto key = MakeBinaryPayload(AesGcm::KEY_LENGTH);
+				auto nonce = MakeBinaryPayload(AesGcm::NONCE_LENGTH);
+				auto payload = MakeBinaryPayload(static_cast<size_t>(state.range(0)));
+				std::vector<uint8_t> ciphertext(payload.size());
+				std::vector<uint8_t> tag(AesGcm::TAG_LENGTH);
+				AesGcm::Encrypt(key.data(), nonce.data(), nullptr, 0,
+					payload.data(), payload.size(), ciphertext.data(), tag.data(), implementation);
+
+				for (auto _ : state) {
+					bool isValid = AesGcm::Decrypt(key.data(), nonce.data(), nullptr, 0,
+						ciphertext.data(), ciphertext.size(), tag.data(), payload.data(), implementation);
+					::benchmark::DoNotOptimize(isValid);
+					::benchmark::ClobberMemory();
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_AesGcm_Decrypt)->Apply(Implementations);
+		}
+	}
+}
@@ -0,0 +1,153 @@
+#include "benchmark_util.h"
+
+#include "include/biometric_cipher/common/aes_gcm_stream.h"
+#include "include/biometric_cipher/common/parallel_runner.h"
+#include "include/biometric_cipher/common/thread_pool_executor.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace biometric_cipher {
+	namespace benchmarks {
+		namespace {
+			// The plaintext is fed in 1 MiB chunks, as a caller streaming a file would, and each
+			// chunk's output is dropped once written, so memory stays at one chunk.
+			const size_t CHUNK_LENGTH = 1 << 20;
+
+			void BM_AesGcmStream_Encrypt(::benchmark::State& state)
+			{
+				auto key = MakeBinaryPayload(AesGcm::KEY_LENGTH);
+				auto preparedKey = std::make_shared<const AesGcmKey>(key.data());
+				auto nonce = MakeBinaryPayload(AesGcm::NONCE_LENGTH);
+				auto chunk = MakeBinaryPayload(CHUNK_LENGTH);
+				auto size = static_cast<size_t>(state.range(0));
+				std::vector<uint8_t> output;
+				output.reserve(CHUNK_LENGTH + CHUNK_LENGTH / AesGcmStream::DEFAULT_SEGMENT_LENGTH * AesGcm::TAG_LENGTH + AesGcm::TAG_LENGTH);
+
+				for (auto _ : state) {
+					EncryptStream stream(preparedKey, nonce.data());
+					for (size_t offset = 0; offset < size; offset += CHUNK_LENGTH) {
+						auto count = std::min(CHUNK_LENGTH, size - offset);
+						output.clear();
+						stream.Update(std::span<const uint8_t>(chunk.data(), count), output);
+						::benchmark::DoNotOptimize(output.data());
+					}
+					output.clear();
+					stream.Finish(output);
+					::benchmark::ClobberMemory();
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_AesGcmStream_Encrypt)->RangeMultiplier(8)->Range(64 << 10, 256 << 20)->Unit(::benchmark::kMillisecond);
+
+			void BM_AesGcmStream_Decrypt(::benchmark::State& state)
+			{
+				auto key = MakeBinaryPayload(AesGcm::KEY_LENGTH);
+				auto preparedKey = std::make_shared<const AesGcmKey>(key.data());
+				auto nonce = MakeBinaryPayload(AesGcm::NONCE_LENGTH);
+				auto payload = MakeBinaryPayload(static_cast<size_t>(state.range(0)));
+
+				EncryptStream encryptStream(preparedKey, nonce.data());
+				auto header = encryptStream.GetHeader();
+				std::vector<uint8_t> encrypted;
+				encryptStream.Update(payload, encrypted);
+				encryptStream.Finish(encrypted);
+
+				SecureBuffer output;
+				for (auto _ : state) {
+					DecryptStream stream(preparedKey, header);
+					for (size_t offset = 0; offset < encrypted.size(); offset += CHUNK_LENGTH) {
+						auto count = std::min(CHUNK_LENGTH, encrypted.size() - offset);
+						output.clear();
+						stream.Update(std::span<const uint8_t>(encrypted.data() + offset, count), output);
+						::benchmark::DoNotOptimize(output.data());
+					}
+					output.clear();
+					stream.Finish(output);
+					::benchmark::ClobberMemory();
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_AesGcmStream_Decrypt)->RangeMultiplier(8)->Range(64 << 10, 16 << 20)->Unit(::benchmark::kMillisecond);
+
+			// 16 MiB fed in one chunk, so that its 256 segments are sealed or opened on the
+			// calling thread and the given number of helpers (0 is the serial path).
+			const size_t PARALLEL_PAYLOAD_LENGTH = 16 << 20;
+
+			void HelperCounts(::benchmark::internal::Benchmark* benchmark)
+			{
+				for (int64_t helperCount : { 0, 1, 3, 7, 15 }) {
+					benchmark->Arg(helperCount);
+				}
+				benchmark->ArgName("helpers")->Unit(::benchmark::kMillisecond)->UseRealTime();
+			}
+
+			std::shared_ptr<const ParallelRunner> MakeRunner(size_t helperCount)
+			{
+				if (helperCount == 0) {
+					return nullptr;
+				}
+
+				return std::make_shared<ParallelRunner>(std::make_shared<ThreadPoolExecutor>(helperCount), helperCount);
+			}
+
+			void BM_AesGcmStream_EncryptParallel(::benchmark::State& state)
+			{
+				auto runner = MakeRunner(static_cast<size_t>(state.range(0)));
+				auto key = MakeBinaryPayload(AesGcm::KEY_LENGTH);
+				auto preparedKey = std::make_shared<const AesGcmKey>(key.data());
+				auto nonce = MakeBinaryPayload(AesGcm::NONCE_LENGTH);
+				auto payload = MakeBinaryPayload(PARALLEL_PAYLOAD_LENGTH);
+				std::vector<uint8_t> output;
+				output.reserve(AesGcmStream::GetEncryptedLength(PARALLEL_PAYLOAD_LENGTH));
+
+				for (auto _ : state) {
+					EncryptStream stream(preparedKey, nonce.data(), AesGcmStream::DEFAULT_SEGMENT_LENGTH, runner);
+					output.clear();
+					stream.Update(payload, output);
+					stream.Finish(output);
+					::benchmark::DoNotOptimize(output.data());
+					::benchmark::ClobberMemory();
+				}
+
+				state.SetBytesProcessed(state.iterations() * PARALLEL_PAYLOAD_LENGTH);
+			}
+			BENCHMARK(BM_AesGcmStream_EncryptParallel)->Apply(HelperCounts);
+
+			void BM_AesGcmStream_DecryptParallel(::benchmark::State& state)
+			{
+				auto runner = MakeRunner(static_cast<size_t>(state.range(0)));
+				auto key = MakeBinaryPayload(AesGcm::KEY_LENGTH);
+				auto preparedKey = std::make_shared<const AesGcmKey>(key.data());
+				auto nonce = MakeBinaryPayload(AesGcm::NONCE_LENGTH);
+				auto payload = MakeBinaryPayload(PARALLEL_PAYLOAD_LENGTH);
+
+				EncryptStream encryptStream(preparedKey, nonce.data());
+				auto header = encryptStream.GetHeader();
+				std::vector<uint8_t> encrypted;
+				encryptStream.Update(payload, encrypted);
+				encryptStream.Finish(encrypted);
+
+				SecureBuffer output;
+				output.reserve(PARALLEL_PAYLOAD_LENGTH);
+				for (auto _ : state) {
+					DecryptStream stream(preparedKey, header, runner);
+					output.clear();
+					stream.Update(encrypted, output);
+					stream.Finish(output);
+					::benchmark::DoNotOptimize(output.data());
+					::benchmark::ClobberMemory();
+				}
+
+				state.SetBytesProcessed(state.iterations() * PARALLEL_PAYLOAD_LENGTH);
+			}
+			BENCHMARK(BM_AesGcmStream_DecryptParallel)->Apply(HelperCounts);
+		}
+	}
+}
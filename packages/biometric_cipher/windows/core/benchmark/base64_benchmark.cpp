@@ -0,0 +1,76 @@
+#include "benchmark_util.h"
+
+#include "include/biometric_cipher/common/base64.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+namespace biometric_cipher {
+	namespace benchmarks {
+		namespace {
+			// The second argument is the SimdLevel; levels the CPU does not have are skipped.
+			void SimdLevels(::benchmark::internal::Benchmark* benchmark)
+			{
+				for (auto level : { SimdLevel::kScalar, SimdLevel::kSse41, SimdLevel::kAvx2 }) {
+					for (int64_t size = 32; size <= (16 << 20); size *= 8) {
+						benchmark->Args({ size, static_cast<int64_t>(level) });
+					}
+				}
+				benchmark->ArgNames({ "size", "level" });
+			}
+
+			bool SkipUnsupportedLevel(::benchmark::State& state, SimdLevel level)
+			{
+				if (CpuFeatures::Clamp(level) != level) {
+					state.SkipWithError("Not supported by this CPU");
+					return true;
+				}
+
+				return false;
+			}
+
+			void BM_Base64_Encode(::benchmark::State& state)
+			{
+				auto level = static_cast<SimdLevel>(state.range(1));
+				if (SkipUnsupportedLevel(state, level)) {
+					return;
+				}
+
+				auto payload = MakeBinaryPayload(static_cast<size_t>(state.range(0)));
+				std::string encoded(Base64::GetEncodedLength(payload.size()), '\0');
+
+				for (auto _ : state) {
+					Base64::Encode(payload.data(), payload.size(), encoded.data(), level);
+					::benchmark::DoNotOptimize(encoded.data());
+					::benchmark::ClobberMemory();
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_Base64_Encode)->Apply(SimdLevels);
+
+			void BM_Base64_Decode(::benchmark::State& state)
+			{
+				auto level = static_cast<SimdLevel>(state.range(1));
+				if (SkipUnsupportedLevel(state, level)) {
+					return;
+				}
+
+				auto payload = MakeBinaryPayload(static_cast<size_t>(state.range(0)));
+				auto encoded = Base64::Encode(payload.data(), payload.size());
+				std::vector<uint8_t> decoded(payload.size());
+
+				for (auto _ : state) {
+					bool isValid = Base64::Decode(encoded, decoded.data(), level);
+					::benchmark::DoNotOptimize(isValid);
+					::benchmark::ClobberMemory();
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_Base64_Decode)->Apply(SimdLevels);
+		}
+	}  // namespace benchmarks
+}  // namespace biometric_cipher
@@ -0,0 +1,49 @@
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+	bool HasFlag(int argc, char** argv, const char* flag)
+	{
+		auto flagLength = std::strlen(flag);
+		for (int i = 1; i < argc; ++i) {
+			if (std::strncmp(argv[i], flag, flagLength) == 0) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
+
+// Same as benchmark_main, except that results are also written as JSON next to the
+// console report unless --benchmark_out is given explicitly, so that every run leaves a
+// file that can be compared between releases, e.g. with tools/compare.py from
+// google/benchmark.
+int main(int argc, char** argv)
+{
+	std::string defaultOut = std::string("--benchmark_out=") + BENCHMARK_DEFAULT_OUT;
+	std::string defaultFormat = "--benchmark_out_format=json";
+
+	std::vector<char*> args(argv, argv + argc);
+	if (!HasFlag(argc, argv, "--benchmark_out=")) {
+		args.push_back(defaultOut.data());
+	}
+	if (!HasFlag(argc, argv, "--benchmark_out_format=")) {
+		args.push_back(defaultFormat.data());
+	}
+
+	int argCount = static_cast<int>(args.size());
+	args.push_back(nullptr);
+	benchmark::Initialize(&argCount, args.data());
+	if (benchmark::ReportUnrecognizedArguments(argCount, args.data())) {
+		return 1;
+	}
+
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+
+	return 0;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "include/biometric_cipher/data/config_data.h"
+#include "include/biometric_cipher/services/biometric_cipher_service.h"
+#include "include/biometric_cipher/storages/config_storage.h"
+
+#include "fakes/fake_windows_hello_repository.h"
+#include "fakes/fake_windows_tpm_repository.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace biometric_cipher {
+	namespace benchmarks {
+		// 32 B, 64 B, 512 B, 4 KiB, 32 KiB, 256 KiB, 2 MiB, 16 MiB.
+		inline void PayloadSizes(::benchmark::internal::Benchmark* benchmark)
+		{
+			benchmark->RangeMultiplier(8)->Range(32, 16 << 20);
+		}
+
+		// Printable ASCII, so the same payload can be used for the string API. Plaintext for
+		// the service and repositories is made as a SecureString.
+		template <typename String = std::string>
+		String MakeTextPayload(size_t size)
+		{
+			String payload(size, '\0');
+			for (size_t i = 0; i < size; ++i) {
+				payload[i] = static_cast<char>('!' + (i * 7) % 94);
+			}
+
+			return payload;
+		}
+
+		template <typename Buffer = std::vector<uint8_t>>
+		Buffer MakeBinaryPayload(size_t size)
+		{
+			Buffer payload(size);
+			for (size_t i = 0; i < size; ++i) {
+				payload[i] = static_cast<uint8_t>(i * 131 + 17);
+			}
+
+			return payload;
+		}
+
+		// A service wired to the in-memory Windows Hello fake, which signs without any UI
+		// or latency, so the numbers only contain the plugin's own work and that of the
+		// given encrypt repository. The key cache is off unless a TTL is given, i.e. every
+		// operation signs and derives a fresh key, as in the default configuration.
+		inline std::unique_ptr<BiometricCipherService> CreateServiceWithFakeSigner(
+			std::shared_ptr<WinrtEncryptRepository> encryptRepository,
+			uint32_t keyCacheTtlSeconds = 0)
+		{
+			auto service = std::make_unique<BiometricCipherService>(
+				std::make_shared<ConfigStorage>(),
+				std::make_shared<test::FakeWindowsHelloRepository>(),
+				std::make_shared<test::FakeWindowsTpmRepository>(),
+				std::move(encryptRepository)
+			);
+			service->Configure(ConfigData("benchmark data to sign", keyCacheTtlSeconds, ConfigData::kDefaultKeyCacheMaxEntries));
+			service->GenerateKeyAsync("benchmark").get();
+
+			return service;
+		}
+	}  // namespace benchmarks
+}  // namespace biometric_cipher
@@ -0,0 +1,135 @@
+#include "benchmark_util.h"
+
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+#include "include/biometric_cipher/repositories/winrt_encrypt_repository.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace biometric_cipher {
+	namespace benchmarks {
+		namespace {
+			// Encrypt repository that only copies the data, so that the service benchmarks
+			// measure the per-operation overhead of the service itself: signature data,
+			// coroutine plumbing, key derivation round trip and payload copies. The cost of
+			// real encryption is measured by the Windows benchmark target.
+			class PassthroughEncryptRepository : public WinrtEncryptRepository {
+			public:
+				std::shared_ptr<SymmetricKey> CreateAESKey(const SecureBuffer&) const override
+				{
+					return std::make_shared<SymmetricKey>();
+				}
+
+				std::shared_ptr<SymmetricKey> DeriveSubkey(const std::shared_ptr<SymmetricKey>& key, std::string_view) const override
+				{
+					return key;
+				}
+
+				std::string Encrypt(const std::shared_ptr<SymmetricKey>&, const SecureString& data) const override
+				{
+					return std::string(data);
+				}
+
+				SecureString Decrypt(const std::shared_ptr<SymmetricKey>&, const std::string& data) const override
+				{
+					return SecureString(data);
+				}
+
+				std::vector<uint8_t> EncryptBinary(const std::shared_ptr<SymmetricKey>&, const SecureBuffer& data) const override
+				{
+					return std::vector<uint8_t>(data.begin(), data.end());
+				}
+
+				SecureBuffer DecryptBinary(const std::shared_ptr<SymmetricKey>&, const std::vector<uint8_t>& data) const override
+				{
+					return SecureBuffer(data.begin(), data.end());
+				}
+
+				// Streams are measured on their own in aes_gcm_stream_benchmark.cpp.
+				std::unique_ptr<EncryptStream> CreateEncryptStream(const std::shared_ptr<SymmetricKey>&) const override
+				{
+					throw BiometricCipherException(error_fail, "Not used by the service benchmarks.");
+				}
+
+				std::unique_ptr<DecryptStream> CreateDecryptStream(const std::shared_ptr<SymmetricKey>&, std::span<const uint8_t>) const override
+				{
+					throw BiometricCipherException(error_fail, "Not used by the service benchmarks.");
+				}
+			};
+
+			void BM_Service_EncryptAsync(::benchmark::State& state)
+			{
+				auto service = CreateServiceWithFakeSigner(std::make_shared<PassthroughEncryptRepository>());
+				auto payload = MakeTextPayload<SecureString>(static_cast<size_t>(state.range(0)));
+
+				for (auto _ : state) {
+					auto encrypted = service->EncryptAsync("benchmark", payload).get();
+					::benchmark::DoNotOptimize(encrypted);
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_Service_EncryptAsync)->Apply(PayloadSizes);
+
+			void BM_Service_DecryptAsync(::benchmark::State& state)
+			{
+				auto service = CreateServiceWithFakeSigner(std::make_shared<PassthroughEncryptRepository>());
+				auto encrypted = service->EncryptAsync("benchmark", MakeTextPayload<SecureString>(static_cast<size_t>(state.range(0)))).get();
+
+				for (auto _ : state) {
+					auto decrypted = service->DecryptAsync("benchmark", encrypted).get();
+					::benchmark::DoNotOptimize(decrypted);
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_Service_DecryptAsync)->Apply(PayloadSizes);
+
+			void BM_Service_EncryptBinaryAsync(::benchmark::State& state)
+			{
+				auto service = CreateServiceWithFakeSigner(std::make_shared<PassthroughEncryptRepository>());
+				auto payload = MakeBinaryPayload<SecureBuffer>(static_cast<size_t>(state.range(0)));
+
+				for (auto _ : state) {
+					auto encrypted = service->EncryptBinaryAsync("benchmark", payload).get();
+					::benchmark::DoNotOptimize(encrypted);
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_Service_EncryptBinaryAsync)->Apply(PayloadSizes);
+
+			void BM_Service_DecryptBinaryAsync(::benchmark::State& state)
+			{
+				auto service = CreateServiceWithFakeSigner(std::make_shared<PassthroughEncryptRepository>());
+				auto encrypted = service->EncryptBinaryAsync("benchmark", MakeBinaryPayload<SecureBuffer>(static_cast<size_t>(state.range(0)))).get();
+
+				for (auto _ : state) {
+					auto decrypted = service->DecryptBinaryAsync("benchmark", encrypted).get();
+					::benchmark::DoNotOptimize(decrypted);
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_Service_DecryptBinaryAsync)->Apply(PayloadSizes);
+
+			// Same as above with the session key cache on: no signature and no key derivation.
+			void BM_Service_EncryptBinaryAsync_CachedKey(::benchmark::State& state)
+			{
+				auto service = CreateServiceWithFakeSigner(std::make_shared<PassthroughEncryptRepository>(), 3600);
+				auto payload = MakeBinaryPayload<SecureBuffer>(static_cast<size_t>(state.range(0)));
+
+				for (auto _ : state) {
+					auto encrypted = service->EncryptBinaryAsync("benchmark", payload).get();
+					::benchmark::DoNotOptimize(encrypted);
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_Service_EncryptBinaryAsync_CachedKey)->Apply(PayloadSizes);
+		}
+	}  // namespace benchmarks
+}  // namespace biometric_cipher
@@ -0,0 +1,75 @@
+#include "benchmark_util.h"
+
+#include "include/biometric_cipher/common/aead_suite_selector.h"
+#include "include/biometric_cipher/common/ciphertext_envelope.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+namespace biometric_cipher {
+	namespace benchmarks {
+		namespace {
+			// The second argument is the AeadSuite. AES-256-GCM runs on the best implementation
+			// the CPU has, as the repository does.
+			void Suites(::benchmark::internal::Benchmark* benchmark)
+			{
+				for (auto suite : { AeadSuite::kAes256Gcm, AeadSuite::kChaCha20Poly1305 }) {
+					for (int64_t size = 64; size <= (1 << 20); size *= 8) {
+						benchmark->Args({ size, static_cast<int64_t>(suite) });
+					}
+				}
+				benchmark->ArgNames({ "size", "suite" });
+			}
+
+			void BM_CiphertextEnvelope_Seal(::benchmark::State& state)
+			{
+				auto suite = static_cast<AeadSuite>(state.range(1));
+				auto keyBytes = MakeBinaryPayload(AeadKey::KEY_LENGTH);
+				AeadKey key(keyBytes.data());
+				auto nonce = MakeBinaryPayload(AeadKey::NONCE_LENGTH);
+				auto payload = MakeBinaryPayload(static_cast<size_t>(state.range(0)));
+				std::vector<uint8_t> envelope(CiphertextEnvelope::GetSealedLength(payload.size()));
+
+				for (auto _ : state) {
+					CiphertextEnvelope::Seal(suite, key, nonce.data(), payload.data(), payload.size(), envelope.data());
+					::benchmark::DoNotOptimize(envelope.data());
+					::benchmark::ClobberMemory();
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_CiphertextEnvelope_Seal)->Apply(Suites);
+
+			void BM_CiphertextEnvelope_Open(::benchmark::State& state)
+			{
+				auto suite = static_cast<AeadSuite>(state.range(1));
+				auto keyBytes = MakeBinaryPayload(AeadKey::KEY_LENGTH);
+				AeadKey key(keyBytes.data());
+				auto nonce = MakeBinaryPayload(AeadKey::NONCE_LENGTH);
+				auto payload = MakeBinaryPayload(static_cast<size_t>(state.range(0)));
+				std::vector<uint8_t> envelope(CiphertextEnvelope::GetSealedLength(payload.size()));
+				CiphertextEnvelope::Seal(suite, key, nonce.data(), payload.data(), payload.size(), envelope.data());
+				std::vector<uint8_t> output(CiphertextEnvelope::GetMaxPlaintextLength(envelope.size()));
+
+				for (auto _ : state) {
+					auto length = CiphertextEnvelope::Open(key, envelope, output.data());
+					::benchmark::DoNotOptimize(length);
+					::benchmark::ClobberMemory();
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_CiphertextEnvelope_Open)->Apply(Suites);
+
+			// What the first encryption in a process pays for picking the suite.
+			void BM_AeadSuiteSelector_MeasureFastestSuite(::benchmark::State& state)
+			{
+				for (auto _ : state) {
+					::benchmark::DoNotOptimize(AeadSuiteSelector::MeasureFastestSuite());
+				}
+			}
+			BENCHMARK(BM_AeadSuiteSelector_MeasureFastestSuite)->Unit(::benchmark::kMicrosecond);
+		}
+	}
+}
@@ -0,0 +1,31 @@
+#include "include/biometric_cipher/enums/method_name.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+namespace biometric_cipher {
+	namespace benchmarks {
+		namespace {
+			void BM_GetMethodName(::benchmark::State& state)
+			{
+				const std::string methodName = "encrypt";
+
+				for (auto _ : state) {
+					::benchmark::DoNotOptimize(GetMethodName(methodName));
+				}
+			}
+			BENCHMARK(BM_GetMethodName);
+
+			void BM_GetMethodName_Unknown(::benchmark::State& state)
+			{
+				const std::string methodName = "encryptWithSomethingElse";
+
+				for (auto _ : state) {
+					::benchmark::DoNotOptimize(GetMethodName(methodName));
+				}
+			}
+			BENCHMARK(BM_GetMethodName_Unknown);
+		}
+	}  // namespace benchmarks
+}  // namespace biometric_cipher
@@ -0,0 +1,39 @@
+#include "include/biometric_cipher/common/metrics_registry.h"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+
+namespace biometric_cipher {
+	namespace benchmarks {
+		namespace {
+			MetricsRegistry g_Metrics;
+
+			// The cost a method call pays for its metrics: a call, three phases and a timer.
+			void BM_MetricsRegistry_RecordCall(::benchmark::State& state)
+			{
+				int64_t latency = 1000 + state.thread_index() * 17;
+
+				for (auto _ : state) {
+					{
+						MetricsRegistry::PhaseTimer timer(&g_Metrics, MetricsPhase::kAesGcm);
+					}
+					g_Metrics.RecordPhase(MetricsPhase::kArgumentParsing, std::chrono::nanoseconds(latency));
+					g_Metrics.RecordPhase(MetricsPhase::kEncodingAndReply, std::chrono::nanoseconds(latency));
+					g_Metrics.RecordCall(MethodName::kEncrypt, std::chrono::nanoseconds(latency));
+					latency = (latency * 7 + 13) % 100000000;
+				}
+			}
+			BENCHMARK(BM_MetricsRegistry_RecordCall)->ThreadRange(1, 8)->UseRealTime();
+
+			void BM_MetricsRegistry_GetSnapshot(::benchmark::State& state)
+			{
+				for (auto _ : state) {
+					auto snapshot = g_Metrics.GetSnapshot();
+					::benchmark::DoNotOptimize(snapshot.methods.data());
+				}
+			}
+			BENCHMARK(BM_MetricsRegistry_GetSnapshot);
+		}
+	}
+}
@@ -0,0 +1,60 @@
+#include "include/biometric_cipher/common/secure_arena.h"
+#include "include/biometric_cipher/common/secure_memory.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <new>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace biometric_cipher {
+	namespace benchmarks {
+		namespace {
+			// A plaintext the size of a typical password entry, from the pre-locked region.
+			void BM_SecureArena_AllocateAndFree(::benchmark::State& state)
+			{
+				auto size = static_cast<size_t>(state.range(0));
+				SecureArena arena;
+
+				for (auto _ : state) {
+					auto* block = arena.Allocate(size);
+					std::memset(block, 0x5A, size);
+					::benchmark::DoNotOptimize(block);
+					arena.Deallocate(block, size);
+				}
+			}
+			BENCHMARK(BM_SecureArena_AllocateAndFree)->Arg(64)->Arg(1024);
+
+			// What locking each buffer on its own would cost: a heap block, a lock and an
+			// unlock per operation.
+			void BM_LockedHeapBlock_AllocateAndFree(::benchmark::State& state)
+			{
+				auto size = static_cast<size_t>(state.range(0));
+
+				for (auto _ : state) {
+					auto* block = ::operator new(size);
+#if defined(_WIN32)
+					VirtualLock(block, size);
+#else
+					mlock(block, size);
+#endif
+					std::memset(block, 0x5A, size);
+					::benchmark::DoNotOptimize(block);
+					SecureMemory::Zero(block, size);
+#if defined(_WIN32)
+					VirtualUnlock(block, size);
+#else
+					munlock(block, size);
+#endif
+					::operator delete(block);
+				}
+			}
+			BENCHMARK(BM_LockedHeapBlock_AllocateAndFree)->Arg(64)->Arg(1024);
+		}
+	}
+}
@@ -0,0 +1,128 @@
+#include "benchmark_util.h"
+
+#include "include/biometric_cipher/common/sha256.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+namespace biometric_cipher {
+	namespace benchmarks {
+		namespace {
+			// The second argument is the Sha256::Implementation; the ones the CPU does not have
+			// are skipped.
+			void Implementations(::benchmark::internal::Benchmark* benchmark)
+			{
+				for (auto implementation : {
+					Sha256::Implementation::kScalar,
+					Sha256::Implementation::kAvx2,
+					Sha256::Implementation::kShaNi }) {
+					for (int64_t size = 64; size <= (16 << 20); size *= 8) {
+						benchmark->Args({ size, static_cast<int64_t>(implementation) });
+					}
+				}
+				benchmark->ArgNames({ "size", "implementation" });
+			}
+
+			bool SkipUnsupportedImplementation(::benchmark::State& state, Sha256::Implementation implementation)
+			{
+				if (Sha256::Clamp(implementation) != implementation) {
+					state.SkipWithError("Not supported by this CPU");
+					return true;
+				}
+
+				return false;
+			}
+
+			void BM_Sha256_Hash(::benchmark::State& state)
+			{
+				auto implementation = static_cast<Sha256::Implementation>(state.range(1));
+				if (SkipUnsupportedImplementation(state, implementation)) {
+					return;
+				}
+
+				auto payload = MakeBinaryPayload(static_cast<size_t>(state.range(0)));
+				std::vector<uint8_t> digest(Sha256::DIGEST_LENGTH);
+
+				for (auto _ : state) {
+					Sha256::Hash(payload.data(), payload.size(), digest.data(), implementation);
+					::benchmark::DoNotOptimize(digest.data());
+					::benchmark::ClobberMemory();
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_Sha256_Hash)->Apply(Implementations);
+
+			// 64 messages of the given size each, e.g. the entries of a vault.
+			void BM_Sha256_HashMany(::benchmark::State& state)
+			{
+				auto implementation = static_cast<Sha256::Implementation>(state.range(1));
+				if (SkipUnsupportedImplementation(state, implementation)) {
+					return;
+				}
+
+				const size_t count = 64;
+				auto size = static_cast<size_t>(state.range(0));
+				auto payload = MakeBinaryPayload(size * count);
+				std::vector<const uint8_t*> data;
+				std::vector<size_t> lengths(count, size);
+				for (size_t i = 0; i < count; ++i) {
+					data.push_back(payload.data() + i * size);
+				}
+				std::vector<uint8_t> digests(count * Sha256::DIGEST_LENGTH);
+
+				for (auto _ : state) {
+					Sha256::HashMany(data.data(), lengths.data(), count, digests.data(), implementation);
+					::benchmark::DoNotOptimize(digests.data());
+					::benchmark::ClobberMemory();
+				}
+
+				state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size * count));
+			}
+			BENCHMARK(BM_Sha256_HashMany)
+				->ArgsProduct({ { 64, 512, 4096 }, { 0, 1, 2 } })
+				->ArgNames({ "size", "implementation" });
+
+			// A vault-sized message with the key prepared once, as a storage MAC would be.
+			void BM_HmacSha256_PreparedKey(::benchmark::State& state)
+			{
+				auto implementation = static_cast<Sha256::Implementation>(state.range(1));
+				if (SkipUnsupportedImplementation(state, implementation)) {
+					return;
+				}
+
+				auto key = MakeBinaryPayload(32);
+				HmacSha256 hmac(key.data(), key.size(), implementation);
+				auto payload = MakeBinaryPayload(static_cast<size_t>(state.range(0)));
+				std::vector<uint8_t> mac(HmacSha256::MAC_LENGTH);
+
+				for (auto _ : state) {
+					hmac.Update(payload.data(), payload.size());
+					hmac.Final(mac.data());
+					::benchmark::DoNotOptimize(mac.data());
+					::benchmark::ClobberMemory();
+				}
+
+				state.SetBytesProcessed(state.iterations() * state.range(0));
+			}
+			BENCHMARK(BM_HmacSha256_PreparedKey)->Apply(Implementations);
+
+			// One subkey from a signed secret, as each context of a tag costs: a 32-byte key
+			// under a short label.
+			void BM_HkdfSha256_DeriveKey(::benchmark::State& state)
+			{
+				auto secret = MakeBinaryPayload(32);
+				auto info = MakeBinaryPayload(static_cast<size_t>(state.range(0)));
+				std::vector<uint8_t> key(32);
+
+				for (auto _ : state) {
+					HkdfSha256::Derive(nullptr, 0, secret.data(), secret.size(), info.data(), info.size(), key.data(), key.size());
+					::benchmark::DoNotOptimize(key.data());
+					::benchmark::ClobberMemory();
+				}
+			}
+			BENCHMARK(BM_HkdfSha256_DeriveKey)->Arg(16)->Arg(256)->ArgName("infoLength");
+		}
+	}
+}
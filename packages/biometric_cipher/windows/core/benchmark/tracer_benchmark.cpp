@@ -0,0 +1,43 @@
+#include "include/biometric_cipher/common/tracer.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+namespace biometric_cipher {
+	namespace benchmarks {
+		namespace {
+			Tracer g_Tracer;
+
+			// What an always-on scope costs the code it wraps.
+			void BM_Tracer_TraceScope(::benchmark::State& state)
+			{
+				for (auto _ : state) {
+					TraceScope scope("Scope", g_Tracer);
+				}
+			}
+			BENCHMARK(BM_Tracer_TraceScope)->ThreadRange(1, 8)->UseRealTime();
+
+			void BM_Tracer_TraceAwait(::benchmark::State& state)
+			{
+				for (auto _ : state) {
+					TraceAwait await("Await", g_Tracer);
+				}
+			}
+			BENCHMARK(BM_Tracer_TraceAwait);
+
+			void BM_Tracer_ExportChromeTrace(::benchmark::State& state)
+			{
+				for (size_t i = 0; i < Tracer::EVENTS_PER_THREAD; ++i) {
+					TraceScope scope("Scope", g_Tracer);
+				}
+
+				for (auto _ : state) {
+					auto trace = g_Tracer.ExportChromeTrace();
+					::benchmark::DoNotOptimize(trace.data());
+				}
+			}
+			BENCHMARK(BM_Tracer_ExportChromeTrace)->Unit(::benchmark::kMillisecond);
+		}
+	}
+}
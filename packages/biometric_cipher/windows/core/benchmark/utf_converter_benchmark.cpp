@@ -0,0 +1,147 @@
+#include "benchmark_util.h"
+
+#include "include/biometric_cipher/common/utf_converter.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+namespace biometric_cipher {
+	namespace benchmarks {
+		namespace {
+			std::string MakeMixedPayload(size_t size)
+			{
+				// ASCII with a two-byte and a three-byte sequence every 16 bytes.
+				static const std::string kChunk = "abcdefghij\xD0\xB4\xE2\x82\xAC!";
+
+				std::string payload;
+				payload.reserve(size + kChunk.size());
+				while (payload.size() < size) {
+					payload += kChunk;
+				}
+				payload.resize(size - size % kChunk.size());
+
+				return payload;
+			}
+
+			void BM_ConvertUtf8ToUtf16_Ascii(::benchmark::State& state)
+			{
+				auto payload = MakeTextPayload(static_cast<size_t>(state.range(0)));
+
+				for (auto _ : state) {
+					auto converted = UtfConverter::ConvertUtf8ToUtf16(payload);
+					::benchmark::DoNotOptimize(converted);
+				}
+
+				state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(payload.size()));
+			}
+			BENCHMARK(BM_ConvertUtf8ToUtf16_Ascii)->Apply(PayloadSizes);
+
+			void BM_ConvertUtf8ToUtf16_Mixed(::benchmark::State& state)
+			{
+				auto payload = MakeMixedPayload(static_cast<size_t>(state.range(0)));
+
+				for (auto _ : state) {
+					auto converted = UtfConverter::ConvertUtf8ToUtf16(payload);
+					::benchmark::DoNotOptimize(converted);
+				}
+
+				state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(payload.size()));
+			}
+			BENCHMARK(BM_ConvertUtf8ToUtf16_Mixed)->Apply(PayloadSizes);
+
+			void BM_ConvertUtf8ToUtf16LE(::benchmark::State& state)
+			{
+				auto payload = MakeMixedPayload(static_cast<size_t>(state.range(0)));
+
+				for (auto _ : state) {
+					auto converted = UtfConverter::ConvertUtf8ToUtf16LE(payload);
+					::benchmark::DoNotOptimize(converted);
+				}
+
+				state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(payload.size()));
+			}
+			BENCHMARK(BM_ConvertUtf8ToUtf16LE)->Apply(PayloadSizes);
+
+			void BM_ConvertUtf16ToUtf8_Ascii(::benchmark::State& state)
+			{
+				auto payload = UtfConverter::ConvertUtf8ToUtf16(MakeTextPayload(static_cast<size_t>(state.range(0))));
+
+				for (auto _ : state) {
+					auto converted = UtfConverter::ConvertUtf16ToUtf8(payload);
+					::benchmark::DoNotOptimize(converted);
+				}
+
+				state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(payload.size()));
+			}
+			BENCHMARK(BM_ConvertUtf16ToUtf8_Ascii)->Apply(PayloadSizes);
+
+			void BM_ConvertUtf16ToUtf8_Mixed(::benchmark::State& state)
+			{
+				auto payload = UtfConverter::ConvertUtf8ToUtf16(MakeMixedPayload(static_cast<size_t>(state.range(0))));
+
+				for (auto _ : state) {
+					auto converted = UtfConverter::ConvertUtf16ToUtf8(payload);
+					::benchmark::DoNotOptimize(converted);
+				}
+
+				state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(payload.size()));
+			}
+			BENCHMARK(BM_ConvertUtf16ToUtf8_Mixed)->Apply(PayloadSizes);
+
+			// The buffer API without allocations, per SimdLevel (second argument); levels the
+			// CPU does not have are skipped.
+			void SimdLevels(::benchmark::internal::Benchmark* benchmark)
+			{
+				for (auto level : { SimdLevel::kScalar, SimdLevel::kSse41, SimdLevel::kAvx2 }) {
+					for (int64_t size = 32; size <= (16 << 20); size *= 8) {
+						benchmark->Args({ size, static_cast<int64_t>(level) });
+					}
+				}
+				benchmark->ArgNames({ "size", "level" });
+			}
+
+			void BM_ConvertUtf8ToUtf16_AsciiInto(::benchmark::State& state)
+			{
+				auto level = static_cast<SimdLevel>(state.range(1));
+				if (CpuFeatures::Clamp(level) != level) {
+					state.SkipWithError("Not supported by this CPU");
+					return;
+				}
+
+				auto payload = MakeTextPayload(static_cast<size_t>(state.range(0)));
+				std::u16string output(UtfConverter::GetMaxUtf16Length(payload.size()), u'\0');
+
+				for (auto _ : state) {
+					auto length = UtfConverter::ConvertUtf8ToUtf16(payload, output.data(), level);
+					::benchmark::DoNotOptimize(length);
+					::benchmark::ClobberMemory();
+				}
+
+				state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(payload.size()));
+			}
+			BENCHMARK(BM_ConvertUtf8ToUtf16_AsciiInto)->Apply(SimdLevels);
+
+			void BM_ConvertUtf16ToUtf8_AsciiInto(::benchmark::State& state)
+			{
+				auto level = static_cast<SimdLevel>(state.range(1));
+				if (CpuFeatures::Clamp(level) != level) {
+					state.SkipWithError("Not supported by this CPU");
+					return;
+				}
+
+				auto payload = UtfConverter::ConvertUtf8ToUtf16(MakeTextPayload(static_cast<size_t>(state.range(0))));
+				std::string output(UtfConverter::GetMaxUtf8Length(payload.size()), '\0');
+
+				for (auto _ : state) {
+					auto length = UtfConverter::ConvertUtf16ToUtf8(payload, output.data(), level);
+					::benchmark::DoNotOptimize(length);
+					::benchmark::ClobberMemory();
+				}
+
+				state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(payload.size()));
+			}
+			BENCHMARK(BM_ConvertUtf16ToUtf8_AsciiInto)->Apply(SimdLevels);
+		}
+	}  // namespace benchmarks
+}  // namespace biometric_cipher
@@ -0,0 +1,399 @@
+#include "include/biometric_cipher/services/biometric_cipher_service.h"
+#include "include/biometric_cipher/common/sha256.h"
+#include "include/biometric_cipher/common/tracer.h"
+#include "include/biometric_cipher/common/utf_converter.h"
+#include "include/biometric_cipher/enums/tpm_status.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+
+namespace biometric_cipher
+{
+	void BiometricCipherService::Configure(const ConfigData& configData) const
+	{
+		// Keys derived under the previous configuration were signed over different data,
+		// so they are dropped even if the new configuration turns out to be invalid.
+		m_SessionKeyCache->Lock();
+
+		m_ConfigStorage->SetConfigData(configData);
+
+		m_SessionKeyCache->Configure(
+			std::chrono::seconds(configData.keyCacheTtlSeconds),
+			configData.keyCacheMaxEntries);
+
+		m_BiometryStatusCache->Configure(std::chrono::seconds(configData.biometryStatusCacheTtlSeconds));
+	}
+
+	Task<int> BiometricCipherService::GetTPMStatusAsync() const
+	{
+		TraceAsyncScope trace("GetTPMStatusAsync");
+
+		{
+			std::lock_guard<std::mutex> lock(m_TpmStatusMutex);
+			if (m_TpmStatus) {
+				co_return *m_TpmStatus;
+			}
+		}
+
+		auto tpmStatus = QueryTPMStatus();
+
+		std::lock_guard<std::mutex> lock(m_TpmStatusMutex);
+		m_TpmStatus = tpmStatus;
+
+		co_return tpmStatus;
+	}
+
+	Task<int> BiometricCipherService::RefreshTPMStatusAsync() const
+	{
+		TraceAsyncScope trace("RefreshTPMStatusAsync");
+
+		{
+			std::lock_guard<std::mutex> lock(m_TpmStatusMutex);
+			m_TpmStatus.reset();
+		}
+
+		m_WindowsTpmRepository->Refresh();
+
+		auto tpmStatus = co_await GetTPMStatusAsync();
+
+		co_return tpmStatus;
+	}
+
+	Task<int> BiometricCipherService::GetBiometryStatusAsync() const
+	{
+		TraceAsyncScope trace("GetBiometryStatusAsync");
+
+		auto biometryStatus = co_await m_WindowsHelloRepository->GetWindowsHelloStatusAsync();
+
+		m_BiometryStatusCache->Put(biometryStatus);
+
+		co_return biometryStatus;
+	}
+
+	Task<int> BiometricCipherService::GetCachedBiometryStatusAsync() const
+	{
+		TraceAsyncScope trace("GetCachedBiometryStatusAsync");
+
+		if (auto cachedStatus = m_BiometryStatusCache->Get()) {
+			co_return *cachedStatus;
+		}
+
+		auto biometryStatus = co_await GetBiometryStatusAsync();
+
+		co_return biometryStatus;
+	}
+
+	Task<> BiometricCipherService::GenerateKeyAsync(const std::string tag) const
+	{
+		TraceAsyncScope trace("GenerateKeyAsync");
+
+		m_SessionKeyCache->Invalidate(tag);
+
+		co_await m_WindowsHelloRepository->CreateCredentialAsync(tag);
+
+		co_return;
+	}
+
+	Task<> BiometricCipherService::DeleteKeyAsync(const std::string tag) const 
+	{
+		TraceAsyncScope trace("DeleteKeyAsync");
+
+		m_SessionKeyCache->Invalidate(tag);
+
+		try {
+			co_await m_WindowsHelloRepository->DeleteCredentialAsync(tag);
+		}
+		catch (const BiometricCipherException& e) {
+			if (e.Code() != error_no_key) {
+				throw;
+			}
+		}
+
+		co_return;
+	}
+
+	Task<std::string> BiometricCipherService::EncryptAsync(const std::string tag, SecureString data, const std::string context) const 
+	{
+		TraceAsyncScope trace("EncryptAsync");
+
+		auto configData = m_ConfigStorage->GetConfig();
+		if (!configData) {
+			throw BiometricCipherException(error_invalid_argument, "Data to sign is empty");
+		}
+
+		auto signature = UtfConverter::ConvertUtf8ToUtf16LE(configData->dataToSign);
+
+		auto aesKey = co_await CreateKeyAsync(tag, context, std::move(signature));
+
+		auto encryptedBase64String = m_WinrtEncryptRepository->Encrypt(aesKey, data);
+
+		co_return encryptedBase64String;
+	}
+
+	Task<SecureString> BiometricCipherService::DecryptAsync(const std::string tag, std::string data, const std::string context) const
+	{
+		TraceAsyncScope trace("DecryptAsync");
+
+		auto configData = m_ConfigStorage->GetConfig();
+		if (!configData) {
+			throw BiometricCipherException(error_decrypt, "Data to sign is empty");
+		}
+
+		auto signature = UtfConverter::ConvertUtf8ToUtf16LE(configData->dataToSign);
+
+		auto aesKey = co_await CreateKeyAsync(tag, context, std::move(signature));
+
+		auto decryptedData = m_WinrtEncryptRepository->Decrypt(aesKey, data);
+
+		co_return decryptedData;
+	}
+
+	Task<std::vector<uint8_t>> BiometricCipherService::EncryptBinaryAsync(const std::string tag, SecureBuffer data, const std::string context) const
+	{
+		TraceAsyncScope trace("EncryptBinaryAsync");
+
+		auto configData = m_ConfigStorage->GetConfig();
+		if (!configData) {
+			throw BiometricCipherException(error_invalid_argument, "Data to sign is empty");
+		}
+
+		auto signature = UtfConverter::ConvertUtf8ToUtf16LE(configData->dataToSign);
+
+		auto aesKey = co_await CreateKeyAsync(tag, context, std::move(signature));
+
+		auto encryptedData = m_WinrtEncryptRepository->EncryptBinary(aesKey, data);
+
+		co_return encryptedData;
+	}
+
+	Task<SecureBuffer> BiometricCipherService::DecryptBinaryAsync(const std::string tag, std::vector<uint8_t> data, const std::string context) const
+	{
+		TraceAsyncScope trace("DecryptBinaryAsync");
+
+		auto configData = m_ConfigStorage->GetConfig();
+		if (!configData) {
+			throw BiometricCipherException(error_decrypt, "Data to sign is empty");
+		}
+
+		auto signature = UtfConverter::ConvertUtf8ToUtf16LE(configData->dataToSign);
+
+		auto aesKey = co_await CreateKeyAsync(tag, context, std::move(signature));
+
+		auto decryptedData = m_WinrtEncryptRepository->DecryptBinary(aesKey, data);
+
+		co_return decryptedData;
+	}
+
+	Task<std::vector<std::string>> BiometricCipherService::EncryptBatchAsync(const std::string tag, std::vector<SecureString> data, const std::string context) const
+	{
+		TraceAsyncScope trace("EncryptBatchAsync");
+
+		auto configData = m_ConfigStorage->GetConfig();
+		if (!configData) {
+			throw BiometricCipherException(error_invalid_argument, "Data to sign is empty");
+		}
+
+		std::vector<std::string> encryptedData;
+		if (data.empty()) {
+			co_return encryptedData;
+		}
+
+		auto signature = UtfConverter::ConvertUtf8ToUtf16LE(configData->dataToSign);
+
+		auto aesKey = co_await CreateKeyAsync(tag, context, std::move(signature));
+
+		encryptedData.reserve(data.size());
+		for (const auto& item : data) {
+			encryptedData.push_back(m_WinrtEncryptRepository->Encrypt(aesKey, item));
+		}
+
+		co_return encryptedData;
+	}
+
+	Task<std::vector<SecureString>> BiometricCipherService::DecryptBatchAsync(const std::string tag, std::vector<std::string> data, const std::string context) const
+	{
+		TraceAsyncScope trace("DecryptBatchAsync");
+
+		auto configData = m_ConfigStorage->GetConfig();
+		if (!configData) {
+			throw BiometricCipherException(error_decrypt, "Data to sign is empty");
+		}
+
+		std::vector<SecureString> decryptedData;
+		if (data.empty()) {
+			co_return decryptedData;
+		}
+
+		auto signature = UtfConverter::ConvertUtf8ToUtf16LE(configData->dataToSign);
+
+		auto aesKey = co_await CreateKeyAsync(tag, context, std::move(signature));
+
+		decryptedData.reserve(data.size());
+		for (const auto& item : data) {
+			decryptedData.push_back(m_WinrtEncryptRepository->Decrypt(aesKey, item));
+		}
+
+		co_return decryptedData;
+	}
+
+	Task<std::unique_ptr<EncryptStream>> BiometricCipherService::BeginEncryptStreamAsync(const std::string tag, const std::string context) const
+	{
+		TraceAsyncScope trace("BeginEncryptStreamAsync");
+
+		auto configData = m_ConfigStorage->GetConfig();
+		if (!configData) {
+			throw BiometricCipherException(error_invalid_argument, "Data to sign is empty");
+		}
+
+		auto signature = UtfConverter::ConvertUtf8ToUtf16LE(configData->dataToSign);
+
+		auto aesKey = co_await CreateKeyAsync(tag, context, std::move(signature));
+
+		co_return m_WinrtEncryptRepository->CreateEncryptStream(aesKey);
+	}
+
+	Task<std::unique_ptr<DecryptStream>> BiometricCipherService::BeginDecryptStreamAsync(
+		const std::string tag,
+		std::vector<uint8_t> header,
+		const std::string context) const
+	{
+		TraceAsyncScope trace("BeginDecryptStreamAsync");
+
+		auto configData = m_ConfigStorage->GetConfig();
+		if (!configData) {
+			throw BiometricCipherException(error_invalid_argument, "Data to sign is empty");
+		}
+
+		auto signature = UtfConverter::ConvertUtf8ToUtf16LE(configData->dataToSign);
+
+		auto aesKey = co_await CreateKeyAsync(tag, context, std::move(signature));
+
+		co_return m_WinrtEncryptRepository->CreateDecryptStream(aesKey, header);
+	}
+
+	Task<std::vector<std::shared_ptr<SymmetricKey>>> BiometricCipherService::DeriveSubkeysAsync(
+		const std::string tag,
+		std::vector<std::string> contexts) const
+	{
+		TraceAsyncScope trace("DeriveSubkeysAsync");
+
+		auto configData = m_ConfigStorage->GetConfig();
+		if (!configData) {
+			throw BiometricCipherException(error_invalid_argument, "Data to sign is empty");
+		}
+
+		std::vector<std::shared_ptr<SymmetricKey>> subkeys;
+		if (contexts.empty()) {
+			co_return subkeys;
+		}
+
+		auto signature = UtfConverter::ConvertUtf8ToUtf16LE(configData->dataToSign);
+
+		auto aesKey = co_await CreateAESKeyAsync(tag, std::move(signature));
+
+		subkeys.reserve(contexts.size());
+		for (const auto& context : contexts) {
+			subkeys.push_back(m_WinrtEncryptRepository->DeriveSubkey(aesKey, context));
+		}
+
+		co_return subkeys;
+	}
+
+	void BiometricCipherService::InvalidateKeyCache(const std::string& tag) const
+	{
+		m_SessionKeyCache->Invalidate(tag);
+	}
+
+	void BiometricCipherService::LockKeyCache() const
+	{
+		m_SessionKeyCache->Lock();
+	}
+
+	int BiometricCipherService::QueryTPMStatus() const
+	{
+		try
+		{
+			auto tpmVersion = m_WindowsTpmRepository->GetWindowsTpmVersion();
+			if (tpmVersion < 2)
+			{
+				return TpmStatusToInteger(TpmStatus::kTPMVersionUnsupported);
+			}
+		}
+		catch (const BiometricCipherException& e)
+		{
+			switch (e.Code())
+			{
+			case error_tpm_unsupported:
+				return TpmStatusToInteger(TpmStatus::kUnsupported);
+
+			case error_tpm_version:
+				return TpmStatusToInteger(TpmStatus::kTPMVersionUnsupported);
+			}
+
+			throw;
+		}
+
+		return TpmStatusToInteger(TpmStatus::kSupported);
+	}
+
+	Task<std::shared_ptr<SymmetricKey>> BiometricCipherService::CreateKeyAsync(
+		const std::string tag,
+		const std::string context,
+		const SecureBuffer signature) const
+	{
+		auto aesKey = co_await CreateAESKeyAsync(tag, std::move(signature));
+		if (context.empty()) {
+			co_return aesKey;
+		}
+
+		co_return m_WinrtEncryptRepository->DeriveSubkey(aesKey, context);
+	}
+
+	Task<std::shared_ptr<SymmetricKey>> BiometricCipherService::CreateAESKeyAsync(
+		const std::string tag,
+		const SecureBuffer signature) const
+	{
+		TraceAsyncScope trace("CreateAESKeyAsync");
+
+		if (auto cachedKey = m_SessionKeyCache->Get(tag)) {
+			co_return cachedKey;
+		}
+
+		// The data to sign is part of the key so that a call made after Configure() never
+		// joins a derivation that is signing the previous data. Only its hash is: the key
+		// lives in an ordinary string. The cache generation below keeps that derivation
+		// from storing its key once it completes.
+		uint8_t signatureHash[Sha256::DIGEST_LENGTH];
+		Sha256::Hash(signature.data(), signature.size(), signatureHash);
+
+		std::string flightKey = tag;
+		flightKey.push_back('\0');
+		flightKey.append(std::begin(signatureHash), std::end(signatureHash));
+
+		// Read before the prompt: a Lock, Invalidate or Configure while it is pending keeps
+		// its key out of the cache.
+		auto cacheGeneration = m_SessionKeyCache->GetGeneration();
+
+		auto derivation = m_KeyDerivations->Run(flightKey, [this, tag, signature, cacheGeneration]() {
+			return DeriveAESKeyAsync(tag, signature, cacheGeneration);
+		});
+
+		co_return co_await derivation;
+	}
+
+	Task<std::shared_ptr<SymmetricKey>> BiometricCipherService::DeriveAESKeyAsync(
+		const std::string tag,
+		const SecureBuffer signature,
+		const uint64_t cacheGeneration) const
+	{
+		SecureBuffer signedData;
+		{
+			TraceAwait trace("SignAsync");
+			signedData = co_await m_WindowsHelloRepository->SignAsync(tag, signature);
+		}
+
+		auto aesKey = m_WinrtEncryptRepository->CreateAESKey(signedData);
+
+		m_SessionKeyCache->Put(tag, aesKey, cacheGeneration);
+
+		co_return aesKey;
+	}
+}
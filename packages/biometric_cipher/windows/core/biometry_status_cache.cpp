@@ -0,0 +1,42 @@
+#include "include/biometric_cipher/storages/biometry_status_cache.h"
+
+namespace biometric_cipher
+{
+	void BiometryStatusCache::Configure(std::chrono::seconds ttl)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		m_Status.reset();
+		m_Ttl = ttl;
+	}
+
+	std::optional<int> BiometryStatusCache::Get() const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		if (!m_Status || m_TimeProvider() >= m_ExpiresAt) {
+			return std::nullopt;
+		}
+
+		return m_Status;
+	}
+
+	void BiometryStatusCache::Put(int status)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		if (m_Ttl.count() <= 0) {
+			return;
+		}
+
+		m_Status = status;
+		m_ExpiresAt = m_TimeProvider() + m_Ttl;
+	}
+
+	void BiometryStatusCache::Invalidate()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		m_Status.reset();
+	}
+}  // namespace biometric_cipher
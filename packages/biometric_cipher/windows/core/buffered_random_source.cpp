@@ -0,0 +1,63 @@
+#include "include/biometric_cipher/common/buffered_random_source.h"
+#include "include/biometric_cipher/common/secure_memory.h"
+
+#include <atomic>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace biometric_cipher
+{
+	namespace
+	{
+		struct ThreadBuffer
+		{
+			uint64_t ownerId = 0;
+			std::vector<uint8_t> bytes;
+			size_t position = 0;
+
+			~ThreadBuffer()
+			{
+				SecureMemory::Zero(bytes.data(), bytes.size());
+			}
+		};
+
+		thread_local ThreadBuffer t_Buffer;
+
+		std::atomic<uint64_t> g_NextSourceId{ 1 };
+	}
+
+	BufferedRandomSource::BufferedRandomSource(EntropyFunction entropy, size_t bufferLength)
+		: m_Entropy(std::move(entropy)),
+		m_BufferLength(bufferLength),
+		m_Id(g_NextSourceId.fetch_add(1, std::memory_order_relaxed))
+	{
+	}
+
+	void BufferedRandomSource::Fill(uint8_t* output, size_t length)
+	{
+		if (length >= m_BufferLength) {
+			m_Entropy(output, length);
+			return;
+		}
+
+		auto& buffer = t_Buffer;
+		if (buffer.ownerId != m_Id) {
+			SecureMemory::Zero(buffer.bytes.data(), buffer.bytes.size());
+			buffer.bytes.assign(m_BufferLength, 0);
+			buffer.position = m_BufferLength;
+			buffer.ownerId = m_Id;
+		}
+
+		if (buffer.bytes.size() - buffer.position < length) {
+			// The few bytes left over are dropped rather than combined with new ones. If the
+			// entropy function throws, the buffer stays empty.
+			buffer.position = buffer.bytes.size();
+			m_Entropy(buffer.bytes.data(), buffer.bytes.size());
+			buffer.position = 0;
+		}
+
+		std::memcpy(output, buffer.bytes.data() + buffer.position, length);
+		buffer.position += length;
+	}
+}  // namespace biometric_cipher
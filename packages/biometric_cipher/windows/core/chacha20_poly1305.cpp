@@ -0,0 +1,302 @@
+#include "include/biometric_cipher/common/chacha20_poly1305.h"
+#include "include/biometric_cipher/common/secure_memory.h"
+
+#include <cstring>
+
+namespace biometric_cipher
+{
+	namespace
+	{
+		constexpr size_t kBlockLength = 64;
+
+		constexpr size_t kPoly1305BlockLength = 16;
+
+		constexpr uint32_t kLimbMask = 0x3FFFFFF;
+
+		uint32_t LoadLittleEndian32(const uint8_t* bytes)
+		{
+			return static_cast<uint32_t>(bytes[0])
+				| (static_cast<uint32_t>(bytes[1]) << 8)
+				| (static_cast<uint32_t>(bytes[2]) << 16)
+				| (static_cast<uint32_t>(bytes[3]) << 24);
+		}
+
+		void StoreLittleEndian32(uint32_t value, uint8_t* bytes)
+		{
+			bytes[0] = static_cast<uint8_t>(value);
+			bytes[1] = static_cast<uint8_t>(value >> 8);
+			bytes[2] = static_cast<uint8_t>(value >> 16);
+			bytes[3] = static_cast<uint8_t>(value >> 24);
+		}
+
+		void StoreLittleEndian64(uint64_t value, uint8_t* bytes)
+		{
+			StoreLittleEndian32(static_cast<uint32_t>(value), bytes);
+			StoreLittleEndian32(static_cast<uint32_t>(value >> 32), bytes + 4);
+		}
+
+		uint32_t RotateLeft(uint32_t value, int count)
+		{
+			return (value << count) | (value >> (32 - count));
+		}
+
+		void QuarterRound(uint32_t* x, int a, int b, int c, int d)
+		{
+			x[a] += x[b]; x[d] = RotateLeft(x[d] ^ x[a], 16);
+			x[c] += x[d]; x[b] = RotateLeft(x[b] ^ x[c], 12);
+			x[a] += x[b]; x[d] = RotateLeft(x[d] ^ x[a], 8);
+			x[c] += x[d]; x[b] = RotateLeft(x[b] ^ x[c], 7);
+		}
+
+		// The cipher state: constants, key, block counter and nonce.
+		class ChaCha20
+		{
+		public:
+			ChaCha20(const uint8_t* key, const uint8_t* nonce, uint32_t counter)
+			{
+				m_State[0] = 0x61707865;
+				m_State[1] = 0x3320646E;
+				m_State[2] = 0x79622D32;
+				m_State[3] = 0x6B206574;
+				for (int i = 0; i < 8; ++i) {
+					m_State[4 + i] = LoadLittleEndian32(key + 4 * i);
+				}
+				m_State[12] = counter;
+				for (int i = 0; i < 3; ++i) {
+					m_State[13 + i] = LoadLittleEndian32(nonce + 4 * i);
+				}
+			}
+
+			~ChaCha20()
+			{
+				SecureMemory::Zero(m_State, sizeof(m_State));
+			}
+
+			// Writes the key stream block for the current counter and advances it.
+			void NextBlock(uint8_t* block)
+			{
+				uint32_t x[16];
+				std::memcpy(x, m_State, sizeof(x));
+				for (int i = 0; i < 10; ++i) {
+					QuarterRound(x, 0, 4, 8, 12);
+					QuarterRound(x, 1, 5, 9, 13);
+					QuarterRound(x, 2, 6, 10, 14);
+					QuarterRound(x, 3, 7, 11, 15);
+					QuarterRound(x, 0, 5, 10, 15);
+					QuarterRound(x, 1, 6, 11, 12);
+					QuarterRound(x, 2, 7, 8, 13);
+					QuarterRound(x, 3, 4, 9, 14);
+				}
+				for (int i = 0; i < 16; ++i) {
+					StoreLittleEndian32(x[i] + m_State[i], block + 4 * i);
+				}
+				SecureMemory::Zero(x, sizeof(x));
+				++m_State[12];
+			}
+
+			// XORs the key stream into input; output may be the same buffer.
+			void Apply(const uint8_t* input, size_t length, uint8_t* output)
+			{
+				uint8_t block[kBlockLength];
+				while (length > 0) {
+					NextBlock(block);
+					size_t count = length < kBlockLength ? length : kBlockLength;
+					for (size_t i = 0; i < count; ++i) {
+						output[i] = input[i] ^ block[i];
+					}
+					input += count;
+					output += count;
+					length -= count;
+				}
+				SecureMemory::Zero(block, sizeof(block));
+			}
+
+		private:
+			uint32_t m_State[16];
+		};
+
+		// Poly1305 with 26-bit limbs, so that every product fits in 64 bits on any compiler.
+		// The AEAD construction pads every part to 16 bytes, so only whole blocks are hashed.
+		class Poly1305
+		{
+		public:
+			explicit Poly1305(const uint8_t* key)
+			{
+				m_R[0] = LoadLittleEndian32(key) & 0x3FFFFFF;
+				m_R[1] = (LoadLittleEndian32(key + 3) >> 2) & 0x3FFFF03;
+				m_R[2] = (LoadLittleEndian32(key + 6) >> 4) & 0x3FFC0FF;
+				m_R[3] = (LoadLittleEndian32(key + 9) >> 6) & 0x3F03FFF;
+				m_R[4] = (LoadLittleEndian32(key + 12) >> 8) & 0x00FFFFF;
+				for (int i = 0; i < 4; ++i) {
+					m_Pad[i] = LoadLittleEndian32(key + 16 + 4 * i);
+				}
+			}
+
+			~Poly1305()
+			{
+				SecureMemory::Zero(m_R, sizeof(m_R));
+				SecureMemory::Zero(m_H, sizeof(m_H));
+				SecureMemory::Zero(m_Pad, sizeof(m_Pad));
+			}
+
+			// Hashes data zero-padded to a multiple of 16 bytes.
+			void UpdatePadded(const uint8_t* data, size_t length)
+			{
+				size_t wholeLength = length - length % kPoly1305BlockLength;
+				Blocks(data, wholeLength);
+				if (wholeLength < length) {
+					uint8_t block[kPoly1305BlockLength] = {};
+					std::memcpy(block, data + wholeLength, length - wholeLength);
+					Blocks(block, kPoly1305BlockLength);
+				}
+			}
+
+			void Finish(uint8_t* tag)
+			{
+				uint32_t h0 = m_H[0], h1 = m_H[1], h2 = m_H[2], h3 = m_H[3], h4 = m_H[4];
+
+				uint32_t c = h1 >> 26; h1 &= kLimbMask;
+				h2 += c; c = h2 >> 26; h2 &= kLimbMask;
+				h3 += c; c = h3 >> 26; h3 &= kLimbMask;
+				h4 += c; c = h4 >> 26; h4 &= kLimbMask;
+				h0 += c * 5; c = h0 >> 26; h0 &= kLimbMask;
+				h1 += c;
+
+				// g = h - p; keep h if that underflows.
+				uint32_t g0 = h0 + 5; c = g0 >> 26; g0 &= kLimbMask;
+				uint32_t g1 = h1 + c; c = g1 >> 26; g1 &= kLimbMask;
+				uint32_t g2 = h2 + c; c = g2 >> 26; g2 &= kLimbMask;
+				uint32_t g3 = h3 + c; c = g3 >> 26; g3 &= kLimbMask;
+				uint32_t g4 = h4 + c - (1u << 26);
+
+				uint32_t keepG = (g4 >> 31) - 1;
+				uint32_t keepH = ~keepG;
+				h0 = (h0 & keepH) | (g0 & keepG);
+				h1 = (h1 & keepH) | (g1 & keepG);
+				h2 = (h2 & keepH) | (g2 & keepG);
+				h3 = (h3 & keepH) | (g3 & keepG);
+				h4 = (h4 & keepH) | (g4 & keepG);
+
+				// h mod 2^128, plus the pad.
+				uint32_t w0 = h0 | (h1 << 26);
+				uint32_t w1 = (h1 >> 6) | (h2 << 20);
+				uint32_t w2 = (h2 >> 12) | (h3 << 14);
+				uint32_t w3 = (h3 >> 18) | (h4 << 8);
+
+				uint64_t f = static_cast<uint64_t>(w0) + m_Pad[0];
+				StoreLittleEndian32(static_cast<uint32_t>(f), tag);
+				f = static_cast<uint64_t>(w1) + m_Pad[1] + (f >> 32);
+				StoreLittleEndian32(static_cast<uint32_t>(f), tag + 4);
+				f = static_cast<uint64_t>(w2) + m_Pad[2] + (f >> 32);
+				StoreLittleEndian32(static_cast<uint32_t>(f), tag + 8);
+				f = static_cast<uint64_t>(w3) + m_Pad[3] + (f >> 32);
+				StoreLittleEndian32(static_cast<uint32_t>(f), tag + 12);
+			}
+
+		private:
+			void Blocks(const uint8_t* data, size_t length)
+			{
+				const uint64_t r0 = m_R[0], r1 = m_R[1], r2 = m_R[2], r3 = m_R[3], r4 = m_R[4];
+				const uint64_t s1 = r1 * 5, s2 = r2 * 5, s3 = r3 * 5, s4 = r4 * 5;
+				uint32_t h0 = m_H[0], h1 = m_H[1], h2 = m_H[2], h3 = m_H[3], h4 = m_H[4];
+
+				for (; length >= kPoly1305BlockLength; data += kPoly1305BlockLength, length -= kPoly1305BlockLength) {
+					h0 += LoadLittleEndian32(data) & kLimbMask;
+					h1 += (LoadLittleEndian32(data + 3) >> 2) & kLimbMask;
+					h2 += (LoadLittleEndian32(data + 6) >> 4) & kLimbMask;
+					h3 += (LoadLittleEndian32(data + 9) >> 6) & kLimbMask;
+					h4 += (LoadLittleEndian32(data + 12) >> 8) | (1u << 24);
+
+					uint64_t d0 = h0 * r0 + h1 * s4 + h2 * s3 + h3 * s2 + h4 * s1;
+					uint64_t d1 = h0 * r1 + h1 * r0 + h2 * s4 + h3 * s3 + h4 * s2;
+					uint64_t d2 = h0 * r2 + h1 * r1 + h2 * r0 + h3 * s4 + h4 * s3;
+					uint64_t d3 = h0 * r3 + h1 * r2 + h2 * r1 + h3 * r0 + h4 * s4;
+					uint64_t d4 = h0 * r4 + h1 * r3 + h2 * r2 + h3 * r1 + h4 * r0;
+
+					uint64_t c = d0 >> 26; h0 = static_cast<uint32_t>(d0) & kLimbMask;
+					d1 += c; c = d1 >> 26; h1 = static_cast<uint32_t>(d1) & kLimbMask;
+					d2 += c; c = d2 >> 26; h2 = static_cast<uint32_t>(d2) & kLimbMask;
+					d3 += c; c = d3 >> 26; h3 = static_cast<uint32_t>(d3) & kLimbMask;
+					d4 += c; c = d4 >> 26; h4 = static_cast<uint32_t>(d4) & kLimbMask;
+					h0 += static_cast<uint32_t>(c) * 5;
+					h1 += h0 >> 26; h0 &= kLimbMask;
+				}
+
+				m_H[0] = h0; m_H[1] = h1; m_H[2] = h2; m_H[3] = h3; m_H[4] = h4;
+			}
+
+			uint32_t m_R[5];
+			uint32_t m_H[5] = {};
+			uint32_t m_Pad[4];
+		};
+
+		// Block 0 of the key stream keys Poly1305; the message is encrypted from block 1.
+		void ComputeTag(
+			const uint8_t* key,
+			const uint8_t* nonce,
+			const uint8_t* aad,
+			size_t aadLength,
+			const uint8_t* ciphertext,
+			size_t length,
+			uint8_t* tag)
+		{
+			uint8_t block[kBlockLength];
+			ChaCha20(key, nonce, 0).NextBlock(block);
+
+			Poly1305 poly1305(block);
+			SecureMemory::Zero(block, sizeof(block));
+
+			if (aadLength > 0) {
+				poly1305.UpdatePadded(aad, aadLength);
+			}
+			poly1305.UpdatePadded(ciphertext, length);
+
+			uint8_t lengths[kPoly1305BlockLength];
+			StoreLittleEndian64(aadLength, lengths);
+			StoreLittleEndian64(length, lengths + 8);
+			poly1305.UpdatePadded(lengths, sizeof(lengths));
+			poly1305.Finish(tag);
+		}
+	}
+
+	void ChaCha20Poly1305::Encrypt(
+		const uint8_t* key,
+		const uint8_t* nonce,
+		const uint8_t* aad,
+		size_t aadLength,
+		const uint8_t* input,
+		size_t length,
+		uint8_t* output,
+		uint8_t* tag)
+	{
+		ChaCha20(key, nonce, 1).Apply(input, length, output);
+		ComputeTag(key, nonce, aad, aadLength, output, length, tag);
+	}
+
+	bool ChaCha20Poly1305::Decrypt(
+		const uint8_t* key,
+		const uint8_t* nonce,
+		const uint8_t* aad,
+		size_t aadLength,
+		const uint8_t* input,
+		size_t length,
+		const uint8_t* tag,
+		uint8_t* output)
+	{
+		uint8_t expectedTag[TAG_LENGTH];
+		ComputeTag(key, nonce, aad, aadLength, input, length, expectedTag);
+
+		uint8_t difference = 0;
+		for (size_t i = 0; i < TAG_LENGTH; ++i) {
+			difference |= expectedTag[i] ^ tag[i];
+		}
+
+		if (difference != 0) {
+			return false;
+		}
+
+		ChaCha20(key, nonce, 1).Apply(input, length, output);
+
+		return true;
+	}
+}  // namespace biometric_cipher
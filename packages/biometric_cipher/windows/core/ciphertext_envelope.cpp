@@ -0,0 +1,73 @@
+#include "include/biometric_cipher/common/ciphertext_envelope.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+
+#include <algorithm>
+
+namespace biometric_cipher
+{
+	void CiphertextEnvelope::Seal(
+		AeadSuite suite,
+		const AeadKey& key,
+		const uint8_t* nonce,
+		const uint8_t* data,
+		size_t length,
+		uint8_t* envelope)
+	{
+		envelope[0] = MAGIC[0];
+		envelope[1] = MAGIC[1];
+		envelope[2] = VERSION;
+		envelope[3] = static_cast<uint8_t>(suite);
+		envelope[4] = 0;
+
+		auto* envelopeNonce = envelope + HEADER_LENGTH;
+		auto* ciphertext = envelopeNonce + AeadKey::NONCE_LENGTH;
+		std::copy(nonce, nonce + AeadKey::NONCE_LENGTH, envelopeNonce);
+		key.Seal(suite, envelopeNonce, envelope, HEADER_LENGTH, data, length, ciphertext, ciphertext + length);
+	}
+
+	size_t CiphertextEnvelope::GetMaxPlaintextLength(size_t envelopeLength)
+	{
+		if (envelopeLength < LEGACY_OVERHEAD) {
+			throw BiometricCipherException(error_decrypt, "Encrypted data is too short or corrupted.");
+		}
+
+		return envelopeLength - LEGACY_OVERHEAD;
+	}
+
+	std::optional<AeadSuite> CiphertextEnvelope::ParseHeader(std::span<const uint8_t> envelope)
+	{
+		if (envelope.size() < OVERHEAD
+			|| envelope[0] != MAGIC[0]
+			|| envelope[1] != MAGIC[1]
+			|| envelope[2] != VERSION
+			|| (envelope[4] & ~KNOWN_FLAGS) != 0) {
+			return std::nullopt;
+		}
+
+		return ByteToAeadSuite(envelope[3]);
+	}
+
+	std::optional<size_t> CiphertextEnvelope::Open(const AeadKey& key, std::span<const uint8_t> envelope, uint8_t* output)
+	{
+		if (auto suite = ParseHeader(envelope)) {
+			auto* nonce = envelope.data() + HEADER_LENGTH;
+			auto length = envelope.size() - OVERHEAD;
+			auto* ciphertext = nonce + AeadKey::NONCE_LENGTH;
+			if (key.Open(*suite, nonce, envelope.data(), HEADER_LENGTH, ciphertext, length, ciphertext + length, output)) {
+				return length;
+			}
+		}
+
+		if (envelope.size() < LEGACY_OVERHEAD) {
+			return std::nullopt;
+		}
+
+		auto length = envelope.size() - LEGACY_OVERHEAD;
+		auto* ciphertext = envelope.data() + AeadKey::NONCE_LENGTH;
+		if (key.Open(AeadSuite::kAes256Gcm, envelope.data(), nullptr, 0, ciphertext, length, ciphertext + length, output)) {
+			return length;
+		}
+
+		return std::nullopt;
+	}
+}  // namespace biometric_cipher
@@ -0,0 +1,34 @@
+#include "include/biometric_cipher/storages/config_storage.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+
+namespace biometric_cipher
+{
+	std::shared_ptr<const ConfigData> ConfigStorage::GetConfig() const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		return m_ConfigData;
+	}
+
+	void ConfigStorage::SetConfigData(const ConfigData& configData)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_ConfigData.reset();
+		}
+
+		if (configData.dataToSign.empty()) {
+			throw BiometricCipherException(error_configure, "Field 'dataToSign' can't be empty");
+		}
+		if (configData.keyCacheTtlSeconds > 0 && configData.keyCacheMaxEntries == 0) {
+			throw BiometricCipherException(error_configure, "Field 'keyCacheMaxEntries' must be positive when the key cache is enabled");
+		}
+
+		// Built outside the lock; the previous configuration is freed by whoever drops the last
+		// reference to it.
+		auto newConfigData = std::make_shared<const ConfigData>(configData);
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_ConfigData = std::move(newConfigData);
+	}
+}
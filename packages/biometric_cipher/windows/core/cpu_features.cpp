@@ -0,0 +1,145 @@
+#include "include/biometric_cipher/common/cpu_features.h"
+
+#include <cstdint>
+
+#if defined(BIOMETRIC_CIPHER_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace biometric_cipher
+{
+	namespace
+	{
+#if defined(BIOMETRIC_CIPHER_X86)
+		struct CpuidRegisters
+		{
+			uint32_t eax = 0;
+			uint32_t ebx = 0;
+			uint32_t ecx = 0;
+			uint32_t edx = 0;
+		};
+
+		uint32_t GetMaxLeaf()
+		{
+#if defined(_MSC_VER)
+			int registers[4] = {};
+			__cpuid(registers, 0);
+
+			return static_cast<uint32_t>(registers[0]);
+#else
+			return __get_cpuid_max(0, nullptr);
+#endif
+		}
+
+		CpuidRegisters Cpuid(uint32_t leaf, uint32_t subleaf)
+		{
+			CpuidRegisters result;
+#if defined(_MSC_VER)
+			int registers[4] = {};
+			__cpuidex(registers, static_cast<int>(leaf), static_cast<int>(subleaf));
+			result.eax = static_cast<uint32_t>(registers[0]);
+			result.ebx = static_cast<uint32_t>(registers[1]);
+			result.ecx = static_cast<uint32_t>(registers[2]);
+			result.edx = static_cast<uint32_t>(registers[3]);
+#else
+			__cpuid_count(leaf, subleaf, result.eax, result.ebx, result.ecx, result.edx);
+#endif
+
+			return result;
+		}
+
+		// Only valid when CPUID reports OSXSAVE.
+		uint64_t GetEnabledXsaveFeatures()
+		{
+#if defined(_MSC_VER)
+			return _xgetbv(0);
+#else
+			uint32_t eax = 0;
+			uint32_t edx = 0;
+			__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+
+			return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+		}
+
+		bool HasBit(uint32_t value, int bit)
+		{
+			return (value & (1u << bit)) != 0;
+		}
+#endif
+
+		CpuFeatures Detect()
+		{
+			CpuFeatures features;
+#if defined(BIOMETRIC_CIPHER_X86)
+			auto maxLeaf = GetMaxLeaf();
+			if (maxLeaf < 1) {
+				return features;
+			}
+
+			auto leaf1 = Cpuid(1, 0);
+			features.ssse3 = HasBit(leaf1.ecx, 9);
+			features.sse41 = HasBit(leaf1.ecx, 19);
+			features.aesni = HasBit(leaf1.ecx, 25);
+			features.pclmulqdq = HasBit(leaf1.ecx, 1);
+
+			// The OS must save the XMM and YMM registers (and for AVX-512 the opmask and ZMM
+			// registers) on context switches.
+			bool osSupportsXsave = HasBit(leaf1.ecx, 27) && HasBit(leaf1.ecx, 28);
+			uint64_t enabledFeatures = osSupportsXsave ? GetEnabledXsaveFeatures() : 0;
+			bool osSavesAvxState = (enabledFeatures & 0x6) == 0x6;
+			bool osSavesAvx512State = osSavesAvxState && (enabledFeatures & 0xE0) == 0xE0;
+			if (maxLeaf < 7) {
+				return features;
+			}
+
+			// The SHA extensions only use XMM registers.
+			auto leaf7 = Cpuid(7, 0);
+			features.sha = HasBit(leaf7.ebx, 29);
+			if (osSavesAvxState) {
+				features.avx2 = HasBit(leaf7.ebx, 5);
+				features.vaes = HasBit(leaf7.ecx, 9);
+				features.vpclmulqdq = HasBit(leaf7.ecx, 10);
+				if (osSavesAvx512State) {
+					features.avx512f = HasBit(leaf7.ebx, 16);
+					features.avx512bw = HasBit(leaf7.ebx, 30);
+				}
+			}
+#endif
+
+			return features;
+		}
+	}
+
+	const CpuFeatures& CpuFeatures::Get()
+	{
+		static const CpuFeatures features = Detect();
+
+		return features;
+	}
+
+	SimdLevel CpuFeatures::GetMaxSimdLevel()
+	{
+		const auto& features = Get();
+		if (features.avx2 && features.sse41 && features.ssse3) {
+			return SimdLevel::kAvx2;
+		}
+		if (features.sse41 && features.ssse3) {
+			return SimdLevel::kSse41;
+		}
+
+		return SimdLevel::kScalar;
+	}
+
+	SimdLevel CpuFeatures::Clamp(SimdLevel requested)
+	{
+		auto maxLevel = GetMaxSimdLevel();
+
+		return requested < maxLevel ? requested : maxLevel;
+	}
+}  // namespace biometric_cipher
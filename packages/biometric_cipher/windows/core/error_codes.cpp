@@ -1,11 +1,10 @@
 #include "include/biometric_cipher/errors/error_codes.h"
 
-using namespace winrt;
-using namespace winrt::impl;
+using namespace biometric_cipher;
 
-const std::string biometric_cipher::GetErrorCodeString(hresult hr)
+const std::string biometric_cipher::GetErrorCodeString(ErrorCode code)
 {
-	switch (hr)
+	switch (code)
 	{
 	case error_tpm_unsupported:
 		return "TPM_UNSUPPORTED";
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "include/biometric_cipher/common/aes_gcm.h"
+#include "include/biometric_cipher/enums/aead_suite.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace biometric_cipher
+{
+	// A 256-bit key usable with every AeadSuite: AES-256-GCM gets its prepared AesGcmKey,
+	// ChaCha20-Poly1305 the raw key, which is wiped when the key is destroyed. Immutable
+	// after construction, so it can be used from several threads.
+	class AeadKey
+	{
+	public:
+		static const size_t KEY_LENGTH = 32;
+
+		static const size_t NONCE_LENGTH = 12;
+
+		static const size_t TAG_LENGTH = 16;
+
+		explicit AeadKey(const uint8_t* key);
+
+		~AeadKey();
+
+		AeadKey(const AeadKey&) = delete;
+		AeadKey& operator=(const AeadKey&) = delete;
+
+		const AesGcmKey& GetAesGcmKey() const
+		{
+			return m_AesGcmKey;
+		}
+
+		// Writes KEY_LENGTH bytes of HKDF-SHA256 over this key, with no salt, under info: a
+		// key independent of this one and of those derived under any other info.
+		void DeriveKey(const uint8_t* info, size_t infoLength, uint8_t* output) const;
+
+		// Same contract as AesGcm::Encrypt, with the given suite.
+		void Seal(
+			AeadSuite suite,
+			const uint8_t* nonce,
+			const uint8_t* aad,
+			size_t aadLength,
+			const uint8_t* input,
+			size_t length,
+			uint8_t* output,
+			uint8_t* tag) const;
+
+		// Same contract as AesGcm::Decrypt, with the given suite.
+		bool Open(
+			AeadSuite suite,
+			const uint8_t* nonce,
+			const uint8_t* aad,
+			size_t aadLength,
+			const uint8_t* input,
+			size_t length,
+			const uint8_t* tag,
+			uint8_t* output) const;
+
+	private:
+		std::array<uint8_t, KEY_LENGTH> m_Key;
+		AesGcmKey m_AesGcmKey;
+	};
+}  // namespace biometric_cipher
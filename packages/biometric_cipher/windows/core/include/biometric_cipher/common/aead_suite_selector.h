@@ -0,0 +1,35 @@
+#pragma once
+
+#include "include/biometric_cipher/enums/aead_suite.h"
+
+#include <chrono>
+#include <cstddef>
+
+namespace biometric_cipher
+{
+	// Picks the suite new envelopes are sealed with on this device by timing both. With
+	// AES-NI, AES-256-GCM wins by a wide margin; without it, the constant-time portable AES
+	// is several times slower than ChaCha20-Poly1305.
+	class AeadSuiteSelector
+	{
+	public:
+		// The payload each suite is timed on: a typical secret is far smaller, but the
+		// per-byte cost has to dominate the setup cost for the comparison to mean anything.
+		static const size_t SAMPLE_LENGTH = 4096;
+
+		// AES-256-GCM is kept unless ChaCha20-Poly1305 is faster by more than this factor:
+		// its envelopes also open on builds that predate the suites, and timer noise must not
+		// flip the choice on CPUs where the two are close.
+		static constexpr double CHACHA_MIN_SPEEDUP = 1.25;
+
+		// Measured once per process, on the first call; thread-safe.
+		static AeadSuite GetPreferredSuite();
+
+		// Times both suites now; takes well under a millisecond with AES-NI and around ten
+		// milliseconds without it.
+		static AeadSuite MeasureFastestSuite();
+
+		// The choice for the best of several timings of each suite.
+		static AeadSuite Choose(std::chrono::nanoseconds aesGcmTime, std::chrono::nanoseconds chaChaTime);
+	};
+}  // namespace biometric_cipher
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace biometric_cipher
+{
+	class AesGcmKey;
+
+	// AES-256-GCM (NIST SP 800-38D) with a 96-bit nonce and a 128-bit tag, implemented
+	// natively so that encryption does not go through WinRT buffers and COM calls.
+	//
+	// Three implementations produce identical output:
+	//  - kPortable: plain C++, constant time (bitsliced S-box, masked GHASH), slow;
+	//  - kAesNi: AES-NI and PCLMULQDQ, eight blocks per iteration;
+	//  - kVaes: VAES and VPCLMULQDQ on AVX-512 CPUs, sixteen blocks per iteration.
+	// The implementation parameters exist for tests and benchmarks; they are lowered to what
+	// the CPU supports.
+	class AesGcm
+	{
+	public:
+		static const size_t KEY_LENGTH = 32;
+
+		static const size_t NONCE_LENGTH = 12;
+
+		static const size_t TAG_LENGTH = 16;
+
+		// Ordered, so that a caller can ask for "at most" a given implementation.
+		enum class Implementation
+		{
+			kPortable,
+			kAesNi,
+			kVaes,
+		};
+
+		// The best implementation supported by the CPU.
+		static Implementation GetBestImplementation();
+
+		// The requested implementation, lowered to what the CPU supports.
+		static Implementation Clamp(Implementation requested);
+
+		// Encrypts length bytes of input into output (which may be the same buffer) and
+		// writes the tag. aad may be null if aadLength is zero.
+		static void Encrypt(
+			const AesGcmKey& key,
+			const uint8_t* nonce,
+			const uint8_t* aad,
+			size_t aadLength,
+			const uint8_t* input,
+			size_t length,
+			uint8_t* output,
+			uint8_t* tag);
+
+		// Verifies the tag and only then decrypts input into output (which may be the same
+		// buffer). Returns false, leaving output untouched, if the tag does not match.
+		static bool Decrypt(
+			const AesGcmKey& key,
+			const uint8_t* nonce,
+			const uint8_t* aad,
+			size_t aadLength,
+			const uint8_t* input,
+			size_t length,
+			const uint8_t* tag,
+			uint8_t* output);
+
+		// One-off variants that prepare the raw 32-byte key for a single message.
+		static void Encrypt(
+			const uint8_t* key,
+			const uint8_t* nonce,
+			const uint8_t* aad,
+			size_t aadLength,
+			const uint8_t* input,
+			size_t length,
+			uint8_t* output,
+			uint8_t* tag,
+			Implementation implementation = Implementation::kVaes);
+
+		static bool Decrypt(
+			const uint8_t* key,
+			const uint8_t* nonce,
+			const uint8_t* aad,
+			size_t aadLength,
+			const uint8_t* input,
+			size_t length,
+			const uint8_t* tag,
+			uint8_t* output,
+			Implementation implementation = Implementation::kVaes);
+	};
+
+	// Defined by the implementation: the AES round keys, H and the powers of H that GHASH
+	// multiplies by.
+	struct AesGcmKeySchedule;
+
+	// An AES-256 key prepared for AesGcm: the round keys are expanded and the GHASH tables
+	// computed once, so messages encrypted with the same key only pay for their own blocks.
+	// The schedule lives in its own cache-line aligned allocation and is wiped when the key
+	// is destroyed. Immutable after construction, so it can be used from several threads.
+	class AesGcmKey
+	{
+	public:
+		explicit AesGcmKey(
+			const uint8_t* key,
+			AesGcm::Implementation implementation = AesGcm::Implementation::kVaes);
+
+		~AesGcmKey();
+
+		AesGcmKey(const AesGcmKey&) = delete;
+		AesGcmKey& operator=(const AesGcmKey&) = delete;
+
+		// The requested implementation, lowered to what the CPU supports.
+		AesGcm::Implementation GetImplementation() const;
+
+		const AesGcmKeySchedule& GetSchedule() const;
+
+	private:
+		AesGcm::Implementation m_Implementation;
+		std::unique_ptr<AesGcmKeySchedule> m_Schedule;
+	};
+}  // namespace biometric_cipher
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "include/biometric_cipher/common/aes_gcm.h"
+#include "include/biometric_cipher/common/parallel_runner.h"
+#include "include/biometric_cipher/common/secure_allocator.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace biometric_cipher
+{
+	// Segmented AES-GCM for payloads too large to hold in memory at once (the STREAM
+	// construction of Hoang, Reyhanitabar, Rogaway and Vizar). The plaintext is cut into
+	// segments of segmentLength bytes, each sealed on its own:
+	//
+	//   header:  version(1) | segmentLength(4, big-endian) | base nonce(12)
+	//   segment: ciphertext | tag(16)
+	//
+	// Segment i is sealed under the base nonce with bytes 7..10 XORed with i (big-endian)
+	// and byte 11 XORed with 1 for the last segment, and with the header as AAD. Every
+	// segment but the last holds exactly segmentLength bytes; the last one holds fewer, and
+	// is empty when the plaintext length is a multiple of segmentLength. Reordered, dropped
+	// or truncated segments and a modified header fail to authenticate.
+	class AesGcmStream
+	{
+	public:
+		static const uint8_t VERSION = 1;
+
+		static const size_t HEADER_LENGTH = 1 + 4 + AesGcm::NONCE_LENGTH;
+
+		static const uint32_t DEFAULT_SEGMENT_LENGTH = 64 * 1024;
+
+		// Bounds what a DecryptStream holds back for a header it was given.
+		static const uint32_t MAX_SEGMENT_LENGTH = 1024 * 1024;
+
+		using Header = std::array<uint8_t, HEADER_LENGTH>;
+
+		// The length of the whole stream, header included.
+		static uint64_t GetEncryptedLength(uint64_t plaintextLength, uint32_t segmentLength = DEFAULT_SEGMENT_LENGTH);
+
+		static void DeriveSegmentNonce(const uint8_t* baseNonce, uint32_t index, bool isLast, uint8_t* nonce);
+	};
+
+	// Encrypts a stream whose length is not known up front while holding back at most one
+	// segment of plaintext: every segment is written out as soon as it is complete. Not
+	// thread-safe, but given a runner it seals the whole segments of a large Update() on
+	// several threads; the output is the same either way.
+	class EncryptStream
+	{
+	public:
+		// baseNonce points to AesGcm::NONCE_LENGTH random bytes. The key is kept alive until
+		// the stream is destroyed. runner may be null.
+		EncryptStream(
+			std::shared_ptr<const AesGcmKey> key,
+			const uint8_t* baseNonce,
+			uint32_t segmentLength = AesGcmStream::DEFAULT_SEGMENT_LENGTH,
+			std::shared_ptr<const ParallelRunner> runner = nullptr);
+
+		EncryptStream(const EncryptStream&) = delete;
+		EncryptStream& operator=(const EncryptStream&) = delete;
+
+		// Written before the first segment.
+		const AesGcmStream::Header& GetHeader() const
+		{
+			return m_Header;
+		}
+
+		// Appends the segments that data completes to output.
+		void Update(std::span<const uint8_t> data, std::vector<uint8_t>& output);
+
+		// Seals what is held back as the last segment and appends it to output. The stream
+		// cannot be used afterwards.
+		void Finish(std::vector<uint8_t>& output);
+
+	private:
+		void SealSegment(const uint8_t* data, size_t length, bool isLast, std::vector<uint8_t>& output);
+
+		// Seals data, a whole number of segments, on the runner.
+		void SealSegments(std::span<const uint8_t> data, std::vector<uint8_t>& output);
+
+		// Writes the ciphertext and tag of segment index to output.
+		void SealSegmentTo(const uint8_t* data, size_t length, uint64_t index, bool isLast, uint8_t* output) const;
+
+		void ThrowIfFinished() const;
+
+		std::shared_ptr<const AesGcmKey> m_Key;
+		AesGcmStream::Header m_Header{};
+		uint32_t m_SegmentLength;
+		std::shared_ptr<const ParallelRunner> m_Runner;
+		SecureBuffer m_Pending;
+		uint64_t m_SegmentIndex = 0;
+		bool m_IsFinished = false;
+	};
+
+	// Decrypts what an EncryptStream wrote, one segment at a time. The plaintext of each
+	// segment is released as soon as that segment authenticates, but the stream as a whole
+	// is only known to be complete once Finish() returns. Not thread-safe; like EncryptStream
+	// it can open the whole segments of a large Update() on a runner.
+	class DecryptStream
+	{
+	public:
+		// Throws error_decrypt if header is not a stream header of this version. runner may be
+		// null.
+		DecryptStream(
+			std::shared_ptr<const AesGcmKey> key,
+			std::span<const uint8_t> header,
+			std::shared_ptr<const ParallelRunner> runner = nullptr);
+
+		DecryptStream(const DecryptStream&) = delete;
+		DecryptStream& operator=(const DecryptStream&) = delete;
+
+		// Appends the plaintext of the segments that data completes to output. Throws
+		// error_decrypt if a segment does not authenticate; the stream cannot be used
+		// afterwards.
+		void Update(std::span<const uint8_t> data, SecureBuffer& output);
+
+		// Opens what is held back as the last segment and appends its plaintext to output.
+		// Throws error_decrypt if the stream was cut short. The stream cannot be used
+		// afterwards.
+		void Finish(SecureBuffer& output);
+
+	private:
+		void OpenSegment(const uint8_t* data, size_t length, bool isLast, SecureBuffer& output);
+
+		// Opens data, a whole number of full segments, on the runner. Nothing is appended to
+		// output unless every one of them authenticates.
+		void OpenSegments(std::span<const uint8_t> data, SecureBuffer& output);
+
+		// Returns false, leaving output untouched, if the segment does not authenticate.
+		bool OpenSegmentTo(const uint8_t* data, size_t length, uint64_t index, bool isLast, uint8_t* output) const;
+
+		void ThrowIfFinished() const;
+
+		std::shared_ptr<const AesGcmKey> m_Key;
+		std::shared_ptr<const ParallelRunner> m_Runner;
+		AesGcmStream::Header m_Header{};
+		uint32_t m_SegmentLength = 0;
+		std::vector<uint8_t> m_Pending;
+		uint64_t m_SegmentIndex = 0;
+		bool m_IsFinished = false;
+	};
+}  // namespace biometric_cipher
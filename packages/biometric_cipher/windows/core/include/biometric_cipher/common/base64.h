@@ -0,0 +1,56 @@
+#pragma once
+
+#include "include/biometric_cipher/common/cpu_features.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace biometric_cipher
+{
+	// Standard Base64 (RFC 4648, "+/" alphabet, '=' padding, no line breaks), which is what
+	// CryptographicBuffer::EncodeToBase64String produces. Works on UTF-8 (i.e. ASCII) bytes
+	// and uses SSE4.1 or AVX2 when the CPU has them.
+	//
+	// Decoding is strict: the length must be a multiple of 4, only the last one or two
+	// characters may be '=', and the unused bits of the last character must be zero, so
+	// every byte sequence has exactly one accepted encoding.
+	//
+	// The level parameters exist for tests and benchmarks; they are lowered to what the CPU
+	// supports.
+	class Base64
+	{
+	public:
+		static size_t GetEncodedLength(size_t length);
+
+		// Returns std::nullopt if the length or the padding cannot be valid.
+		static std::optional<size_t> GetDecodedLength(std::string_view encoded);
+
+		// Writes exactly GetEncodedLength(length) characters.
+		static void Encode(
+			const uint8_t* data,
+			size_t length,
+			char* output,
+			SimdLevel level = SimdLevel::kAvx2);
+
+		static std::string Encode(
+			const uint8_t* data,
+			size_t length,
+			SimdLevel level = SimdLevel::kAvx2);
+
+		// Writes exactly *GetDecodedLength(encoded) bytes. Returns false if the input is not
+		// valid Base64; the output is then unspecified.
+		static bool Decode(
+			std::string_view encoded,
+			uint8_t* output,
+			SimdLevel level = SimdLevel::kAvx2);
+
+		// Throws BiometricCipherException(error_invalid_argument) if the input is not valid.
+		static std::vector<uint8_t> Decode(
+			std::string_view encoded,
+			SimdLevel level = SimdLevel::kAvx2);
+	};
+}  // namespace biometric_cipher
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "include/biometric_cipher/common/random_source.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace biometric_cipher
+{
+	// Amortizes the cost of the system RNG over many small requests: every thread keeps its
+	// own buffer, refilled from the entropy function a whole buffer at a time, and serves
+	// requests from it without locking. Requests of at least a buffer's length go to the
+	// entropy function directly.
+	//
+	// A thread keeps one buffer, for the source it used last; switching to another source
+	// discards the rest of it.
+	class BufferedRandomSource : public RandomSource
+	{
+	public:
+		// Fills the buffer with cryptographically secure random bytes; throws on failure.
+		using EntropyFunction = std::function<void(uint8_t* output, size_t length)>;
+
+		// 341 AES-GCM nonces per call to the entropy function.
+		static constexpr size_t DEFAULT_BUFFER_LENGTH = 4096;
+
+		explicit BufferedRandomSource(EntropyFunction entropy, size_t bufferLength = DEFAULT_BUFFER_LENGTH);
+
+		void Fill(uint8_t* output, size_t length) override;
+
+	private:
+		EntropyFunction m_Entropy;
+		size_t m_BufferLength;
+		// Tells the per-thread buffers of different sources apart; never reused.
+		uint64_t m_Id;
+	};
+}  // namespace biometric_cipher
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace biometric_cipher
+{
+	// ChaCha20-Poly1305 (RFC 8439) with a 96-bit nonce and a 128-bit tag. Plain C++ and
+	// constant time: on CPUs without AES-NI it is several times faster than the portable
+	// AES-GCM, whose S-box has to be bitsliced to stay constant time.
+	//
+	// The 32-bit block counter limits a message to 256 GiB, far beyond any payload here.
+	class ChaCha20Poly1305
+	{
+	public:
+		static const size_t KEY_LENGTH = 32;
+
+		static const size_t NONCE_LENGTH = 12;
+
+		static const size_t TAG_LENGTH = 16;
+
+		// Encrypts length bytes of input into output (which may be the same buffer) and
+		// writes the tag. aad may be null if aadLength is zero.
+		static void Encrypt(
+			const uint8_t* key,
+			const uint8_t* nonce,
+			const uint8_t* aad,
+			size_t aadLength,
+			const uint8_t* input,
+			size_t length,
+			uint8_t* output,
+			uint8_t* tag);
+
+		// Verifies the tag and only then decrypts input into output (which may be the same
+		// buffer). Returns false, leaving output untouched, if the tag does not match.
+		static bool Decrypt(
+			const uint8_t* key,
+			const uint8_t* nonce,
+			const uint8_t* aad,
+			size_t aadLength,
+			const uint8_t* input,
+			size_t length,
+			const uint8_t* tag,
+			uint8_t* output);
+	};
+}  // namespace biometric_cipher
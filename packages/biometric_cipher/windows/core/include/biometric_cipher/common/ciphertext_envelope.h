@@ -0,0 +1,64 @@
+#pragma once
+
+#include "include/biometric_cipher/common/aead_key.h"
+#include "include/biometric_cipher/enums/aead_suite.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace biometric_cipher
+{
+	// The format of everything Encrypt, EncryptBinary and EncryptBatch return:
+	//
+	//   magic (2) | version (1) | suite (1) | flags (1) | nonce (12) | ciphertext | tag (16)
+	//
+	// The five header bytes are the AAD, so a changed suite or flag fails authentication
+	// instead of selecting another decoder. Envelopes written before the header existed are
+	// nonce (12) | ciphertext | tag (16) under AES-256-GCM with no AAD, and still open.
+	class CiphertextEnvelope
+	{
+	public:
+		static constexpr uint8_t MAGIC[2] = { 0xBC, 0xE1 };
+
+		static constexpr uint8_t VERSION = 1;
+
+		// No flags are defined yet; a reader rejects any it does not know.
+		static constexpr uint8_t KNOWN_FLAGS = 0;
+
+		static constexpr size_t HEADER_LENGTH = 5;
+
+		static constexpr size_t OVERHEAD = HEADER_LENGTH + AeadKey::NONCE_LENGTH + AeadKey::TAG_LENGTH;
+
+		static constexpr size_t LEGACY_OVERHEAD = AeadKey::NONCE_LENGTH + AeadKey::TAG_LENGTH;
+
+		static size_t GetSealedLength(size_t plaintextLength)
+		{
+			return OVERHEAD + plaintextLength;
+		}
+
+		// Writes GetSealedLength(length) bytes to envelope.
+		static void Seal(
+			AeadSuite suite,
+			const AeadKey& key,
+			const uint8_t* nonce,
+			const uint8_t* data,
+			size_t length,
+			uint8_t* envelope);
+
+		// An upper bound of the plaintext length, for sizing the output of Open. Throws
+		// error_decrypt if the envelope is too short to be either format.
+		static size_t GetMaxPlaintextLength(size_t envelopeLength);
+
+		// The suite of a versioned envelope; nullopt for anything else, including a legacy
+		// envelope (whose nonce is random and can only look like a header by chance).
+		static std::optional<AeadSuite> ParseHeader(std::span<const uint8_t> envelope);
+
+		// Writes the plaintext to output, which must have room for GetMaxPlaintextLength
+		// bytes, and returns its length; nullopt if authentication fails. A blob that parses
+		// as a header but does not authenticate is retried as a legacy envelope, so a legacy
+		// nonce that happens to start with the magic does not make it unreadable.
+		static std::optional<size_t> Open(const AeadKey& key, std::span<const uint8_t> envelope, uint8_t* output);
+	};
+}  // namespace biometric_cipher
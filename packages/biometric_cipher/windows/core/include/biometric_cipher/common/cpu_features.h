@@ -0,0 +1,49 @@
+#pragma once
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define BIOMETRIC_CIPHER_X86 1
+#endif
+
+// Lets a single function use an instruction set extension that the rest of the library is
+// not compiled for; it must only be called after checking CpuFeatures. MSVC needs no flag.
+#if defined(BIOMETRIC_CIPHER_X86) && (defined(__GNUC__) || defined(__clang__))
+#define BIOMETRIC_CIPHER_TARGET(extensions) __attribute__((target(extensions)))
+#else
+#define BIOMETRIC_CIPHER_TARGET(extensions)
+#endif
+
+namespace biometric_cipher
+{
+	// Widest vector instruction set that a codec may use. Ordered, so that a caller can
+	// ask for "at most" a given level.
+	enum class SimdLevel
+	{
+		kScalar,
+		kSse41,
+		kAvx2,
+	};
+
+	// Instruction set extensions of the CPU the process runs on, detected once.
+	struct CpuFeatures
+	{
+		bool ssse3 = false;
+		bool sse41 = false;
+		bool avx2 = false;
+		bool aesni = false;
+		bool pclmulqdq = false;
+		bool sha = false;
+		// AVX-512 foundation and byte/word instructions, with the OS saving the ZMM state.
+		bool avx512f = false;
+		bool avx512bw = false;
+		bool vaes = false;
+		bool vpclmulqdq = false;
+
+		static const CpuFeatures& Get();
+
+		// The best level supported by the CPU (and the OS, which must save the AVX state).
+		static SimdLevel GetMaxSimdLevel();
+
+		// The requested level, lowered to what the CPU supports.
+		static SimdLevel Clamp(SimdLevel requested);
+	};
+}  // namespace biometric_cipher
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <coroutine>
+#include <functional>
+
+namespace biometric_cipher
+{
+	// Somewhere to run work: a pool of worker threads, the Flutter platform thread, etc.
+	class Executor
+	{
+	public:
+		using Work = std::function<void()>;
+
+		virtual ~Executor() = default;
+
+		// Queues the work and returns immediately. The work must not throw.
+		virtual void Post(Work work) = 0;
+	};
+
+	// co_await ResumeOn(executor) suspends the calling coroutine and resumes it from the
+	// executor, e.g. to move CPU-bound work off the platform thread and to get back there
+	// before replying to Dart.
+	inline auto ResumeOn(Executor& executor)
+	{
+		struct Awaiter
+		{
+			Executor* executor;
+
+			bool await_ready() const noexcept
+			{
+				return false;
+			}
+
+			void await_suspend(std::coroutine_handle<> continuation) const
+			{
+				executor->Post([continuation] { continuation.resume(); });
+			}
+
+			void await_resume() const noexcept {}
+		};
+
+		return Awaiter{ &executor };
+	}
+}  // namespace biometric_cipher
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace biometric_cipher
+{
+	struct LatencyHistogramSnapshot
+	{
+		uint64_t count = 0;
+		std::chrono::nanoseconds total{ 0 };
+		std::chrono::nanoseconds max{ 0 };
+		std::chrono::nanoseconds p50{ 0 };
+		std::chrono::nanoseconds p90{ 0 };
+		std::chrono::nanoseconds p99{ 0 };
+	};
+
+	// A log-linear (HDR-style) histogram of durations: values below SUB_BUCKET_COUNT ns have a
+	// bucket each, and every power of two above is split into SUB_BUCKET_COUNT buckets, so a
+	// percentile is reported at most 1/8 above the value recorded. Record() is lock-free and
+	// may be called from any thread; a snapshot taken while others record is approximate.
+	class LatencyHistogram
+	{
+	public:
+		static constexpr size_t SUB_BUCKET_BITS = 3;
+
+		static constexpr size_t SUB_BUCKET_COUNT = size_t{ 1 } << SUB_BUCKET_BITS;
+
+		// Values of 2^(MAX_EXPONENT + 1) ns (about 37 minutes) and more share the last bucket.
+		static constexpr size_t MAX_EXPONENT = 40;
+
+		static constexpr size_t BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKET_COUNT;
+
+		void Record(std::chrono::nanoseconds duration);
+
+		LatencyHistogramSnapshot GetSnapshot() const;
+
+		static size_t GetBucketIndex(uint64_t nanoseconds);
+
+		// The largest value that falls into the bucket.
+		static uint64_t GetBucketUpperBound(size_t index);
+
+	private:
+		std::array<std::atomic<uint64_t>, BUCKET_COUNT> m_Buckets{};
+		std::atomic<uint64_t> m_TotalNanoseconds{ 0 };
+		std::atomic<uint64_t> m_MaxNanoseconds{ 0 };
+	};
+}
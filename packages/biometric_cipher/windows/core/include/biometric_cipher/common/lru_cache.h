@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace biometric_cipher
+{
+	// Thread-safe map bounded to a fixed number of entries; adding an entry to a full cache
+	// evicts the least recently used one. A capacity of zero disables the cache.
+	template <typename Key, typename Value>
+	class LruCache
+	{
+	public:
+		explicit LruCache(size_t capacity)
+			: m_Capacity(capacity) {}
+
+		std::optional<Value> Get(const Key& key)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			auto it = m_Index.find(key);
+			if (it == m_Index.end()) {
+				return std::nullopt;
+			}
+
+			m_Entries.splice(m_Entries.begin(), m_Entries, it->second);
+
+			return it->second->second;
+		}
+
+		void Put(const Key& key, Value value)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			if (m_Capacity == 0) {
+				return;
+			}
+
+			auto it = m_Index.find(key);
+			if (it != m_Index.end()) {
+				it->second->second = std::move(value);
+				m_Entries.splice(m_Entries.begin(), m_Entries, it->second);
+
+				return;
+			}
+
+			if (m_Entries.size() >= m_Capacity) {
+				m_Index.erase(m_Entries.back().first);
+				m_Entries.pop_back();
+			}
+
+			m_Entries.emplace_front(key, std::move(value));
+			m_Index.emplace(key, m_Entries.begin());
+		}
+
+		void Erase(const Key& key)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			auto it = m_Index.find(key);
+			if (it == m_Index.end()) {
+				return;
+			}
+
+			m_Entries.erase(it->second);
+			m_Index.erase(it);
+		}
+
+		void Clear()
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			m_Index.clear();
+			m_Entries.clear();
+		}
+
+		size_t Size() const
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			return m_Entries.size();
+		}
+
+	private:
+		using EntryList = std::list<std::pair<Key, Value>>;
+
+		const size_t m_Capacity;
+
+		mutable std::mutex m_Mutex;
+		// Most recently used first.
+		EntryList m_Entries;
+		std::unordered_map<Key, typename EntryList::iterator> m_Index;
+	};
+}  // namespace biometric_cipher
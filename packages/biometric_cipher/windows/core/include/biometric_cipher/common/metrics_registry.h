@@ -0,0 +1,104 @@
+#pragma once
+
+#include "include/biometric_cipher/common/latency_histogram.h"
+#include "include/biometric_cipher/enums/method_name.h"
+#include "include/biometric_cipher/enums/method_schema.h"
+#include "include/biometric_cipher/enums/metrics_phase.h"
+#include "include/biometric_cipher/errors/error_codes.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace biometric_cipher
+{
+	struct MethodMetricsSnapshot
+	{
+		MethodName method = MethodName::kNotImplemented;
+		uint64_t calls = 0;
+		uint64_t errors = 0;
+		LatencyHistogramSnapshot latency;
+	};
+
+	struct MetricsSnapshot
+	{
+		// Only the methods that have been called, in MethodName order.
+		std::vector<MethodMetricsSnapshot> methods;
+		// By the code Dart receives (GetErrorCodeString); only codes that occurred.
+		std::vector<std::pair<std::string, uint64_t>> errors;
+		// Indexed by MetricsPhase.
+		std::array<LatencyHistogramSnapshot, METRICS_PHASE_COUNT> phases;
+	};
+
+	// Counters and latency histograms of the plugin's method calls since it was loaded.
+	// Every Record* is lock-free, so it can be called from the platform thread, the worker
+	// pool and WinRT completion threads without them waiting on each other.
+	//
+	// A call adds one sample to each phase it goes through; a batch adds one AES-GCM (and
+	// encoding) sample per item.
+	class MetricsRegistry
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		// Records the time from its construction to its destruction as a phase. Does
+		// nothing if the registry is null, so components built without one need no checks.
+		class PhaseTimer
+		{
+		public:
+			PhaseTimer(MetricsRegistry* metrics, MetricsPhase phase)
+				: m_Metrics(metrics),
+				m_Phase(phase),
+				m_Start(metrics ? Clock::now() : Clock::time_point{}) {}
+
+			~PhaseTimer()
+			{
+				if (m_Metrics) {
+					m_Metrics->RecordPhase(m_Phase, Clock::now() - m_Start);
+				}
+			}
+
+			PhaseTimer(const PhaseTimer&) = delete;
+			PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+		private:
+			MetricsRegistry* m_Metrics;
+			MetricsPhase m_Phase;
+			Clock::time_point m_Start;
+		};
+
+		// A finished call, successful or not, and how long it took from the method call to
+		// the reply.
+		void RecordCall(MethodName method, std::chrono::nanoseconds latency);
+
+		void RecordError(MethodName method, ErrorCode code);
+
+		void RecordPhase(MetricsPhase phase, std::chrono::nanoseconds duration);
+
+		MetricsSnapshot GetSnapshot() const;
+
+	private:
+		struct MethodMetrics
+		{
+			std::atomic<uint64_t> calls{ 0 };
+			std::atomic<uint64_t> errors{ 0 };
+			LatencyHistogram latency;
+		};
+
+		// One slot per code in error_codes.h and a last one for any other code.
+		static constexpr size_t ERROR_SLOT_COUNT = 18;
+
+		static size_t GetErrorSlot(ErrorCode code);
+
+		MethodMetrics& GetMethodMetrics(MethodName method);
+
+		// The last slot is kNotImplemented.
+		std::array<MethodMetrics, METHOD_COUNT + 1> m_Methods;
+		std::array<std::atomic<uint64_t>, ERROR_SLOT_COUNT> m_Errors{};
+		std::array<LatencyHistogram, METRICS_PHASE_COUNT> m_Phases;
+	};
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "include/biometric_cipher/common/executor.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace biometric_cipher
+{
+	// Runs the items of an index range on several threads: the calling thread and up to
+	// helperCount helpers posted to the executor. Every thread claims the next unclaimed index
+	// from a shared counter, so a thread that is descheduled or slow holds up only the item it
+	// is on, never a fixed share of the range.
+	//
+	// Run() does not wait for helpers that have not started by the time the range is done:
+	// those find nothing left and return at once. So Run() can be called from a thread of the
+	// same executor without deadlocking, even when every other thread of it is busy.
+	class ParallelRunner
+	{
+	public:
+		using Item = std::function<void(size_t index)>;
+
+		// The executor must outlive the helpers posted to it.
+		ParallelRunner(std::shared_ptr<Executor> executor, size_t helperCount);
+
+		ParallelRunner(const ParallelRunner&) = delete;
+		ParallelRunner& operator=(const ParallelRunner&) = delete;
+
+		// Calls item(i) for every i in [0, count) and returns once all of them have returned.
+		// If an item throws, the items not yet claimed are skipped and the first exception is
+		// rethrown.
+		void Run(size_t count, const Item& item) const;
+
+		size_t GetHelperCount() const
+		{
+			return m_HelperCount;
+		}
+
+		// One helper per hardware thread besides the caller's.
+		static size_t GetDefaultHelperCount();
+
+	private:
+		struct Job;
+
+		static void RunItems(Job& job);
+
+		std::shared_ptr<Executor> m_Executor;
+		size_t m_HelperCount;
+	};
+}  // namespace biometric_cipher
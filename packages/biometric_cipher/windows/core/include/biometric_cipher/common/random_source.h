@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace biometric_cipher
+{
+	// Where the repositories get their random bytes (AES-GCM nonces) from. Implementations
+	// must be cryptographically secure and safe to call from several threads at once.
+	struct RandomSource
+	{
+		virtual ~RandomSource() = default;
+
+		virtual void Fill(uint8_t* output, size_t length) = 0;
+	};
+}  // namespace biometric_cipher
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "include/biometric_cipher/common/secure_arena.h"
+#include "include/biometric_cipher/common/secure_memory.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace biometric_cipher
+{
+	// Allocates from SecureArena::Get(). A container using it keeps its contents in locked
+	// memory and zeroes every buffer it lets go of, including the ones it outgrows.
+	template <typename T>
+	class SecureAllocator
+	{
+	public:
+		using value_type = T;
+
+		SecureAllocator() noexcept = default;
+
+		template <typename U>
+		SecureAllocator(const SecureAllocator<U>&) noexcept {}
+
+		T* allocate(size_t count)
+		{
+			return static_cast<T*>(SecureArena::Get().Allocate(count * sizeof(T)));
+		}
+
+		void deallocate(T* data, size_t count) noexcept
+		{
+			SecureArena::Get().Deallocate(data, count * sizeof(T));
+		}
+
+		template <typename U>
+		bool operator==(const SecureAllocator<U>&) const noexcept
+		{
+			return true;
+		}
+	};
+
+	// Key material, signatures and binary plaintext.
+	using SecureBuffer = std::vector<uint8_t, SecureAllocator<uint8_t>>;
+
+	// Text plaintext. Short strings are kept inside the object rather than in the arena, so
+	// the destructor zeroes the characters wherever they are. A short string that later grows
+	// leaves its old characters inside the object: build these at their final length.
+	class SecureString : public std::basic_string<char, std::char_traits<char>, SecureAllocator<char>>
+	{
+	public:
+		using Base = std::basic_string<char, std::char_traits<char>, SecureAllocator<char>>;
+
+		using Base::Base;
+		using Base::operator=;
+
+		SecureString() = default;
+
+		SecureString(const SecureString&) = default;
+
+		SecureString(SecureString&&) noexcept = default;
+
+		SecureString& operator=(const SecureString&) = default;
+
+		SecureString& operator=(SecureString&&) noexcept = default;
+
+		~SecureString()
+		{
+			SecureMemory::Zero(data(), capacity());
+		}
+
+		friend bool operator==(const SecureString& left, std::string_view right) noexcept
+		{
+			return std::string_view(left) == right;
+		}
+	};
+}
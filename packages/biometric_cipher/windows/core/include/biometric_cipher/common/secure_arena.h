@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace biometric_cipher
+{
+	// Memory for key material and plaintext. The arena maps one region when it is created and
+	// locks it into RAM (mlock/VirtualLock), so that secrets are never written to the page
+	// file and the lock and the page faults are paid once rather than per operation.
+	//
+	// Blocks come in power-of-two size classes from MIN_BLOCK_SIZE to MAX_BLOCK_SIZE and are
+	// zeroed when they are freed. Larger requests, and requests made once the region is used
+	// up, are served from the heap: those blocks are still zeroed, but not locked.
+	class SecureArena
+	{
+	public:
+		static constexpr size_t MIN_BLOCK_SIZE = 32;
+		static constexpr size_t MAX_BLOCK_SIZE = 4096;
+		static constexpr size_t SIZE_CLASS_COUNT = 8;
+		static constexpr size_t DEFAULT_REGION_SIZE = 64 * 1024;
+
+		struct Stats
+		{
+			size_t regionSize = 0;
+			// False if the system refused to lock the region (e.g. RLIMIT_MEMLOCK); the
+			// arena still works and still zeroes, but the pages may be swapped out.
+			bool isLocked = false;
+			// Bytes handed out from the region, rounded up to the size classes.
+			size_t bytesInUse = 0;
+			size_t heapAllocations = 0;
+		};
+
+		explicit SecureArena(size_t regionSize = DEFAULT_REGION_SIZE);
+
+		~SecureArena();
+
+		SecureArena(const SecureArena&) = delete;
+		SecureArena& operator=(const SecureArena&) = delete;
+
+		// The arena SecureBuffer and SecureString allocate from.
+		static SecureArena& Get();
+
+		// Never returns null; throws std::bad_alloc like operator new.
+		void* Allocate(size_t size);
+
+		// size must be the size the block was allocated with.
+		void Deallocate(void* block, size_t size) noexcept;
+
+		Stats GetStats() const;
+
+		// The size class a request is rounded up to; sizes above MAX_BLOCK_SIZE are returned
+		// as they are.
+		static size_t GetBlockSize(size_t size);
+
+	private:
+		// Freed blocks are chained through their first bytes.
+		struct FreeBlock
+		{
+			FreeBlock* next;
+		};
+
+		static size_t GetSizeClass(size_t blockSize);
+
+		bool IsInRegion(const void* block) const;
+
+		uint8_t* m_Region = nullptr;
+		size_t m_RegionSize = 0;
+		bool m_IsLocked = false;
+
+		mutable std::mutex m_Mutex;
+		// Blocks below this offset have been carved out of the region.
+		size_t m_RegionUsed = 0;
+		std::array<FreeBlock*, SIZE_CLASS_COUNT> m_FreeLists = {};
+		size_t m_BytesInUse = 0;
+		size_t m_HeapAllocations = 0;
+	};
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+
+namespace biometric_cipher
+{
+	class SecureMemory
+	{
+	public:
+		// Overwrites memory that held key material or plaintext with zeros. Unlike memset,
+		// the stores are not removed by the optimizer when the memory is about to be freed.
+		static void Zero(void* data, size_t length);
+	};
+}  // namespace biometric_cipher
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace biometric_cipher
+{
+	// SHA-256 (FIPS 180-4), implemented natively so that hashing does not open a CNG
+	// algorithm provider on every call.
+	//
+	// Three implementations produce identical output:
+	//  - kScalar: plain C++;
+	//  - kAvx2: eight independent messages per iteration, one per 32-bit lane. Only
+	//    HashMany benefits; the blocks of a single message depend on each other, so it is
+	//    hashed with the scalar code;
+	//  - kShaNi: the SHA extensions (SHA256RNDS2, SHA256MSG1/2).
+	// The implementation parameters exist for tests and benchmarks; they are lowered to what
+	// the CPU supports.
+	class Sha256
+	{
+	public:
+		static const size_t DIGEST_LENGTH = 32;
+
+		static const size_t BLOCK_LENGTH = 64;
+
+		// Ordered, so that a caller can ask for "at most" a given implementation.
+		enum class Implementation
+		{
+			kScalar,
+			kAvx2,
+			kShaNi,
+		};
+
+		// The best implementation supported by the CPU.
+		static Implementation GetBestImplementation();
+
+		// The requested implementation, lowered to what the CPU supports.
+		static Implementation Clamp(Implementation requested);
+
+		static void Hash(
+			const uint8_t* data,
+			size_t length,
+			uint8_t* digest,
+			Implementation implementation = Implementation::kShaNi);
+
+		// Hashes count independent messages; digests receives count * DIGEST_LENGTH bytes.
+		// data may only be null for messages of zero length.
+		static void HashMany(
+			const uint8_t* const* data,
+			const size_t* lengths,
+			size_t count,
+			uint8_t* digests,
+			Implementation implementation = Implementation::kShaNi);
+
+		explicit Sha256(Implementation implementation = Implementation::kShaNi);
+
+		~Sha256();
+
+		Sha256(const Sha256&) = default;
+		Sha256& operator=(const Sha256&) = default;
+
+		void Update(const uint8_t* data, size_t length);
+
+		// Writes the digest and starts a new message.
+		void Final(uint8_t* digest);
+
+		// The requested implementation, lowered to what the CPU supports.
+		Implementation GetImplementation() const;
+
+	private:
+		void Reset();
+
+		Implementation m_Implementation;
+		uint32_t m_State[8];
+		uint8_t m_Buffer[BLOCK_LENGTH];
+		size_t m_BufferLength = 0;
+		uint64_t m_MessageLength = 0;
+	};
+
+	// HMAC-SHA256 (RFC 2104). The key is hashed into the inner and outer states once, so a
+	// prepared instance only pays for the message when it authenticates several of them.
+	class HmacSha256
+	{
+	public:
+		static const size_t MAC_LENGTH = Sha256::DIGEST_LENGTH;
+
+		static void Compute(
+			const uint8_t* key,
+			size_t keyLength,
+			const uint8_t* data,
+			size_t length,
+			uint8_t* mac,
+			Sha256::Implementation implementation = Sha256::Implementation::kShaNi);
+
+		// Compares in constant time.
+		static bool Verify(
+			const uint8_t* key,
+			size_t keyLength,
+			const uint8_t* data,
+			size_t length,
+			const uint8_t* expectedMac,
+			Sha256::Implementation implementation = Sha256::Implementation::kShaNi);
+
+		// key may be null if keyLength is zero.
+		HmacSha256(
+			const uint8_t* key,
+			size_t keyLength,
+			Sha256::Implementation implementation = Sha256::Implementation::kShaNi);
+
+		void Update(const uint8_t* data, size_t length);
+
+		// Writes the MAC and starts a new message with the same key.
+		void Final(uint8_t* mac);
+
+	private:
+		Sha256 m_InnerStart;
+		Sha256 m_OuterStart;
+		Sha256 m_Inner;
+	};
+
+	// HKDF-SHA256 (RFC 5869): expands one secret into any number of independent keys, each
+	// bound to its info.
+	class HkdfSha256
+	{
+	public:
+		static const size_t PRK_LENGTH = Sha256::DIGEST_LENGTH;
+
+		static const size_t MAX_OUTPUT_LENGTH = 255 * Sha256::DIGEST_LENGTH;
+
+		// salt may be null if saltLength is zero, which RFC 5869 treats as PRK_LENGTH zeros.
+		static void Extract(
+			const uint8_t* salt,
+			size_t saltLength,
+			const uint8_t* secret,
+			size_t secretLength,
+			uint8_t* prk);
+
+		// info may be null if infoLength is zero. Throws error_invalid_argument if length is
+		// larger than MAX_OUTPUT_LENGTH.
+		static void Expand(
+			const uint8_t* prk,
+			const uint8_t* info,
+			size_t infoLength,
+			uint8_t* output,
+			size_t length);
+
+		// Extract followed by Expand; the PRK is wiped.
+		static void Derive(
+			const uint8_t* salt,
+			size_t saltLength,
+			const uint8_t* secret,
+			size_t secretLength,
+			const uint8_t* info,
+			size_t infoLength,
+			uint8_t* output,
+			size_t length);
+	};
+}  // namespace biometric_cipher
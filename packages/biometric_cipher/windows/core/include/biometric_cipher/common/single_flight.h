@@ -0,0 +1,166 @@
+#pragma once
+
+#include "include/biometric_cipher/common/task.h"
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace biometric_cipher
+{
+	// Coalesces concurrent asynchronous calls with the same key: the first caller starts the
+	// operation, callers arriving while it is still running wait for it and get a copy of
+	// the same result (or the same exception). Once the operation completes the key is
+	// forgotten, so the next call starts a new operation.
+	template <typename T>
+	class SingleFlight
+	{
+	public:
+		using Operation = std::function<Task<T>()>;
+
+		Task<T> Run(const std::string key, Operation operation)
+		{
+			std::shared_ptr<Flight> flight;
+			bool isLeader = false;
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				auto it = m_Flights.find(key);
+				if (it != m_Flights.end()) {
+					flight = it->second;
+				}
+				else {
+					flight = std::make_shared<Flight>();
+					m_Flights.emplace(key, flight);
+					isLeader = true;
+				}
+			}
+
+			if (isLeader) {
+				try {
+					auto task = operation();
+					flight->SetValue(co_await task);
+				}
+				catch (...) {
+					flight->SetException(std::current_exception());
+				}
+
+				{
+					std::lock_guard<std::mutex> lock(m_Mutex);
+					m_Flights.erase(key);
+				}
+
+				flight->Complete();
+			}
+
+			// Awaitables are kept in named variables throughout: GCC 12 may destroy
+			// non-trivial temporaries in a co_await operand twice.
+			FlightAwaiter awaiter{ flight };
+			auto result = co_await awaiter;
+
+			co_return result;
+		}
+
+		size_t GetInFlightCount() const
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			return m_Flights.size();
+		}
+
+	private:
+		class Flight
+		{
+		public:
+			void SetValue(T value)
+			{
+				m_Value.emplace(std::move(value));
+			}
+
+			void SetException(std::exception_ptr exception)
+			{
+				m_Exception = std::move(exception);
+			}
+
+			void Complete()
+			{
+				std::vector<std::coroutine_handle<>> waiters;
+				{
+					std::lock_guard<std::mutex> lock(m_Mutex);
+					m_IsCompleted = true;
+					waiters.swap(m_Waiters);
+				}
+
+				for (auto waiter : waiters) {
+					waiter.resume();
+				}
+			}
+
+			bool IsCompleted() const
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+
+				return m_IsCompleted;
+			}
+
+			// Returns false if the flight has already completed and the caller must not suspend.
+			bool TryAddWaiter(std::coroutine_handle<> waiter)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				if (m_IsCompleted) {
+					return false;
+				}
+
+				m_Waiters.push_back(waiter);
+
+				return true;
+			}
+
+			// Every caller gets its own copy; the result stays valid for the other waiters.
+			T GetResult() const
+			{
+				if (m_Exception) {
+					std::rethrow_exception(m_Exception);
+				}
+
+				return *m_Value;
+			}
+
+		private:
+			mutable std::mutex m_Mutex;
+			bool m_IsCompleted = false;
+			std::vector<std::coroutine_handle<>> m_Waiters;
+			std::optional<T> m_Value;
+			std::exception_ptr m_Exception;
+		};
+
+		struct FlightAwaiter
+		{
+			std::shared_ptr<Flight> flight;
+
+			bool await_ready() const
+			{
+				return flight->IsCompleted();
+			}
+
+			bool await_suspend(std::coroutine_handle<> waiter) const
+			{
+				return flight->TryAddWaiter(waiter);
+			}
+
+			T await_resume() const
+			{
+				return flight->GetResult();
+			}
+		};
+
+		mutable std::mutex m_Mutex;
+		std::unordered_map<std::string, std::shared_ptr<Flight>> m_Flights;
+	};
+}  // namespace biometric_cipher
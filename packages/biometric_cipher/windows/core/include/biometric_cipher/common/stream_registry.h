@@ -0,0 +1,293 @@
+#pragma once
+
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace biometric_cipher
+{
+	// The streams a caller has begun and not yet ended, by the id it refers to them with
+	// across method calls. Each stream has its own lock, so chunks of different streams are
+	// processed in parallel while the calls on one stream are serialized. The worker pool may
+	// start the calls of a stream in any order, so each call carries its index in the stream
+	// and co_awaits WaitForTurn() before Use() or Remove(): a call that arrives early is
+	// parked, without holding a thread, until the calls before it have finished. A stream is
+	// removed by Remove(), or by the first call on it that throws, repeats an index or runs
+	// too far ahead: a stream that failed half way cannot be resumed.
+	template <typename Stream>
+	class StreamRegistry
+	{
+	public:
+		// Each open stream holds back up to a segment and keeps its key alive, so a caller
+		// that never ends its streams is bounded.
+		static constexpr size_t DEFAULT_MAX_OPEN_STREAMS = 16;
+
+		// Calls parked per stream, each holding its chunk. An index further ahead than this
+		// is taken as a skipped one.
+		static constexpr uint32_t MAX_WAITING_CALLS = 64;
+
+		explicit StreamRegistry(size_t maxOpenStreams = DEFAULT_MAX_OPEN_STREAMS)
+			: m_MaxOpenStreams(maxOpenStreams) {}
+
+		// Throws error_invalid_argument if maxOpenStreams streams are already open.
+		uint32_t Add(std::unique_ptr<Stream> stream)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			if (m_Streams.size() >= m_MaxOpenStreams) {
+				throw BiometricCipherException(error_invalid_argument, "Too many open streams.");
+			}
+
+			// Ids are never 0, so that a caller can use 0 for "no stream".
+			do {
+				++m_LastId;
+			} while (m_LastId == 0 || m_Streams.count(m_LastId) != 0);
+
+			auto entry = std::make_shared<Entry>();
+			entry->stream = std::move(stream);
+			m_Streams.emplace(m_LastId, std::move(entry));
+
+			return m_LastId;
+		}
+
+		// co_await WaitForTurn(id, index) resumes once the calls before index have finished,
+		// on the thread that finished the last of them. It does not wait, and the Use() or
+		// Remove() that follows throws, if there is no such stream, if index has already been
+		// used or is already waiting, or if it is more than MAX_WAITING_CALLS ahead.
+		auto WaitForTurn(uint32_t id, uint32_t index)
+		{
+			struct Awaiter
+			{
+				std::shared_ptr<Entry> entry;
+				uint32_t index;
+
+				bool await_ready() const
+				{
+					if (!entry) {
+						return true;
+					}
+
+					std::lock_guard<std::mutex> lock(entry->turnMutex);
+
+					return IsReady();
+				}
+
+				bool await_suspend(std::coroutine_handle<> waiter) const
+				{
+					std::lock_guard<std::mutex> lock(entry->turnMutex);
+					if (IsReady()) {
+						return false;
+					}
+
+					entry->waiters.emplace(index, waiter);
+
+					return true;
+				}
+
+				void await_resume() const noexcept {}
+
+				bool IsReady() const
+				{
+					return entry->isClosed
+						|| index <= entry->nextIndex
+						|| index - entry->nextIndex > MAX_WAITING_CALLS
+						|| entry->waiters.count(index) != 0;
+				}
+			};
+
+			return Awaiter{ FindOrNull(id), index };
+		}
+
+		// Calls action(stream) under the stream's lock and returns what it returns; index is
+		// the number of calls made on the stream before this one. Throws
+		// error_invalid_argument if there is no such stream or if index is not the next one.
+		template <typename Action>
+		auto Use(uint32_t id, uint32_t index, Action&& action)
+		{
+			auto entry = Find(id);
+
+			// Declared before the lock so that the next call is resumed after it is released.
+			ResumeOnExit next;
+
+			std::lock_guard<std::mutex> lock(entry->mutex);
+			if (!entry->stream) {
+				ThrowUnknownStream();
+			}
+
+			try {
+				if (entry->nextIndex != index) {
+					ThrowOutOfOrder();
+				}
+
+				// The index is used up even if the action throws; the stream is closed then.
+				next.waiters.push_back(Advance(*entry));
+
+				return action(*entry->stream);
+			}
+			catch (...) {
+				Erase(id, entry);
+				entry->stream.reset();
+				next.waiters = Close(*entry);
+				throw;
+			}
+		}
+
+		// Takes the stream out of the registry, waiting for a call that is using it; index is
+		// the number of calls made on the stream. Throws error_invalid_argument if there is no
+		// such stream, and also drops the stream if index is not the next one.
+		std::unique_ptr<Stream> Remove(uint32_t id, uint32_t index)
+		{
+			auto entry = Find(id);
+
+			ResumeOnExit rest;
+
+			std::lock_guard<std::mutex> lock(entry->mutex);
+			if (!entry->stream) {
+				ThrowUnknownStream();
+			}
+			Erase(id, entry);
+			rest.waiters = Close(*entry);
+
+			if (entry->nextIndex != index) {
+				entry->stream.reset();
+				ThrowOutOfOrder();
+			}
+
+			return std::move(entry->stream);
+		}
+
+		// Drops every stream; calls in progress finish on the streams they hold, and calls
+		// waiting for their turn fail.
+		void Clear()
+		{
+			std::unordered_map<uint32_t, std::shared_ptr<Entry>> streams;
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				streams.swap(m_Streams);
+			}
+
+			ResumeOnExit rest;
+			for (auto& [id, entry] : streams) {
+				auto waiters = Close(*entry);
+				rest.waiters.insert(rest.waiters.end(), waiters.begin(), waiters.end());
+			}
+		}
+
+		size_t GetOpenCount() const
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			return m_Streams.size();
+		}
+
+	private:
+		struct Entry
+		{
+			// Held while a call uses the stream.
+			std::mutex mutex;
+			std::unique_ptr<Stream> stream;
+
+			// Held only to hand the turn on, never while a call runs.
+			std::mutex turnMutex;
+			uint32_t nextIndex = 0;
+			bool isClosed = false;
+			std::map<uint32_t, std::coroutine_handle<>> waiters;
+		};
+
+		struct ResumeOnExit
+		{
+			std::vector<std::coroutine_handle<>> waiters;
+
+			~ResumeOnExit()
+			{
+				for (auto waiter : waiters) {
+					if (waiter) {
+						waiter.resume();
+					}
+				}
+			}
+		};
+
+		// Returns the call waiting for the new index, if there is one.
+		static std::coroutine_handle<> Advance(Entry& entry)
+		{
+			std::lock_guard<std::mutex> lock(entry.turnMutex);
+			++entry.nextIndex;
+
+			auto it = entry.waiters.find(entry.nextIndex);
+			if (it == entry.waiters.end()) {
+				return nullptr;
+			}
+
+			auto waiter = it->second;
+			entry.waiters.erase(it);
+
+			return waiter;
+		}
+
+		// Returns every waiting call; each finds the stream gone.
+		static std::vector<std::coroutine_handle<>> Close(Entry& entry)
+		{
+			std::lock_guard<std::mutex> lock(entry.turnMutex);
+			entry.isClosed = true;
+
+			std::vector<std::coroutine_handle<>> waiters;
+			for (auto& [index, waiter] : entry.waiters) {
+				waiters.push_back(waiter);
+			}
+			entry.waiters.clear();
+
+			return waiters;
+		}
+
+		std::shared_ptr<Entry> FindOrNull(uint32_t id) const
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			auto it = m_Streams.find(id);
+
+			return it != m_Streams.end() ? it->second : nullptr;
+		}
+
+		std::shared_ptr<Entry> Find(uint32_t id) const
+		{
+			auto entry = FindOrNull(id);
+			if (!entry) {
+				ThrowUnknownStream();
+			}
+
+			return entry;
+		}
+
+		// Only erases the entry it was given: the id may have been reused after a Clear().
+		void Erase(uint32_t id, const std::shared_ptr<Entry>& entry)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			auto it = m_Streams.find(id);
+			if (it != m_Streams.end() && it->second == entry) {
+				m_Streams.erase(it);
+			}
+		}
+
+		[[noreturn]] static void ThrowUnknownStream()
+		{
+			throw BiometricCipherException(error_invalid_argument, "Unknown or already ended stream.");
+		}
+
+		[[noreturn]] static void ThrowOutOfOrder()
+		{
+			throw BiometricCipherException(error_invalid_argument, "Stream call repeats or skips an index.");
+		}
+
+		size_t m_MaxOpenStreams;
+		mutable std::mutex m_Mutex;
+		std::unordered_map<uint32_t, std::shared_ptr<Entry>> m_Streams;
+		uint32_t m_LastId = 0;
+	};
+}  // namespace biometric_cipher
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace biometric_cipher
+{
+	template <typename T = void>
+	class Task;
+
+	namespace detail
+	{
+		// State shared by a running coroutine and the Task returned to its caller. The coroutine
+		// frame is destroyed as soon as the body finishes, so the result is kept here instead.
+		class TaskStateBase
+		{
+		public:
+			bool IsCompleted() const
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+
+				return m_IsCompleted;
+			}
+
+			void SetException(std::exception_ptr exception)
+			{
+				m_Exception = std::move(exception);
+			}
+
+			// Returns false if the task has already completed and the awaiting coroutine
+			// must not be suspended.
+			bool TrySetContinuation(std::coroutine_handle<> continuation)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				if (m_IsCompleted) {
+					return false;
+				}
+
+				m_Continuation = continuation;
+
+				return true;
+			}
+
+			void Complete()
+			{
+				std::coroutine_handle<> continuation;
+				{
+					std::lock_guard<std::mutex> lock(m_Mutex);
+					m_IsCompleted = true;
+					continuation = std::exchange(m_Continuation, nullptr);
+				}
+
+				m_CompletedCondition.notify_all();
+
+				if (continuation) {
+					continuation.resume();
+				}
+			}
+
+			void Wait() const
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				m_CompletedCondition.wait(lock, [this] { return m_IsCompleted; });
+			}
+
+		protected:
+			void RethrowIfFailed() const
+			{
+				if (m_Exception) {
+					std::rethrow_exception(m_Exception);
+				}
+			}
+
+		private:
+			mutable std::mutex m_Mutex;
+			mutable std::condition_variable m_CompletedCondition;
+			bool m_IsCompleted = false;
+			std::coroutine_handle<> m_Continuation;
+			std::exception_ptr m_Exception;
+		};
+
+		template <typename T>
+		class TaskState : public TaskStateBase
+		{
+		public:
+			void SetValue(T value)
+			{
+				m_Value.emplace(std::move(value));
+			}
+
+			T TakeResult()
+			{
+				RethrowIfFailed();
+
+				return std::move(*m_Value);
+			}
+
+		private:
+			std::optional<T> m_Value;
+		};
+
+		template <>
+		class TaskState<void> : public TaskStateBase
+		{
+		public:
+			void TakeResult()
+			{
+				RethrowIfFailed();
+			}
+		};
+
+		template <typename T>
+		class TaskPromiseBase
+		{
+		public:
+			Task<T> get_return_object();
+
+			std::suspend_never initial_suspend() const noexcept
+			{
+				return {};
+			}
+
+			std::suspend_never final_suspend() const noexcept
+			{
+				m_State->Complete();
+
+				return {};
+			}
+
+			void unhandled_exception() const noexcept
+			{
+				m_State->SetException(std::current_exception());
+			}
+
+		protected:
+			std::shared_ptr<TaskState<T>> m_State = std::make_shared<TaskState<T>>();
+		};
+
+		template <typename T>
+		class TaskPromise : public TaskPromiseBase<T>
+		{
+		public:
+			template <typename U>
+			void return_value(U&& value)
+			{
+				this->m_State->SetValue(T(std::forward<U>(value)));
+			}
+		};
+
+		template <>
+		class TaskPromise<void> : public TaskPromiseBase<void>
+		{
+		public:
+			void return_void() const noexcept {}
+		};
+	}  // namespace detail
+
+	// Platform-neutral replacement for IAsyncOperation/IAsyncAction. The coroutine starts
+	// eagerly on the calling thread, like a C++/WinRT coroutine, and may finish on whichever
+	// thread completes the last thing it awaited. The result can be consumed once, either by
+	// co_await or by get(), which blocks until the coroutine finishes.
+	template <typename T>
+	class Task
+	{
+	public:
+		using promise_type = detail::TaskPromise<T>;
+
+		explicit Task(std::shared_ptr<detail::TaskState<T>> state)
+			: m_State(std::move(state)) {}
+
+		Task(Task&&) noexcept = default;
+		Task& operator=(Task&&) noexcept = default;
+
+		Task(const Task&) = delete;
+		Task& operator=(const Task&) = delete;
+
+		bool IsCompleted() const
+		{
+			return m_State->IsCompleted();
+		}
+
+		T get()
+		{
+			m_State->Wait();
+
+			return m_State->TakeResult();
+		}
+
+		auto operator co_await() const noexcept
+		{
+			struct Awaiter
+			{
+				std::shared_ptr<detail::TaskState<T>> state;
+
+				bool await_ready() const
+				{
+					return state->IsCompleted();
+				}
+
+				bool await_suspend(std::coroutine_handle<> continuation) const
+				{
+					return state->TrySetContinuation(continuation);
+				}
+
+				T await_resume() const
+				{
+					return state->TakeResult();
+				}
+			};
+
+			return Awaiter{ m_State };
+		}
+
+	private:
+		std::shared_ptr<detail::TaskState<T>> m_State;
+	};
+
+	template <typename T>
+	Task<T> detail::TaskPromiseBase<T>::get_return_object()
+	{
+		return Task<T>(m_State);
+	}
+}  // namespace biometric_cipher
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "include/biometric_cipher/common/executor.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace biometric_cipher
+{
+	// A fixed number of worker threads sharing one FIFO queue. The destructor runs the work
+	// that is still queued and then joins the workers.
+	class ThreadPoolExecutor : public Executor
+	{
+	public:
+		using ThreadHook = std::function<void()>;
+
+		static constexpr size_t MAX_DEFAULT_THREAD_COUNT = 4;
+
+		// threadCount == 0 picks GetDefaultThreadCount(). The hooks, if any, run on every
+		// worker thread when it starts and right before it exits (e.g. to enter and leave a
+		// COM apartment).
+		explicit ThreadPoolExecutor(
+			size_t threadCount = 0,
+			ThreadHook onThreadStart = nullptr,
+			ThreadHook onThreadExit = nullptr);
+
+		~ThreadPoolExecutor() override;
+
+		ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+		ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete;
+
+		void Post(Work work) override;
+
+		size_t GetThreadCount() const;
+
+		// The hardware concurrency, capped at MAX_DEFAULT_THREAD_COUNT: the plugin only runs
+		// a handful of requests at a time and must not compete with the app for every core.
+		static size_t GetDefaultThreadCount();
+
+	private:
+		void RunWorker();
+
+		ThreadHook m_OnThreadStart;
+		ThreadHook m_OnThreadExit;
+
+		std::mutex m_Mutex;
+		std::condition_variable m_WorkAvailable;
+		std::deque<Work> m_Queue;
+		bool m_IsStopping = false;
+
+		std::vector<std::thread> m_Threads;
+	};
+}  // namespace biometric_cipher
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace biometric_cipher
+{
+	// Always-on flight recorder of what the plugin did, exported in the Chrome trace-event
+	// format (chrome://tracing, ui.perfetto.dev). Every thread records into its own ring of
+	// EVENTS_PER_THREAD events without locks; when a ring is full its oldest events are
+	// overwritten. Only registering a thread the first time it records takes a lock.
+	//
+	// Event names are not copied: pass string literals.
+	class Tracer
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		static constexpr size_t EVENTS_PER_THREAD = 2048;
+
+		// Rings of threads that have exited are reused once there are this many.
+		static constexpr size_t MAX_THREAD_BUFFERS = 32;
+
+		Tracer();
+
+		~Tracer();
+
+		Tracer(const Tracer&) = delete;
+		Tracer& operator=(const Tracer&) = delete;
+
+		// The tracer the plugin records into.
+		static Tracer& Get();
+
+		uint64_t NewId();
+
+		// A slice on the calling thread ("X"). Must not span a co_await.
+		void RecordComplete(const char* name, Clock::time_point start, Clock::time_point end);
+
+		// A slice that may end on another thread than it began ("b"/"e"), matched by id.
+		void RecordAsyncBegin(const char* name, uint64_t id);
+
+		void RecordAsyncEnd(const char* name, uint64_t id);
+
+		// An arrow from the slice enclosing the start to the one enclosing the end ("s"/"f"),
+		// on the calling thread at the given time.
+		void RecordFlowStart(const char* name, uint64_t id, Clock::time_point timestamp);
+
+		void RecordFlowEnd(const char* name, uint64_t id, Clock::time_point timestamp);
+
+		// Drops everything recorded so far from later exports.
+		void Clear();
+
+		// {"traceEvents": [...]} with the events of every thread, oldest first.
+		std::string ExportChromeTrace() const;
+
+		// Writes ExportChromeTrace() to a file; path is UTF-8. Throws error_fail if the file
+		// cannot be written.
+		void WriteChromeTrace(const std::string& path) const;
+
+	private:
+		enum class EventType : uint32_t
+		{
+			kComplete,
+			kAsyncBegin,
+			kAsyncEnd,
+			kFlowStart,
+			kFlowEnd,
+		};
+
+		// Written by one thread and read by the exporter, seqlock style: sequence is zero while
+		// the fields are being written and the event's index + 1 after, so a reader can tell
+		// an event that was overwritten while it was being read.
+		struct Event
+		{
+			std::atomic<uint64_t> sequence{ 0 };
+			std::atomic<uint32_t> type{ 0 };
+			std::atomic<uint32_t> threadId{ 0 };
+			std::atomic<const char*> name{ nullptr };
+			std::atomic<int64_t> timestamp{ 0 };
+			std::atomic<int64_t> duration{ 0 };
+			std::atomic<uint64_t> id{ 0 };
+		};
+
+		struct ThreadBuffer
+		{
+			std::atomic<uint64_t> writeIndex{ 0 };
+			std::atomic<bool> retired{ false };
+			uint32_t threadId = 0;
+			std::array<Event, EVENTS_PER_THREAD> events;
+		};
+
+		struct EventCopy
+		{
+			EventType type;
+			uint32_t threadId;
+			const char* name;
+			int64_t timestamp;
+			int64_t duration;
+			uint64_t id;
+		};
+
+		friend struct ThreadRegistration;
+
+		ThreadBuffer& GetThreadBuffer();
+
+		void Record(EventType type, const char* name, Clock::time_point timestamp, Clock::duration duration, uint64_t id);
+
+		std::vector<EventCopy> CopyEvents() const;
+
+		const uint64_t m_Generation;
+		const Clock::time_point m_Epoch;
+		std::atomic<uint64_t> m_NextId{ 1 };
+		std::atomic<int64_t> m_ClearedAt{ 0 };
+
+		mutable std::mutex m_BuffersMutex;
+		std::vector<std::shared_ptr<ThreadBuffer>> m_Buffers;
+		uint32_t m_NextThreadId = 1;
+	};
+
+	// Records its lifetime as a slice on the calling thread. For code that does not co_await.
+	class TraceScope
+	{
+	public:
+		explicit TraceScope(const char* name, Tracer& tracer = Tracer::Get())
+			: m_Tracer(tracer),
+			m_Name(name),
+			m_Start(Tracer::Clock::now()) {}
+
+		~TraceScope()
+		{
+			m_Tracer.RecordComplete(m_Name, m_Start, Tracer::Clock::now());
+		}
+
+		TraceScope(const TraceScope&) = delete;
+		TraceScope& operator=(const TraceScope&) = delete;
+
+	private:
+		Tracer& m_Tracer;
+		const char* m_Name;
+		Tracer::Clock::time_point m_Start;
+	};
+
+	// Records its lifetime as an async slice, so it may live in a coroutine frame across
+	// co_awaits that resume on other threads.
+	class TraceAsyncScope
+	{
+	public:
+		explicit TraceAsyncScope(const char* name, Tracer& tracer = Tracer::Get())
+			: m_Tracer(tracer),
+			m_Name(name),
+			m_Id(tracer.NewId())
+		{
+			m_Tracer.RecordAsyncBegin(m_Name, m_Id);
+		}
+
+		~TraceAsyncScope()
+		{
+			m_Tracer.RecordAsyncEnd(m_Name, m_Id);
+		}
+
+		TraceAsyncScope(const TraceAsyncScope&) = delete;
+		TraceAsyncScope& operator=(const TraceAsyncScope&) = delete;
+
+	private:
+		Tracer& m_Tracer;
+		const char* m_Name;
+		uint64_t m_Id;
+	};
+
+	// Wraps a single co_await: an async slice for the wait, and a flow arrow from the thread
+	// that suspended to the one that resumed, each end marked by a short slice of the same
+	// name so that trace viewers have something to attach the arrow to.
+	class TraceAwait
+	{
+	public:
+		explicit TraceAwait(const char* name, Tracer& tracer = Tracer::Get())
+			: m_Tracer(tracer),
+			m_Name(name),
+			m_Id(tracer.NewId())
+		{
+			auto now = Tracer::Clock::now();
+			m_Tracer.RecordComplete(m_Name, now, now + std::chrono::nanoseconds(1));
+			m_Tracer.RecordFlowStart(m_Name, m_Id, now);
+			m_Tracer.RecordAsyncBegin(m_Name, m_Id);
+		}
+
+		~TraceAwait()
+		{
+			m_Tracer.RecordAsyncEnd(m_Name, m_Id);
+			auto now = Tracer::Clock::now();
+			m_Tracer.RecordComplete(m_Name, now, now + std::chrono::nanoseconds(1));
+			m_Tracer.RecordFlowEnd(m_Name, m_Id, now);
+		}
+
+		TraceAwait(const TraceAwait&) = delete;
+		TraceAwait& operator=(const TraceAwait&) = delete;
+
+	private:
+		Tracer& m_Tracer;
+		const char* m_Name;
+		uint64_t m_Id;
+	};
+}
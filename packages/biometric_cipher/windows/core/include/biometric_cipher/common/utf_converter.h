@@ -0,0 +1,52 @@
+#pragma once
+
+#include "include/biometric_cipher/common/cpu_features.h"
+#include "include/biometric_cipher/common/secure_allocator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace biometric_cipher {
+	// Portable UTF-8 <-> UTF-16 conversion. Malformed input is not rejected: every maximal
+	// ill-formed UTF-8 subsequence and every unpaired surrogate is replaced with U+FFFD,
+	// which is what MultiByteToWideChar/WideCharToMultiByte did, so derived keys and
+	// converted strings stay the same.
+	//
+	// The conversion is single pass: callers size the output with the GetMax* bounds and
+	// get back the number of code units written. Runs of ASCII are converted 16 or 32 at a
+	// time with SSE4.1 or AVX2 when the CPU has them; the level parameters exist for tests
+	// and benchmarks and are lowered to what the CPU supports.
+	class UtfConverter {
+	public:
+		// Every UTF-8 byte produces at most one UTF-16 code unit.
+		static size_t GetMaxUtf16Length(size_t utf8Length)
+		{
+			return utf8Length;
+		}
+
+		// Every UTF-16 code unit produces at most three UTF-8 bytes.
+		static size_t GetMaxUtf8Length(size_t utf16Length)
+		{
+			return utf16Length * 3;
+		}
+
+		// Returns the number of code units written to output.
+		static size_t ConvertUtf8ToUtf16(
+			std::string_view string,
+			char16_t* output,
+			SimdLevel level = SimdLevel::kAvx2);
+
+		// Returns the number of bytes written to output.
+		static size_t ConvertUtf16ToUtf8(
+			std::u16string_view string,
+			char* output,
+			SimdLevel level = SimdLevel::kAvx2);
+
+		static std::u16string ConvertUtf8ToUtf16(std::string_view string);
+		static SecureBuffer ConvertUtf8ToUtf16LE(std::string_view string);
+		static std::string ConvertUtf16ToUtf8(std::u16string_view string);
+	};
+}
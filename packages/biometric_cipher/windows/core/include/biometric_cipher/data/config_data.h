@@ -0,0 +1,28 @@
+#pragma once
+
+#include "include/biometric_cipher/common/secure_allocator.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace biometric_cipher
+{
+	struct ConfigData {
+		static constexpr uint32_t kDefaultKeyCacheMaxEntries = 16;
+		static constexpr uint32_t kDefaultBiometryStatusCacheTtlSeconds = 5;
+
+		SecureString dataToSign;
+		uint32_t keyCacheTtlSeconds;
+		uint32_t keyCacheMaxEntries;
+		uint32_t biometryStatusCacheTtlSeconds = kDefaultBiometryStatusCacheTtlSeconds;
+		// UTF-8 path exportTrace also writes the trace to; empty for none.
+		std::string traceFilePath;
+		
+		ConfigData() : dataToSign(""), keyCacheTtlSeconds(0), keyCacheMaxEntries(kDefaultKeyCacheMaxEntries) {}
+		ConfigData(std::string_view dataToSign) 
+			: dataToSign(dataToSign), keyCacheTtlSeconds(0), keyCacheMaxEntries(kDefaultKeyCacheMaxEntries) {}
+		ConfigData(std::string_view dataToSign, uint32_t keyCacheTtlSeconds, uint32_t keyCacheMaxEntries)
+			: dataToSign(dataToSign), keyCacheTtlSeconds(keyCacheTtlSeconds), keyCacheMaxEntries(keyCacheMaxEntries) {}
+	};
+}
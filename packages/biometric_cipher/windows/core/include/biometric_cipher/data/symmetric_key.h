@@ -0,0 +1,11 @@
+#pragma once
+
+namespace biometric_cipher
+{
+	// Opaque handle to a key created by a WinrtEncryptRepository. Only the repository that
+	// created a key knows its concrete type and can use it.
+	struct SymmetricKey
+	{
+		virtual ~SymmetricKey() = default;
+	};
+}  // namespace biometric_cipher
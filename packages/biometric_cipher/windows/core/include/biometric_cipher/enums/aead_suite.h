@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+namespace biometric_cipher
+{
+	// The AEAD an envelope is sealed with. The values are written into envelope headers, so
+	// they must never change or be reused.
+	enum class AeadSuite : uint8_t
+	{
+		kAes256Gcm = 1,
+		kChaCha20Poly1305 = 2,
+	};
+
+	// Nullopt if no suite has the value.
+	std::optional<AeadSuite> ByteToAeadSuite(uint8_t value);
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string_view>
+
+namespace biometric_cipher {
+
+	enum class ArgumentName {
+		kTag,
+		kData,
+		kKey,
+		kWindowsDataToSign,
+		kWindowsKeyCacheTtlSeconds,
+		kWindowsKeyCacheMaxEntries,
+		kWindowsBiometryStatusCacheTtlSeconds,
+		kWindowsTraceFilePath,
+		kStreamId,
+		kContext,
+		kChunkIndex,
+	};
+
+	// The names are listed in method_schema.h.
+	std::string_view GetArgumentName(ArgumentName argumentName);
+}
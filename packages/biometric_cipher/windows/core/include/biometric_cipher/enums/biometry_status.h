@@ -13,7 +13,7 @@ namespace biometric_cipher
 		kAndroidBiometricErrorSecurityUpdateRequired = 6,
 	};
 
-	const int BiometryStatusToInteger(BiometryStatus biometryStatus);
+	int BiometryStatusToInteger(BiometryStatus biometryStatus);
 
-	const BiometryStatus IntegerToBiometryStatus(int value);
+	BiometryStatus IntegerToBiometryStatus(int value);
 } // namespace biometric_cipher
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string_view>
+
+namespace biometric_cipher {
+
+	enum class MethodName {
+		kGetTPMStatus,
+		kRefreshTPMStatus,
+		kGetBiometryStatus,
+		kGetCachedBiometryStatus,
+		kGenerateKey,
+		kEncrypt,
+		kDecrypt,
+		kEncryptBatch,
+		kDecryptBatch,
+		kSha256,
+		kHmacSha256,
+		kDeleteKey,
+		kConfigure,
+		kInvalidateKeyCache,
+		kLockKeyCache,
+		kGetMetrics,
+		kExportTrace,
+		kEncryptStreamBegin,
+		kEncryptStreamChunk,
+		kEncryptStreamEnd,
+		kDecryptStreamBegin,
+		kDecryptStreamChunk,
+		kDecryptStreamEnd,
+		kNotImplemented,
+	};
+
+	// Unknown names map to kNotImplemented. The names are listed in method_schema.h.
+	MethodName GetMethodName(std::string_view methodName);
+}
@@ -0,0 +1,245 @@
+#pragma once
+
+#include "include/biometric_cipher/enums/argument_name.h"
+#include "include/biometric_cipher/enums/method_name.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <span>
+#include <string_view>
+#include <utility>
+
+namespace biometric_cipher {
+	// What ArgumentParser accepts for an argument.
+	enum class ArgumentType {
+		kString,
+		kStringOrBinary,
+		kStringList,
+		// An integer in the uint32_t range; may be missing or null.
+		kOptionalUInt,
+		// A string; may be missing or null.
+		kOptionalString,
+		// An integer in the uint32_t range.
+		kUInt,
+	};
+
+	struct ArgumentSchema {
+		ArgumentName name = ArgumentName::kTag;
+		ArgumentType type = ArgumentType::kString;
+	};
+
+	struct MethodSchema {
+		static constexpr size_t MAX_ARGUMENT_COUNT = 5;
+
+		MethodName method = MethodName::kNotImplemented;
+		std::string_view name;
+		std::array<ArgumentSchema, MAX_ARGUMENT_COUNT> arguments = {};
+		size_t argumentCount = 0;
+
+		constexpr std::span<const ArgumentSchema> GetArguments() const
+		{
+			return { arguments.data(), argumentCount };
+		}
+	};
+
+	constexpr MethodSchema DescribeMethod(
+		MethodName method,
+		std::string_view name,
+		std::initializer_list<ArgumentSchema> arguments = {})
+	{
+		MethodSchema schema;
+		schema.method = method;
+		schema.name = name;
+		schema.argumentCount = arguments.size();
+		std::copy(arguments.begin(), arguments.end(), schema.arguments.begin());
+
+		return schema;
+	}
+
+	// The names of the arguments on the channel, in ArgumentName order.
+	inline constexpr std::pair<ArgumentName, std::string_view> ARGUMENT_NAMES[] = {
+		{ ArgumentName::kTag, "tag" },
+		{ ArgumentName::kData, "data" },
+		{ ArgumentName::kKey, "key" },
+		{ ArgumentName::kWindowsDataToSign, "windowsDataToSign" },
+		{ ArgumentName::kWindowsKeyCacheTtlSeconds, "windowsKeyCacheTtlSeconds" },
+		{ ArgumentName::kWindowsKeyCacheMaxEntries, "windowsKeyCacheMaxEntries" },
+		{ ArgumentName::kWindowsBiometryStatusCacheTtlSeconds, "windowsBiometryStatusCacheTtlSeconds" },
+		{ ArgumentName::kWindowsTraceFilePath, "windowsTraceFilePath" },
+		{ ArgumentName::kStreamId, "streamId" },
+		{ ArgumentName::kContext, "context" },
+		{ ArgumentName::kChunkIndex, "chunkIndex" },
+	};
+
+	inline constexpr size_t ARGUMENT_NAME_COUNT = std::size(ARGUMENT_NAMES);
+
+	// Every method of the channel, in MethodName order: the name Dart calls it by and the
+	// arguments ArgumentParser requires for it. Adding a method takes a MethodName, a row
+	// here and a case in the plugin's HandleMethodCall.
+	//
+	// The methods that take a key by tag also take an optional context, which selects the
+	// subkey derived for it instead.
+	inline constexpr MethodSchema METHOD_SCHEMAS[] = {
+		DescribeMethod(MethodName::kGetTPMStatus, "getTPMStatus"),
+		DescribeMethod(MethodName::kRefreshTPMStatus, "refreshTPMStatus"),
+		DescribeMethod(MethodName::kGetBiometryStatus, "getBiometryStatus"),
+		DescribeMethod(MethodName::kGetCachedBiometryStatus, "getCachedBiometryStatus"),
+		DescribeMethod(MethodName::kGenerateKey, "generateKey", {
+			{ ArgumentName::kTag, ArgumentType::kString },
+		}),
+		DescribeMethod(MethodName::kEncrypt, "encrypt", {
+			{ ArgumentName::kTag, ArgumentType::kString },
+			{ ArgumentName::kData, ArgumentType::kStringOrBinary },
+			{ ArgumentName::kContext, ArgumentType::kOptionalString },
+		}),
+		DescribeMethod(MethodName::kDecrypt, "decrypt", {
+			{ ArgumentName::kTag, ArgumentType::kString },
+			{ ArgumentName::kData, ArgumentType::kStringOrBinary },
+			{ ArgumentName::kContext, ArgumentType::kOptionalString },
+		}),
+		DescribeMethod(MethodName::kEncryptBatch, "encryptBatch", {
+			{ ArgumentName::kTag, ArgumentType::kString },
+			{ ArgumentName::kData, ArgumentType::kStringList },
+			{ ArgumentName::kContext, ArgumentType::kOptionalString },
+		}),
+		DescribeMethod(MethodName::kDecryptBatch, "decryptBatch", {
+			{ ArgumentName::kTag, ArgumentType::kString },
+			{ ArgumentName::kData, ArgumentType::kStringList },
+			{ ArgumentName::kContext, ArgumentType::kOptionalString },
+		}),
+		DescribeMethod(MethodName::kSha256, "sha256", {
+			{ ArgumentName::kData, ArgumentType::kStringOrBinary },
+		}),
+		DescribeMethod(MethodName::kHmacSha256, "hmacSha256", {
+			{ ArgumentName::kKey, ArgumentType::kStringOrBinary },
+			{ ArgumentName::kData, ArgumentType::kStringOrBinary },
+		}),
+		DescribeMethod(MethodName::kDeleteKey, "deleteKey", {
+			{ ArgumentName::kTag, ArgumentType::kString },
+		}),
+		DescribeMethod(MethodName::kConfigure, "configure", {
+			{ ArgumentName::kWindowsDataToSign, ArgumentType::kString },
+			{ ArgumentName::kWindowsKeyCacheTtlSeconds, ArgumentType::kOptionalUInt },
+			{ ArgumentName::kWindowsKeyCacheMaxEntries, ArgumentType::kOptionalUInt },
+			{ ArgumentName::kWindowsBiometryStatusCacheTtlSeconds, ArgumentType::kOptionalUInt },
+			{ ArgumentName::kWindowsTraceFilePath, ArgumentType::kOptionalString },
+		}),
+		DescribeMethod(MethodName::kInvalidateKeyCache, "invalidateKeyCache", {
+			{ ArgumentName::kTag, ArgumentType::kString },
+		}),
+		DescribeMethod(MethodName::kLockKeyCache, "lockKeyCache"),
+		DescribeMethod(MethodName::kGetMetrics, "getMetrics"),
+		DescribeMethod(MethodName::kExportTrace, "exportTrace"),
+		DescribeMethod(MethodName::kEncryptStreamBegin, "encryptStreamBegin", {
+			{ ArgumentName::kTag, ArgumentType::kString },
+			{ ArgumentName::kContext, ArgumentType::kOptionalString },
+		}),
+		// chunkIndex counts the calls on a stream: 0 for the first chunk, and the number of
+		// chunks for the end. Calls may be sent without waiting for the previous reply; each
+		// is applied in index order. Repeating or skipping an index fails and ends the stream.
+		DescribeMethod(MethodName::kEncryptStreamChunk, "encryptStreamChunk", {
+			{ ArgumentName::kStreamId, ArgumentType::kUInt },
+			{ ArgumentName::kChunkIndex, ArgumentType::kUInt },
+			{ ArgumentName::kData, ArgumentType::kStringOrBinary },
+		}),
+		DescribeMethod(MethodName::kEncryptStreamEnd, "encryptStreamEnd", {
+			{ ArgumentName::kStreamId, ArgumentType::kUInt },
+			{ ArgumentName::kChunkIndex, ArgumentType::kUInt },
+		}),
+		// data is the header encryptStreamBegin returned.
+		DescribeMethod(MethodName::kDecryptStreamBegin, "decryptStreamBegin", {
+			{ ArgumentName::kTag, ArgumentType::kString },
+			{ ArgumentName::kData, ArgumentType::kStringOrBinary },
+			{ ArgumentName::kContext, ArgumentType::kOptionalString },
+		}),
+		DescribeMethod(MethodName::kDecryptStreamChunk, "decryptStreamChunk", {
+			{ ArgumentName::kStreamId, ArgumentType::kUInt },
+			{ ArgumentName::kChunkIndex, ArgumentType::kUInt },
+			{ ArgumentName::kData, ArgumentType::kStringOrBinary },
+		}),
+		DescribeMethod(MethodName::kDecryptStreamEnd, "decryptStreamEnd", {
+			{ ArgumentName::kStreamId, ArgumentType::kUInt },
+			{ ArgumentName::kChunkIndex, ArgumentType::kUInt },
+		}),
+	};
+
+	inline constexpr size_t METHOD_COUNT = std::size(METHOD_SCHEMAS);
+
+	// Returns null for kNotImplemented.
+	constexpr const MethodSchema* GetMethodSchema(MethodName method)
+	{
+		auto index = static_cast<size_t>(method);
+
+		return index < METHOD_COUNT ? &METHOD_SCHEMAS[index] : nullptr;
+	}
+
+	constexpr bool TakesArgument(MethodName method, ArgumentName name, ArgumentType type)
+	{
+		// Compares indices rather than GetMethodSchema() with null, which some compilers
+		// refuse to evaluate at compile time under sanitizers.
+		auto index = static_cast<size_t>(method);
+		if (index >= METHOD_COUNT) {
+			return false;
+		}
+
+		for (const auto& argument : METHOD_SCHEMAS[index].GetArguments()) {
+			if (argument.name == name && argument.type == type) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// The method names sorted for a binary search by GetMethodName.
+	inline constexpr auto SORTED_METHOD_NAMES = [] {
+		std::array<std::pair<std::string_view, MethodName>, METHOD_COUNT> names = {};
+		for (size_t i = 0; i < METHOD_COUNT; ++i) {
+			names[i] = { METHOD_SCHEMAS[i].name, METHOD_SCHEMAS[i].method };
+		}
+		std::sort(names.begin(), names.end());
+
+		return names;
+	}();
+
+	namespace detail {
+		constexpr bool AreArgumentNamesInOrder()
+		{
+			for (size_t i = 0; i < ARGUMENT_NAME_COUNT; ++i) {
+				if (static_cast<size_t>(ARGUMENT_NAMES[i].first) != i) {
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		constexpr bool AreMethodsInOrder()
+		{
+			for (size_t i = 0; i < METHOD_COUNT; ++i) {
+				if (static_cast<size_t>(METHOD_SCHEMAS[i].method) != i) {
+					return false;
+				}
+			}
+
+			return static_cast<size_t>(MethodName::kNotImplemented) == METHOD_COUNT;
+		}
+
+		constexpr bool AreMethodNamesUnique()
+		{
+			for (size_t i = 1; i < METHOD_COUNT; ++i) {
+				if (SORTED_METHOD_NAMES[i - 1].first == SORTED_METHOD_NAMES[i].first) {
+					return false;
+				}
+			}
+
+			return true;
+		}
+	}
+
+	static_assert(detail::AreArgumentNamesInOrder(), "ARGUMENT_NAMES must follow the ArgumentName order.");
+	static_assert(detail::AreMethodsInOrder(), "METHOD_SCHEMAS must list every method in MethodName order.");
+	static_assert(detail::AreMethodNamesUnique(), "Method names must be unique.");
+}
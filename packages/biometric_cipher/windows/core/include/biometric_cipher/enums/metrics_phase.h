@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace biometric_cipher
+{
+	// The phases a method call is timed in, so that the time a user spends on the Windows
+	// Hello prompt can be told apart from the time spent on crypto.
+	enum class MetricsPhase
+	{
+		kArgumentParsing,
+		kHelloStatusCheck,
+		kSignPrompt,
+		kKeyDerivation,
+		kAesGcm,
+		kEncodingAndReply,
+	};
+
+	inline constexpr size_t METRICS_PHASE_COUNT = 6;
+
+	// The name getMetrics reports the phase under.
+	std::string_view GetMetricsPhaseName(MetricsPhase phase);
+}
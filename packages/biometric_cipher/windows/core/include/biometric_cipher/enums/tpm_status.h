@@ -9,7 +9,7 @@ namespace biometric_cipher
 		kTPMVersionUnsupported = 2,
 	};
 
-	const int TpmStatusToInteger(TpmStatus tmpStatus);
+	int TpmStatusToInteger(TpmStatus tmpStatus);
 
-	const TpmStatus IntegerToTpmStatus(int value);
+	TpmStatus IntegerToTpmStatus(int value);
 }
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "include/biometric_cipher/errors/error_codes.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace biometric_cipher
+{
+	class BiometricCipherException : public std::runtime_error
+	{
+	public:
+		BiometricCipherException(ErrorCode code, const std::string& message)
+			: std::runtime_error(message), m_Code(code) {}
+
+		ErrorCode Code() const noexcept { return m_Code; }
+
+	private:
+		ErrorCode m_Code;
+	};
+}  // namespace biometric_cipher
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace biometric_cipher
+{
+	// Error codes keep the HRESULT values the plugin has always reported, so the codes seen by
+	// Dart (and in logs) are the same whether an error comes from the core or from WinRT.
+	using ErrorCode = int32_t;
+
+	inline constexpr ErrorCode error_fail{ static_cast<ErrorCode>(0x80004005) };
+	inline constexpr ErrorCode error_invalid_argument{ static_cast<ErrorCode>(0x80070057) };
+	inline constexpr ErrorCode error_no_key{ static_cast<ErrorCode>(0x8009000D) };
+
+	inline constexpr ErrorCode error_tpm_unsupported{ static_cast<ErrorCode>(0xA0082001) };
+	inline constexpr ErrorCode error_tpm_version{ static_cast<ErrorCode>(0xA0082002) };
+	inline constexpr ErrorCode error_biometry_not_supported{ static_cast<ErrorCode>(0xA0082003) };
+	inline constexpr ErrorCode error_configure{ static_cast<ErrorCode>(0xA0082004) };
+	inline constexpr ErrorCode error_generate_key{ static_cast<ErrorCode>(0xA0082005) };
+	inline constexpr ErrorCode error_key_not_found{ static_cast<ErrorCode>(0xA0082006) };
+	inline constexpr ErrorCode error_key_already_exists{ static_cast<ErrorCode>(0xA0082007) };
+	inline constexpr ErrorCode error_delete_key{ static_cast<ErrorCode>(0xA0082008) };
+	inline constexpr ErrorCode error_encrypt{ static_cast<ErrorCode>(0xA0082009) };
+	inline constexpr ErrorCode error_decrypt{ static_cast<ErrorCode>(0xA008200A) };
+	inline constexpr ErrorCode error_authentication_canceled{ static_cast<ErrorCode>(0xA008200B) };
+	inline constexpr ErrorCode error_user_prefers_password{ static_cast<ErrorCode>(0xA008200C) };
+	inline constexpr ErrorCode error_secure_device_locked{ static_cast<ErrorCode>(0xA008200D) };
+	inline constexpr ErrorCode error_converting_string{ static_cast<ErrorCode>(0xA008200E) };
+
+	const std::string GetErrorCodeString(ErrorCode code);
+}
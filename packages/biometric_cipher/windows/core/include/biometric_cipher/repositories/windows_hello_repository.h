@@ -0,0 +1,27 @@
+#pragma once
+
+#include "include/biometric_cipher/common/secure_allocator.h"
+#include "include/biometric_cipher/common/task.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace biometric_cipher
+{
+	struct WindowsHelloRepository
+	{
+		virtual ~WindowsHelloRepository() = default;
+
+		virtual Task<int> GetWindowsHelloStatusAsync() const = 0;
+
+		// The signature is the key material AES keys are derived from.
+		virtual Task<SecureBuffer> SignAsync(
+			const std::string tag,
+			const SecureBuffer data) const = 0;
+
+		virtual Task<> CreateCredentialAsync(const std::string tag) const = 0;
+
+		virtual Task<> DeleteCredentialAsync(const std::string tag) const = 0;
+	};
+}
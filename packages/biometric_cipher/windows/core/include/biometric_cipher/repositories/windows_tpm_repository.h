@@ -9,5 +9,9 @@ namespace biometric_cipher
 		virtual ~WindowsTpmRepository() = default;
 
 		virtual int GetWindowsTpmVersion() const = 0;
+
+		// Drops any state kept between queries (such as an open provider handle), so that
+		// the next query sees the current state of the TPM.
+		virtual void Refresh() const = 0;
 	};
 }  // namespace biometric_cipher
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "include/biometric_cipher/common/aes_gcm_stream.h"
+#include "include/biometric_cipher/common/secure_allocator.h"
+#include "include/biometric_cipher/data/symmetric_key.h"
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace biometric_cipher
+{
+	struct WinrtEncryptRepository
+	{
+		virtual ~WinrtEncryptRepository() = default;
+
+		// Plaintext and key material are passed in SecureBuffer/SecureString; ciphertext is not
+		// secret and uses the ordinary types.
+		virtual std::shared_ptr<SymmetricKey> CreateAESKey(const SecureBuffer& signature) const = 0;
+
+		// A key for context, derived from key without another signature. The same key and
+		// context always give the same subkey; different contexts give independent ones.
+		virtual std::shared_ptr<SymmetricKey> DeriveSubkey(
+			const std::shared_ptr<SymmetricKey>& key,
+			std::string_view context) const = 0;
+
+		virtual std::string Encrypt(
+			const std::shared_ptr<SymmetricKey>& key,
+			const SecureString& data) const = 0;
+
+		virtual SecureString Decrypt(
+			const std::shared_ptr<SymmetricKey>& key,
+			const std::string& data) const = 0;
+
+		virtual std::vector<uint8_t> EncryptBinary(
+			const std::shared_ptr<SymmetricKey>& key,
+			const SecureBuffer& data) const = 0;
+
+		virtual SecureBuffer DecryptBinary(
+			const std::shared_ptr<SymmetricKey>& key,
+			const std::vector<uint8_t>& data) const = 0;
+
+		// Segmented encryption for payloads too large to hold in memory (see AesGcmStream).
+		// The streams keep the key alive.
+		virtual std::unique_ptr<EncryptStream> CreateEncryptStream(
+			const std::shared_ptr<SymmetricKey>& key) const = 0;
+
+		// Throws error_decrypt if header is not a stream header.
+		virtual std::unique_ptr<DecryptStream> CreateDecryptStream(
+			const std::shared_ptr<SymmetricKey>& key,
+			std::span<const uint8_t> header) const = 0;
+	};
+}
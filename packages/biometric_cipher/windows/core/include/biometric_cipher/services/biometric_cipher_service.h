@@ -0,0 +1,128 @@
+#pragma once
+
+#include "include/biometric_cipher/common/single_flight.h"
+#include "include/biometric_cipher/common/task.h"
+#include "include/biometric_cipher/data/symmetric_key.h"
+#include "include/biometric_cipher/storages/biometry_status_cache.h"
+#include "include/biometric_cipher/storages/config_storage.h"
+#include "include/biometric_cipher/storages/session_key_cache.h"
+#include "include/biometric_cipher/repositories/windows_hello_repository.h"
+#include "include/biometric_cipher/repositories/windows_tpm_repository.h"
+#include "include/biometric_cipher/repositories/winrt_encrypt_repository.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace biometric_cipher
+{
+	class BiometricCipherService
+	{
+
+	public:
+		BiometricCipherService(
+			std::shared_ptr<ConfigStorage> configStorage,
+			std::shared_ptr<WindowsHelloRepository> windowsHelloRepository,
+			std::shared_ptr<WindowsTpmRepository> windowsTpmRepository,
+			std::shared_ptr<WinrtEncryptRepository> winrtEncryptRepository,
+			std::shared_ptr<SessionKeyCache> sessionKeyCache = nullptr,
+			std::shared_ptr<BiometryStatusCache> biometryStatusCache = nullptr
+		) 
+			: m_ConfigStorage(configStorage),
+			m_WindowsHelloRepository(std::move(windowsHelloRepository)),
+			m_WindowsTpmRepository(std::move(windowsTpmRepository)),
+			m_WinrtEncryptRepository(std::move(winrtEncryptRepository)),
+			m_SessionKeyCache(sessionKeyCache ? sessionKeyCache : std::make_shared<SessionKeyCache>()),
+			m_BiometryStatusCache(biometryStatusCache ? biometryStatusCache : std::make_shared<BiometryStatusCache>()),
+			m_KeyDerivations(std::make_shared<SingleFlight<std::shared_ptr<SymmetricKey>>>())
+		{}
+
+		void Configure(const ConfigData& configData) const;
+
+		// The TPM status does not change while the process runs, so it is queried once and
+		// then served from memory until RefreshTPMStatusAsync() is called.
+		Task<int> GetTPMStatusAsync() const;
+
+		Task<int> RefreshTPMStatusAsync() const;
+
+		Task<int> GetBiometryStatusAsync() const;
+
+		// Same as GetBiometryStatusAsync(), but returns the last known status if it is still
+		// within the configured biometry status TTL.
+		Task<int> GetCachedBiometryStatusAsync() const;
+
+		Task<> GenerateKeyAsync(const std::string tag) const;
+
+		Task<> DeleteKeyAsync(const std::string tag) const;
+
+		// The encrypt and decrypt methods use the key of tag, or with a non-empty context the
+		// subkey DeriveSubkeysAsync derives for it. Data encrypted under one context does not
+		// decrypt under another.
+		Task<std::string> EncryptAsync(const std::string tag, SecureString data, const std::string context = {}) const;
+
+		Task<SecureString> DecryptAsync(const std::string tag, std::string data, const std::string context = {}) const;
+
+		Task<std::vector<uint8_t>> EncryptBinaryAsync(const std::string tag, SecureBuffer data, const std::string context = {}) const;
+
+		Task<SecureBuffer> DecryptBinaryAsync(const std::string tag, std::vector<uint8_t> data, const std::string context = {}) const;
+
+		Task<std::vector<std::string>> EncryptBatchAsync(const std::string tag, std::vector<SecureString> data, const std::string context = {}) const;
+
+		Task<std::vector<SecureString>> DecryptBatchAsync(const std::string tag, std::vector<std::string> data, const std::string context = {}) const;
+
+		// Derive the key for tag once, like EncryptBinaryAsync, and return a stream that
+		// encrypts or decrypts a payload in segments without holding it in memory.
+		Task<std::unique_ptr<EncryptStream>> BeginEncryptStreamAsync(const std::string tag, const std::string context = {}) const;
+
+		Task<std::unique_ptr<DecryptStream>> BeginDecryptStreamAsync(
+			const std::string tag,
+			std::vector<uint8_t> header,
+			const std::string context = {}) const;
+
+		// One key per context, all expanded with HKDF-SHA256 from the key of tag, so a single
+		// Windows Hello signature unlocks all of them. Subkeys are not cached: deriving one
+		// takes microseconds, and the key of tag is cached like for any other call, so later
+		// calls within the key cache TTL derive theirs without a prompt.
+		Task<std::vector<std::shared_ptr<SymmetricKey>>> DeriveSubkeysAsync(
+			const std::string tag,
+			std::vector<std::string> contexts) const;
+
+		void InvalidateKeyCache(const std::string& tag) const;
+
+		void LockKeyCache() const;
+
+	private:
+		int QueryTPMStatus() const;
+
+		// The key of tag, or its subkey for context if context is not empty.
+		Task<std::shared_ptr<SymmetricKey>> CreateKeyAsync(
+			const std::string tag,
+			const std::string context,
+			const SecureBuffer signature) const;
+
+		Task<std::shared_ptr<SymmetricKey>> CreateAESKeyAsync(
+			const std::string tag,
+			const SecureBuffer signature) const;
+
+		// Caches the key only if the cache is still at cacheGeneration, read before signing.
+		Task<std::shared_ptr<SymmetricKey>> DeriveAESKeyAsync(
+			const std::string tag,
+			const SecureBuffer signature,
+			const uint64_t cacheGeneration) const;
+
+		std::shared_ptr<ConfigStorage> m_ConfigStorage;
+		std::shared_ptr<WindowsHelloRepository> m_WindowsHelloRepository;
+		std::shared_ptr<WindowsTpmRepository> m_WindowsTpmRepository;
+		std::shared_ptr<WinrtEncryptRepository> m_WinrtEncryptRepository;
+		std::shared_ptr<SessionKeyCache> m_SessionKeyCache;
+		std::shared_ptr<BiometryStatusCache> m_BiometryStatusCache;
+		// Concurrent operations on the same tag share one Windows Hello prompt.
+		std::shared_ptr<SingleFlight<std::shared_ptr<SymmetricKey>>> m_KeyDerivations;
+
+		mutable std::mutex m_TpmStatusMutex;
+		mutable std::optional<int> m_TpmStatus;
+	};
+}  // namespace biometric_cipher
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <optional>
+
+namespace biometric_cipher
+{
+	// Remembers the last Windows Hello availability status for a short time, so that every
+	// sign does not have to ask Windows again. The cache is disabled until a non-zero TTL is
+	// configured, and should be invalidated whenever an operation fails in a way that
+	// suggests that the availability has changed.
+	class BiometryStatusCache
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+		using TimeProvider = std::function<Clock::time_point()>;
+
+		explicit BiometryStatusCache(TimeProvider timeProvider = nullptr)
+			: m_TimeProvider(timeProvider ? timeProvider : [] { return Clock::now(); }) {}
+
+		virtual ~BiometryStatusCache() = default;
+
+		// Applies a new TTL and drops the cached status.
+		virtual void Configure(std::chrono::seconds ttl);
+
+		// Returns std::nullopt when there is no fresh status.
+		virtual std::optional<int> Get() const;
+
+		virtual void Put(int status);
+
+		virtual void Invalidate();
+
+	private:
+		TimeProvider m_TimeProvider;
+
+		mutable std::mutex m_Mutex;
+		std::optional<int> m_Status;
+		Clock::time_point m_ExpiresAt{};
+		std::chrono::seconds m_Ttl{ 0 };
+	};
+}  // namespace biometric_cipher
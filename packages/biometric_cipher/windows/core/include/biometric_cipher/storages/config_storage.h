@@ -0,0 +1,30 @@
+#pragma once
+
+#include "include/biometric_cipher/data/config_data.h"
+
+#include <memory>
+#include <mutex>
+
+namespace biometric_cipher {
+
+	// configure replaces the configuration on the platform thread while operations read it
+	// on the worker pool, so it is never changed in place: each SetConfigData installs a new
+	// ConfigData, and GetConfig hands out the current one, which stays valid and unchanged
+	// for as long as the caller holds it.
+	class ConfigStorage
+	{
+	public:
+		virtual ~ConfigStorage() = default;
+
+		// Throws error_configure, and leaves the storage unconfigured, if configData is invalid.
+		virtual void SetConfigData(const ConfigData& configData);
+
+		// Null until a valid configuration has been set. An operation reads it once and uses
+		// that snapshot throughout.
+		virtual std::shared_ptr<const ConfigData> GetConfig() const;
+
+	private:
+		mutable std::mutex m_Mutex;
+		std::shared_ptr<const ConfigData> m_ConfigData;
+	};
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "include/biometric_cipher/data/symmetric_key.h"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace biometric_cipher
+{
+	// Keeps derived AES keys for a short unlock window so that repeated operations on the
+	// same tag do not need another Windows Hello signature. The cache is disabled until a
+	// non-zero TTL is configured. Evicted keys are released immediately; dropping the last
+	// reference destroys the platform key object, which wipes the key material.
+	class SessionKeyCache
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+		using TimeProvider = std::function<Clock::time_point()>;
+
+		explicit SessionKeyCache(TimeProvider timeProvider = nullptr)
+			: m_TimeProvider(timeProvider ? timeProvider : [] { return Clock::now(); }) {}
+
+		virtual ~SessionKeyCache();
+
+		// Applies new limits and drops every cached key.
+		virtual void Configure(std::chrono::seconds ttl, uint32_t maxEntries);
+
+		virtual bool IsEnabled() const;
+
+		// Returns nullptr when there is no live key for the tag.
+		virtual std::shared_ptr<SymmetricKey> Get(const std::string& tag);
+
+		// Changes on every Configure, Invalidate and Lock. A derivation reads it before it
+		// signs and hands it to Put, so that a key signed before the cache was cleared is
+		// never stored after it.
+		virtual uint64_t GetGeneration() const;
+
+		// Does nothing if the generation has changed since generation was read.
+		virtual void Put(const std::string& tag, const std::shared_ptr<SymmetricKey>& key, uint64_t generation);
+
+		virtual void Invalidate(const std::string& tag);
+
+		virtual void Lock();
+
+	private:
+		struct Entry
+		{
+			std::shared_ptr<SymmetricKey> key;
+			Clock::time_point expiresAt;
+			uint64_t lastAccess = 0;
+		};
+
+		using EntryMap = std::unordered_map<std::string, Entry>;
+
+		void EvictExpired(Clock::time_point now);
+
+		void EvictLeastRecentlyUsed();
+
+		void Evict(EntryMap::iterator it);
+
+		TimeProvider m_TimeProvider;
+
+		mutable std::mutex m_Mutex;
+		EntryMap m_Entries;
+		std::chrono::seconds m_Ttl{ 0 };
+		uint32_t m_MaxEntries = 0;
+		uint64_t m_AccessCounter = 0;
+		uint64_t m_Generation = 0;
+	};
+}  // namespace biometric_cipher
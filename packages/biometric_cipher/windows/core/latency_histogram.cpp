@@ -0,0 +1,90 @@
+#include "include/biometric_cipher/common/latency_histogram.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace biometric_cipher
+{
+	void LatencyHistogram::Record(std::chrono::nanoseconds duration)
+	{
+		auto nanoseconds = static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0));
+
+		m_Buckets[GetBucketIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+		m_TotalNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+		auto max = m_MaxNanoseconds.load(std::memory_order_relaxed);
+		while (nanoseconds > max
+			&& !m_MaxNanoseconds.compare_exchange_weak(max, nanoseconds, std::memory_order_relaxed)) {
+		}
+	}
+
+	LatencyHistogramSnapshot LatencyHistogram::GetSnapshot() const
+	{
+		std::array<uint64_t, BUCKET_COUNT> buckets;
+		LatencyHistogramSnapshot snapshot;
+		for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+			buckets[i] = m_Buckets[i].load(std::memory_order_relaxed);
+			snapshot.count += buckets[i];
+		}
+		snapshot.total = std::chrono::nanoseconds(m_TotalNanoseconds.load(std::memory_order_relaxed));
+		snapshot.max = std::chrono::nanoseconds(m_MaxNanoseconds.load(std::memory_order_relaxed));
+
+		if (snapshot.count == 0) {
+			return snapshot;
+		}
+
+		// The value below which the given share of the recorded values falls, reported as the
+		// upper bound of its bucket but never above the largest value seen.
+		auto percentile = [&](uint64_t perMille) {
+			auto rank = std::max<uint64_t>((snapshot.count * perMille + 999) / 1000, 1);
+			uint64_t seen = 0;
+			for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+				seen += buckets[i];
+				if (seen >= rank) {
+					auto bound = static_cast<int64_t>(GetBucketUpperBound(i));
+					return std::min(std::chrono::nanoseconds(bound), snapshot.max);
+				}
+			}
+
+			return snapshot.max;
+		};
+		snapshot.p50 = percentile(500);
+		snapshot.p90 = percentile(900);
+		snapshot.p99 = percentile(990);
+
+		return snapshot;
+	}
+
+	size_t LatencyHistogram::GetBucketIndex(uint64_t nanoseconds)
+	{
+		if (nanoseconds < SUB_BUCKET_COUNT) {
+			return static_cast<size_t>(nanoseconds);
+		}
+
+		auto exponent = static_cast<size_t>(std::bit_width(nanoseconds)) - 1;
+		if (exponent > MAX_EXPONENT) {
+			return BUCKET_COUNT - 1;
+		}
+
+		auto subBucket = static_cast<size_t>(nanoseconds >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKET_COUNT - 1);
+
+		return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT + subBucket;
+	}
+
+	uint64_t LatencyHistogram::GetBucketUpperBound(size_t index)
+	{
+		if (index < SUB_BUCKET_COUNT) {
+			return index;
+		}
+		if (index == BUCKET_COUNT - 1) {
+			return UINT64_MAX;
+		}
+
+		auto exponent = index / SUB_BUCKET_COUNT + SUB_BUCKET_BITS - 1;
+		auto subBucket = index % SUB_BUCKET_COUNT;
+		auto shift = exponent - SUB_BUCKET_BITS;
+		uint64_t lowerBound = (SUB_BUCKET_COUNT + subBucket) << shift;
+
+		return lowerBound + (uint64_t{ 1 } << shift) - 1;
+	}
+}
@@ -0,0 +1,20 @@
+#include "include/biometric_cipher/enums/method_name.h"
+#include "include/biometric_cipher/enums/method_schema.h"
+
+#include <algorithm>
+
+namespace biometric_cipher {
+	MethodName GetMethodName(std::string_view methodName)
+	{
+		auto it = std::lower_bound(
+			SORTED_METHOD_NAMES.begin(),
+			SORTED_METHOD_NAMES.end(),
+			methodName,
+			[](const auto& entry, std::string_view name) { return entry.first < name; });
+		if (it != SORTED_METHOD_NAMES.end() && it->first == methodName) {
+			return it->second;
+		}
+
+		return MethodName::kNotImplemented;
+	}
+}
@@ -0,0 +1,30 @@
+#include "include/biometric_cipher/enums/metrics_phase.h"
+
+namespace biometric_cipher
+{
+	std::string_view GetMetricsPhaseName(MetricsPhase phase)
+	{
+		switch (phase)
+		{
+		case MetricsPhase::kArgumentParsing:
+			return "argumentParsing";
+
+		case MetricsPhase::kHelloStatusCheck:
+			return "helloStatusCheck";
+
+		case MetricsPhase::kSignPrompt:
+			return "signPrompt";
+
+		case MetricsPhase::kKeyDerivation:
+			return "keyDerivation";
+
+		case MetricsPhase::kAesGcm:
+			return "aesGcm";
+
+		case MetricsPhase::kEncodingAndReply:
+			return "encodingAndReply";
+		}
+
+		return "unknown";
+	}
+}
@@ -0,0 +1,110 @@
+#include "include/biometric_cipher/common/metrics_registry.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace biometric_cipher
+{
+	namespace
+	{
+		constexpr ErrorCode kErrorCodes[] = {
+			error_fail,
+			error_invalid_argument,
+			error_no_key,
+			error_tpm_unsupported,
+			error_tpm_version,
+			error_biometry_not_supported,
+			error_configure,
+			error_generate_key,
+			error_key_not_found,
+			error_key_already_exists,
+			error_delete_key,
+			error_encrypt,
+			error_decrypt,
+			error_authentication_canceled,
+			error_user_prefers_password,
+			error_secure_device_locked,
+			error_converting_string,
+		};
+	}
+
+	void MetricsRegistry::RecordCall(MethodName method, std::chrono::nanoseconds latency)
+	{
+		auto& metrics = GetMethodMetrics(method);
+		metrics.calls.fetch_add(1, std::memory_order_relaxed);
+		metrics.latency.Record(latency);
+	}
+
+	void MetricsRegistry::RecordError(MethodName method, ErrorCode code)
+	{
+		GetMethodMetrics(method).errors.fetch_add(1, std::memory_order_relaxed);
+		m_Errors[GetErrorSlot(code)].fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void MetricsRegistry::RecordPhase(MetricsPhase phase, std::chrono::nanoseconds duration)
+	{
+		auto index = static_cast<size_t>(phase);
+		if (index < METRICS_PHASE_COUNT) {
+			m_Phases[index].Record(duration);
+		}
+	}
+
+	MetricsSnapshot MetricsRegistry::GetSnapshot() const
+	{
+		MetricsSnapshot snapshot;
+
+		for (size_t i = 0; i < m_Methods.size(); ++i) {
+			MethodMetricsSnapshot method;
+			method.method = static_cast<MethodName>(i);
+			method.calls = m_Methods[i].calls.load(std::memory_order_relaxed);
+			method.errors = m_Methods[i].errors.load(std::memory_order_relaxed);
+			if (method.calls == 0 && method.errors == 0) {
+				continue;
+			}
+			method.latency = m_Methods[i].latency.GetSnapshot();
+			snapshot.methods.push_back(std::move(method));
+		}
+
+		// Several codes reach Dart as UNKNOWN_ERROR, so the slots are merged by that string.
+		for (size_t slot = 0; slot < ERROR_SLOT_COUNT; ++slot) {
+			auto count = m_Errors[slot].load(std::memory_order_relaxed);
+			if (count == 0) {
+				continue;
+			}
+
+			auto code = slot < std::size(kErrorCodes) ? kErrorCodes[slot] : error_fail;
+			auto name = GetErrorCodeString(code);
+			auto it = std::find_if(snapshot.errors.begin(), snapshot.errors.end(), [&](const auto& entry) {
+				return entry.first == name;
+			});
+			if (it != snapshot.errors.end()) {
+				it->second += count;
+			}
+			else {
+				snapshot.errors.emplace_back(std::move(name), count);
+			}
+		}
+
+		for (size_t i = 0; i < METRICS_PHASE_COUNT; ++i) {
+			snapshot.phases[i] = m_Phases[i].GetSnapshot();
+		}
+
+		return snapshot;
+	}
+
+	size_t MetricsRegistry::GetErrorSlot(ErrorCode code)
+	{
+		static_assert(std::size(kErrorCodes) + 1 == ERROR_SLOT_COUNT, "Every error code needs a slot.");
+
+		auto it = std::find(std::begin(kErrorCodes), std::end(kErrorCodes), code);
+
+		return static_cast<size_t>(it - std::begin(kErrorCodes));
+	}
+
+	MetricsRegistry::MethodMetrics& MetricsRegistry::GetMethodMetrics(MethodName method)
+	{
+		auto index = std::min(static_cast<size_t>(method), METHOD_COUNT);
+
+		return m_Methods[index];
+	}
+}
@@ -0,0 +1,101 @@
+#include "include/biometric_cipher/common/parallel_runner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace biometric_cipher
+{
+	// Shared with the helpers, which may start after Run() has returned.
+	struct ParallelRunner::Job
+	{
+		const Item* item = nullptr;
+		size_t count = 0;
+		std::atomic<size_t> next{ 0 };
+		std::atomic<bool> isFailed{ false };
+
+		std::mutex mutex;
+		std::condition_variable helpersDone;
+		// Helpers running items; guarded by mutex.
+		size_t activeHelpers = 0;
+		// Set once the caller stops waiting: helpers that start later must not touch item.
+		bool isClosed = false;
+		std::exception_ptr error;
+	};
+
+	ParallelRunner::ParallelRunner(std::shared_ptr<Executor> executor, size_t helperCount)
+		: m_Executor(std::move(executor)),
+		m_HelperCount(m_Executor ? helperCount : 0)
+	{
+	}
+
+	void ParallelRunner::Run(size_t count, const Item& item) const
+	{
+		auto job = std::make_shared<Job>();
+		job->item = &item;
+		job->count = count;
+
+		// The caller takes one share itself.
+		auto helperCount = std::min(m_HelperCount, count > 0 ? count - 1 : 0);
+		for (size_t i = 0; i < helperCount; ++i) {
+			m_Executor->Post([job] {
+				{
+					std::lock_guard<std::mutex> lock(job->mutex);
+					if (job->isClosed) {
+						return;
+					}
+					++job->activeHelpers;
+				}
+
+				RunItems(*job);
+
+				std::lock_guard<std::mutex> lock(job->mutex);
+				if (--job->activeHelpers == 0) {
+					job->helpersDone.notify_one();
+				}
+			});
+		}
+
+		RunItems(*job);
+
+		std::unique_lock<std::mutex> lock(job->mutex);
+		job->isClosed = true;
+		job->helpersDone.wait(lock, [&job] { return job->activeHelpers == 0; });
+
+		if (job->error) {
+			std::rethrow_exception(job->error);
+		}
+	}
+
+	size_t ParallelRunner::GetDefaultHelperCount()
+	{
+		size_t hardwareThreads = std::thread::hardware_concurrency();
+
+		return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+	}
+
+	void ParallelRunner::RunItems(Job& job)
+	{
+		while (!job.isFailed.load(std::memory_order_relaxed)) {
+			auto index = job.next.fetch_add(1, std::memory_order_relaxed);
+			if (index >= job.count) {
+				break;
+			}
+
+			try {
+				(*job.item)(index);
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> lock(job.mutex);
+				if (!job.error) {
+					job.error = std::current_exception();
+				}
+				job.isFailed.store(true, std::memory_order_relaxed);
+			}
+		}
+	}
+}  // namespace biometric_cipher
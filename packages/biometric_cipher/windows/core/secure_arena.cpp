@@ -0,0 +1,186 @@
+#include "include/biometric_cipher/common/secure_arena.h"
+#include "include/biometric_cipher/common/secure_memory.h"
+
+#include <bit>
+#include <new>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace biometric_cipher
+{
+	static_assert(SecureArena::MAX_BLOCK_SIZE == SecureArena::MIN_BLOCK_SIZE << (SecureArena::SIZE_CLASS_COUNT - 1));
+
+	namespace
+	{
+		// Returns null if the system has no memory to map.
+		uint8_t* MapRegion(size_t size)
+		{
+#if defined(_WIN32)
+			return static_cast<uint8_t*>(VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+#else
+			void* region = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (region == MAP_FAILED) {
+				return nullptr;
+			}
+#if defined(MADV_DONTDUMP)
+			// Keep the secrets out of core dumps too.
+			madvise(region, size, MADV_DONTDUMP);
+#endif
+			return static_cast<uint8_t*>(region);
+#endif
+		}
+
+		bool LockRegion(uint8_t* region, size_t size)
+		{
+#if defined(_WIN32)
+			return VirtualLock(region, size) != FALSE;
+#else
+			return mlock(region, size) == 0;
+#endif
+		}
+
+		void UnmapRegion(uint8_t* region, size_t size, bool isLocked)
+		{
+#if defined(_WIN32)
+			if (isLocked) {
+				VirtualUnlock(region, size);
+			}
+			VirtualFree(region, 0, MEM_RELEASE);
+#else
+			if (isLocked) {
+				munlock(region, size);
+			}
+			munmap(region, size);
+#endif
+		}
+	}
+
+	SecureArena::SecureArena(size_t regionSize)
+	{
+		// Whole pages, so that the lock covers nothing but the arena.
+		regionSize = (regionSize + MAX_BLOCK_SIZE - 1) / MAX_BLOCK_SIZE * MAX_BLOCK_SIZE;
+		if (regionSize == 0) {
+			return;
+		}
+
+		m_Region = MapRegion(regionSize);
+		if (m_Region == nullptr) {
+			return;
+		}
+
+		m_RegionSize = regionSize;
+		m_IsLocked = LockRegion(m_Region, m_RegionSize);
+	}
+
+	SecureArena::~SecureArena()
+	{
+		if (m_Region != nullptr) {
+			SecureMemory::Zero(m_Region, m_RegionUsed);
+			UnmapRegion(m_Region, m_RegionSize, m_IsLocked);
+		}
+	}
+
+	SecureArena& SecureArena::Get()
+	{
+		// Never destroyed: SecureStrings in other static objects may be freed after it would be.
+		static auto* arena = new SecureArena();
+
+		return *arena;
+	}
+
+	void* SecureArena::Allocate(size_t size)
+	{
+		auto blockSize = GetBlockSize(size);
+		if (blockSize <= MAX_BLOCK_SIZE) {
+			auto sizeClass = GetSizeClass(blockSize);
+
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			if (auto* block = m_FreeLists[sizeClass]) {
+				m_FreeLists[sizeClass] = block->next;
+				block->next = nullptr;
+				m_BytesInUse += blockSize;
+
+				return block;
+			}
+			if (m_RegionSize - m_RegionUsed >= blockSize) {
+				auto* block = m_Region + m_RegionUsed;
+				m_RegionUsed += blockSize;
+				m_BytesInUse += blockSize;
+
+				return block;
+			}
+			++m_HeapAllocations;
+		}
+		else {
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			++m_HeapAllocations;
+		}
+
+		return ::operator new(size);
+	}
+
+	void SecureArena::Deallocate(void* block, size_t size) noexcept
+	{
+		if (block == nullptr) {
+			return;
+		}
+
+		if (!IsInRegion(block)) {
+			SecureMemory::Zero(block, size);
+			::operator delete(block);
+			return;
+		}
+
+		auto blockSize = GetBlockSize(size);
+		SecureMemory::Zero(block, blockSize);
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		auto* freeBlock = static_cast<FreeBlock*>(block);
+		auto sizeClass = GetSizeClass(blockSize);
+		freeBlock->next = m_FreeLists[sizeClass];
+		m_FreeLists[sizeClass] = freeBlock;
+		m_BytesInUse -= blockSize;
+	}
+
+	SecureArena::Stats SecureArena::GetStats() const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		Stats stats;
+		stats.regionSize = m_RegionSize;
+		stats.isLocked = m_IsLocked;
+		stats.bytesInUse = m_BytesInUse;
+		stats.heapAllocations = m_HeapAllocations;
+
+		return stats;
+	}
+
+	size_t SecureArena::GetBlockSize(size_t size)
+	{
+		if (size <= MIN_BLOCK_SIZE) {
+			return MIN_BLOCK_SIZE;
+		}
+		if (size > MAX_BLOCK_SIZE) {
+			return size;
+		}
+
+		return std::bit_ceil(size);
+	}
+
+	size_t SecureArena::GetSizeClass(size_t blockSize)
+	{
+		return static_cast<size_t>(std::countr_zero(blockSize) - std::countr_zero(MIN_BLOCK_SIZE));
+	}
+
+	bool SecureArena::IsInRegion(const void* block) const
+	{
+		auto address = reinterpret_cast<uintptr_t>(block);
+		auto region = reinterpret_cast<uintptr_t>(m_Region);
+
+		return m_Region != nullptr && address >= region && address < region + m_RegionSize;
+	}
+}
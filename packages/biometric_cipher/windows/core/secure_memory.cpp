@@ -0,0 +1,12 @@
+#include "include/biometric_cipher/common/secure_memory.h"
+
+namespace biometric_cipher
+{
+	void SecureMemory::Zero(void* data, size_t length)
+	{
+		auto* bytes = static_cast<volatile unsigned char*>(data);
+		for (size_t i = 0; i < length; ++i) {
+			bytes[i] = 0;
+		}
+	}
+}  // namespace biometric_cipher
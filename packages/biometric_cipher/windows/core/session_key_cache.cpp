@@ -0,0 +1,138 @@
+#include "include/biometric_cipher/storages/session_key_cache.h"
+
+#include <iterator>
+
+namespace biometric_cipher
+{
+	SessionKeyCache::~SessionKeyCache()
+	{
+		Lock();
+	}
+
+	void SessionKeyCache::Configure(std::chrono::seconds ttl, uint32_t maxEntries)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		while (!m_Entries.empty()) {
+			Evict(m_Entries.begin());
+		}
+
+		++m_Generation;
+		m_Ttl = ttl;
+		m_MaxEntries = maxEntries;
+	}
+
+	bool SessionKeyCache::IsEnabled() const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		return m_Ttl.count() > 0 && m_MaxEntries > 0;
+	}
+
+	std::shared_ptr<SymmetricKey> SessionKeyCache::Get(const std::string& tag)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		EvictExpired(m_TimeProvider());
+
+		auto it = m_Entries.find(tag);
+		if (it == m_Entries.end()) {
+			return nullptr;
+		}
+
+		it->second.lastAccess = ++m_AccessCounter;
+
+		return it->second.key;
+	}
+
+	uint64_t SessionKeyCache::GetGeneration() const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		return m_Generation;
+	}
+
+	void SessionKeyCache::Put(const std::string& tag, const std::shared_ptr<SymmetricKey>& key, uint64_t generation)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		if (generation != m_Generation || m_Ttl.count() <= 0 || m_MaxEntries == 0) {
+			return;
+		}
+
+		auto now = m_TimeProvider();
+		EvictExpired(now);
+
+		auto it = m_Entries.find(tag);
+		if (it != m_Entries.end()) {
+			Evict(it);
+		}
+
+		while (m_Entries.size() >= m_MaxEntries) {
+			EvictLeastRecentlyUsed();
+		}
+
+		Entry entry;
+		entry.key = key;
+		entry.expiresAt = now + m_Ttl;
+		entry.lastAccess = ++m_AccessCounter;
+
+		m_Entries.emplace(tag, std::move(entry));
+	}
+
+	void SessionKeyCache::Invalidate(const std::string& tag)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		auto it = m_Entries.find(tag);
+		if (it != m_Entries.end()) {
+			Evict(it);
+		}
+
+		// One counter for all tags: a pending derivation for another tag is refused too,
+		// which only costs it a prompt on its next call.
+		++m_Generation;
+	}
+
+	void SessionKeyCache::Lock()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		while (!m_Entries.empty()) {
+			Evict(m_Entries.begin());
+		}
+
+		++m_Generation;
+	}
+
+	void SessionKeyCache::EvictExpired(Clock::time_point now)
+	{
+		for (auto it = m_Entries.begin(); it != m_Entries.end();) {
+			auto next = std::next(it);
+			if (it->second.expiresAt <= now) {
+				Evict(it);
+			}
+			it = next;
+		}
+	}
+
+	void SessionKeyCache::EvictLeastRecentlyUsed()
+	{
+		auto oldest = m_Entries.begin();
+		for (auto it = m_Entries.begin(); it != m_Entries.end(); ++it) {
+			if (it->second.lastAccess < oldest->second.lastAccess) {
+				oldest = it;
+			}
+		}
+
+		if (oldest != m_Entries.end()) {
+			Evict(oldest);
+		}
+	}
+
+	void SessionKeyCache::Evict(EntryMap::iterator it)
+	{
+		it->second.key.reset();
+		m_Entries.erase(it);
+	}
+}  // namespace biometric_cipher
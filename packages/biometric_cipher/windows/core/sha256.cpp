@@ -0,0 +1,693 @@
+#include "include/biometric_cipher/common/sha256.h"
+#include "include/biometric_cipher/common/cpu_features.h"
+#include "include/biometric_cipher/common/secure_memory.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#if defined(BIOMETRIC_CIPHER_X86)
+#include <immintrin.h>
+#endif
+
+namespace biometric_cipher
+{
+	namespace
+	{
+		constexpr size_t kBlockLength = Sha256::BLOCK_LENGTH;
+
+		// The length is appended to the message as a 64-bit big-endian number of bits.
+		constexpr size_t kLengthFieldLength = 8;
+
+		constexpr size_t kLaneCount = 8;
+
+		constexpr uint32_t kInitialState[8] = {
+			0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+		};
+
+		alignas(16) constexpr uint32_t kRoundConstants[64] = {
+			0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+			0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+			0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+			0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+			0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+			0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+			0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+			0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+		};
+
+		uint32_t LoadBigEndian32(const uint8_t* bytes)
+		{
+			return (static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16) |
+				(static_cast<uint32_t>(bytes[2]) << 8) | static_cast<uint32_t>(bytes[3]);
+		}
+
+		void StoreBigEndian32(uint32_t value, uint8_t* bytes)
+		{
+			bytes[0] = static_cast<uint8_t>(value >> 24);
+			bytes[1] = static_cast<uint8_t>(value >> 16);
+			bytes[2] = static_cast<uint8_t>(value >> 8);
+			bytes[3] = static_cast<uint8_t>(value);
+		}
+
+		void StoreBigEndian64(uint64_t value, uint8_t* bytes)
+		{
+			StoreBigEndian32(static_cast<uint32_t>(value >> 32), bytes);
+			StoreBigEndian32(static_cast<uint32_t>(value), bytes + 4);
+		}
+
+		void StoreDigest(const uint32_t* state, uint8_t* digest)
+		{
+			for (int i = 0; i < 8; ++i) {
+				StoreBigEndian32(state[i], digest + 4 * i);
+			}
+		}
+
+		// Writes the last one or two blocks of a message: the bytes after its last full
+		// block, the 0x80 marker, zeros and the length. Returns the number of blocks.
+		size_t PadFinalBlocks(const uint8_t* rest, size_t restLength, uint64_t messageLength, uint8_t* blocks)
+		{
+			size_t blockCount = restLength + 1 + kLengthFieldLength > kBlockLength ? 2 : 1;
+			size_t paddedLength = blockCount * kBlockLength;
+			if (restLength > 0) {
+				std::memcpy(blocks, rest, restLength);
+			}
+			blocks[restLength] = 0x80;
+			std::memset(blocks + restLength + 1, 0, paddedLength - restLength - 1 - kLengthFieldLength);
+			StoreBigEndian64(messageLength * 8, blocks + paddedLength - kLengthFieldLength);
+
+			return blockCount;
+		}
+
+		// === Scalar implementation ===
+
+		void CompressScalar(uint32_t* state, const uint8_t* blocks, size_t blockCount)
+		{
+			uint32_t schedule[64];
+			for (size_t block = 0; block < blockCount; ++block, blocks += kBlockLength) {
+				for (int t = 0; t < 16; ++t) {
+					schedule[t] = LoadBigEndian32(blocks + 4 * t);
+				}
+				for (int t = 16; t < 64; ++t) {
+					uint32_t w15 = schedule[t - 15];
+					uint32_t w2 = schedule[t - 2];
+					uint32_t sigma0 = std::rotr(w15, 7) ^ std::rotr(w15, 18) ^ (w15 >> 3);
+					uint32_t sigma1 = std::rotr(w2, 17) ^ std::rotr(w2, 19) ^ (w2 >> 10);
+					schedule[t] = schedule[t - 16] + sigma0 + schedule[t - 7] + sigma1;
+				}
+
+				uint32_t a = state[0];
+				uint32_t b = state[1];
+				uint32_t c = state[2];
+				uint32_t d = state[3];
+				uint32_t e = state[4];
+				uint32_t f = state[5];
+				uint32_t g = state[6];
+				uint32_t h = state[7];
+				for (int t = 0; t < 64; ++t) {
+					uint32_t sum1 = std::rotr(e, 6) ^ std::rotr(e, 11) ^ std::rotr(e, 25);
+					uint32_t choice = (e & f) ^ (~e & g);
+					uint32_t temp1 = h + sum1 + choice + kRoundConstants[t] + schedule[t];
+					uint32_t sum0 = std::rotr(a, 2) ^ std::rotr(a, 13) ^ std::rotr(a, 22);
+					uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+					uint32_t temp2 = sum0 + majority;
+					h = g;
+					g = f;
+					f = e;
+					e = d + temp1;
+					d = c;
+					c = b;
+					b = a;
+					a = temp1 + temp2;
+				}
+
+				state[0] += a;
+				state[1] += b;
+				state[2] += c;
+				state[3] += d;
+				state[4] += e;
+				state[5] += f;
+				state[6] += g;
+				state[7] += h;
+			}
+			SecureMemory::Zero(schedule, sizeof(schedule));
+		}
+
+#if defined(BIOMETRIC_CIPHER_X86)
+		// === SHA extensions ===
+
+		// SHA256RNDS2 keeps the state as two registers, ABEF and CDGH, and runs two rounds
+		// per instruction; SHA256MSG1/2 compute the message schedule four words at a time.
+
+		BIOMETRIC_CIPHER_TARGET("sha,ssse3,sse4.1")
+		inline void RoundsShaNi(__m128i& abef, __m128i& cdgh, __m128i message, int group)
+		{
+			auto roundConstants = _mm_load_si128(reinterpret_cast<const __m128i*>(kRoundConstants + 4 * group));
+			auto words = _mm_add_epi32(message, roundConstants);
+			cdgh = _mm_sha256rnds2_epu32(cdgh, abef, words);
+			words = _mm_shuffle_epi32(words, 0x0E);
+			abef = _mm_sha256rnds2_epu32(abef, cdgh, words);
+		}
+
+		// The four schedule words after current, from the partially computed next ones.
+		BIOMETRIC_CIPHER_TARGET("sha,ssse3,sse4.1")
+		inline __m128i NextMessageShaNi(__m128i next, __m128i previous, __m128i current)
+		{
+			next = _mm_add_epi32(next, _mm_alignr_epi8(current, previous, 4));
+
+			return _mm_sha256msg2_epu32(next, current);
+		}
+
+		BIOMETRIC_CIPHER_TARGET("sha,ssse3,sse4.1")
+		void CompressShaNi(uint32_t* state, const uint8_t* blocks, size_t blockCount)
+		{
+			const auto byteSwapMask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+			auto dcba = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state));
+			auto hgfe = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4));
+			auto cdab = _mm_shuffle_epi32(dcba, 0xB1);
+			auto efgh = _mm_shuffle_epi32(hgfe, 0x1B);
+			auto abef = _mm_alignr_epi8(cdab, efgh, 8);
+			auto cdgh = _mm_blend_epi16(efgh, cdab, 0xF0);
+
+			for (size_t block = 0; block < blockCount; ++block, blocks += kBlockLength) {
+				auto savedAbef = abef;
+				auto savedCdgh = cdgh;
+
+				const auto* words = reinterpret_cast<const __m128i*>(blocks);
+				auto message0 = _mm_shuffle_epi8(_mm_loadu_si128(words), byteSwapMask);
+				auto message1 = _mm_shuffle_epi8(_mm_loadu_si128(words + 1), byteSwapMask);
+				auto message2 = _mm_shuffle_epi8(_mm_loadu_si128(words + 2), byteSwapMask);
+				auto message3 = _mm_shuffle_epi8(_mm_loadu_si128(words + 3), byteSwapMask);
+
+				RoundsShaNi(abef, cdgh, message0, 0);
+				RoundsShaNi(abef, cdgh, message1, 1);
+				message0 = _mm_sha256msg1_epu32(message0, message1);
+				RoundsShaNi(abef, cdgh, message2, 2);
+				message1 = _mm_sha256msg1_epu32(message1, message2);
+				RoundsShaNi(abef, cdgh, message3, 3);
+				message0 = NextMessageShaNi(message0, message2, message3);
+				message2 = _mm_sha256msg1_epu32(message2, message3);
+
+				for (int group = 4; group < 12; group += 4) {
+					RoundsShaNi(abef, cdgh, message0, group);
+					message1 = NextMessageShaNi(message1, message3, message0);
+					message3 = _mm_sha256msg1_epu32(message3, message0);
+					RoundsShaNi(abef, cdgh, message1, group + 1);
+					message2 = NextMessageShaNi(message2, message0, message1);
+					message0 = _mm_sha256msg1_epu32(message0, message1);
+					RoundsShaNi(abef, cdgh, message2, group + 2);
+					message3 = NextMessageShaNi(message3, message1, message2);
+					message1 = _mm_sha256msg1_epu32(message1, message2);
+					RoundsShaNi(abef, cdgh, message3, group + 3);
+					message0 = NextMessageShaNi(message0, message2, message3);
+					message2 = _mm_sha256msg1_epu32(message2, message3);
+				}
+
+				RoundsShaNi(abef, cdgh, message0, 12);
+				message1 = NextMessageShaNi(message1, message3, message0);
+				message3 = _mm_sha256msg1_epu32(message3, message0);
+				RoundsShaNi(abef, cdgh, message1, 13);
+				message2 = NextMessageShaNi(message2, message0, message1);
+				RoundsShaNi(abef, cdgh, message2, 14);
+				message3 = NextMessageShaNi(message3, message1, message2);
+				RoundsShaNi(abef, cdgh, message3, 15);
+
+				abef = _mm_add_epi32(abef, savedAbef);
+				cdgh = _mm_add_epi32(cdgh, savedCdgh);
+			}
+
+			auto feba = _mm_shuffle_epi32(abef, 0x1B);
+			auto dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+			dcba = _mm_blend_epi16(feba, dchg, 0xF0);
+			hgfe = _mm_alignr_epi8(dchg, feba, 8);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(state), dcba);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), hgfe);
+		}
+
+		// === AVX2, eight messages at once ===
+
+		// Lane i of every register belongs to message i. Lanes whose message has no block
+		// left are given a dummy block and keep their state.
+
+		struct LaneStates
+		{
+			__m256i words[8];
+		};
+
+		BIOMETRIC_CIPHER_TARGET("avx2")
+		inline __m256i RotateRightAvx2(__m256i value, int count)
+		{
+			return _mm256_or_si256(_mm256_srli_epi32(value, count), _mm256_slli_epi32(value, 32 - count));
+		}
+
+		// Loads eight words from each lane's block and transposes them, so that register t
+		// holds word t of every lane.
+		BIOMETRIC_CIPHER_TARGET("avx2")
+		void LoadTransposedAvx2(const uint8_t* const* blocks, size_t offset, __m256i* words)
+		{
+			const auto byteSwapMask = _mm256_set_epi64x(
+				0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL, 0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+			__m256i rows[kLaneCount];
+			for (size_t lane = 0; lane < kLaneCount; ++lane) {
+				rows[lane] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blocks[lane] + offset));
+			}
+
+			auto t0 = _mm256_unpacklo_epi32(rows[0], rows[1]);
+			auto t1 = _mm256_unpackhi_epi32(rows[0], rows[1]);
+			auto t2 = _mm256_unpacklo_epi32(rows[2], rows[3]);
+			auto t3 = _mm256_unpackhi_epi32(rows[2], rows[3]);
+			auto t4 = _mm256_unpacklo_epi32(rows[4], rows[5]);
+			auto t5 = _mm256_unpackhi_epi32(rows[4], rows[5]);
+			auto t6 = _mm256_unpacklo_epi32(rows[6], rows[7]);
+			auto t7 = _mm256_unpackhi_epi32(rows[6], rows[7]);
+
+			auto u0 = _mm256_unpacklo_epi64(t0, t2);
+			auto u1 = _mm256_unpackhi_epi64(t0, t2);
+			auto u2 = _mm256_unpacklo_epi64(t1, t3);
+			auto u3 = _mm256_unpackhi_epi64(t1, t3);
+			auto u4 = _mm256_unpacklo_epi64(t4, t6);
+			auto u5 = _mm256_unpackhi_epi64(t4, t6);
+			auto u6 = _mm256_unpacklo_epi64(t5, t7);
+			auto u7 = _mm256_unpackhi_epi64(t5, t7);
+
+			words[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+			words[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+			words[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+			words[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+			words[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+			words[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+			words[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+			words[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+			for (int t = 0; t < 8; ++t) {
+				words[t] = _mm256_shuffle_epi8(words[t], byteSwapMask);
+			}
+		}
+
+		BIOMETRIC_CIPHER_TARGET("avx2")
+		void CompressAvx2x8(LaneStates& states, const uint8_t* const* blocks, __m256i activeLanes)
+		{
+			__m256i schedule[16];
+			LoadTransposedAvx2(blocks, 0, schedule);
+			LoadTransposedAvx2(blocks, 32, schedule + 8);
+
+			auto a = states.words[0];
+			auto b = states.words[1];
+			auto c = states.words[2];
+			auto d = states.words[3];
+			auto e = states.words[4];
+			auto f = states.words[5];
+			auto g = states.words[6];
+			auto h = states.words[7];
+			for (int t = 0; t < 64; ++t) {
+				if (t >= 16) {
+					auto w15 = schedule[(t - 15) & 15];
+					auto w2 = schedule[(t - 2) & 15];
+					auto sigma0 = _mm256_xor_si256(
+						_mm256_xor_si256(RotateRightAvx2(w15, 7), RotateRightAvx2(w15, 18)), _mm256_srli_epi32(w15, 3));
+					auto sigma1 = _mm256_xor_si256(
+						_mm256_xor_si256(RotateRightAvx2(w2, 17), RotateRightAvx2(w2, 19)), _mm256_srli_epi32(w2, 10));
+					schedule[t & 15] = _mm256_add_epi32(
+						_mm256_add_epi32(schedule[t & 15], sigma0), _mm256_add_epi32(schedule[(t - 7) & 15], sigma1));
+				}
+
+				auto sum1 = _mm256_xor_si256(
+					_mm256_xor_si256(RotateRightAvx2(e, 6), RotateRightAvx2(e, 11)), RotateRightAvx2(e, 25));
+				auto choice = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+				auto temp1 = _mm256_add_epi32(
+					_mm256_add_epi32(h, sum1),
+					_mm256_add_epi32(
+						_mm256_add_epi32(choice, _mm256_set1_epi32(static_cast<int>(kRoundConstants[t]))),
+						schedule[t & 15]));
+				auto sum0 = _mm256_xor_si256(
+					_mm256_xor_si256(RotateRightAvx2(a, 2), RotateRightAvx2(a, 13)), RotateRightAvx2(a, 22));
+				auto majority = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+				auto temp2 = _mm256_add_epi32(sum0, majority);
+				h = g;
+				g = f;
+				f = e;
+				e = _mm256_add_epi32(d, temp1);
+				d = c;
+				c = b;
+				b = a;
+				a = _mm256_add_epi32(temp1, temp2);
+			}
+
+			const __m256i results[8] = { a, b, c, d, e, f, g, h };
+			for (int i = 0; i < 8; ++i) {
+				auto updated = _mm256_add_epi32(states.words[i], results[i]);
+				states.words[i] = _mm256_blendv_epi8(states.words[i], updated, activeLanes);
+			}
+		}
+
+		// Hashes up to eight messages, one per lane.
+		BIOMETRIC_CIPHER_TARGET("avx2")
+		void HashLanesAvx2(const uint8_t* const* data, const size_t* lengths, size_t count, uint8_t* const* digests)
+		{
+			alignas(32) static constexpr uint8_t kDummyBlock[kBlockLength] = {};
+
+			uint8_t finalBlocks[kLaneCount][2 * kBlockLength];
+			size_t fullBlockCounts[kLaneCount] = {};
+			size_t blockCounts[kLaneCount] = {};
+			size_t maxBlockCount = 0;
+			for (size_t lane = 0; lane < count; ++lane) {
+				fullBlockCounts[lane] = lengths[lane] / kBlockLength;
+				size_t fullLength = fullBlockCounts[lane] * kBlockLength;
+				blockCounts[lane] = fullBlockCounts[lane] +
+					PadFinalBlocks(data[lane] + fullLength, lengths[lane] - fullLength, lengths[lane], finalBlocks[lane]);
+				maxBlockCount = std::max(maxBlockCount, blockCounts[lane]);
+			}
+
+			LaneStates states;
+			for (int i = 0; i < 8; ++i) {
+				states.words[i] = _mm256_set1_epi32(static_cast<int>(kInitialState[i]));
+			}
+
+			const uint8_t* blocks[kLaneCount];
+			alignas(32) int32_t activeLanes[kLaneCount];
+			for (size_t block = 0; block < maxBlockCount; ++block) {
+				for (size_t lane = 0; lane < kLaneCount; ++lane) {
+					bool active = lane < count && block < blockCounts[lane];
+					activeLanes[lane] = active ? -1 : 0;
+					if (!active) {
+						blocks[lane] = kDummyBlock;
+					}
+					else if (block < fullBlockCounts[lane]) {
+						blocks[lane] = data[lane] + block * kBlockLength;
+					}
+					else {
+						blocks[lane] = finalBlocks[lane] + (block - fullBlockCounts[lane]) * kBlockLength;
+					}
+				}
+				CompressAvx2x8(states, blocks, _mm256_load_si256(reinterpret_cast<const __m256i*>(activeLanes)));
+			}
+
+			alignas(32) uint32_t words[8][kLaneCount];
+			for (int i = 0; i < 8; ++i) {
+				_mm256_store_si256(reinterpret_cast<__m256i*>(words[i]), states.words[i]);
+			}
+			for (size_t lane = 0; lane < count; ++lane) {
+				for (int i = 0; i < 8; ++i) {
+					StoreBigEndian32(words[i][lane], digests[lane] + 4 * i);
+				}
+			}
+			SecureMemory::Zero(finalBlocks, sizeof(finalBlocks));
+			SecureMemory::Zero(words, sizeof(words));
+		}
+
+		void HashManyAvx2(const uint8_t* const* data, const size_t* lengths, size_t count, uint8_t* digests)
+		{
+			// Messages of similar length share a group, so that few lanes sit idle.
+			std::vector<size_t> order(count);
+			std::iota(order.begin(), order.end(), size_t{ 0 });
+			std::stable_sort(order.begin(), order.end(), [lengths](size_t left, size_t right) {
+				return lengths[left] > lengths[right];
+			});
+
+			for (size_t first = 0; first < count; first += kLaneCount) {
+				size_t laneCount = std::min(kLaneCount, count - first);
+				const uint8_t* laneData[kLaneCount];
+				size_t laneLengths[kLaneCount];
+				uint8_t* laneDigests[kLaneCount];
+				for (size_t lane = 0; lane < laneCount; ++lane) {
+					auto index = order[first + lane];
+					laneData[lane] = data[index];
+					laneLengths[lane] = lengths[index];
+					laneDigests[lane] = digests + index * Sha256::DIGEST_LENGTH;
+				}
+				HashLanesAvx2(laneData, laneLengths, laneCount, laneDigests);
+			}
+		}
+#endif
+
+		// === Dispatch ===
+
+		bool HasShaNi(const CpuFeatures& features)
+		{
+			return features.sha && features.ssse3 && features.sse41;
+		}
+
+		void Compress(Sha256::Implementation implementation, uint32_t* state, const uint8_t* blocks, size_t blockCount)
+		{
+#if defined(BIOMETRIC_CIPHER_X86)
+			if (implementation == Sha256::Implementation::kShaNi) {
+				CompressShaNi(state, blocks, blockCount);
+				return;
+			}
+#endif
+			CompressScalar(state, blocks, blockCount);
+		}
+	}
+
+	Sha256::Implementation Sha256::GetBestImplementation()
+	{
+		return Clamp(Implementation::kShaNi);
+	}
+
+	Sha256::Implementation Sha256::Clamp(Implementation requested)
+	{
+		// Not a plain minimum: some CPUs have the SHA extensions but no AVX2.
+		const auto& features = CpuFeatures::Get();
+		if (requested >= Implementation::kShaNi && HasShaNi(features)) {
+			return Implementation::kShaNi;
+		}
+		if (requested >= Implementation::kAvx2 && features.avx2) {
+			return Implementation::kAvx2;
+		}
+
+		return Implementation::kScalar;
+	}
+
+	void Sha256::Hash(const uint8_t* data, size_t length, uint8_t* digest, Implementation implementation)
+	{
+		Sha256 context(implementation);
+		context.Update(data, length);
+		context.Final(digest);
+	}
+
+	void Sha256::HashMany(
+		const uint8_t* const* data,
+		const size_t* lengths,
+		size_t count,
+		uint8_t* digests,
+		Implementation implementation)
+	{
+		implementation = Clamp(implementation);
+#if defined(BIOMETRIC_CIPHER_X86)
+		if (implementation == Implementation::kAvx2) {
+			HashManyAvx2(data, lengths, count, digests);
+			return;
+		}
+#endif
+		for (size_t i = 0; i < count; ++i) {
+			Hash(data[i], lengths[i], digests + i * DIGEST_LENGTH, implementation);
+		}
+	}
+
+	Sha256::Sha256(Implementation implementation)
+		: m_Implementation(Clamp(implementation))
+	{
+		Reset();
+	}
+
+	Sha256::~Sha256()
+	{
+		SecureMemory::Zero(m_State, sizeof(m_State));
+		SecureMemory::Zero(m_Buffer, sizeof(m_Buffer));
+	}
+
+	void Sha256::Update(const uint8_t* data, size_t length)
+	{
+		if (length == 0) {
+			return;
+		}
+
+		m_MessageLength += length;
+		if (m_BufferLength > 0) {
+			size_t copied = std::min(length, BLOCK_LENGTH - m_BufferLength);
+			std::memcpy(m_Buffer + m_BufferLength, data, copied);
+			m_BufferLength += copied;
+			data += copied;
+			length -= copied;
+			if (m_BufferLength < BLOCK_LENGTH) {
+				return;
+			}
+			Compress(m_Implementation, m_State, m_Buffer, 1);
+			m_BufferLength = 0;
+		}
+
+		size_t blockCount = length / BLOCK_LENGTH;
+		if (blockCount > 0) {
+			Compress(m_Implementation, m_State, data, blockCount);
+			data += blockCount * BLOCK_LENGTH;
+			length -= blockCount * BLOCK_LENGTH;
+		}
+		if (length > 0) {
+			std::memcpy(m_Buffer, data, length);
+			m_BufferLength = length;
+		}
+	}
+
+	void Sha256::Final(uint8_t* digest)
+	{
+		uint8_t finalBlocks[2 * BLOCK_LENGTH];
+		auto blockCount = PadFinalBlocks(m_Buffer, m_BufferLength, m_MessageLength, finalBlocks);
+		Compress(m_Implementation, m_State, finalBlocks, blockCount);
+		StoreDigest(m_State, digest);
+		SecureMemory::Zero(finalBlocks, sizeof(finalBlocks));
+		Reset();
+	}
+
+	Sha256::Implementation Sha256::GetImplementation() const
+	{
+		return m_Implementation;
+	}
+
+	void Sha256::Reset()
+	{
+		std::copy(std::begin(kInitialState), std::end(kInitialState), m_State);
+		SecureMemory::Zero(m_Buffer, sizeof(m_Buffer));
+		m_BufferLength = 0;
+		m_MessageLength = 0;
+	}
+
+	void HmacSha256::Compute(
+		const uint8_t* key,
+		size_t keyLength,
+		const uint8_t* data,
+		size_t length,
+		uint8_t* mac,
+		Sha256::Implementation implementation)
+	{
+		HmacSha256 hmac(key, keyLength, implementation);
+		hmac.Update(data, length);
+		hmac.Final(mac);
+	}
+
+	bool HmacSha256::Verify(
+		const uint8_t* key,
+		size_t keyLength,
+		const uint8_t* data,
+		size_t length,
+		const uint8_t* expectedMac,
+		Sha256::Implementation implementation)
+	{
+		uint8_t mac[MAC_LENGTH];
+		Compute(key, keyLength, data, length, mac, implementation);
+
+		uint8_t difference = 0;
+		for (size_t i = 0; i < MAC_LENGTH; ++i) {
+			difference |= mac[i] ^ expectedMac[i];
+		}
+		SecureMemory::Zero(mac, sizeof(mac));
+
+		return difference == 0;
+	}
+
+	HmacSha256::HmacSha256(const uint8_t* key, size_t keyLength, Sha256::Implementation implementation)
+		: m_InnerStart(implementation),
+		m_OuterStart(implementation),
+		m_Inner(implementation)
+	{
+		// Keys longer than a block are hashed first; shorter ones are padded with zeros.
+		uint8_t block[Sha256::BLOCK_LENGTH] = {};
+		if (keyLength > Sha256::BLOCK_LENGTH) {
+			Sha256::Hash(key, keyLength, block, implementation);
+		}
+		else if (keyLength > 0) {
+			std::memcpy(block, key, keyLength);
+		}
+
+		for (auto& byte : block) {
+			byte ^= 0x36;
+		}
+		m_InnerStart.Update(block, sizeof(block));
+		for (auto& byte : block) {
+			byte ^= 0x36 ^ 0x5c;
+		}
+		m_OuterStart.Update(block, sizeof(block));
+		SecureMemory::Zero(block, sizeof(block));
+
+		m_Inner = m_InnerStart;
+	}
+
+	void HmacSha256::Update(const uint8_t* data, size_t length)
+	{
+		m_Inner.Update(data, length);
+	}
+
+	void HmacSha256::Final(uint8_t* mac)
+	{
+		uint8_t innerDigest[Sha256::DIGEST_LENGTH];
+		m_Inner.Final(innerDigest);
+
+		auto outer = m_OuterStart;
+		outer.Update(innerDigest, sizeof(innerDigest));
+		outer.Final(mac);
+		SecureMemory::Zero(innerDigest, sizeof(innerDigest));
+
+		m_Inner = m_InnerStart;
+	}
+
+	void HkdfSha256::Extract(
+		const uint8_t* salt,
+		size_t saltLength,
+		const uint8_t* secret,
+		size_t secretLength,
+		uint8_t* prk)
+	{
+		HmacSha256::Compute(salt, saltLength, secret, secretLength, prk);
+	}
+
+	void HkdfSha256::Expand(
+		const uint8_t* prk,
+		const uint8_t* info,
+		size_t infoLength,
+		uint8_t* output,
+		size_t length)
+	{
+		if (length > MAX_OUTPUT_LENGTH) {
+			throw BiometricCipherException(error_invalid_argument, "HKDF output is too long.");
+		}
+
+		// T(i) = HMAC(PRK, T(i - 1) | info | i), with T(0) empty.
+		HmacSha256 hmac(prk, PRK_LENGTH);
+		uint8_t block[HmacSha256::MAC_LENGTH];
+		uint8_t counter = 1;
+		for (size_t offset = 0; offset < length; offset += sizeof(block), ++counter) {
+			if (offset > 0) {
+				hmac.Update(block, sizeof(block));
+			}
+			hmac.Update(info, infoLength);
+			hmac.Update(&counter, 1);
+			hmac.Final(block);
+
+			std::copy_n(block, std::min(sizeof(block), length - offset), output + offset);
+		}
+		SecureMemory::Zero(block, sizeof(block));
+	}
+
+	void HkdfSha256::Derive(
+		const uint8_t* salt,
+		size_t saltLength,
+		const uint8_t* secret,
+		size_t secretLength,
+		const uint8_t* info,
+		size_t infoLength,
+		uint8_t* output,
+		size_t length)
+	{
+		if (length > MAX_OUTPUT_LENGTH) {
+			throw BiometricCipherException(error_invalid_argument, "HKDF output is too long.");
+		}
+
+		uint8_t prk[PRK_LENGTH];
+		Extract(salt, saltLength, secret, secretLength, prk);
+		Expand(prk, info, infoLength, output, length);
+		SecureMemory::Zero(prk, sizeof(prk));
+	}
+}  // namespace biometric_cipher
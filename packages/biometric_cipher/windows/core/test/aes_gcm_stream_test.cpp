@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "include/biometric_cipher/common/thread_pool_executor.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+
+// Include the code under test
+#include "include/biometric_cipher/common/aes_gcm_stream.h"
+
+namespace biometric_cipher {
+	namespace test {
+
+		using namespace biometric_cipher;
+
+		class AesGcmStreamTest : public ::testing::Test {
+		protected:
+			static const uint32_t SEGMENT_LENGTH = 32;
+
+			std::shared_ptr<const AesGcmKey> m_Key;
+			uint8_t m_BaseNonce[AesGcm::NONCE_LENGTH] = {};
+
+			void SetUp() override
+			{
+				uint8_t key[AesGcm::KEY_LENGTH];
+				for (size_t i = 0; i < AesGcm::KEY_LENGTH; ++i) {
+					key[i] = static_cast<uint8_t>(i * 3 + 1);
+				}
+				m_Key = std::make_shared<const AesGcmKey>(key);
+
+				for (size_t i = 0; i < AesGcm::NONCE_LENGTH; ++i) {
+					m_BaseNonce[i] = static_cast<uint8_t>(0xA0 + i);
+				}
+			}
+
+			static std::vector<uint8_t> MakePayload(size_t size)
+			{
+				std::vector<uint8_t> payload(size);
+				for (size_t i = 0; i < size; ++i) {
+					payload[i] = static_cast<uint8_t>(i * 31 + 7);
+				}
+
+				return payload;
+			}
+
+			// The header followed by the segments, with the plaintext fed in pieces of chunkLength.
+			std::vector<uint8_t> Encrypt(
+				const std::vector<uint8_t>& plaintext,
+				size_t chunkLength,
+				std::shared_ptr<const ParallelRunner> runner = nullptr) const
+			{
+				EncryptStream stream(m_Key, m_BaseNonce, SEGMENT_LENGTH, std::move(runner));
+				const auto& header = stream.GetHeader();
+				std::vector<uint8_t> output(header.begin(), header.end());
+				for (size_t offset = 0; offset < plaintext.size(); offset += chunkLength) {
+					auto count = std::min(chunkLength, plaintext.size() - offset);
+					stream.Update(std::span<const uint8_t>(plaintext.data() + offset, count), output);
+				}
+				stream.Finish(output);
+
+				return output;
+			}
+
+			SecureBuffer Decrypt(
+				const std::vector<uint8_t>& encrypted,
+				size_t chunkLength,
+				std::shared_ptr<const ParallelRunner> runner = nullptr) const
+			{
+				std::span<const uint8_t> data(encrypted);
+				DecryptStream stream(m_Key, data.first(AesGcmStream::HEADER_LENGTH), std::move(runner));
+				data = data.subspan(AesGcmStream::HEADER_LENGTH);
+
+				SecureBuffer output;
+				for (size_t offset = 0; offset < data.size(); offset += chunkLength) {
+					auto count = std::min(chunkLength, data.size() - offset);
+					stream.Update(data.subspan(offset, count), output);
+				}
+				stream.Finish(output);
+
+				return output;
+			}
+		};
+
+		TEST_F(AesGcmStreamTest, RoundTrip_WorksForAnyLengthAndChunking)
+		{
+			for (size_t length : { 0, 1, 31, 32, 33, 64, 100 }) {
+				auto plaintext = MakePayload(length);
+				for (size_t chunkLength : { 1, 7, 32, 1000 }) {
+					auto encrypted = Encrypt(plaintext, chunkLength);
+					ASSERT_EQ(encrypted.size(), AesGcmStream::GetEncryptedLength(length, SEGMENT_LENGTH));
+
+					auto decrypted = Decrypt(encrypted, chunkLength);
+					EXPECT_EQ(std::vector<uint8_t>(decrypted.begin(), decrypted.end()), plaintext)
+						<< "length " << length << ", chunk " << chunkLength;
+				}
+			}
+		}
+
+		TEST_F(AesGcmStreamTest, Encrypt_OutputDoesNotDependOnChunking)
+		{
+			auto plaintext = MakePayload(100);
+
+			EXPECT_EQ(Encrypt(plaintext, 1), Encrypt(plaintext, 100));
+		}
+
+		TEST_F(AesGcmStreamTest, Update_WritesSegmentsAsSoonAsTheyAreComplete)
+		{
+			EncryptStream stream(m_Key, m_BaseNonce, SEGMENT_LENGTH);
+			auto plaintext = MakePayload(SEGMENT_LENGTH * 2 + 5);
+			std::vector<uint8_t> output;
+
+			stream.Update(std::span<const uint8_t>(plaintext.data(), SEGMENT_LENGTH - 1), output);
+			EXPECT_TRUE(output.empty());
+
+			stream.Update(std::span<const uint8_t>(plaintext.data() + SEGMENT_LENGTH - 1, SEGMENT_LENGTH + 6), output);
+			EXPECT_EQ(output.size(), 2 * (SEGMENT_LENGTH + AesGcm::TAG_LENGTH));
+		}
+
+		TEST_F(AesGcmStreamTest, ParallelRunner_ProducesSameOutputAsSerial)
+		{
+			auto runner = std::make_shared<ParallelRunner>(std::make_shared<ThreadPoolExecutor>(3), 3);
+			auto plaintext = MakePayload(SEGMENT_LENGTH * 50 + 9);
+
+			for (size_t chunkLength : { size_t{ 5 }, size_t{ 200 }, plaintext.size() }) {
+				auto encrypted = Encrypt(plaintext, chunkLength, runner);
+				EXPECT_EQ(encrypted, Encrypt(plaintext, chunkLength)) << "chunk " << chunkLength;
+
+				auto decrypted = Decrypt(encrypted, chunkLength, runner);
+				EXPECT_EQ(std::vector<uint8_t>(decrypted.begin(), decrypted.end()), plaintext) << "chunk " << chunkLength;
+			}
+		}
+
+		TEST_F(AesGcmStreamTest, ParallelRunner_ReleasesNoPlaintextIfAnySegmentIsModified)
+		{
+			auto runner = std::make_shared<ParallelRunner>(std::make_shared<ThreadPoolExecutor>(3), 3);
+			auto encrypted = Encrypt(MakePayload(SEGMENT_LENGTH * 20), SEGMENT_LENGTH * 20);
+			encrypted[AesGcmStream::HEADER_LENGTH + 15 * (SEGMENT_LENGTH + AesGcm::TAG_LENGTH)] ^= 0x01;
+
+			std::span<const uint8_t> data(encrypted);
+			DecryptStream stream(m_Key, data.first(AesGcmStream::HEADER_LENGTH), runner);
+			SecureBuffer output;
+
+			EXPECT_THROW(stream.Update(data.subspan(AesGcmStream::HEADER_LENGTH), output), BiometricCipherException);
+			EXPECT_TRUE(output.empty());
+			EXPECT_THROW(stream.Finish(output), BiometricCipherException);
+		}
+
+		TEST_F(AesGcmStreamTest, DeriveSegmentNonce_DiffersByIndexAndLastFlag)
+		{
+			uint8_t first[AesGcm::NONCE_LENGTH];
+			uint8_t second[AesGcm::NONCE_LENGTH];
+			uint8_t firstLast[AesGcm::NONCE_LENGTH];
+			AesGcmStream::DeriveSegmentNonce(m_BaseNonce, 0, false, first);
+			AesGcmStream::DeriveSegmentNonce(m_BaseNonce, 1, false, second);
+			AesGcmStream::DeriveSegmentNonce(m_BaseNonce, 0, true, firstLast);
+
+			EXPECT_EQ(std::vector<uint8_t>(first, first + 12), std::vector<uint8_t>(m_BaseNonce, m_BaseNonce + 12));
+			EXPECT_NE(std::vector<uint8_t>(first, first + 12), std::vector<uint8_t>(second, second + 12));
+			EXPECT_NE(std::vector<uint8_t>(first, first + 12), std::vector<uint8_t>(firstLast, firstLast + 12));
+		}
+
+		TEST_F(AesGcmStreamTest, Decrypt_ThrowsIfSegmentModified)
+		{
+			auto encrypted = Encrypt(MakePayload(100), 100);
+			encrypted[AesGcmStream::HEADER_LENGTH + 40] ^= 0x01;
+
+			EXPECT_THROW(Decrypt(encrypted, 100), BiometricCipherException);
+		}
+
+		TEST_F(AesGcmStreamTest, Decrypt_ThrowsIfHeaderModified)
+		{
+			auto encrypted = Encrypt(MakePayload(100), 100);
+			encrypted[AesGcmStream::HEADER_LENGTH - 1] ^= 0x01;
+
+			EXPECT_THROW(Decrypt(encrypted, 100), BiometricCipherException);
+		}
+
+		TEST_F(AesGcmStreamTest, Decrypt_ThrowsIfSegmentsReordered)
+		{
+			auto encrypted = Encrypt(MakePayload(100), 100);
+			size_t segment = SEGMENT_LENGTH + AesGcm::TAG_LENGTH;
+			std::swap_ranges(
+				encrypted.begin() + AesGcmStream::HEADER_LENGTH,
+				encrypted.begin() + AesGcmStream::HEADER_LENGTH + segment,
+				encrypted.begin() + AesGcmStream::HEADER_LENGTH + segment);
+
+			EXPECT_THROW(Decrypt(encrypted, 100), BiometricCipherException);
+		}
+
+		TEST_F(AesGcmStreamTest, Decrypt_ThrowsIfTruncatedAtSegmentBoundary)
+		{
+			auto encrypted = Encrypt(MakePayload(100), 100);
+			encrypted.resize(AesGcmStream::HEADER_LENGTH + 2 * (SEGMENT_LENGTH + AesGcm::TAG_LENGTH));
+
+			EXPECT_THROW(Decrypt(encrypted, 100), BiometricCipherException);
+		}
+
+		TEST_F(AesGcmStreamTest, Decrypt_ThrowsIfLastSegmentDropped)
+		{
+			// 64 bytes end with an empty last segment; without it the stream is cut short.
+			auto encrypted = Encrypt(MakePayload(64), 64);
+			encrypted.resize(encrypted.size() - AesGcm::TAG_LENGTH);
+
+			EXPECT_THROW(Decrypt(encrypted, 64), BiometricCipherException);
+		}
+
+		TEST_F(AesGcmStreamTest, DecryptStream_ThrowsForInvalidHeader)
+		{
+			EncryptStream stream(m_Key, m_BaseNonce, SEGMENT_LENGTH);
+			auto header = stream.GetHeader();
+
+			auto wrongVersion = header;
+			wrongVersion[0] = AesGcmStream::VERSION + 1;
+			EXPECT_THROW(DecryptStream(m_Key, wrongVersion), BiometricCipherException);
+			EXPECT_THROW(DecryptStream(m_Key, std::span<const uint8_t>(header).first(5)), BiometricCipherException);
+		}
+
+		TEST_F(AesGcmStreamTest, EncryptStream_ThrowsWhenUsedAfterFinish)
+		{
+			EncryptStream stream(m_Key, m_BaseNonce, SEGMENT_LENGTH);
+			std::vector<uint8_t> output;
+			stream.Finish(output);
+
+			EXPECT_THROW(stream.Update(std::span<const uint8_t>(), output), BiometricCipherException);
+			EXPECT_THROW(stream.Finish(output), BiometricCipherException);
+		}
+
+		TEST_F(AesGcmStreamTest, EncryptStream_ThrowsForInvalidSegmentLength)
+		{
+			EXPECT_THROW(EncryptStream(m_Key, m_BaseNonce, 0), BiometricCipherException);
+			EXPECT_THROW(EncryptStream(m_Key, m_BaseNonce, AesGcmStream::MAX_SEGMENT_LENGTH + 1), BiometricCipherException);
+		}
+	}
+}
@@ -0,0 +1,301 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Include the code under test
+#include "include/biometric_cipher/common/aes_gcm.h"
+
+namespace biometric_cipher {
+	namespace test {
+
+		using namespace biometric_cipher;
+
+		// AES-256 test cases 13-16 from "The Galois/Counter Mode of Operation (GCM)" by
+		// McGrew and Viega, which NIST SP 800-38D refers to.
+		struct AesGcmTestVector {
+			const char* key;
+			const char* nonce;
+			const char* aad;
+			const char* plaintext;
+			const char* ciphertext;
+			const char* tag;
+		};
+
+		const AesGcmTestVector kTestVectors[] = {
+			{
+				"0000000000000000000000000000000000000000000000000000000000000000",
+				"000000000000000000000000",
+				"",
+				"",
+				"",
+				"530f8afbc74536b9a963b4f1c4cb738b",
+			},
+			{
+				"0000000000000000000000000000000000000000000000000000000000000000",
+				"000000000000000000000000",
+				"",
+				"00000000000000000000000000000000",
+				"cea7403d4d606b6e074ec5d3baf39d18",
+				"d0d1c8a799996bf0265b98b5d48ab919",
+			},
+			{
+				"feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308",
+				"cafebabefacedbaddecaf888",
+				"",
+				"d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+				"1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b391aafd255",
+				"522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa"
+				"8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662898015ad",
+				"b094dac5d93471bdec1a502270e3cc6c",
+			},
+			{
+				"feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308",
+				"cafebabefacedbaddecaf888",
+				"feedfacedeadbeeffeedfacedeadbeefabaddad2",
+				"d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+				"1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39",
+				"522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa"
+				"8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662",
+				"76fc6ece0f4e1768cddf8853bb2d551b",
+			},
+		};
+
+		// Runs every test for each implementation; the ones the CPU does not support fall
+		// back to a narrower one and are still expected to pass.
+		class AesGcmTest : public ::testing::TestWithParam<AesGcm::Implementation> {
+		protected:
+			static std::vector<uint8_t> FromHex(const std::string& hex)
+			{
+				std::vector<uint8_t> bytes;
+				for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+					bytes.push_back(static_cast<uint8_t>(std::stoi(hex.substr(i, 2), nullptr, 16)));
+				}
+
+				return bytes;
+			}
+
+			static std::vector<uint8_t> MakeData(size_t length, uint32_t seed)
+			{
+				std::mt19937 generator(seed);
+				std::vector<uint8_t> data(length);
+				for (auto& byte : data) {
+					byte = static_cast<uint8_t>(generator());
+				}
+
+				return data;
+			}
+
+			const std::vector<uint8_t> m_Key = MakeData(AesGcm::KEY_LENGTH, 1);
+
+			const std::vector<uint8_t> m_Nonce = MakeData(AesGcm::NONCE_LENGTH, 2);
+		};
+
+		TEST_P(AesGcmTest, Encrypt_MatchesTestVectors)
+		{
+			for (const auto& vector : kTestVectors) {
+				auto key = FromHex(vector.key);
+				auto nonce = FromHex(vector.nonce);
+				auto aad = FromHex(vector.aad);
+				auto plaintext = FromHex(vector.plaintext);
+
+				std::vector<uint8_t> ciphertext(plaintext.size());
+				std::vector<uint8_t> tag(AesGcm::TAG_LENGTH);
+				AesGcm::Encrypt(key.data(), nonce.data(), aad.data(), aad.size(),
+					plaintext.data(), plaintext.size(), ciphertext.data(), tag.data(), GetParam());
+
+				EXPECT_EQ(ciphertext, FromHex(vector.ciphertext));
+				EXPECT_EQ(tag, FromHex(vector.tag));
+			}
+		}
+
+		TEST_P(AesGcmTest, Decrypt_MatchesTestVectors)
+		{
+			for (const auto& vector : kTestVectors) {
+				auto key = FromHex(vector.key);
+				auto nonce = FromHex(vector.nonce);
+				auto aad = FromHex(vector.aad);
+				auto ciphertext = FromHex(vector.ciphertext);
+				auto tag = FromHex(vector.tag);
+
+				std::vector<uint8_t> plaintext(ciphertext.size());
+				EXPECT_TRUE(AesGcm::Decrypt(key.data(), nonce.data(), aad.data(), aad.size(),
+					ciphertext.data(), ciphertext.size(), tag.data(), plaintext.data(), GetParam()));
+				EXPECT_EQ(plaintext, FromHex(vector.plaintext));
+			}
+		}
+
+		TEST_P(AesGcmTest, Encrypt_MatchesPortableForAllLengths)
+		{
+			// Covers partial blocks, every tail after the 8- and 16-block loops and lengths
+			// spanning several internal chunks.
+			std::vector<size_t> lengths;
+			for (size_t length = 0; length <= 300; ++length) {
+				lengths.push_back(length);
+			}
+			lengths.insert(lengths.end(), { 511, 512, 513, 4095, 4096, 4097, 3 * 4096 + 271 });
+
+			for (size_t length : lengths) {
+				auto plaintext = MakeData(length, static_cast<uint32_t>(length));
+				auto aad = MakeData(length % 67, static_cast<uint32_t>(length + 1));
+
+				std::vector<uint8_t> expected(length);
+				std::vector<uint8_t> expectedTag(AesGcm::TAG_LENGTH);
+				AesGcm::Encrypt(m_Key.data(), m_Nonce.data(), aad.data(), aad.size(),
+					plaintext.data(), length, expected.data(), expectedTag.data(), AesGcm::Implementation::kPortable);
+
+				std::vector<uint8_t> ciphertext(length);
+				std::vector<uint8_t> tag(AesGcm::TAG_LENGTH);
+				AesGcm::Encrypt(m_Key.data(), m_Nonce.data(), aad.data(), aad.size(),
+					plaintext.data(), length, ciphertext.data(), tag.data(), GetParam());
+
+				EXPECT_EQ(ciphertext, expected) << "length " << length;
+				EXPECT_EQ(tag, expectedTag) << "length " << length;
+			}
+		}
+
+		TEST_P(AesGcmTest, EncryptDecrypt_WorkInPlace)
+		{
+			auto original = MakeData(1000, 3);
+			auto aad = MakeData(20, 4);
+			auto buffer = original;
+			std::vector<uint8_t> tag(AesGcm::TAG_LENGTH);
+
+			AesGcm::Encrypt(m_Key.data(), m_Nonce.data(), aad.data(), aad.size(),
+				buffer.data(), buffer.size(), buffer.data(), tag.data(), GetParam());
+			EXPECT_NE(buffer, original);
+
+			EXPECT_TRUE(AesGcm::Decrypt(m_Key.data(), m_Nonce.data(), aad.data(), aad.size(),
+				buffer.data(), buffer.size(), tag.data(), buffer.data(), GetParam()));
+			EXPECT_EQ(buffer, original);
+		}
+
+		TEST_P(AesGcmTest, Decrypt_RejectsTamperingWithoutWritingOutput)
+		{
+			auto plaintext = MakeData(100, 5);
+			auto aad = MakeData(10, 6);
+			std::vector<uint8_t> ciphertext(plaintext.size());
+			std::vector<uint8_t> tag(AesGcm::TAG_LENGTH);
+			AesGcm::Encrypt(m_Key.data(), m_Nonce.data(), aad.data(), aad.size(),
+				plaintext.data(), plaintext.size(), ciphertext.data(), tag.data(), GetParam());
+
+			auto tryDecrypt = [&](std::vector<uint8_t> key, std::vector<uint8_t> nonce, std::vector<uint8_t> additional,
+				std::vector<uint8_t> data, std::vector<uint8_t> authTag) {
+				std::vector<uint8_t> output(data.size(), 0xAA);
+				bool isValid = AesGcm::Decrypt(key.data(), nonce.data(), additional.data(), additional.size(),
+					data.data(), data.size(), authTag.data(), output.data(), GetParam());
+				EXPECT_EQ(output, std::vector<uint8_t>(data.size(), 0xAA));
+
+				return isValid;
+			};
+
+			auto tamperedCiphertext = ciphertext;
+			tamperedCiphertext[42] ^= 0x01;
+			EXPECT_FALSE(tryDecrypt(m_Key, m_Nonce, aad, tamperedCiphertext, tag));
+
+			auto tamperedTag = tag;
+			tamperedTag[15] ^= 0x80;
+			EXPECT_FALSE(tryDecrypt(m_Key, m_Nonce, aad, ciphertext, tamperedTag));
+
+			auto tamperedAad = aad;
+			tamperedAad[0] ^= 0x01;
+			EXPECT_FALSE(tryDecrypt(m_Key, m_Nonce, tamperedAad, ciphertext, tag));
+
+			auto otherNonce = m_Nonce;
+			otherNonce[11] ^= 0x01;
+			EXPECT_FALSE(tryDecrypt(m_Key, otherNonce, aad, ciphertext, tag));
+
+			auto otherKey = m_Key;
+			otherKey[0] ^= 0x01;
+			EXPECT_FALSE(tryDecrypt(otherKey, m_Nonce, aad, ciphertext, tag));
+
+			ciphertext.pop_back();
+			EXPECT_FALSE(tryDecrypt(m_Key, m_Nonce, aad, ciphertext, tag));
+		}
+
+		TEST_P(AesGcmTest, PreparedKey_MatchesOneOffKeyAcrossMessages)
+		{
+			AesGcmKey preparedKey(m_Key.data(), GetParam());
+
+			for (uint32_t message = 0; message < 50; ++message) {
+				auto plaintext = MakeData(message * 37, message);
+				auto nonce = MakeData(AesGcm::NONCE_LENGTH, message + 100);
+
+				std::vector<uint8_t> expected(plaintext.size());
+				std::vector<uint8_t> expectedTag(AesGcm::TAG_LENGTH);
+				AesGcm::Encrypt(m_Key.data(), nonce.data(), nullptr, 0,
+					plaintext.data(), plaintext.size(), expected.data(), expectedTag.data(), GetParam());
+
+				std::vector<uint8_t> ciphertext(plaintext.size());
+				std::vector<uint8_t> tag(AesGcm::TAG_LENGTH);
+				AesGcm::Encrypt(preparedKey, nonce.data(), nullptr, 0,
+					plaintext.data(), plaintext.size(), ciphertext.data(), tag.data());
+				EXPECT_EQ(ciphertext, expected) << "message " << message;
+				EXPECT_EQ(tag, expectedTag) << "message " << message;
+
+				std::vector<uint8_t> decrypted(ciphertext.size());
+				EXPECT_TRUE(AesGcm::Decrypt(preparedKey, nonce.data(), nullptr, 0,
+					ciphertext.data(), ciphertext.size(), tag.data(), decrypted.data()));
+				EXPECT_EQ(decrypted, plaintext) << "message " << message;
+			}
+		}
+
+		TEST_P(AesGcmTest, PreparedKey_IsAlignedAndClamped)
+		{
+			AesGcmKey preparedKey(m_Key.data(), GetParam());
+
+			EXPECT_EQ(reinterpret_cast<uintptr_t>(&preparedKey.GetSchedule()) % 64, 0u);
+			EXPECT_EQ(preparedKey.GetImplementation(), AesGcm::Clamp(GetParam()));
+		}
+
+		TEST_P(AesGcmTest, PreparedKey_CanBeSharedBetweenThreads)
+		{
+			AesGcmKey preparedKey(m_Key.data(), GetParam());
+			auto plaintext = MakeData(777, 7);
+
+			std::vector<std::thread> threads;
+			std::vector<int> failures(4, 0);
+			for (size_t i = 0; i < failures.size(); ++i) {
+				threads.emplace_back([&, i]() {
+					auto nonce = MakeData(AesGcm::NONCE_LENGTH, static_cast<uint32_t>(i));
+					std::vector<uint8_t> buffer(plaintext.size());
+					std::vector<uint8_t> tag(AesGcm::TAG_LENGTH);
+					for (int round = 0; round < 100; ++round) {
+						AesGcm::Encrypt(preparedKey, nonce.data(), nullptr, 0,
+							plaintext.data(), plaintext.size(), buffer.data(), tag.data());
+						bool isValid = AesGcm::Decrypt(preparedKey, nonce.data(), nullptr, 0,
+							buffer.data(), buffer.size(), tag.data(), buffer.data());
+						if (!isValid || buffer != plaintext) {
+							++failures[i];
+						}
+					}
+				});
+			}
+			for (auto& thread : threads) {
+				thread.join();
+			}
+
+			EXPECT_EQ(failures, std::vector<int>(4, 0));
+		}
+
+		TEST(AesGcmImplementationTest, Clamp_NeverExceedsBestImplementation)
+		{
+			auto best = AesGcm::GetBestImplementation();
+
+			EXPECT_EQ(AesGcm::Clamp(AesGcm::Implementation::kPortable), AesGcm::Implementation::kPortable);
+			EXPECT_LE(AesGcm::Clamp(AesGcm::Implementation::kVaes), best);
+			EXPECT_EQ(AesGcm::Clamp(best), best);
+		}
+
+		INSTANTIATE_TEST_SUITE_P(
+			AllImplementations,
+			AesGcmTest,
+			::testing::Values(
+				AesGcm::Implementation::kPortable,
+				AesGcm::Implementation::kAesNi,
+				AesGcm::Implementation::kVaes));
+	}
+}
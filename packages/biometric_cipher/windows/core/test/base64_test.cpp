@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+
+// Include the code under test
+#include "include/biometric_cipher/common/base64.h"
+
+namespace biometric_cipher {
+	namespace test {
+
+		using namespace biometric_cipher;
+
+		// Runs every test for each implementation the CPU supports; the others fall back to a
+		// narrower one and are still expected to pass.
+		class Base64Test : public ::testing::TestWithParam<SimdLevel> {
+		protected:
+			static std::vector<uint8_t> MakeData(size_t length)
+			{
+				std::mt19937 generator(static_cast<uint32_t>(length));
+				std::vector<uint8_t> data(length);
+				for (auto& byte : data) {
+					byte = static_cast<uint8_t>(generator());
+				}
+
+				return data;
+			}
+
+			static std::vector<uint8_t> ToBytes(const std::string& string)
+			{
+				return std::vector<uint8_t>(string.begin(), string.end());
+			}
+		};
+
+		TEST_P(Base64Test, Encode_MatchesRfc4648Vectors)
+		{
+			EXPECT_EQ(Base64::Encode(nullptr, 0, GetParam()), "");
+			EXPECT_EQ(Base64::Encode(ToBytes("f").data(), 1, GetParam()), "Zg==");
+			EXPECT_EQ(Base64::Encode(ToBytes("fo").data(), 2, GetParam()), "Zm8=");
+			EXPECT_EQ(Base64::Encode(ToBytes("foo").data(), 3, GetParam()), "Zm9v");
+			EXPECT_EQ(Base64::Encode(ToBytes("foob").data(), 4, GetParam()), "Zm9vYg==");
+			EXPECT_EQ(Base64::Encode(ToBytes("fooba").data(), 5, GetParam()), "Zm9vYmE=");
+			EXPECT_EQ(Base64::Encode(ToBytes("foobar").data(), 6, GetParam()), "Zm9vYmFy");
+		}
+
+		TEST_P(Base64Test, Encode_UsesWholeAlphabet)
+		{
+			std::vector<uint8_t> data;
+			for (int i = 0; i < 64; ++i) {
+				// Three bytes per group of four 6-bit values i, i, i, i.
+				uint32_t group = (i << 18) | (i << 12) | (i << 6) | i;
+				data.push_back(static_cast<uint8_t>(group >> 16));
+				data.push_back(static_cast<uint8_t>(group >> 8));
+				data.push_back(static_cast<uint8_t>(group));
+			}
+
+			auto encoded = Base64::Encode(data.data(), data.size(), GetParam());
+
+			const std::string alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+			for (size_t i = 0; i < alphabet.size(); ++i) {
+				EXPECT_EQ(encoded.substr(i * 4, 4), std::string(4, alphabet[i]));
+			}
+		}
+
+		TEST_P(Base64Test, Encode_MatchesScalarForAllLengths)
+		{
+			for (size_t length = 0; length < 300; ++length) {
+				auto data = MakeData(length);
+
+				EXPECT_EQ(
+					Base64::Encode(data.data(), data.size(), GetParam()),
+					Base64::Encode(data.data(), data.size(), SimdLevel::kScalar)) << "length " << length;
+			}
+		}
+
+		TEST_P(Base64Test, Decode_RoundTripsAllLengths)
+		{
+			for (size_t length = 0; length < 300; ++length) {
+				auto data = MakeData(length);
+				auto encoded = Base64::Encode(data.data(), data.size(), SimdLevel::kScalar);
+
+				EXPECT_EQ(Base64::Decode(encoded, GetParam()), data) << "length " << length;
+			}
+		}
+
+		TEST_P(Base64Test, Decode_RejectsInvalidCharacterAtAnyPosition)
+		{
+			auto data = MakeData(150);
+			const auto encoded = Base64::Encode(data.data(), data.size(), SimdLevel::kScalar);
+			std::vector<uint8_t> output(*Base64::GetDecodedLength(encoded));
+
+			for (char invalid : { ' ', '\n', '-', '_', '.', '*', '@', '[', '`', '{', ':', '\0', '\x80', '\xFF' }) {
+				for (size_t position = 0; position < encoded.size(); ++position) {
+					auto corrupted = encoded;
+					corrupted[position] = invalid;
+
+					EXPECT_FALSE(Base64::Decode(corrupted, output.data(), GetParam()))
+						<< "character " << static_cast<int>(invalid) << " at " << position;
+				}
+			}
+		}
+
+		TEST_P(Base64Test, Decode_RejectsMisplacedPadding)
+		{
+			EXPECT_THROW(Base64::Decode("=AAA", GetParam()), BiometricCipherException);
+			EXPECT_THROW(Base64::Decode("A===", GetParam()), BiometricCipherException);
+			EXPECT_THROW(Base64::Decode("AA=A", GetParam()), BiometricCipherException);
+			EXPECT_THROW(Base64::Decode("AA==AAAA", GetParam()), BiometricCipherException);
+			EXPECT_THROW(Base64::Decode("Zm9vYg=", GetParam()), BiometricCipherException);
+		}
+
+		TEST_P(Base64Test, Decode_RejectsNonCanonicalTrailingBits)
+		{
+			EXPECT_EQ(Base64::Decode("Zg==", GetParam()), ToBytes("f"));
+			EXPECT_THROW(Base64::Decode("Zh==", GetParam()), BiometricCipherException);
+			EXPECT_EQ(Base64::Decode("Zm8=", GetParam()), ToBytes("fo"));
+			EXPECT_THROW(Base64::Decode("Zm9=", GetParam()), BiometricCipherException);
+		}
+
+		TEST_P(Base64Test, Decode_RejectsLengthNotMultipleOfFour)
+		{
+			EXPECT_THROW(Base64::Decode("Zm9vY", GetParam()), BiometricCipherException);
+			EXPECT_THROW(Base64::Decode("Zm9vYmFyZg", GetParam()), BiometricCipherException);
+		}
+
+		TEST_P(Base64Test, Decode_InvalidInputThrowsInvalidArgument)
+		{
+			try {
+				Base64::Decode("Zm9v!mFy", GetParam());
+				FAIL() << "Expected BiometricCipherException";
+			}
+			catch (const BiometricCipherException& e) {
+				EXPECT_EQ(e.Code(), error_invalid_argument);
+			}
+		}
+
+		INSTANTIATE_TEST_SUITE_P(
+			AllLevels,
+			Base64Test,
+			::testing::Values(SimdLevel::kScalar, SimdLevel::kSse41, SimdLevel::kAvx2));
+	}
+}
@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "include/biometric_cipher/enums/tpm_status.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+
+// Include fakes
+#include "fakes/fake_windows_hello_repository.h"
+#include "fakes/fake_windows_tpm_repository.h"
+#include "fakes/fake_winrt_encrypt_repository.h"
+
+// Include the code under test
+#include "include/biometric_cipher/services/biometric_cipher_service.h"
+
+namespace biometric_cipher {
+	namespace test {
+
+		using namespace biometric_cipher;
+
+		class BiometricCipherServiceFakeBackendTest : public ::testing::Test {
+		protected:
+			std::shared_ptr<FakeWindowsHelloRepository> m_WindowsHelloRepository;
+
+			std::unique_ptr<BiometricCipherService> m_Service;
+
+			void SetUp() override
+			{
+				m_WindowsHelloRepository = std::make_shared<FakeWindowsHelloRepository>();
+				m_Service = std::make_unique<BiometricCipherService>(
+					std::make_shared<ConfigStorage>(),
+					m_WindowsHelloRepository,
+					std::make_shared<FakeWindowsTpmRepository>(),
+					std::make_shared<FakeWinrtEncryptRepository>()
+				);
+				m_Service->Configure(ConfigData("dataToSign"));
+			}
+		};
+
+		TEST_F(BiometricCipherServiceFakeBackendTest, EncryptAsync_RoundTripsThroughDecryptAsync)
+		{
+			m_Service->GenerateKeyAsync("tag").get();
+
+			auto encrypted = m_Service->EncryptAsync("tag", "secret \xD0\xB4\xD0\xB0\xD0\xBD\xD0\xBD\xD1\x8B\xD0\xB5").get();
+			auto decrypted = m_Service->DecryptAsync("tag", encrypted).get();
+
+			EXPECT_EQ(decrypted, "secret \xD0\xB4\xD0\xB0\xD0\xBD\xD0\xBD\xD1\x8B\xD0\xB5");
+		}
+
+		TEST_F(BiometricCipherServiceFakeBackendTest, EncryptBinaryAsync_RoundTripsThroughDecryptBinaryAsync)
+		{
+			const SecureBuffer payload = { 0x00, 0x01, 0xFE, 0xFF };
+			m_Service->GenerateKeyAsync("tag").get();
+
+			auto encrypted = m_Service->EncryptBinaryAsync("tag", payload).get();
+			auto decrypted = m_Service->DecryptBinaryAsync("tag", encrypted).get();
+
+			EXPECT_EQ(decrypted, payload);
+		}
+
+		TEST_F(BiometricCipherServiceFakeBackendTest, EncryptBatchAsync_RoundTripsWithSingleSignature)
+		{
+			m_Service->GenerateKeyAsync("tag").get();
+
+			auto encrypted = m_Service->EncryptBatchAsync("tag", { "first", "second", "third" }).get();
+			auto decrypted = m_Service->DecryptBatchAsync("tag", encrypted).get();
+
+			EXPECT_EQ(decrypted, std::vector<SecureString>({ "first", "second", "third" }));
+			EXPECT_EQ(m_WindowsHelloRepository->GetSignCount(), 2u);
+		}
+
+		TEST_F(BiometricCipherServiceFakeBackendTest, BeginEncryptStreamAsync_RoundTripsThroughBeginDecryptStreamAsync)
+		{
+			std::vector<uint8_t> payload(FakeWinrtEncryptRepository::STREAM_SEGMENT_LENGTH * 3 + 10);
+			for (size_t i = 0; i < payload.size(); ++i) {
+				payload[i] = static_cast<uint8_t>(i);
+			}
+			m_Service->GenerateKeyAsync("tag").get();
+
+			auto encryptStream = m_Service->BeginEncryptStreamAsync("tag").get();
+			const auto& header = encryptStream->GetHeader();
+			std::vector<uint8_t> encrypted;
+			encryptStream->Update(payload, encrypted);
+			encryptStream->Finish(encrypted);
+
+			auto decryptStream = m_Service->BeginDecryptStreamAsync("tag", std::vector<uint8_t>(header.begin(), header.end())).get();
+			SecureBuffer decrypted;
+			decryptStream->Update(encrypted, decrypted);
+			decryptStream->Finish(decrypted);
+
+			EXPECT_EQ(std::vector<uint8_t>(decrypted.begin(), decrypted.end()), payload);
+			EXPECT_EQ(m_WindowsHelloRepository->GetSignCount(), 2u);
+		}
+
+		TEST_F(BiometricCipherServiceFakeBackendTest, EncryptAsync_WithContextDecryptsOnlyUnderSameContext)
+		{
+			m_Service->GenerateKeyAsync("tag").get();
+
+			auto encrypted = m_Service->EncryptAsync("tag", "secret", "vault/1").get();
+
+			EXPECT_EQ(m_Service->DecryptAsync("tag", encrypted, "vault/1").get(), "secret");
+			for (const char* otherContext : { "vault/2", "" }) {
+				try {
+					m_Service->DecryptAsync("tag", encrypted, otherContext).get();
+					FAIL() << "Expected BiometricCipherException for context '" << otherContext << "'";
+				}
+				catch (const BiometricCipherException& e) {
+					EXPECT_EQ(e.Code(), error_decrypt);
+				}
+			}
+		}
+
+		TEST_F(BiometricCipherServiceFakeBackendTest, DeriveSubkeysAsync_UnlocksEveryContextWithSingleSignature)
+		{
+			m_Service->Configure(ConfigData("dataToSign", 60, ConfigData::kDefaultKeyCacheMaxEntries));
+			m_Service->GenerateKeyAsync("tag").get();
+
+			auto subkeys = m_Service->DeriveSubkeysAsync("tag", { "first", "second", "first" }).get();
+			ASSERT_EQ(subkeys.size(), 3u);
+			EXPECT_EQ(m_WindowsHelloRepository->GetSignCount(), 1u);
+
+			// Within the key cache TTL, calls under any context reuse the signature.
+			const SecureBuffer payload = { 0x01, 0x02, 0x03 };
+			auto first = m_Service->EncryptBinaryAsync("tag", payload, "first").get();
+			auto second = m_Service->EncryptBinaryAsync("tag", payload, "second").get();
+			EXPECT_EQ(m_Service->DecryptBinaryAsync("tag", first, "first").get(), payload);
+			EXPECT_EQ(m_Service->DecryptBinaryAsync("tag", second, "second").get(), payload);
+			EXPECT_THROW(m_Service->DecryptBinaryAsync("tag", first, "second").get(), BiometricCipherException);
+			EXPECT_EQ(m_WindowsHelloRepository->GetSignCount(), 1u);
+
+			// The subkeys are the ones the context parameter selects.
+			FakeWinrtEncryptRepository repository;
+			EXPECT_EQ(repository.DecryptBinary(subkeys[0], first), payload);
+			EXPECT_EQ(repository.DecryptBinary(subkeys[2], first), payload);
+			EXPECT_EQ(repository.DecryptBinary(subkeys[1], second), payload);
+		}
+
+		TEST_F(BiometricCipherServiceFakeBackendTest, DeriveSubkeysAsync_DoesNotSignForNoContexts)
+		{
+			m_Service->GenerateKeyAsync("tag").get();
+
+			EXPECT_TRUE(m_Service->DeriveSubkeysAsync("tag", {}).get().empty());
+			EXPECT_EQ(m_WindowsHelloRepository->GetSignCount(), 0u);
+		}
+
+		TEST_F(BiometricCipherServiceFakeBackendTest, DecryptAsync_ThrowsForDataEncryptedWithAnotherKey)
+		{
+			m_Service->GenerateKeyAsync("first").get();
+			m_Service->GenerateKeyAsync("second").get();
+
+			auto encrypted = m_Service->EncryptAsync("first", "secret").get();
+
+			EXPECT_THROW(
+				m_Service->DecryptAsync("second", encrypted).get(),
+				BiometricCipherException
+			);
+		}
+
+		TEST_F(BiometricCipherServiceFakeBackendTest, EncryptAsync_ThrowsAfterKeyDeleted)
+		{
+			m_Service->GenerateKeyAsync("tag").get();
+			m_Service->DeleteKeyAsync("tag").get();
+
+			try {
+				m_Service->EncryptAsync("tag", "secret").get();
+				FAIL() << "Expected BiometricCipherException";
+			}
+			catch (const BiometricCipherException& e) {
+				EXPECT_EQ(e.Code(), error_key_not_found);
+			}
+		}
+
+		TEST_F(BiometricCipherServiceFakeBackendTest, DeleteKeyAsync_IgnoresMissingKey)
+		{
+			EXPECT_NO_THROW(m_Service->DeleteKeyAsync("missing").get());
+		}
+
+		TEST_F(BiometricCipherServiceFakeBackendTest, GetTPMStatusAsync_ReturnsSupported)
+		{
+			EXPECT_EQ(m_Service->GetTPMStatusAsync().get(), TpmStatusToInteger(TpmStatus::kSupported));
+		}
+
+		TEST_F(BiometricCipherServiceFakeBackendTest, GenerateKeyAsync_ThrowsIfBiometryUnsupported)
+		{
+			m_Service = std::make_unique<BiometricCipherService>(
+				std::make_shared<ConfigStorage>(),
+				std::make_shared<FakeWindowsHelloRepository>(BiometryStatus::kNotConfiguredForUser),
+				std::make_shared<FakeWindowsTpmRepository>(),
+				std::make_shared<FakeWinrtEncryptRepository>()
+			);
+
+			EXPECT_THROW(m_Service->GenerateKeyAsync("tag").get(), BiometricCipherException);
+		}
+	}  // namespace test
+}  // namespace biometric_cipher
@@ -0,0 +1,1000 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "include/biometric_cipher/common/tracer.h"
+#include "include/biometric_cipher/enums/tpm_status.h"
+#include "include/biometric_cipher/enums/biometry_status.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+
+#include "helpers/async_gate.h"
+
+// Include mock
+#include "mocks/mock_config_storage.h"
+#include "mocks/mock_windows_hello_repository.h"
+#include "mocks/mock_windows_tpm_repository.h"
+#include "mocks/mock_winrt_encrypt_repository.h"
+
+// Include the code under test
+#include "include/biometric_cipher/services/biometric_cipher_service.h"
+
+
+
+namespace biometric_cipher {
+	namespace test {
+
+		using namespace biometric_cipher;
+
+		class BiometricCipherServiceTest : public ::testing::Test  {
+		protected:
+			ConfigData m_ConfigData;
+
+			// Shared pointers to mocks
+			std::shared_ptr<MockConfigStorage> m_ConfigStorage;
+			std::shared_ptr<MockWindowsHelloRepository> m_WindowsHelloRepository;
+			std::shared_ptr<MockWindowsTpmRepository> m_WindowsTpmRepository;
+			std::shared_ptr<MockWinrtEncryptRepository> m_WinrtEncryptRepository;
+
+			// The service under test
+			std::unique_ptr<BiometricCipherService> m_Service;
+
+			// What ConfigStorage::GetConfig() returns once m_ConfigData has been set.
+			std::shared_ptr<const ConfigData> GetConfigSnapshot() const
+			{
+				return std::make_shared<const ConfigData>(m_ConfigData);
+			}
+		
+			void SetUp() override {
+				// Initialize mocks
+				m_ConfigStorage = std::make_shared<MockConfigStorage>();
+				m_WindowsHelloRepository = std::make_shared<MockWindowsHelloRepository>();
+				m_WindowsTpmRepository = std::make_shared<MockWindowsTpmRepository>();
+				m_WinrtEncryptRepository = std::make_shared<MockWinrtEncryptRepository>();
+
+				// Create the service
+				m_Service = std::make_unique<BiometricCipherService>(
+					m_ConfigStorage,
+					m_WindowsHelloRepository,
+					m_WindowsTpmRepository,
+					m_WinrtEncryptRepository
+				);
+			}
+		};
+
+		TEST_F(BiometricCipherServiceTest, GetTPMStatusAsync_ReturnsUnsupportedIfWindowsTpmRepositoryThrows)
+		{
+			// Set expectations
+			EXPECT_CALL(*m_WindowsTpmRepository, GetWindowsTpmVersion())
+				.Times(1)
+				.WillOnce(testing::Throw(BiometricCipherException(error_tpm_unsupported, "Test exception")));
+
+			// Act: create an instance and call the function that triggers mock calls.
+			auto asyncOp = m_Service->GetTPMStatusAsync();
+			int result = asyncOp.get();
+			// Assert
+			EXPECT_EQ(result, TpmStatusToInteger(TpmStatus::kUnsupported));
+		}
+
+		TEST_F(BiometricCipherServiceTest, GetTPMStatusAsync_ReturnsUnsupportedIfWindowsTpmRepositoryVersionThrows)
+		{
+			// Set expectations
+			EXPECT_CALL(*m_WindowsTpmRepository, GetWindowsTpmVersion())
+				.Times(1)
+				.WillOnce(testing::Throw(BiometricCipherException(error_tpm_version, "Test exception")));
+
+			// Act: create an instance and call the function that triggers mock calls.
+			auto asyncOp = m_Service->GetTPMStatusAsync();
+			int result = asyncOp.get();
+			// Assert
+			EXPECT_EQ(result, TpmStatusToInteger(TpmStatus::kTPMVersionUnsupported));
+		}
+
+		TEST_F(BiometricCipherServiceTest, GetTPMStatusAsync_ReturnsTPMVersionUnsupportedIfTpmVersionLessThan2)
+		{
+			auto tpmVersion = 1;
+			// Set expectations
+			EXPECT_CALL(*m_WindowsTpmRepository, GetWindowsTpmVersion())
+				.Times(1)
+				.WillOnce([&, tpmVersion]() -> int
+					{
+						return tpmVersion;
+					}
+				);
+
+			// Act: create an instance and call the function that triggers mock calls.
+			auto asyncOp = m_Service->GetTPMStatusAsync();
+			int result = asyncOp.get();
+			// Assert
+			EXPECT_EQ(result, TpmStatusToInteger(TpmStatus::kTPMVersionUnsupported));
+		}
+
+		TEST_F(BiometricCipherServiceTest, GetTPMStatusAsync_QueriesRepositoryOnlyOnce)
+		{
+			EXPECT_CALL(*m_WindowsTpmRepository, GetWindowsTpmVersion())
+				.Times(1)
+				.WillOnce(testing::Return(2));
+
+			EXPECT_EQ(m_Service->GetTPMStatusAsync().get(), TpmStatusToInteger(TpmStatus::kSupported));
+			EXPECT_EQ(m_Service->GetTPMStatusAsync().get(), TpmStatusToInteger(TpmStatus::kSupported));
+		}
+
+		TEST_F(BiometricCipherServiceTest, GetTPMStatusAsync_RemembersUnsupportedStatus)
+		{
+			EXPECT_CALL(*m_WindowsTpmRepository, GetWindowsTpmVersion())
+				.Times(1)
+				.WillOnce(testing::Throw(BiometricCipherException(error_tpm_unsupported, "Test exception")));
+
+			EXPECT_EQ(m_Service->GetTPMStatusAsync().get(), TpmStatusToInteger(TpmStatus::kUnsupported));
+			EXPECT_EQ(m_Service->GetTPMStatusAsync().get(), TpmStatusToInteger(TpmStatus::kUnsupported));
+		}
+
+		TEST_F(BiometricCipherServiceTest, GetTPMStatusAsync_DoesNotRememberUnexpectedErrors)
+		{
+			EXPECT_CALL(*m_WindowsTpmRepository, GetWindowsTpmVersion())
+				.Times(2)
+				.WillOnce(testing::Throw(BiometricCipherException(error_fail, "Test exception")))
+				.WillOnce(testing::Return(2));
+
+			EXPECT_THROW(m_Service->GetTPMStatusAsync().get(), BiometricCipherException);
+			EXPECT_EQ(m_Service->GetTPMStatusAsync().get(), TpmStatusToInteger(TpmStatus::kSupported));
+		}
+
+		TEST_F(BiometricCipherServiceTest, RefreshTPMStatusAsync_QueriesRepositoryAgain)
+		{
+			testing::InSequence sequence;
+			EXPECT_CALL(*m_WindowsTpmRepository, GetWindowsTpmVersion())
+				.WillOnce(testing::Return(1));
+			EXPECT_CALL(*m_WindowsTpmRepository, Refresh())
+				.Times(1);
+			EXPECT_CALL(*m_WindowsTpmRepository, GetWindowsTpmVersion())
+				.WillOnce(testing::Return(2));
+
+			EXPECT_EQ(m_Service->GetTPMStatusAsync().get(), TpmStatusToInteger(TpmStatus::kTPMVersionUnsupported));
+			EXPECT_EQ(m_Service->RefreshTPMStatusAsync().get(), TpmStatusToInteger(TpmStatus::kSupported));
+			EXPECT_EQ(m_Service->GetTPMStatusAsync().get(), TpmStatusToInteger(TpmStatus::kSupported));
+		}
+
+		TEST_F(BiometricCipherServiceTest, GetBiometryStatusAsync_ReturnsNotSupportedIfWindowsHelloUnsupported) {
+			// Set expectations
+			auto status = BiometryStatus::kUnsupported;
+			EXPECT_CALL(*m_WindowsHelloRepository, GetWindowsHelloStatusAsync())
+				.Times(1)
+				.WillOnce([&, status]() -> Task<int>
+					{
+						co_return BiometryStatusToInteger(status);
+					}
+				);
+
+			// Act: create an instance and call the function that triggers mock calls.
+			auto asyncOp = m_Service->GetBiometryStatusAsync();
+			int result = asyncOp.get();
+
+			// Assert
+			EXPECT_EQ(result, BiometryStatusToInteger(status));
+		}
+
+		TEST_F(BiometricCipherServiceTest, GetBiometryStatusAsync_ReturnsSupportedIfWindowsHelloSupported) {
+			// Set expectations
+			auto status = BiometryStatus::kSupported;
+			EXPECT_CALL(*m_WindowsHelloRepository, GetWindowsHelloStatusAsync())
+				.Times(1)
+				.WillOnce([&, status]() -> Task<int>
+					{
+						co_return BiometryStatusToInteger(status);
+					}
+				);
+
+			// Act: create an instance and call the function that triggers mock calls.
+			auto asyncOp = m_Service->GetBiometryStatusAsync();
+			int result = asyncOp.get();
+
+			// Assert
+			EXPECT_EQ(result, BiometryStatusToInteger(status));
+		}
+
+		TEST_F(BiometricCipherServiceTest, GetCachedBiometryStatusAsync_ReusesStatusWithinTtl)
+		{
+			auto biometryStatusCache = std::make_shared<BiometryStatusCache>();
+			biometryStatusCache->Configure(std::chrono::seconds(60));
+			m_Service = std::make_unique<BiometricCipherService>(
+				m_ConfigStorage,
+				m_WindowsHelloRepository,
+				m_WindowsTpmRepository,
+				m_WinrtEncryptRepository,
+				nullptr,
+				biometryStatusCache
+			);
+
+			EXPECT_CALL(*m_WindowsHelloRepository, GetWindowsHelloStatusAsync())
+				.Times(1)
+				.WillOnce([]() -> Task<int>
+					{
+						co_return BiometryStatusToInteger(BiometryStatus::kSupported);
+					}
+				);
+
+			EXPECT_EQ(m_Service->GetCachedBiometryStatusAsync().get(), BiometryStatusToInteger(BiometryStatus::kSupported));
+			EXPECT_EQ(m_Service->GetCachedBiometryStatusAsync().get(), BiometryStatusToInteger(BiometryStatus::kSupported));
+		}
+
+		TEST_F(BiometricCipherServiceTest, GetBiometryStatusAsync_AlwaysQueriesRepository)
+		{
+			auto biometryStatusCache = std::make_shared<BiometryStatusCache>();
+			biometryStatusCache->Configure(std::chrono::seconds(60));
+			biometryStatusCache->Put(BiometryStatusToInteger(BiometryStatus::kSupported));
+			m_Service = std::make_unique<BiometricCipherService>(
+				m_ConfigStorage,
+				m_WindowsHelloRepository,
+				m_WindowsTpmRepository,
+				m_WinrtEncryptRepository,
+				nullptr,
+				biometryStatusCache
+			);
+
+			EXPECT_CALL(*m_WindowsHelloRepository, GetWindowsHelloStatusAsync())
+				.Times(1)
+				.WillOnce([]() -> Task<int>
+					{
+						co_return BiometryStatusToInteger(BiometryStatus::kDeviceBusy);
+					}
+				);
+
+			EXPECT_EQ(m_Service->GetBiometryStatusAsync().get(), BiometryStatusToInteger(BiometryStatus::kDeviceBusy));
+			// The fresh status replaces the cached one.
+			EXPECT_EQ(biometryStatusCache->Get(), BiometryStatusToInteger(BiometryStatus::kDeviceBusy));
+		}
+
+		TEST_F(BiometricCipherServiceTest, GenerateKeyAsync_CallsCreateCredentialWithCorrectTag) {
+			// Arrange
+			std::string testTag = "test_tag";
+
+			EXPECT_CALL(*m_WindowsHelloRepository, CreateCredentialAsync)
+				.Times(1)
+				.WillOnce([&, testTag](const std::string& tag) -> Task<>
+					{
+						EXPECT_EQ(tag, testTag);
+						co_return;
+					}
+				);
+
+			// Act
+			auto asyncOp = m_Service->GenerateKeyAsync(testTag);
+			asyncOp.get();
+
+			// Assert
+			// The expectation with EXPECT_CALL is enough to verify correctness here.
+		}
+
+		TEST_F(BiometricCipherServiceTest, DeleteKeyAsync_CallsDeleteCredentialWithCorrectTag)
+		{
+			// Arrange
+			std::string testTag = "delete_tag";
+
+			EXPECT_CALL(*m_WindowsHelloRepository, DeleteCredentialAsync)
+				.Times(1)
+				.WillOnce([&, testTag](const std::string& tag) -> Task<>
+					{
+						EXPECT_EQ(tag, testTag);
+						co_return;
+					});
+
+			// Act
+			auto asyncOp = m_Service->DeleteKeyAsync(testTag);
+			asyncOp.get();
+
+			// Assert
+			// Again, the mock verification ensures correctness.
+		}
+
+		TEST_F(BiometricCipherServiceTest, EncryptAsync_ThrowsIfDataToSignEmpty)
+		{
+			// Arrange
+			m_ConfigData.dataToSign = "";
+			EXPECT_CALL(*m_ConfigStorage, GetConfig())
+				.Times(1)
+				.WillOnce(testing::Return(nullptr));
+
+			// Act & Assert
+			EXPECT_THROW(
+				m_Service->EncryptAsync("testTag", "someData").get(),
+				BiometricCipherException
+			);
+		}
+
+		TEST_F(BiometricCipherServiceTest, EncryptAsync_ReturnsEncryptedString)
+		{
+			const std::string encryptedString = "encrypted_base64_string";
+
+			m_ConfigData.dataToSign = "dataToSign";
+			EXPECT_CALL(*m_ConfigStorage, GetConfig())
+				.Times(1)
+				.WillOnce([this] { return GetConfigSnapshot(); });
+
+			// When CreateAESKeyAsync() is called, it calls:
+			//   1) SignAsync(hTag, signature)
+			//   2) CreateAESKey(signedData)
+			// So let's mock them in the repository:
+
+			// 1) Mock SignAsync
+			EXPECT_CALL(*m_WindowsHelloRepository, SignAsync)
+				.Times(1)
+				.WillOnce([](auto, auto) -> Task<SecureBuffer>
+					{
+						// Return some fake signature
+						co_return SecureBuffer{}; 
+					}
+				);
+
+			// 2) Mock CreateAESKey
+			auto fakeAesKey = std::make_shared<SymmetricKey>();
+			EXPECT_CALL(*m_WinrtEncryptRepository, CreateAESKey)
+				.Times(1)
+				.WillOnce([&](auto)
+					{
+						return fakeAesKey;
+					}
+				);
+
+			// Finally, mock the Encrypt call
+			// Suppose the repository's Encrypt returns an encrypted base64 string
+			EXPECT_CALL(*m_WinrtEncryptRepository, Encrypt)
+				.Times(1)
+				.WillOnce([&](auto, auto)
+					{
+						return encryptedString;
+					}
+				);
+
+			auto asyncOp = m_Service->EncryptAsync("testTag", "someData");
+			auto result = asyncOp.get();
+
+			// Assert
+			EXPECT_EQ(result, encryptedString);
+		}
+
+		TEST_F(BiometricCipherServiceTest, EncryptAsync_RecordsTraceSpans)
+		{
+			// Arrange
+			m_ConfigData.dataToSign = "dataToSign";
+			EXPECT_CALL(*m_ConfigStorage, GetConfig()).WillOnce([this] { return GetConfigSnapshot(); });
+			EXPECT_CALL(*m_WindowsHelloRepository, SignAsync)
+				.WillOnce([](auto, auto) -> Task<SecureBuffer> { co_return SecureBuffer{}; });
+			EXPECT_CALL(*m_WinrtEncryptRepository, CreateAESKey)
+				.WillOnce([](auto) { return std::make_shared<SymmetricKey>(); });
+			EXPECT_CALL(*m_WinrtEncryptRepository, Encrypt)
+				.WillOnce([](auto, auto) { return std::string("encrypted"); });
+
+			Tracer::Get().Clear();
+
+			// Act
+			auto asyncOp = m_Service->EncryptAsync("testTag", "someData");
+			asyncOp.get();
+			auto trace = Tracer::Get().ExportChromeTrace();
+
+			// Assert
+			EXPECT_NE(trace.find(R"("name":"EncryptAsync","cat":"biometric_cipher","ph":"b")"), std::string::npos);
+			EXPECT_NE(trace.find(R"("name":"EncryptAsync","cat":"biometric_cipher","ph":"e")"), std::string::npos);
+			EXPECT_NE(trace.find(R"("name":"CreateAESKeyAsync","cat":"biometric_cipher","ph":"b")"), std::string::npos);
+			EXPECT_NE(trace.find(R"("name":"SignAsync","cat":"biometric_cipher","ph":"s")"), std::string::npos);
+			EXPECT_NE(trace.find(R"("name":"SignAsync","cat":"biometric_cipher","ph":"f")"), std::string::npos);
+		}
+
+		TEST_F(BiometricCipherServiceTest, DecryptAsync_ReturnsDecryptedString)
+		{
+			const std::string decryptedString = "decrypted_plaintext";
+
+			m_ConfigData.dataToSign = "dataToSign";
+			EXPECT_CALL(*m_ConfigStorage, GetConfig())
+				.Times(1)
+				.WillOnce([this] { return GetConfigSnapshot(); });
+
+			// Mock the same interactions as encryption: SignAsync & CreateAESKey
+			EXPECT_CALL(*m_WindowsHelloRepository, SignAsync)
+				.Times(1)
+				.WillOnce([](auto, auto)-> Task<SecureBuffer>
+					{
+						co_return SecureBuffer{};
+					}
+				);
+			auto fakeAesKey = std::make_shared<SymmetricKey>();
+			EXPECT_CALL(*m_WinrtEncryptRepository, CreateAESKey)
+				.Times(1)
+				.WillOnce([&](auto)
+					{
+						return fakeAesKey;
+					}
+				);
+			// Mock the Decrypt call
+			EXPECT_CALL(*m_WinrtEncryptRepository, Decrypt)
+				.Times(1)
+				.WillOnce([&](auto, auto)
+					{
+						return SecureString(decryptedString);
+					}
+				);
+
+			// Act
+			auto asyncOp = m_Service->DecryptAsync("tag", "ciphertext_data");
+			auto result = asyncOp.get();
+
+			// Assert
+			EXPECT_EQ(result, decryptedString);
+		}
+		TEST_F(BiometricCipherServiceTest, EncryptBatchAsync_SignsOnceForAllPayloads)
+		{
+			m_ConfigData.dataToSign = "dataToSign";
+			EXPECT_CALL(*m_ConfigStorage, GetConfig())
+				.Times(1)
+				.WillOnce([this] { return GetConfigSnapshot(); });
+
+			// Only one signature (and therefore one Windows Hello prompt) is expected for the whole batch.
+			EXPECT_CALL(*m_WindowsHelloRepository, SignAsync)
+				.Times(1)
+				.WillOnce([](auto, auto) -> Task<SecureBuffer>
+					{
+						co_return SecureBuffer{};
+					}
+				);
+
+			auto fakeAesKey = std::make_shared<SymmetricKey>();
+			EXPECT_CALL(*m_WinrtEncryptRepository, CreateAESKey)
+				.Times(1)
+				.WillOnce([&](auto)
+					{
+						return fakeAesKey;
+					}
+				);
+
+			EXPECT_CALL(*m_WinrtEncryptRepository, Encrypt)
+				.Times(3)
+				.WillRepeatedly([](auto, const SecureString& data)
+					{
+						return "encrypted_" + std::string(data);
+					}
+				);
+
+			auto asyncOp = m_Service->EncryptBatchAsync("testTag", { "first", "second", "third" });
+			auto result = asyncOp.get();
+
+			// Assert: results are returned in the same order as the payloads
+			ASSERT_EQ(result.size(), 3u);
+			EXPECT_EQ(result[0], "encrypted_first");
+			EXPECT_EQ(result[1], "encrypted_second");
+			EXPECT_EQ(result[2], "encrypted_third");
+		}
+
+		TEST_F(BiometricCipherServiceTest, EncryptBatchAsync_DoesNotSignEmptyBatch)
+		{
+			EXPECT_CALL(*m_ConfigStorage, GetConfig())
+				.Times(1)
+				.WillOnce([this] { return GetConfigSnapshot(); });
+
+			EXPECT_CALL(*m_WindowsHelloRepository, SignAsync).Times(0);
+			EXPECT_CALL(*m_WinrtEncryptRepository, Encrypt).Times(0);
+
+			auto asyncOp = m_Service->EncryptBatchAsync("testTag", {});
+			auto result = asyncOp.get();
+
+			EXPECT_EQ(result.size(), 0u);
+		}
+
+		TEST_F(BiometricCipherServiceTest, DecryptBatchAsync_SignsOnceForAllPayloads)
+		{
+			m_ConfigData.dataToSign = "dataToSign";
+			EXPECT_CALL(*m_ConfigStorage, GetConfig())
+				.Times(1)
+				.WillOnce([this] { return GetConfigSnapshot(); });
+
+			EXPECT_CALL(*m_WindowsHelloRepository, SignAsync)
+				.Times(1)
+				.WillOnce([](auto, auto) -> Task<SecureBuffer>
+					{
+						co_return SecureBuffer{};
+					}
+				);
+
+			auto fakeAesKey = std::make_shared<SymmetricKey>();
+			EXPECT_CALL(*m_WinrtEncryptRepository, CreateAESKey)
+				.Times(1)
+				.WillOnce([&](auto)
+					{
+						return fakeAesKey;
+					}
+				);
+
+			EXPECT_CALL(*m_WinrtEncryptRepository, Decrypt)
+				.Times(2)
+				.WillRepeatedly([](auto, const std::string& data)
+					{
+						return SecureString("decrypted_" + data);
+					}
+				);
+
+			auto asyncOp = m_Service->DecryptBatchAsync("testTag", { "first", "second" });
+			auto result = asyncOp.get();
+
+			ASSERT_EQ(result.size(), 2u);
+			EXPECT_EQ(result[0], "decrypted_first");
+			EXPECT_EQ(result[1], "decrypted_second");
+		}
+
+		TEST_F(BiometricCipherServiceTest, DecryptBatchAsync_ThrowsIfNotConfigured)
+		{
+			EXPECT_CALL(*m_ConfigStorage, GetConfig())
+				.Times(1)
+				.WillOnce(testing::Return(nullptr));
+
+			EXPECT_CALL(*m_WindowsHelloRepository, SignAsync).Times(0);
+
+			EXPECT_THROW(
+				m_Service->DecryptBatchAsync("testTag", { "ciphertext" }).get(),
+				BiometricCipherException
+			);
+		}
+		TEST_F(BiometricCipherServiceTest, EncryptAsync_ReusesCachedKeyWithinSession)
+		{
+			auto sessionKeyCache = std::make_shared<SessionKeyCache>();
+			sessionKeyCache->Configure(std::chrono::seconds(60), 4);
+			m_Service = std::make_unique<BiometricCipherService>(
+				m_ConfigStorage,
+				m_WindowsHelloRepository,
+				m_WindowsTpmRepository,
+				m_WinrtEncryptRepository,
+				sessionKeyCache
+			);
+
+			m_ConfigData.dataToSign = "dataToSign";
+			EXPECT_CALL(*m_ConfigStorage, GetConfig())
+				.Times(2)
+				.WillRepeatedly([this] { return GetConfigSnapshot(); });
+
+			// The second call must be served from the cache without signing again.
+			EXPECT_CALL(*m_WindowsHelloRepository, SignAsync)
+				.Times(1)
+				.WillOnce([](auto, auto) -> Task<SecureBuffer>
+					{
+						co_return SecureBuffer{};
+					}
+				);
+
+			auto fakeAesKey = std::make_shared<SymmetricKey>();
+			EXPECT_CALL(*m_WinrtEncryptRepository, CreateAESKey)
+				.Times(1)
+				.WillOnce([&](auto)
+					{
+						return fakeAesKey;
+					}
+				);
+
+			EXPECT_CALL(*m_WinrtEncryptRepository, Encrypt)
+				.Times(2)
+				.WillRepeatedly([](auto, auto)
+					{
+						return std::string("encrypted");
+					}
+				);
+
+			m_Service->EncryptAsync("testTag", "first").get();
+			m_Service->EncryptAsync("testTag", "second").get();
+		}
+
+		TEST_F(BiometricCipherServiceTest, DecryptAsync_ConcurrentCallsForSameTagShareOneSignature)
+		{
+			AsyncGate signGate;
+			m_ConfigData.dataToSign = "dataToSign";
+			EXPECT_CALL(*m_ConfigStorage, GetConfig())
+				.WillRepeatedly([this] { return GetConfigSnapshot(); });
+
+			// Only one Windows Hello prompt for all three calls.
+			EXPECT_CALL(*m_WindowsHelloRepository, SignAsync(std::string("testTag"), testing::_))
+				.Times(1)
+				.WillOnce([&](auto, auto) -> Task<SecureBuffer>
+					{
+						co_await signGate;
+						co_return SecureBuffer{ 1, 2, 3 };
+					}
+				);
+
+			auto fakeAesKey = std::make_shared<SymmetricKey>();
+			EXPECT_CALL(*m_WinrtEncryptRepository, CreateAESKey)
+				.Times(1)
+				.WillOnce([&](auto)
+					{
+						return fakeAesKey;
+					}
+				);
+
+			EXPECT_CALL(*m_WinrtEncryptRepository, Decrypt(fakeAesKey, testing::_))
+				.Times(3)
+				.WillRepeatedly([](auto, const std::string& data)
+					{
+						return SecureString("plain-" + data);
+					}
+				);
+
+			auto first = m_Service->DecryptAsync("testTag", "1");
+			auto second = m_Service->DecryptAsync("testTag", "2");
+			auto third = m_Service->DecryptAsync("testTag", "3");
+			EXPECT_FALSE(first.IsCompleted());
+
+			signGate.Open();
+
+			EXPECT_EQ(first.get(), "plain-1");
+			EXPECT_EQ(second.get(), "plain-2");
+			EXPECT_EQ(third.get(), "plain-3");
+		}
+
+		TEST_F(BiometricCipherServiceTest, DecryptAsync_ConcurrentCallsShareSigningFailure)
+		{
+			AsyncGate signGate;
+			m_ConfigData.dataToSign = "dataToSign";
+			EXPECT_CALL(*m_ConfigStorage, GetConfig())
+				.WillRepeatedly([this] { return GetConfigSnapshot(); });
+
+			EXPECT_CALL(*m_WindowsHelloRepository, SignAsync)
+				.Times(1)
+				.WillOnce([&](auto, auto) -> Task<SecureBuffer>
+					{
+						co_await signGate;
+						throw BiometricCipherException(error_authentication_canceled, "User canceled the operation.");
+					}
+				);
+			EXPECT_CALL(*m_WinrtEncryptRepository, CreateAESKey).Times(0);
+
+			auto first = m_Service->DecryptAsync("testTag", "1");
+			auto second = m_Service->DecryptAsync("testTag", "2");
+
+			signGate.Open();
+
+			EXPECT_THROW(first.get(), BiometricCipherException);
+			EXPECT_THROW(second.get(), BiometricCipherException);
+		}
+
+		TEST_F(BiometricCipherServiceTest, DecryptAsync_ConcurrentCallsForDifferentTagsSignSeparately)
+		{
+			AsyncGate signGate;
+			m_ConfigData.dataToSign = "dataToSign";
+			EXPECT_CALL(*m_ConfigStorage, GetConfig())
+				.WillRepeatedly([this] { return GetConfigSnapshot(); });
+
+			EXPECT_CALL(*m_WindowsHelloRepository, SignAsync)
+				.Times(2)
+				.WillRepeatedly([&](auto, auto) -> Task<SecureBuffer>
+					{
+						co_await signGate;
+						co_return SecureBuffer{};
+					}
+				);
+			EXPECT_CALL(*m_WinrtEncryptRepository, CreateAESKey)
+				.Times(2)
+				.WillRepeatedly([](auto)
+					{
+						return std::make_shared<SymmetricKey>();
+					}
+				);
+			EXPECT_CALL(*m_WinrtEncryptRepository, Decrypt)
+				.Times(2)
+				.WillRepeatedly([](auto, auto)
+					{
+						return SecureString("plain");
+					}
+				);
+
+			auto first = m_Service->DecryptAsync("tag1", "1");
+			auto second = m_Service->DecryptAsync("tag2", "2");
+
+			signGate.Open();
+
+			EXPECT_EQ(first.get(), "plain");
+			EXPECT_EQ(second.get(), "plain");
+		}
+
+		TEST_F(BiometricCipherServiceTest, LockKeyCache_KeepsPendingDerivationOutOfCache)
+		{
+			auto sessionKeyCache = std::make_shared<SessionKeyCache>();
+			sessionKeyCache->Configure(std::chrono::seconds(60), 4);
+			m_Service = std::make_unique<BiometricCipherService>(
+				m_ConfigStorage,
+				m_WindowsHelloRepository,
+				m_WindowsTpmRepository,
+				m_WinrtEncryptRepository,
+				sessionKeyCache
+			);
+
+			AsyncGate signGate;
+			m_ConfigData.dataToSign = "dataToSign";
+			EXPECT_CALL(*m_ConfigStorage, GetConfig())
+				.WillRepeatedly([this] { return GetConfigSnapshot(); });
+
+			// The call after the lock must prompt again.
+			EXPECT_CALL(*m_WindowsHelloRepository, SignAsync)
+				.Times(2)
+				.WillOnce([&](auto, auto) -> Task<SecureBuffer>
+					{
+						co_await signGate;
+						co_return SecureBuffer{};
+					}
+				)
+				.WillOnce([](auto, auto) -> Task<SecureBuffer>
+					{
+						co_return SecureBuffer{};
+					}
+				);
+			EXPECT_CALL(*m_WinrtEncryptRepository, CreateAESKey)
+				.Times(2)
+				.WillRepeatedly([](auto)
+					{
+						return std::make_shared<SymmetricKey>();
+					}
+				);
+			EXPECT_CALL(*m_WinrtEncryptRepository, Decrypt)
+				.Times(2)
+				.WillRepeatedly([](auto, auto)
+					{
+						return SecureString("plain");
+					}
+				);
+
+			auto pending = m_Service->DecryptAsync("testTag", "1");
+			m_Service->LockKeyCache();
+			signGate.Open();
+
+			EXPECT_EQ(pending.get(), "plain");
+			EXPECT_EQ(sessionKeyCache->Get("testTag"), nullptr);
+			EXPECT_EQ(m_Service->DecryptAsync("testTag", "2").get(), "plain");
+		}
+
+		TEST_F(BiometricCipherServiceTest, Configure_KeepsKeySignedOverPreviousDataOutOfCache)
+		{
+			auto sessionKeyCache = std::make_shared<SessionKeyCache>();
+			m_Service = std::make_unique<BiometricCipherService>(
+				m_ConfigStorage,
+				m_WindowsHelloRepository,
+				m_WindowsTpmRepository,
+				m_WinrtEncryptRepository,
+				sessionKeyCache
+			);
+
+			AsyncGate signGate;
+			m_ConfigData = ConfigData("oldDataToSign", 60, 4);
+			sessionKeyCache->Configure(std::chrono::seconds(60), 4);
+			EXPECT_CALL(*m_ConfigStorage, GetConfig())
+				.WillRepeatedly([this] { return GetConfigSnapshot(); });
+			EXPECT_CALL(*m_ConfigStorage, SetConfigData)
+				.WillOnce([&](const ConfigData& data)
+					{
+						m_ConfigData = data;
+					});
+
+			// The call after Configure must sign the new data rather than reuse the key
+			// signed over the old data.
+			std::vector<SecureBuffer> signedData;
+			EXPECT_CALL(*m_WindowsHelloRepository, SignAsync)
+				.Times(2)
+				.WillOnce([&](auto, SecureBuffer data) -> Task<SecureBuffer>
+					{
+						signedData.push_back(data);
+						co_await signGate;
+						co_return SecureBuffer{};
+					}
+				)
+				.WillOnce([&](auto, SecureBuffer data) -> Task<SecureBuffer>
+					{
+						signedData.push_back(data);
+						co_return SecureBuffer{};
+					}
+				);
+			EXPECT_CALL(*m_WinrtEncryptRepository, CreateAESKey)
+				.Times(2)
+				.WillRepeatedly([](auto)
+					{
+						return std::make_shared<SymmetricKey>();
+					}
+				);
+			EXPECT_CALL(*m_WinrtEncryptRepository, Decrypt)
+				.Times(2)
+				.WillRepeatedly([](auto, auto)
+					{
+						return SecureString("plain");
+					}
+				);
+
+			auto pending = m_Service->DecryptAsync("testTag", "1");
+			m_Service->Configure(ConfigData("newDataToSign", 60, 4));
+			signGate.Open();
+
+			EXPECT_EQ(pending.get(), "plain");
+			EXPECT_EQ(m_Service->DecryptAsync("testTag", "2").get(), "plain");
+			ASSERT_EQ(signedData.size(), 2u);
+			EXPECT_NE(signedData[0], signedData[1]);
+		}
+
+		TEST_F(BiometricCipherServiceTest, DeleteKeyAsync_InvalidatesCachedKey)
+		{
+			auto sessionKeyCache = std::make_shared<SessionKeyCache>();
+			sessionKeyCache->Configure(std::chrono::seconds(60), 4);
+			sessionKeyCache->Put("delete_tag", std::make_shared<SymmetricKey>(), sessionKeyCache->GetGeneration());
+			m_Service = std::make_unique<BiometricCipherService>(
+				m_ConfigStorage,
+				m_WindowsHelloRepository,
+				m_WindowsTpmRepository,
+				m_WinrtEncryptRepository,
+				sessionKeyCache
+			);
+
+			EXPECT_CALL(*m_WindowsHelloRepository, DeleteCredentialAsync)
+				.Times(1)
+				.WillOnce([](auto) -> Task<>
+					{
+						co_return;
+					});
+
+			m_Service->DeleteKeyAsync("delete_tag").get();
+
+			EXPECT_EQ(sessionKeyCache->Get("delete_tag"), nullptr);
+		}
+
+		TEST_F(BiometricCipherServiceTest, Configure_StoresConfigAndClearsCachedKeys)
+		{
+			auto sessionKeyCache = std::make_shared<SessionKeyCache>();
+			sessionKeyCache->Configure(std::chrono::seconds(60), 4);
+			sessionKeyCache->Put("tag", std::make_shared<SymmetricKey>(), sessionKeyCache->GetGeneration());
+			m_Service = std::make_unique<BiometricCipherService>(
+				m_ConfigStorage,
+				m_WindowsHelloRepository,
+				m_WindowsTpmRepository,
+				m_WinrtEncryptRepository,
+				sessionKeyCache
+			);
+
+			ConfigData configData("newDataToSign", 120, 8);
+			EXPECT_CALL(*m_ConfigStorage, SetConfigData)
+				.Times(1)
+				.WillOnce([](const ConfigData& data)
+					{
+						EXPECT_EQ(data.dataToSign, "newDataToSign");
+					});
+
+			m_Service->Configure(configData);
+
+			EXPECT_EQ(sessionKeyCache->Get("tag"), nullptr);
+			EXPECT_TRUE(sessionKeyCache->IsEnabled());
+		}
+		TEST_F(BiometricCipherServiceTest, Configure_AppliesBiometryStatusCacheTtl)
+		{
+			auto biometryStatusCache = std::make_shared<BiometryStatusCache>();
+			m_Service = std::make_unique<BiometricCipherService>(
+				m_ConfigStorage,
+				m_WindowsHelloRepository,
+				m_WindowsTpmRepository,
+				m_WinrtEncryptRepository,
+				nullptr,
+				biometryStatusCache
+			);
+			EXPECT_CALL(*m_ConfigStorage, SetConfigData).Times(2);
+
+			ConfigData configData("dataToSign");
+			m_Service->Configure(configData);
+			biometryStatusCache->Put(BiometryStatusToInteger(BiometryStatus::kSupported));
+			EXPECT_EQ(biometryStatusCache->Get(), BiometryStatusToInteger(BiometryStatus::kSupported));
+
+			configData.biometryStatusCacheTtlSeconds = 0;
+			m_Service->Configure(configData);
+			biometryStatusCache->Put(BiometryStatusToInteger(BiometryStatus::kSupported));
+			EXPECT_EQ(biometryStatusCache->Get(), std::nullopt);
+		}
+
+		TEST_F(BiometricCipherServiceTest, EncryptBinaryAsync_PassesRawBytesToRepository)
+		{
+			const SecureBuffer payload = { 0x00, 0x01, 0xFE, 0xFF };
+
+			m_ConfigData.dataToSign = "dataToSign";
+			EXPECT_CALL(*m_ConfigStorage, GetConfig())
+				.Times(1)
+				.WillOnce([this] { return GetConfigSnapshot(); });
+
+			EXPECT_CALL(*m_WindowsHelloRepository, SignAsync)
+				.Times(1)
+				.WillOnce([](auto, auto) -> Task<SecureBuffer>
+					{
+						co_return SecureBuffer{};
+					}
+				);
+
+			auto fakeAesKey = std::make_shared<SymmetricKey>();
+			EXPECT_CALL(*m_WinrtEncryptRepository, CreateAESKey)
+				.Times(1)
+				.WillOnce([&](auto)
+					{
+						return fakeAesKey;
+					}
+				);
+
+			// The payload must reach the repository unchanged: no UTF-16 widening, no Base64.
+			EXPECT_CALL(*m_WinrtEncryptRepository, EncryptBinary)
+				.Times(1)
+				.WillOnce([&](auto, const SecureBuffer& data)
+					{
+						EXPECT_EQ(data, payload);
+						return std::vector<uint8_t>(data.begin(), data.end());
+					}
+				);
+
+			auto result = m_Service->EncryptBinaryAsync("testTag", payload).get();
+
+			EXPECT_EQ(result, std::vector<uint8_t>(payload.begin(), payload.end()));
+		}
+
+		TEST_F(BiometricCipherServiceTest, DecryptBinaryAsync_ThrowsIfNotConfigured)
+		{
+			EXPECT_CALL(*m_ConfigStorage, GetConfig())
+				.Times(1)
+				.WillOnce(testing::Return(nullptr));
+
+			EXPECT_CALL(*m_WindowsHelloRepository, SignAsync).Times(0);
+
+			EXPECT_THROW(
+				m_Service->DecryptBinaryAsync("testTag", { 0x01 }).get(),
+				BiometricCipherException
+			);
+		}
+
+		TEST_F(BiometricCipherServiceTest, EncryptBinaryAsync_WithContextEncryptsUnderSubkey)
+		{
+			m_ConfigData.dataToSign = "dataToSign";
+			EXPECT_CALL(*m_ConfigStorage, GetConfig())
+				.Times(1)
+				.WillOnce([this] { return GetConfigSnapshot(); });
+
+			EXPECT_CALL(*m_WindowsHelloRepository, SignAsync)
+				.Times(1)
+				.WillOnce([](auto, auto) -> Task<SecureBuffer>
+					{
+						co_return SecureBuffer{};
+					}
+				);
+
+			auto fakeAesKey = std::make_shared<SymmetricKey>();
+			EXPECT_CALL(*m_WinrtEncryptRepository, CreateAESKey)
+				.Times(1)
+				.WillOnce([&](auto)
+					{
+						return fakeAesKey;
+					}
+				);
+
+			auto fakeSubkey = std::make_shared<SymmetricKey>();
+			EXPECT_CALL(*m_WinrtEncryptRepository, DeriveSubkey(fakeAesKey, std::string_view("vault/1")))
+				.Times(1)
+				.WillOnce(testing::Return(fakeSubkey));
+
+			EXPECT_CALL(*m_WinrtEncryptRepository, EncryptBinary(fakeSubkey, testing::_))
+				.Times(1)
+				.WillOnce(testing::Return(std::vector<uint8_t>{ 0x01 }));
+
+			auto result = m_Service->EncryptBinaryAsync("testTag", { 0x02 }, "vault/1").get();
+
+			EXPECT_EQ(result, std::vector<uint8_t>{ 0x01 });
+		}
+
+		TEST_F(BiometricCipherServiceTest, DeriveSubkeysAsync_ThrowsIfNotConfigured)
+		{
+			EXPECT_CALL(*m_ConfigStorage, GetConfig())
+				.Times(1)
+				.WillOnce(testing::Return(nullptr));
+
+			EXPECT_CALL(*m_WindowsHelloRepository, SignAsync).Times(0);
+			EXPECT_CALL(*m_WinrtEncryptRepository, DeriveSubkey).Times(0);
+
+			try {
+				m_Service->DeriveSubkeysAsync("testTag", { "vault/1" }).get();
+				FAIL() << "Expected BiometricCipherException";
+			}
+			catch (const BiometricCipherException& e) {
+				EXPECT_EQ(e.Code(), error_invalid_argument);
+			}
+		}
+	}  // namespace test
+}  // namespace biometric_cipher
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+
+// Include the code under test
+#include "include/biometric_cipher/storages/biometry_status_cache.h"
+
+namespace biometric_cipher {
+	namespace test {
+
+		using namespace biometric_cipher;
+
+		class BiometryStatusCacheTest : public ::testing::Test {
+		protected:
+			BiometryStatusCache::Clock::time_point m_Now{};
+
+			std::unique_ptr<BiometryStatusCache> m_Cache;
+
+			void SetUp() override
+			{
+				m_Cache = std::make_unique<BiometryStatusCache>([this] { return m_Now; });
+			}
+		};
+
+		TEST_F(BiometryStatusCacheTest, IsDisabledByDefault)
+		{
+			m_Cache->Put(0);
+
+			EXPECT_EQ(m_Cache->Get(), std::nullopt);
+		}
+
+		TEST_F(BiometryStatusCacheTest, Get_ReturnsStatusWithinTtl)
+		{
+			m_Cache->Configure(std::chrono::seconds(5));
+			m_Cache->Put(3);
+
+			m_Now += std::chrono::seconds(4);
+
+			EXPECT_EQ(m_Cache->Get(), 3);
+		}
+
+		TEST_F(BiometryStatusCacheTest, Get_DropsStatusAfterTtl)
+		{
+			m_Cache->Configure(std::chrono::seconds(5));
+			m_Cache->Put(3);
+
+			m_Now += std::chrono::seconds(5);
+
+			EXPECT_EQ(m_Cache->Get(), std::nullopt);
+		}
+
+		TEST_F(BiometryStatusCacheTest, Invalidate_DropsStatus)
+		{
+			m_Cache->Configure(std::chrono::seconds(5));
+			m_Cache->Put(3);
+
+			m_Cache->Invalidate();
+
+			EXPECT_EQ(m_Cache->Get(), std::nullopt);
+		}
+
+		TEST_F(BiometryStatusCacheTest, Configure_DropsStatus)
+		{
+			m_Cache->Configure(std::chrono::seconds(5));
+			m_Cache->Put(3);
+
+			m_Cache->Configure(std::chrono::seconds(10));
+
+			EXPECT_EQ(m_Cache->Get(), std::nullopt);
+		}
+	}  // namespace test
+}  // namespace biometric_cipher
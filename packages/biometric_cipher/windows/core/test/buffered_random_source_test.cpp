@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "fakes/fake_random_source.h"
+
+// Include the code under test
+#include "include/biometric_cipher/common/buffered_random_source.h"
+
+namespace biometric_cipher {
+	namespace test {
+
+		using namespace biometric_cipher;
+
+		class BufferedRandomSourceTest : public ::testing::Test {
+		protected:
+			static constexpr size_t BUFFER_LENGTH = 64;
+
+			FakeRandomSource m_Entropy;
+
+			BufferedRandomSource::EntropyFunction GetEntropyFunction()
+			{
+				return [this](uint8_t* output, size_t length) { m_Entropy.Fill(output, length); };
+			}
+
+			std::vector<uint8_t> GetExpectedBytes(uint64_t position, size_t length) const
+			{
+				std::vector<uint8_t> bytes(length);
+				for (size_t i = 0; i < length; ++i) {
+					bytes[i] = m_Entropy.GetByte(position + i);
+				}
+
+				return bytes;
+			}
+		};
+
+		TEST_F(BufferedRandomSourceTest, Fill_ServesSmallRequestsFromOneEntropyCall)
+		{
+			BufferedRandomSource source(GetEntropyFunction(), BUFFER_LENGTH);
+
+			std::vector<uint8_t> first(12);
+			std::vector<uint8_t> second(12);
+			source.Fill(first.data(), first.size());
+			source.Fill(second.data(), second.size());
+
+			EXPECT_EQ(m_Entropy.GetFillCount(), 1);
+			EXPECT_EQ(m_Entropy.GetPosition(), BUFFER_LENGTH);
+			EXPECT_EQ(first, GetExpectedBytes(0, 12));
+			EXPECT_EQ(second, GetExpectedBytes(12, 12));
+		}
+
+		TEST_F(BufferedRandomSourceTest, Fill_RefillsWhenTheRestIsTooShort)
+		{
+			BufferedRandomSource source(GetEntropyFunction(), BUFFER_LENGTH);
+
+			// Five 12-byte nonces fit in 64 bytes; the sixth starts a new buffer.
+			std::vector<uint8_t> nonce(12);
+			for (int i = 0; i < 5; ++i) {
+				source.Fill(nonce.data(), nonce.size());
+			}
+			EXPECT_EQ(m_Entropy.GetFillCount(), 1);
+
+			source.Fill(nonce.data(), nonce.size());
+
+			EXPECT_EQ(m_Entropy.GetFillCount(), 2);
+			EXPECT_EQ(nonce, GetExpectedBytes(BUFFER_LENGTH, 12));
+		}
+
+		TEST_F(BufferedRandomSourceTest, Fill_LargeRequestsBypassTheBuffer)
+		{
+			BufferedRandomSource source(GetEntropyFunction(), BUFFER_LENGTH);
+
+			std::vector<uint8_t> large(BUFFER_LENGTH);
+			source.Fill(large.data(), large.size());
+
+			EXPECT_EQ(m_Entropy.GetFillCount(), 1);
+			EXPECT_EQ(large, GetExpectedBytes(0, BUFFER_LENGTH));
+		}
+
+		TEST_F(BufferedRandomSourceTest, Fill_EachThreadHasItsOwnBuffer)
+		{
+			BufferedRandomSource source(GetEntropyFunction(), BUFFER_LENGTH);
+			const int threadCount = 4;
+			const int noncesPerThread = 50;
+			const size_t nonceLength = 12;
+
+			std::vector<std::vector<std::vector<uint8_t>>> nonces(threadCount);
+			std::vector<std::thread> threads;
+			for (int t = 0; t < threadCount; ++t) {
+				threads.emplace_back([&, t]() {
+					for (int i = 0; i < noncesPerThread; ++i) {
+						std::vector<uint8_t> nonce(nonceLength);
+						source.Fill(nonce.data(), nonce.size());
+						nonces[t].push_back(nonce);
+					}
+				});
+			}
+			for (auto& thread : threads) {
+				thread.join();
+			}
+
+			// Every nonce is a distinct slice of the entropy stream. The nonces are compared with
+			// memcmp over their fixed length: comparing the vectors themselves makes GCC 12 warn
+			// about the memcmp bound in optimized builds.
+			std::vector<std::vector<uint8_t>> all;
+			for (const auto& threadNonces : nonces) {
+				all.insert(all.end(), threadNonces.begin(), threadNonces.end());
+			}
+			std::sort(all.begin(), all.end(), [&](const auto& a, const auto& b) {
+				return std::memcmp(a.data(), b.data(), nonceLength) < 0;
+			});
+			auto duplicate = std::adjacent_find(all.begin(), all.end(), [&](const auto& a, const auto& b) {
+				return std::memcmp(a.data(), b.data(), nonceLength) == 0;
+			});
+			EXPECT_EQ(all.size(), static_cast<size_t>(threadCount * noncesPerThread));
+			EXPECT_EQ(duplicate, all.end());
+			EXPECT_EQ(m_Entropy.GetFillCount(), threadCount * ((noncesPerThread + 4) / 5));
+		}
+
+		TEST_F(BufferedRandomSourceTest, Fill_SourcesDoNotShareBuffers)
+		{
+			FakeRandomSource otherEntropy(7);
+			BufferedRandomSource source(GetEntropyFunction(), BUFFER_LENGTH);
+			BufferedRandomSource otherSource(
+				[&otherEntropy](uint8_t* output, size_t length) { otherEntropy.Fill(output, length); },
+				BUFFER_LENGTH);
+
+			std::vector<uint8_t> nonce(12);
+			source.Fill(nonce.data(), nonce.size());
+			otherSource.Fill(nonce.data(), nonce.size());
+
+			EXPECT_EQ(nonce, std::vector<uint8_t>({
+				otherEntropy.GetByte(0), otherEntropy.GetByte(1), otherEntropy.GetByte(2), otherEntropy.GetByte(3),
+				otherEntropy.GetByte(4), otherEntropy.GetByte(5), otherEntropy.GetByte(6), otherEntropy.GetByte(7),
+				otherEntropy.GetByte(8), otherEntropy.GetByte(9), otherEntropy.GetByte(10), otherEntropy.GetByte(11) }));
+
+			// Switching back starts a fresh buffer instead of reusing the old one.
+			source.Fill(nonce.data(), nonce.size());
+			EXPECT_EQ(m_Entropy.GetFillCount(), 2);
+			EXPECT_EQ(nonce, GetExpectedBytes(BUFFER_LENGTH, 12));
+		}
+
+		TEST_F(BufferedRandomSourceTest, Fill_EntropyFailureLeavesBufferEmpty)
+		{
+			bool shouldFail = true;
+			BufferedRandomSource source([&](uint8_t* output, size_t length) {
+				if (shouldFail) {
+					throw std::runtime_error("no entropy");
+				}
+				m_Entropy.Fill(output, length);
+			}, BUFFER_LENGTH);
+
+			std::vector<uint8_t> nonce(12);
+			EXPECT_THROW(source.Fill(nonce.data(), nonce.size()), std::runtime_error);
+
+			shouldFail = false;
+			source.Fill(nonce.data(), nonce.size());
+
+			EXPECT_EQ(nonce, GetExpectedBytes(0, 12));
+		}
+	}
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+// Include the code under test
+#include "include/biometric_cipher/common/chacha20_poly1305.h"
+
+namespace biometric_cipher {
+	namespace test {
+
+		using namespace biometric_cipher;
+
+		class ChaCha20Poly1305Test : public ::testing::Test {
+		protected:
+			static std::vector<uint8_t> FromHex(const std::string& hex)
+			{
+				std::vector<uint8_t> bytes;
+				for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+					bytes.push_back(static_cast<uint8_t>(std::stoi(hex.substr(i, 2), nullptr, 16)));
+				}
+
+				return bytes;
+			}
+
+			static std::vector<uint8_t> MakeData(size_t length, uint32_t seed)
+			{
+				std::mt19937 generator(seed);
+				std::vector<uint8_t> data(length);
+				for (auto& byte : data) {
+					byte = static_cast<uint8_t>(generator());
+				}
+
+				return data;
+			}
+
+			const std::vector<uint8_t> m_Key = MakeData(ChaCha20Poly1305::KEY_LENGTH, 1);
+
+			const std::vector<uint8_t> m_Nonce = MakeData(ChaCha20Poly1305::NONCE_LENGTH, 2);
+		};
+
+		// RFC 8439, section 2.8.2.
+		TEST_F(ChaCha20Poly1305Test, EncryptDecrypt_MatchRfc8439Vector)
+		{
+			auto key = FromHex("808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f");
+			auto nonce = FromHex("070000004041424344454647");
+			auto aad = FromHex("50515253c0c1c2c3c4c5c6c7");
+			std::string text = "Ladies and Gentlemen of the class of '99: If I could offer you only one tip "
+				"for the future, sunscreen would be it.";
+			std::vector<uint8_t> plaintext(text.begin(), text.end());
+			auto expectedCiphertext = FromHex(
+				"d31a8d34648e60db7b86afbc53ef7ec2a4aded51296e08fea9e2b5a736ee62d6"
+				"3dbea45e8ca9671282fafb69da92728b1a71de0a9e060b2905d6a5b67ecd3b36"
+				"92ddbd7f2d778b8c9803aee328091b58fab324e4fad675945585808b4831d7bc"
+				"3ff4def08e4b7a9de576d26586cec64b6116");
+			auto expectedTag = FromHex("1ae10b594f09e26a7e902ecbd0600691");
+
+			std::vector<uint8_t> ciphertext(plaintext.size());
+			std::vector<uint8_t> tag(ChaCha20Poly1305::TAG_LENGTH);
+			ChaCha20Poly1305::Encrypt(key.data(), nonce.data(), aad.data(), aad.size(),
+				plaintext.data(), plaintext.size(), ciphertext.data(), tag.data());
+
+			EXPECT_EQ(ciphertext, expectedCiphertext);
+			EXPECT_EQ(tag, expectedTag);
+
+			std::vector<uint8_t> decrypted(ciphertext.size());
+			EXPECT_TRUE(ChaCha20Poly1305::Decrypt(key.data(), nonce.data(), aad.data(), aad.size(),
+				ciphertext.data(), ciphertext.size(), tag.data(), decrypted.data()));
+			EXPECT_EQ(decrypted, plaintext);
+		}
+
+		TEST_F(ChaCha20Poly1305Test, EncryptDecrypt_RoundTripAllLengths)
+		{
+			auto aad = MakeData(7, 3);
+			for (size_t length = 0; length <= 200; ++length) {
+				auto plaintext = MakeData(length, static_cast<uint32_t>(length) + 10);
+				std::vector<uint8_t> ciphertext(length);
+				std::vector<uint8_t> tag(ChaCha20Poly1305::TAG_LENGTH);
+				ChaCha20Poly1305::Encrypt(m_Key.data(), m_Nonce.data(), aad.data(), aad.size(),
+					plaintext.data(), length, ciphertext.data(), tag.data());
+
+				std::vector<uint8_t> decrypted(length);
+				ASSERT_TRUE(ChaCha20Poly1305::Decrypt(m_Key.data(), m_Nonce.data(), aad.data(), aad.size(),
+					ciphertext.data(), length, tag.data(), decrypted.data())) << length;
+				EXPECT_EQ(decrypted, plaintext) << length;
+			}
+		}
+
+		TEST_F(ChaCha20Poly1305Test, EncryptDecrypt_WorkInPlace)
+		{
+			auto plaintext = MakeData(1000, 4);
+			auto data = plaintext;
+			std::vector<uint8_t> tag(ChaCha20Poly1305::TAG_LENGTH);
+			ChaCha20Poly1305::Encrypt(m_Key.data(), m_Nonce.data(), nullptr, 0,
+				data.data(), data.size(), data.data(), tag.data());
+			EXPECT_NE(data, plaintext);
+
+			EXPECT_TRUE(ChaCha20Poly1305::Decrypt(m_Key.data(), m_Nonce.data(), nullptr, 0,
+				data.data(), data.size(), tag.data(), data.data()));
+			EXPECT_EQ(data, plaintext);
+		}
+
+		TEST_F(ChaCha20Poly1305Test, Decrypt_RejectsTamperingWithoutWritingOutput)
+		{
+			auto plaintext = MakeData(100, 5);
+			auto aad = MakeData(10, 6);
+			std::vector<uint8_t> ciphertext(plaintext.size());
+			std::vector<uint8_t> tag(ChaCha20Poly1305::TAG_LENGTH);
+			ChaCha20Poly1305::Encrypt(m_Key.data(), m_Nonce.data(), aad.data(), aad.size(),
+				plaintext.data(), plaintext.size(), ciphertext.data(), tag.data());
+
+			auto tryDecrypt = [&](std::vector<uint8_t> key, std::vector<uint8_t> nonce, std::vector<uint8_t> additional,
+				std::vector<uint8_t> data, std::vector<uint8_t> expectedTag) {
+				std::vector<uint8_t> output(data.size(), 0xAA);
+				bool isValid = ChaCha20Poly1305::Decrypt(key.data(), nonce.data(), additional.data(), additional.size(),
+					data.data(), data.size(), expectedTag.data(), output.data());
+				EXPECT_EQ(output, std::vector<uint8_t>(data.size(), 0xAA));
+
+				return isValid;
+			};
+
+			auto tamperedCiphertext = ciphertext;
+			tamperedCiphertext[42] ^= 0x01;
+			EXPECT_FALSE(tryDecrypt(m_Key, m_Nonce, aad, tamperedCiphertext, tag));
+
+			auto tamperedTag = tag;
+			tamperedTag[15] ^= 0x80;
+			EXPECT_FALSE(tryDecrypt(m_Key, m_Nonce, aad, ciphertext, tamperedTag));
+
+			auto tamperedAad = aad;
+			tamperedAad[0] ^= 0x01;
+			EXPECT_FALSE(tryDecrypt(m_Key, m_Nonce, tamperedAad, ciphertext, tag));
+
+			auto otherNonce = m_Nonce;
+			otherNonce[11] ^= 0x01;
+			EXPECT_FALSE(tryDecrypt(m_Key, otherNonce, aad, ciphertext, tag));
+
+			auto otherKey = m_Key;
+			otherKey[0] ^= 0x01;
+			EXPECT_FALSE(tryDecrypt(otherKey, m_Nonce, aad, ciphertext, tag));
+		}
+	}  // namespace test
+}  // namespace biometric_cipher
@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <vector>
+
+// Include the code under test
+#include "include/biometric_cipher/common/aead_suite_selector.h"
+#include "include/biometric_cipher/common/aes_gcm.h"
+#include "include/biometric_cipher/common/ciphertext_envelope.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+
+namespace biometric_cipher {
+	namespace test {
+
+		using namespace biometric_cipher;
+
+		class CiphertextEnvelopeTest : public ::testing::TestWithParam<AeadSuite> {
+		protected:
+			static std::vector<uint8_t> MakeData(size_t length, uint32_t seed)
+			{
+				std::mt19937 generator(seed);
+				std::vector<uint8_t> data(length);
+				for (auto& byte : data) {
+					byte = static_cast<uint8_t>(generator());
+				}
+
+				return data;
+			}
+
+			std::vector<uint8_t> Seal(const std::vector<uint8_t>& plaintext) const
+			{
+				std::vector<uint8_t> envelope(CiphertextEnvelope::GetSealedLength(plaintext.size()));
+				CiphertextEnvelope::Seal(GetParam(), m_Key, m_Nonce.data(), plaintext.data(), plaintext.size(), envelope.data());
+
+				return envelope;
+			}
+
+			std::optional<std::vector<uint8_t>> Open(const AeadKey& key, const std::vector<uint8_t>& envelope) const
+			{
+				std::vector<uint8_t> output(CiphertextEnvelope::GetMaxPlaintextLength(envelope.size()));
+				auto length = CiphertextEnvelope::Open(key, envelope, output.data());
+				if (!length) {
+					return std::nullopt;
+				}
+				output.resize(*length);
+
+				return output;
+			}
+
+			// What Encrypt returned before the envelope had a header.
+			std::vector<uint8_t> SealLegacy(const std::vector<uint8_t>& plaintext, const std::vector<uint8_t>& nonce) const
+			{
+				std::vector<uint8_t> envelope(nonce);
+				envelope.resize(CiphertextEnvelope::LEGACY_OVERHEAD + plaintext.size());
+				AesGcm::Encrypt(m_KeyBytes.data(), nonce.data(), nullptr, 0, plaintext.data(), plaintext.size(),
+					envelope.data() + AesGcm::NONCE_LENGTH, envelope.data() + AesGcm::NONCE_LENGTH + plaintext.size());
+
+				return envelope;
+			}
+
+			const std::vector<uint8_t> m_KeyBytes = MakeData(AeadKey::KEY_LENGTH, 1);
+
+			const AeadKey m_Key{ m_KeyBytes.data() };
+
+			const std::vector<uint8_t> m_Nonce = MakeData(AeadKey::NONCE_LENGTH, 2);
+		};
+
+		TEST_P(CiphertextEnvelopeTest, Seal_WritesHeaderAndRoundTrips)
+		{
+			for (size_t length : { size_t{ 0 }, size_t{ 1 }, size_t{ 64 }, size_t{ 1000 } }) {
+				auto plaintext = MakeData(length, 3);
+				auto envelope = Seal(plaintext);
+
+				ASSERT_EQ(envelope.size(), CiphertextEnvelope::OVERHEAD + length);
+				EXPECT_EQ(envelope[0], CiphertextEnvelope::MAGIC[0]);
+				EXPECT_EQ(envelope[1], CiphertextEnvelope::MAGIC[1]);
+				EXPECT_EQ(envelope[2], CiphertextEnvelope::VERSION);
+				EXPECT_EQ(envelope[3], static_cast<uint8_t>(GetParam()));
+				EXPECT_EQ(envelope[4], 0);
+				EXPECT_EQ(CiphertextEnvelope::ParseHeader(envelope), GetParam());
+
+				EXPECT_EQ(Open(m_Key, envelope), plaintext);
+			}
+		}
+
+		TEST_P(CiphertextEnvelopeTest, Open_RejectsTamperedEnvelopes)
+		{
+			auto envelope = Seal(MakeData(100, 4));
+
+			for (size_t offset : { size_t{ 3 }, size_t{ 4 }, CiphertextEnvelope::HEADER_LENGTH,
+				CiphertextEnvelope::HEADER_LENGTH + AeadKey::NONCE_LENGTH + 50, envelope.size() - 1 }) {
+				auto tampered = envelope;
+				tampered[offset] ^= 0x01;
+				EXPECT_EQ(Open(m_Key, tampered), std::nullopt) << offset;
+			}
+
+			// Switching the suite is caught too, not just by chance.
+			auto otherSuite = envelope;
+			otherSuite[3] = static_cast<uint8_t>(GetParam() == AeadSuite::kAes256Gcm
+				? AeadSuite::kChaCha20Poly1305 : AeadSuite::kAes256Gcm);
+			EXPECT_EQ(Open(m_Key, otherSuite), std::nullopt);
+
+			auto otherKeyBytes = m_KeyBytes;
+			otherKeyBytes[0] ^= 0x01;
+			EXPECT_EQ(Open(AeadKey(otherKeyBytes.data()), envelope), std::nullopt);
+		}
+
+		INSTANTIATE_TEST_SUITE_P(
+			Suites,
+			CiphertextEnvelopeTest,
+			::testing::Values(AeadSuite::kAes256Gcm, AeadSuite::kChaCha20Poly1305));
+
+		using CiphertextEnvelopeLegacyTest = CiphertextEnvelopeTest;
+
+		TEST_P(CiphertextEnvelopeLegacyTest, Open_DecodesLegacyEnvelopes)
+		{
+			auto plaintext = MakeData(100, 5);
+			auto legacy = SealLegacy(plaintext, m_Nonce);
+
+			EXPECT_EQ(CiphertextEnvelope::ParseHeader(legacy), std::nullopt);
+			EXPECT_EQ(Open(m_Key, legacy), plaintext);
+			EXPECT_EQ(Open(m_Key, SealLegacy({}, m_Nonce)), std::vector<uint8_t>());
+		}
+
+		TEST_P(CiphertextEnvelopeLegacyTest, Open_DecodesLegacyEnvelopesThatLookVersioned)
+		{
+			auto nonce = m_Nonce;
+			nonce[0] = CiphertextEnvelope::MAGIC[0];
+			nonce[1] = CiphertextEnvelope::MAGIC[1];
+			nonce[2] = CiphertextEnvelope::VERSION;
+			nonce[3] = static_cast<uint8_t>(AeadSuite::kAes256Gcm);
+			nonce[4] = 0;
+
+			auto plaintext = MakeData(100, 6);
+			auto legacy = SealLegacy(plaintext, nonce);
+
+			EXPECT_EQ(CiphertextEnvelope::ParseHeader(legacy), AeadSuite::kAes256Gcm);
+			EXPECT_EQ(Open(m_Key, legacy), plaintext);
+		}
+
+		INSTANTIATE_TEST_SUITE_P(Aes256Gcm, CiphertextEnvelopeLegacyTest, ::testing::Values(AeadSuite::kAes256Gcm));
+
+		TEST(CiphertextEnvelopeHeaderTest, ParseHeader_RejectsUnknownVersionsSuitesAndFlags)
+		{
+			std::vector<uint8_t> envelope(CiphertextEnvelope::OVERHEAD);
+			envelope[0] = CiphertextEnvelope::MAGIC[0];
+			envelope[1] = CiphertextEnvelope::MAGIC[1];
+			envelope[2] = CiphertextEnvelope::VERSION;
+			envelope[3] = static_cast<uint8_t>(AeadSuite::kChaCha20Poly1305);
+			EXPECT_EQ(CiphertextEnvelope::ParseHeader(envelope), AeadSuite::kChaCha20Poly1305);
+
+			auto truncated = envelope;
+			truncated.pop_back();
+			EXPECT_EQ(CiphertextEnvelope::ParseHeader(truncated), std::nullopt);
+
+			auto otherVersion = envelope;
+			otherVersion[2] = CiphertextEnvelope::VERSION + 1;
+			EXPECT_EQ(CiphertextEnvelope::ParseHeader(otherVersion), std::nullopt);
+
+			auto unknownSuite = envelope;
+			unknownSuite[3] = 0;
+			EXPECT_EQ(CiphertextEnvelope::ParseHeader(unknownSuite), std::nullopt);
+			unknownSuite[3] = 3;
+			EXPECT_EQ(CiphertextEnvelope::ParseHeader(unknownSuite), std::nullopt);
+
+			auto unknownFlag = envelope;
+			unknownFlag[4] = 0x01;
+			EXPECT_EQ(CiphertextEnvelope::ParseHeader(unknownFlag), std::nullopt);
+		}
+
+		TEST(CiphertextEnvelopeHeaderTest, GetMaxPlaintextLength_ThrowsForShortEnvelopes)
+		{
+			EXPECT_EQ(CiphertextEnvelope::GetMaxPlaintextLength(CiphertextEnvelope::LEGACY_OVERHEAD), 0u);
+			EXPECT_EQ(CiphertextEnvelope::GetMaxPlaintextLength(CiphertextEnvelope::OVERHEAD + 10),
+				CiphertextEnvelope::HEADER_LENGTH + 10);
+
+			try {
+				CiphertextEnvelope::GetMaxPlaintextLength(CiphertextEnvelope::LEGACY_OVERHEAD - 1);
+				FAIL() << "Expected BiometricCipherException";
+			}
+			catch (const BiometricCipherException& e) {
+				EXPECT_EQ(e.Code(), error_decrypt);
+			}
+		}
+
+		TEST(AeadSuiteSelectorTest, Choose_PrefersAesGcmUnlessChaChaIsClearlyFaster)
+		{
+			using std::chrono::nanoseconds;
+
+			EXPECT_EQ(AeadSuiteSelector::Choose(nanoseconds(1000), nanoseconds(5000)), AeadSuite::kAes256Gcm);
+			EXPECT_EQ(AeadSuiteSelector::Choose(nanoseconds(1000), nanoseconds(900)), AeadSuite::kAes256Gcm);
+			EXPECT_EQ(AeadSuiteSelector::Choose(nanoseconds(5000), nanoseconds(1000)), AeadSuite::kChaCha20Poly1305);
+		}
+
+		TEST(AeadSuiteSelectorTest, GetPreferredSuite_IsStable)
+		{
+			auto suite = AeadSuiteSelector::GetPreferredSuite();
+
+			EXPECT_TRUE(ByteToAeadSuite(static_cast<uint8_t>(suite)).has_value());
+			EXPECT_EQ(AeadSuiteSelector::GetPreferredSuite(), suite);
+		}
+	}  // namespace test
+}  // namespace biometric_cipher
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+
+// Include the code under test
+#include "include/biometric_cipher/storages/config_storage.h"
+
+namespace biometric_cipher {
+	namespace test {
+
+		using namespace biometric_cipher;
+
+		TEST(ConfigStorageTest, GetConfig_ReturnsNullUntilConfigured)
+		{
+			ConfigStorage storage;
+
+			EXPECT_EQ(storage.GetConfig(), nullptr);
+		}
+
+		TEST(ConfigStorageTest, GetConfig_SnapshotOutlivesReconfiguration)
+		{
+			ConfigStorage storage;
+			storage.SetConfigData(ConfigData("first"));
+			auto snapshot = storage.GetConfig();
+
+			storage.SetConfigData(ConfigData("second"));
+
+			ASSERT_NE(snapshot, nullptr);
+			EXPECT_EQ(snapshot->dataToSign, "first");
+			EXPECT_EQ(storage.GetConfig()->dataToSign, "second");
+		}
+
+		TEST(ConfigStorageTest, SetConfigData_InvalidConfigLeavesStorageUnconfigured)
+		{
+			ConfigStorage storage;
+			storage.SetConfigData(ConfigData("dataToSign"));
+
+			EXPECT_THROW(storage.SetConfigData(ConfigData("")), BiometricCipherException);
+
+			EXPECT_EQ(storage.GetConfig(), nullptr);
+		}
+
+		TEST(ConfigStorageTest, GetConfig_ReadersSeeWholeConfigurations)
+		{
+			// Different lengths, so that a torn read would show up as a mix of the two.
+			const std::string first(40, 'a');
+			const std::string second(50, 'b');
+			ConfigStorage storage;
+			storage.SetConfigData(ConfigData(first));
+
+			std::thread writer([&] {
+				for (int i = 0; i < 1000; ++i) {
+					storage.SetConfigData(ConfigData(i % 2 ? first : second));
+				}
+			});
+
+			for (int i = 0; i < 1000; ++i) {
+				if (auto snapshot = storage.GetConfig()) {
+					std::string_view data(snapshot->dataToSign.data(), snapshot->dataToSign.size());
+					EXPECT_TRUE(data == first || data == second);
+				}
+			}
+
+			writer.join();
+		}
+	}  // namespace test
+}  // namespace biometric_cipher
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "include/biometric_cipher/common/executor.h"
+
+#include <deque>
+#include <mutex>
+#include <utility>
+
+namespace biometric_cipher {
+	namespace test {
+		// Stands in for the platform thread: posted work only runs when the test calls
+		// RunPending(), on the test's own thread.
+		class FakeExecutor : public Executor {
+		public:
+			void Post(Work work) override
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_Queue.push_back(std::move(work));
+			}
+
+			size_t RunPending()
+			{
+				std::deque<Work> queue;
+				{
+					std::lock_guard<std::mutex> lock(m_Mutex);
+					queue.swap(m_Queue);
+				}
+
+				for (auto& work : queue) {
+					work();
+				}
+
+				return queue.size();
+			}
+
+			size_t GetPendingCount() const
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+
+				return m_Queue.size();
+			}
+
+		private:
+			mutable std::mutex m_Mutex;
+			std::deque<Work> m_Queue;
+		};
+	}  // namespace test
+}  // namespace biometric_cipher
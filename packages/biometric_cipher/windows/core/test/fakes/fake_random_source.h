@@ -0,0 +1,52 @@
+#pragma once
+
+#include "include/biometric_cipher/common/random_source.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace biometric_cipher {
+	namespace test {
+		// Deterministic stand-in for the system RNG: byte i of the stream is a function of the
+		// seed and i only, so tests can predict every nonce. NOT random.
+		class FakeRandomSource : public RandomSource {
+		public:
+			explicit FakeRandomSource(uint8_t seed = 0)
+				: m_Seed(seed) {}
+
+			void Fill(uint8_t* output, size_t length) override
+			{
+				auto offset = m_Position.fetch_add(length);
+				for (size_t i = 0; i < length; ++i) {
+					output[i] = GetByte(offset + i);
+				}
+				++m_FillCount;
+			}
+
+			// SplitMix64 of the position, so that no two slices of the stream are alike.
+			uint8_t GetByte(uint64_t position) const
+			{
+				uint64_t z = position + (static_cast<uint64_t>(m_Seed) << 56) + 0x9E3779B97F4A7C15ull;
+				z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+				z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+
+				return static_cast<uint8_t>(z ^ (z >> 31));
+			}
+
+			uint64_t GetPosition() const
+			{
+				return m_Position;
+			}
+
+			int GetFillCount() const
+			{
+				return m_FillCount;
+			}
+
+		private:
+			const uint8_t m_Seed;
+			std::atomic<uint64_t> m_Position{ 0 };
+			std::atomic<int> m_FillCount{ 0 };
+		};
+	}
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "include/biometric_cipher/enums/biometry_status.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+#include "include/biometric_cipher/repositories/windows_hello_repository.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace biometric_cipher {
+	namespace test {
+		// In-process stand-in for Windows Hello: credentials live in memory and signing
+		// completes immediately without any user interaction. Like Hello's RSA signatures,
+		// the signature is deterministic for a given credential and data.
+		class FakeWindowsHelloRepository : public WindowsHelloRepository {
+		public:
+			explicit FakeWindowsHelloRepository(BiometryStatus status = BiometryStatus::kSupported)
+				: m_Status(status) {}
+
+			Task<int> GetWindowsHelloStatusAsync() const override
+			{
+				co_return BiometryStatusToInteger(m_Status);
+			}
+
+			Task<SecureBuffer> SignAsync(const std::string tag, const SecureBuffer data) const override
+			{
+				CheckIsSupported();
+
+				SecureBuffer signature;
+				{
+					std::lock_guard<std::mutex> lock(m_Mutex);
+					auto it = m_Credentials.find(tag);
+					if (it == m_Credentials.end()) {
+						throw BiometricCipherException(error_key_not_found, "Key credential not found.");
+					}
+					signature.assign(it->second.begin(), it->second.end());
+				}
+
+				signature.insert(signature.end(), data.begin(), data.end());
+				++m_SignCount;
+
+				co_return signature;
+			}
+
+			Task<> CreateCredentialAsync(const std::string tag) const override
+			{
+				CheckIsSupported();
+
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				if (m_Credentials.count(tag)) {
+					throw BiometricCipherException(error_key_already_exists, "Key credential already exists.");
+				}
+
+				auto secret = ++m_NextSecret;
+				std::vector<uint8_t> credential(tag.begin(), tag.end());
+				for (int i = 0; i < 8; ++i) {
+					credential.push_back(static_cast<uint8_t>(secret >> (i * 8)));
+				}
+				m_Credentials.emplace(tag, std::move(credential));
+
+				co_return;
+			}
+
+			Task<> DeleteCredentialAsync(const std::string tag) const override
+			{
+				CheckIsSupported();
+
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				if (m_Credentials.erase(tag) == 0) {
+					throw BiometricCipherException(error_no_key, "Key credential not found.");
+				}
+
+				co_return;
+			}
+
+			size_t GetSignCount() const
+			{
+				return m_SignCount;
+			}
+
+		private:
+			void CheckIsSupported() const
+			{
+				if (m_Status != BiometryStatus::kSupported) {
+					throw BiometricCipherException(error_biometry_not_supported, "Windows Hello is not supported.");
+				}
+			}
+
+			BiometryStatus m_Status;
+
+			mutable std::mutex m_Mutex;
+			mutable std::unordered_map<std::string, std::vector<uint8_t>> m_Credentials;
+			mutable uint64_t m_NextSecret = 0;
+			mutable std::atomic<size_t> m_SignCount{ 0 };
+		};
+	}  // namespace test
+}  // namespace biometric_cipher
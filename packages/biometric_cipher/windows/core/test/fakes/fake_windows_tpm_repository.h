@@ -0,0 +1,23 @@
+#pragma once
+
+#include "include/biometric_cipher/repositories/windows_tpm_repository.h"
+
+namespace biometric_cipher {
+	namespace test {
+		class FakeWindowsTpmRepository : public WindowsTpmRepository {
+		public:
+			explicit FakeWindowsTpmRepository(int version = 2)
+				: m_Version(version) {}
+
+			int GetWindowsTpmVersion() const override
+			{
+				return m_Version;
+			}
+
+			void Refresh() const override {}
+
+		private:
+			int m_Version;
+		};
+	}  // namespace test
+}  // namespace biometric_cipher
@@ -0,0 +1,212 @@
+#pragma once
+
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+#include "include/biometric_cipher/repositories/winrt_encrypt_repository.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace biometric_cipher {
+	namespace test {
+		// Deterministic, dependency-free stand-in for the WinRT AES-GCM repository. It keeps the
+		// nonce | ciphertext | tag envelope and rejects ciphertexts produced under another key or
+		// modified in transit, but it is NOT encryption and must never leave the test tree.
+		class FakeWinrtEncryptRepository : public WinrtEncryptRepository {
+		public:
+			static const uint32_t NONCE_LENGTH = 12;
+
+			static const uint32_t TAG_LENGTH = 16;
+
+			struct FakeSymmetricKey : SymmetricKey {
+				std::array<uint8_t, 32> bytes{};
+			};
+
+			std::shared_ptr<SymmetricKey> CreateAESKey(const SecureBuffer& signature) const override
+			{
+				auto key = std::make_shared<FakeSymmetricKey>();
+				for (size_t i = 0; i < key->bytes.size(); ++i) {
+					key->bytes[i] = static_cast<uint8_t>(Hash(signature.data(), signature.size(), i) & 0xFF);
+				}
+
+				return key;
+			}
+
+			std::shared_ptr<SymmetricKey> DeriveSubkey(const std::shared_ptr<SymmetricKey>& key, std::string_view context) const override
+			{
+				auto& keyBytes = GetKeyBytes(key);
+				std::vector<uint8_t> input(keyBytes.begin(), keyBytes.end());
+				input.insert(input.end(), context.begin(), context.end());
+
+				auto subkey = std::make_shared<FakeSymmetricKey>();
+				for (size_t i = 0; i < subkey->bytes.size(); ++i) {
+					subkey->bytes[i] = static_cast<uint8_t>(Hash(input.data(), input.size(), i) & 0xFF);
+				}
+
+				return subkey;
+			}
+
+			std::string Encrypt(const std::shared_ptr<SymmetricKey>& key, const SecureString& data) const override
+			{
+				auto encryptedData = EncryptBinary(key, SecureBuffer(data.begin(), data.end()));
+
+				return EncodeToHex(encryptedData);
+			}
+
+			SecureString Decrypt(const std::shared_ptr<SymmetricKey>& key, const std::string& data) const override
+			{
+				auto decryptedData = DecryptBinary(key, DecodeFromHex(data));
+
+				return SecureString(decryptedData.begin(), decryptedData.end());
+			}
+
+			std::vector<uint8_t> EncryptBinary(const std::shared_ptr<SymmetricKey>& key, const SecureBuffer& data) const override
+			{
+				auto& keyBytes = GetKeyBytes(key);
+				auto counter = ++m_NonceCounter;
+
+				std::vector<uint8_t> output(NONCE_LENGTH + data.size() + TAG_LENGTH);
+				for (uint32_t i = 0; i < NONCE_LENGTH; ++i) {
+					output[i] = static_cast<uint8_t>(counter >> ((i % 8) * 8));
+				}
+				for (size_t i = 0; i < data.size(); ++i) {
+					output[NONCE_LENGTH + i] = data[i] ^ keyBytes[i % keyBytes.size()] ^ output[i % NONCE_LENGTH];
+				}
+				ComputeTag(keyBytes, output.data(), NONCE_LENGTH + data.size(), output.data() + NONCE_LENGTH + data.size());
+
+				return output;
+			}
+
+			SecureBuffer DecryptBinary(const std::shared_ptr<SymmetricKey>& key, const std::vector<uint8_t>& data) const override
+			{
+				if (data.size() < NONCE_LENGTH + TAG_LENGTH) {
+					throw BiometricCipherException(error_decrypt, "Encrypted data is too short or corrupted.");
+				}
+
+				auto& keyBytes = GetKeyBytes(key);
+				auto encryptedLength = data.size() - NONCE_LENGTH - TAG_LENGTH;
+
+				uint8_t expectedTag[TAG_LENGTH];
+				ComputeTag(keyBytes, data.data(), NONCE_LENGTH + encryptedLength, expectedTag);
+				if (!std::equal(expectedTag, expectedTag + TAG_LENGTH, data.data() + NONCE_LENGTH + encryptedLength)) {
+					throw BiometricCipherException(error_decrypt, "Authentication tag mismatch.");
+				}
+
+				SecureBuffer output(encryptedLength);
+				for (size_t i = 0; i < encryptedLength; ++i) {
+					output[i] = data[NONCE_LENGTH + i] ^ keyBytes[i % keyBytes.size()] ^ data[i % NONCE_LENGTH];
+				}
+
+				return output;
+			}
+
+			// Streams are real AES-GCM under the fake key bytes: the segmentation is what the
+			// service tests exercise, and it lives in the core library.
+			std::unique_ptr<EncryptStream> CreateEncryptStream(const std::shared_ptr<SymmetricKey>& key) const override
+			{
+				auto counter = ++m_NonceCounter;
+
+				uint8_t baseNonce[NONCE_LENGTH];
+				for (uint32_t i = 0; i < NONCE_LENGTH; ++i) {
+					baseNonce[i] = static_cast<uint8_t>(counter >> ((i % 8) * 8));
+				}
+
+				return std::make_unique<EncryptStream>(GetStreamKey(key), baseNonce, STREAM_SEGMENT_LENGTH);
+			}
+
+			std::unique_ptr<DecryptStream> CreateDecryptStream(
+				const std::shared_ptr<SymmetricKey>& key,
+				std::span<const uint8_t> header) const override
+			{
+				return std::make_unique<DecryptStream>(GetStreamKey(key), header);
+			}
+
+			// Short, so that small test payloads span several segments.
+			static constexpr uint32_t STREAM_SEGMENT_LENGTH = 64;
+
+		private:
+			static std::shared_ptr<const AesGcmKey> GetStreamKey(const std::shared_ptr<SymmetricKey>& key)
+			{
+				return std::make_shared<const AesGcmKey>(GetKeyBytes(key).data());
+			}
+
+			static const std::array<uint8_t, 32>& GetKeyBytes(const std::shared_ptr<SymmetricKey>& key)
+			{
+				auto fakeKey = std::dynamic_pointer_cast<FakeSymmetricKey>(key);
+				if (!fakeKey) {
+					throw BiometricCipherException(error_invalid_argument, "Key was not created by this repository.");
+				}
+
+				return fakeKey->bytes;
+			}
+
+			// FNV-1a, salted with the output position.
+			static uint64_t Hash(const uint8_t* data, size_t length, uint64_t salt)
+			{
+				uint64_t hash = 0xCBF29CE484222325ULL ^ (salt * 0x9E3779B97F4A7C15ULL);
+				for (size_t i = 0; i < length; ++i) {
+					hash ^= data[i];
+					hash *= 0x100000001B3ULL;
+				}
+
+				return hash;
+			}
+
+			static void ComputeTag(const std::array<uint8_t, 32>& keyBytes, const uint8_t* data, size_t length, uint8_t* tag)
+			{
+				std::vector<uint8_t> input(keyBytes.begin(), keyBytes.end());
+				input.insert(input.end(), data, data + length);
+
+				for (uint32_t i = 0; i < TAG_LENGTH; ++i) {
+					tag[i] = static_cast<uint8_t>(Hash(input.data(), input.size(), i) & 0xFF);
+				}
+			}
+
+			static std::string EncodeToHex(const std::vector<uint8_t>& data)
+			{
+				static const char kDigits[] = "0123456789abcdef";
+
+				std::string output;
+				output.reserve(data.size() * 2);
+				for (auto byte : data) {
+					output.push_back(kDigits[byte >> 4]);
+					output.push_back(kDigits[byte & 0x0F]);
+				}
+
+				return output;
+			}
+
+			static std::vector<uint8_t> DecodeFromHex(const std::string& data)
+			{
+				auto decodeDigit = [](char digit) -> int {
+					if (digit >= '0' && digit <= '9') return digit - '0';
+					if (digit >= 'a' && digit <= 'f') return digit - 'a' + 10;
+					return -1;
+				};
+
+				if (data.size() % 2 != 0) {
+					throw BiometricCipherException(error_decrypt, "Encrypted data is not valid hex.");
+				}
+
+				std::vector<uint8_t> output(data.size() / 2);
+				for (size_t i = 0; i < output.size(); ++i) {
+					auto high = decodeDigit(data[i * 2]);
+					auto low = decodeDigit(data[i * 2 + 1]);
+					if (high < 0 || low < 0) {
+						throw BiometricCipherException(error_decrypt, "Encrypted data is not valid hex.");
+					}
+					output[i] = static_cast<uint8_t>((high << 4) | low);
+				}
+
+				return output;
+			}
+
+			mutable std::atomic<uint64_t> m_NonceCounter{ 0 };
+		};
+	}  // namespace test
+}  // namespace biometric_cipher
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <coroutine>
+#include <mutex>
+#include <vector>
+
+namespace biometric_cipher {
+	namespace test {
+		// Awaitable that keeps every coroutine awaiting it suspended until Open() is called,
+		// which resumes them on the calling thread. Lets tests hold an asynchronous operation
+		// "in flight" for as long as they need.
+		class AsyncGate {
+		public:
+			auto operator co_await()
+			{
+				struct Awaiter {
+					AsyncGate& gate;
+
+					bool await_ready() const
+					{
+						std::lock_guard<std::mutex> lock(gate.m_Mutex);
+
+						return gate.m_IsOpen;
+					}
+
+					bool await_suspend(std::coroutine_handle<> waiter) const
+					{
+						std::lock_guard<std::mutex> lock(gate.m_Mutex);
+						if (gate.m_IsOpen) {
+							return false;
+						}
+
+						gate.m_Waiters.push_back(waiter);
+
+						return true;
+					}
+
+					void await_resume() const noexcept {}
+				};
+
+				return Awaiter{ *this };
+			}
+
+			void Open()
+			{
+				std::vector<std::coroutine_handle<>> waiters;
+				{
+					std::lock_guard<std::mutex> lock(m_Mutex);
+					m_IsOpen = true;
+					waiters.swap(m_Waiters);
+				}
+
+				for (auto waiter : waiters) {
+					waiter.resume();
+				}
+			}
+
+			size_t GetWaiterCount() const
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+
+				return m_Waiters.size();
+			}
+
+		private:
+			mutable std::mutex m_Mutex;
+			bool m_IsOpen = false;
+			std::vector<std::coroutine_handle<>> m_Waiters;
+		};
+	}  // namespace test
+}  // namespace biometric_cipher
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Include the code under test
+#include "include/biometric_cipher/common/latency_histogram.h"
+
+namespace biometric_cipher {
+	namespace test {
+
+		using namespace biometric_cipher;
+		using std::chrono::nanoseconds;
+
+		TEST(LatencyHistogramTest, GetBucketIndex_BoundsContainTheirValues)
+		{
+			std::vector<uint64_t> values;
+			for (uint64_t value = 0; value < 4096; ++value) {
+				values.push_back(value);
+			}
+			for (uint64_t value = 4096; value < (uint64_t{ 1 } << 41); value = value * 3 / 2 + 1) {
+				values.push_back(value);
+			}
+
+			for (auto value : values) {
+				auto index = LatencyHistogram::GetBucketIndex(value);
+
+				ASSERT_LT(index, LatencyHistogram::BUCKET_COUNT) << value;
+				EXPECT_LE(value, LatencyHistogram::GetBucketUpperBound(index)) << value;
+				if (index > 0) {
+					EXPECT_GT(value, LatencyHistogram::GetBucketUpperBound(index - 1)) << value;
+				}
+			}
+		}
+
+		TEST(LatencyHistogramTest, GetBucketIndex_KeepsRelativeErrorWithinOneEighth)
+		{
+			for (uint64_t value = 8; value < (uint64_t{ 1 } << 40); value = value * 5 / 4 + 3) {
+				auto upperBound = LatencyHistogram::GetBucketUpperBound(LatencyHistogram::GetBucketIndex(value));
+
+				EXPECT_LE(upperBound - value, value / 8) << value;
+			}
+		}
+
+		TEST(LatencyHistogramTest, GetBucketIndex_ClampsHugeValues)
+		{
+			EXPECT_EQ(LatencyHistogram::GetBucketIndex(UINT64_MAX), LatencyHistogram::BUCKET_COUNT - 1);
+		}
+
+		TEST(LatencyHistogramTest, GetSnapshot_ReportsPercentiles)
+		{
+			// Arrange
+			LatencyHistogram histogram;
+			for (int64_t i = 1; i <= 1000; ++i) {
+				histogram.Record(nanoseconds(i * 1000));
+			}
+
+			// Act
+			auto snapshot = histogram.GetSnapshot();
+
+			// Assert
+			EXPECT_EQ(snapshot.count, 1000u);
+			EXPECT_EQ(snapshot.total, nanoseconds(500500000));
+			EXPECT_EQ(snapshot.max, nanoseconds(1000000));
+			EXPECT_GE(snapshot.p50, nanoseconds(500000));
+			EXPECT_LE(snapshot.p50, nanoseconds(500000 + 500000 / 8));
+			EXPECT_GE(snapshot.p90, nanoseconds(900000));
+			EXPECT_LE(snapshot.p90, nanoseconds(900000 + 900000 / 8));
+			EXPECT_GE(snapshot.p99, nanoseconds(990000));
+			EXPECT_LE(snapshot.p99, snapshot.max);
+		}
+
+		TEST(LatencyHistogramTest, GetSnapshot_IsEmptyWithoutSamples)
+		{
+			LatencyHistogram histogram;
+
+			auto snapshot = histogram.GetSnapshot();
+
+			EXPECT_EQ(snapshot.count, 0u);
+			EXPECT_EQ(snapshot.p99, nanoseconds(0));
+		}
+
+		TEST(LatencyHistogramTest, Record_CountsNegativeDurationsAsZero)
+		{
+			LatencyHistogram histogram;
+
+			histogram.Record(nanoseconds(-5));
+
+			auto snapshot = histogram.GetSnapshot();
+			EXPECT_EQ(snapshot.count, 1u);
+			EXPECT_EQ(snapshot.max, nanoseconds(0));
+		}
+
+		TEST(LatencyHistogramTest, Record_FromManyThreadsLosesNoSamples)
+		{
+			// Arrange
+			LatencyHistogram histogram;
+			const int threadCount = 8;
+			const int samplesPerThread = 10000;
+
+			// Act
+			std::vector<std::thread> threads;
+			for (int t = 0; t < threadCount; ++t) {
+				threads.emplace_back([&histogram, t] {
+					for (int i = 0; i < samplesPerThread; ++i) {
+						histogram.Record(nanoseconds(t * 1000 + i));
+					}
+				});
+			}
+			for (auto& thread : threads) {
+				thread.join();
+			}
+
+			// Assert
+			auto snapshot = histogram.GetSnapshot();
+			EXPECT_EQ(snapshot.count, static_cast<uint64_t>(threadCount * samplesPerThread));
+			EXPECT_EQ(snapshot.max, nanoseconds((threadCount - 1) * 1000 + samplesPerThread - 1));
+		}
+	}
+}
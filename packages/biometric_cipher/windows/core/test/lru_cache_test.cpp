@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+// Include the code under test
+#include "include/biometric_cipher/common/lru_cache.h"
+
+namespace biometric_cipher {
+	namespace test {
+
+		using namespace biometric_cipher;
+
+		TEST(LruCacheTest, Get_ReturnsStoredValue)
+		{
+			LruCache<std::string, int> cache(2);
+			cache.Put("first", 1);
+
+			EXPECT_EQ(cache.Get("first"), 1);
+			EXPECT_EQ(cache.Get("second"), std::nullopt);
+		}
+
+		TEST(LruCacheTest, Put_ReplacesExistingValue)
+		{
+			LruCache<std::string, int> cache(2);
+			cache.Put("first", 1);
+			cache.Put("first", 2);
+
+			EXPECT_EQ(cache.Get("first"), 2);
+			EXPECT_EQ(cache.Size(), 1u);
+		}
+
+		TEST(LruCacheTest, Put_EvictsLeastRecentlyUsedWhenFull)
+		{
+			LruCache<std::string, int> cache(2);
+			cache.Put("first", 1);
+			cache.Put("second", 2);
+			cache.Get("first");
+
+			cache.Put("third", 3);
+
+			EXPECT_EQ(cache.Get("first"), 1);
+			EXPECT_EQ(cache.Get("second"), std::nullopt);
+			EXPECT_EQ(cache.Get("third"), 3);
+		}
+
+		TEST(LruCacheTest, Erase_RemovesOnlyGivenKey)
+		{
+			LruCache<std::string, int> cache(2);
+			cache.Put("first", 1);
+			cache.Put("second", 2);
+
+			cache.Erase("first");
+			cache.Erase("missing");
+
+			EXPECT_EQ(cache.Get("first"), std::nullopt);
+			EXPECT_EQ(cache.Get("second"), 2);
+		}
+
+		TEST(LruCacheTest, Clear_RemovesEverything)
+		{
+			LruCache<std::string, int> cache(2);
+			cache.Put("first", 1);
+			cache.Put("second", 2);
+
+			cache.Clear();
+
+			EXPECT_EQ(cache.Size(), 0u);
+		}
+
+		TEST(LruCacheTest, ZeroCapacity_StoresNothing)
+		{
+			LruCache<std::string, int> cache(0);
+			cache.Put("first", 1);
+
+			EXPECT_EQ(cache.Get("first"), std::nullopt);
+		}
+	}  // namespace test
+}  // namespace biometric_cipher
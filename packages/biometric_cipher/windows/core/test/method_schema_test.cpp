@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+
+// Include the code under test
+#include "include/biometric_cipher/enums/method_schema.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+
+namespace biometric_cipher {
+	namespace test {
+
+		using namespace biometric_cipher;
+
+		TEST(MethodSchemaTest, GetMethodName_FindsEveryMethodByItsName)
+		{
+			for (const auto& schema : METHOD_SCHEMAS) {
+				EXPECT_EQ(GetMethodName(schema.name), schema.method) << schema.name;
+			}
+		}
+
+		TEST(MethodSchemaTest, GetMethodName_ReturnsNotImplementedForUnknownNames)
+		{
+			EXPECT_EQ(GetMethodName(""), MethodName::kNotImplemented);
+			EXPECT_EQ(GetMethodName("Encrypt"), MethodName::kNotImplemented);
+			EXPECT_EQ(GetMethodName("encryptWithSomethingElse"), MethodName::kNotImplemented);
+			EXPECT_EQ(GetMethodName("zzz"), MethodName::kNotImplemented);
+		}
+
+		TEST(MethodSchemaTest, GetMethodName_AcceptsNamesThatAreNotNullTerminated)
+		{
+			// Arrange
+			const std::string buffer = "encryptBatch";
+
+			// Act
+			auto method = GetMethodName(std::string_view(buffer).substr(0, 7));
+
+			// Assert
+			EXPECT_EQ(method, MethodName::kEncrypt);
+		}
+
+		TEST(MethodSchemaTest, GetArgumentName_ReturnsChannelNames)
+		{
+			EXPECT_EQ(GetArgumentName(ArgumentName::kTag), "tag");
+			EXPECT_EQ(GetArgumentName(ArgumentName::kData), "data");
+			EXPECT_EQ(GetArgumentName(ArgumentName::kWindowsBiometryStatusCacheTtlSeconds), "windowsBiometryStatusCacheTtlSeconds");
+			EXPECT_EQ(GetArgumentName(ArgumentName::kContext), "context");
+			EXPECT_EQ(GetArgumentName(ArgumentName::kChunkIndex), "chunkIndex");
+		}
+
+		TEST(MethodSchemaTest, GetArgumentName_ThrowsForOutOfRangeValue)
+		{
+			EXPECT_THROW(GetArgumentName(static_cast<ArgumentName>(ARGUMENT_NAME_COUNT)), BiometricCipherException);
+		}
+
+		TEST(MethodSchemaTest, GetMethodSchema_DescribesArguments)
+		{
+			static_assert(TakesArgument(MethodName::kEncrypt, ArgumentName::kData, ArgumentType::kStringOrBinary));
+			static_assert(TakesArgument(MethodName::kEncryptBatch, ArgumentName::kData, ArgumentType::kStringList));
+			static_assert(!TakesArgument(MethodName::kEncryptBatch, ArgumentName::kData, ArgumentType::kStringOrBinary));
+			static_assert(!TakesArgument(MethodName::kNotImplemented, ArgumentName::kTag, ArgumentType::kString));
+			static_assert(TakesArgument(MethodName::kEncryptStreamChunk, ArgumentName::kStreamId, ArgumentType::kUInt));
+			static_assert(!TakesArgument(MethodName::kEncryptStreamChunk, ArgumentName::kTag, ArgumentType::kString));
+			static_assert(TakesArgument(MethodName::kDecryptStreamEnd, ArgumentName::kChunkIndex, ArgumentType::kUInt));
+			static_assert(TakesArgument(MethodName::kDecryptBatch, ArgumentName::kContext, ArgumentType::kOptionalString));
+			static_assert(!TakesArgument(MethodName::kGenerateKey, ArgumentName::kContext, ArgumentType::kOptionalString));
+
+			EXPECT_EQ(GetMethodSchema(MethodName::kGetTPMStatus)->GetArguments().size(), 0u);
+			EXPECT_EQ(GetMethodSchema(MethodName::kConfigure)->GetArguments().size(), 5u);
+			EXPECT_EQ(GetMethodSchema(MethodName::kNotImplemented), nullptr);
+		}
+	}
+}
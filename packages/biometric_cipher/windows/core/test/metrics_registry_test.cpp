@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+
+// Include the code under test
+#include "include/biometric_cipher/common/metrics_registry.h"
+
+namespace biometric_cipher {
+	namespace test {
+
+		using namespace biometric_cipher;
+		using std::chrono::milliseconds;
+
+		TEST(MetricsRegistryTest, GetSnapshot_ListsOnlyCalledMethods)
+		{
+			// Arrange
+			MetricsRegistry metrics;
+			metrics.RecordCall(MethodName::kEncrypt, milliseconds(2));
+			metrics.RecordCall(MethodName::kEncrypt, milliseconds(4));
+			metrics.RecordCall(MethodName::kGetTPMStatus, milliseconds(1));
+
+			// Act
+			auto snapshot = metrics.GetSnapshot();
+
+			// Assert
+			ASSERT_EQ(snapshot.methods.size(), 2u);
+			EXPECT_EQ(snapshot.methods[0].method, MethodName::kGetTPMStatus);
+			EXPECT_EQ(snapshot.methods[0].calls, 1u);
+			EXPECT_EQ(snapshot.methods[1].method, MethodName::kEncrypt);
+			EXPECT_EQ(snapshot.methods[1].calls, 2u);
+			EXPECT_EQ(snapshot.methods[1].latency.count, 2u);
+			EXPECT_EQ(snapshot.methods[1].latency.max, milliseconds(4));
+		}
+
+		TEST(MetricsRegistryTest, RecordError_CountsByErrorCodeString)
+		{
+			// Arrange
+			MetricsRegistry metrics;
+			metrics.RecordError(MethodName::kDecrypt, error_decrypt);
+			metrics.RecordError(MethodName::kDecrypt, error_decrypt);
+			metrics.RecordError(MethodName::kEncrypt, error_authentication_canceled);
+			// Both reach Dart as UNKNOWN_ERROR.
+			metrics.RecordError(MethodName::kEncrypt, error_fail);
+			metrics.RecordError(MethodName::kEncrypt, static_cast<ErrorCode>(0x12345678));
+
+			// Act
+			auto snapshot = metrics.GetSnapshot();
+
+			// Assert
+			auto countOf = [&](const std::string& name) -> uint64_t {
+				for (const auto& [errorName, count] : snapshot.errors) {
+					if (errorName == name) {
+						return count;
+					}
+				}
+				return 0;
+			};
+			EXPECT_EQ(snapshot.errors.size(), 3u);
+			EXPECT_EQ(countOf("DECRYPT_ERROR"), 2u);
+			EXPECT_EQ(countOf("AUTHENTICATION_USER_CANCELED"), 1u);
+			EXPECT_EQ(countOf("UNKNOWN_ERROR"), 2u);
+			ASSERT_EQ(snapshot.methods.size(), 2u);
+			EXPECT_EQ(snapshot.methods[0].method, MethodName::kEncrypt);
+			EXPECT_EQ(snapshot.methods[0].errors, 3u);
+			EXPECT_EQ(snapshot.methods[1].errors, 2u);
+		}
+
+		TEST(MetricsRegistryTest, RecordCall_KeepsUnknownMethodsApart)
+		{
+			MetricsRegistry metrics;
+
+			metrics.RecordCall(MethodName::kNotImplemented, milliseconds(1));
+
+			auto snapshot = metrics.GetSnapshot();
+			ASSERT_EQ(snapshot.methods.size(), 1u);
+			EXPECT_EQ(snapshot.methods[0].method, MethodName::kNotImplemented);
+		}
+
+		TEST(MetricsRegistryTest, PhaseTimer_RecordsIntoItsPhase)
+		{
+			// Arrange
+			MetricsRegistry metrics;
+
+			// Act
+			{
+				MetricsRegistry::PhaseTimer timer(&metrics, MetricsPhase::kSignPrompt);
+			}
+			{
+				MetricsRegistry::PhaseTimer timer(nullptr, MetricsPhase::kAesGcm);
+			}
+
+			// Assert
+			auto snapshot = metrics.GetSnapshot();
+			EXPECT_EQ(snapshot.phases[static_cast<size_t>(MetricsPhase::kSignPrompt)].count, 1u);
+			EXPECT_EQ(snapshot.phases[static_cast<size_t>(MetricsPhase::kAesGcm)].count, 0u);
+		}
+
+		TEST(MetricsRegistryTest, GetMetricsPhaseName_NamesEveryPhase)
+		{
+			for (size_t i = 0; i < METRICS_PHASE_COUNT; ++i) {
+				EXPECT_NE(GetMetricsPhaseName(static_cast<MetricsPhase>(i)), "unknown") << i;
+			}
+		}
+	}
+}
@@ -8,9 +8,8 @@ namespace biometric_cipher {
 	namespace test {
 		class MockConfigStorage : public ConfigStorage {
 		public:
-			MOCK_METHOD(bool, getIsConfigured, (), (const, override));
 			MOCK_METHOD(void, SetConfigData, (const ConfigData& configData), (override));
-			MOCK_METHOD(const ConfigData&, GetConfig, (), (const, override));
+			MOCK_METHOD(std::shared_ptr<const ConfigData>, GetConfig, (), (const, override));
 		};
 	}
 }
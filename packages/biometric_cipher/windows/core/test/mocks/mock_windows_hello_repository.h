@@ -6,42 +6,33 @@
 
 namespace biometric_cipher {
 	namespace test {
-
-		using namespace winrt;
-		using namespace winrt::impl;
-		using namespace Windows::Foundation;
-		using namespace Windows::Security::Cryptography;
-		using namespace Windows::Security::Cryptography::Core;
-		using namespace Windows::Security::Credentials;
-		using namespace Windows::Storage::Streams;
-
 		class MockWindowsHelloRepository : public WindowsHelloRepository {
 		public:
 			MOCK_METHOD(
-				(IAsyncOperation<int>),
+				(Task<int>),
 				GetWindowsHelloStatusAsync,
 				(),
 				(const, override)
 			);
 
 			MOCK_METHOD(
-				(IAsyncOperation<IBuffer>),
+				(Task<SecureBuffer>),
 				SignAsync,
-				(const hstring tag, const IBuffer data),
+				(const std::string tag, const SecureBuffer data),
 				(const, override)
 			);
 
 			MOCK_METHOD(
-				(IAsyncAction),
+				(Task<>),
 				CreateCredentialAsync,
-				(const hstring tag),
+				(const std::string tag),
 				(const, override)
 			);
 
 			MOCK_METHOD(
-				(IAsyncAction),
+				(Task<>),
 				DeleteCredentialAsync,
-				(const hstring tag),
+				(const std::string tag),
 				(const, override)
 			);
 		};
@@ -9,6 +9,7 @@ namespace biometric_cipher {
 		class MockWindowsTpmRepository : public WindowsTpmRepository {
 		public:
 			MOCK_METHOD(int, GetWindowsTpmVersion, (), (const, override));
+			MOCK_METHOD(void, Refresh, (), (const, override));
 		};
 	}
 }
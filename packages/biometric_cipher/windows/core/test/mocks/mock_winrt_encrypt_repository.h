@@ -0,0 +1,68 @@
+#pragma once
+
+#include <gmock/gmock.h>
+
+#include "include/biometric_cipher/repositories/winrt_encrypt_repository.h"
+
+namespace biometric_cipher {
+	namespace test {
+		class MockWinrtEncryptRepository : public WinrtEncryptRepository {
+		public:
+			MOCK_METHOD(
+				(std::shared_ptr<SymmetricKey>),
+				CreateAESKey,
+				(const SecureBuffer& signature),
+				(const, override)
+			);
+
+			MOCK_METHOD(
+				(std::shared_ptr<SymmetricKey>),
+				DeriveSubkey,
+				(const std::shared_ptr<SymmetricKey>& key, std::string_view context),
+				(const, override)
+			);
+
+			MOCK_METHOD(
+				(std::string),
+				Encrypt,
+				(const std::shared_ptr<SymmetricKey>& key, const SecureString& data),
+				(const, override)
+			);
+
+			MOCK_METHOD(
+				(SecureString),
+				Decrypt,
+				(const std::shared_ptr<SymmetricKey>& key, const std::string& data),
+				(const, override)
+			);
+
+			MOCK_METHOD(
+				(std::vector<uint8_t>),
+				EncryptBinary,
+				(const std::shared_ptr<SymmetricKey>& key, const SecureBuffer& data),
+				(const, override)
+			);
+
+			MOCK_METHOD(
+				(SecureBuffer),
+				DecryptBinary,
+				(const std::shared_ptr<SymmetricKey>& key, const std::vector<uint8_t>& data),
+				(const, override)
+			);
+
+			MOCK_METHOD(
+				(std::unique_ptr<EncryptStream>),
+				CreateEncryptStream,
+				(const std::shared_ptr<SymmetricKey>& key),
+				(const, override)
+			);
+
+			MOCK_METHOD(
+				(std::unique_ptr<DecryptStream>),
+				CreateDecryptStream,
+				(const std::shared_ptr<SymmetricKey>& key, std::span<const uint8_t> header),
+				(const, override)
+			);
+		};
+	}
+}
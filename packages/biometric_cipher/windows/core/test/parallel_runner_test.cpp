@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "fakes/fake_executor.h"
+
+// Include the code under test
+#include "include/biometric_cipher/common/parallel_runner.h"
+#include "include/biometric_cipher/common/thread_pool_executor.h"
+
+namespace biometric_cipher {
+	namespace test {
+
+		using namespace biometric_cipher;
+
+		TEST(ParallelRunnerTest, Run_CallsEveryIndexOnce)
+		{
+			ParallelRunner runner(std::make_shared<ThreadPoolExecutor>(3), 3);
+			std::vector<std::atomic<int>> calls(1000);
+
+			runner.Run(calls.size(), [&](size_t i) { ++calls[i]; });
+
+			for (const auto& count : calls) {
+				EXPECT_EQ(count.load(), 1);
+			}
+		}
+
+		TEST(ParallelRunnerTest, Run_UsesHelperThreads)
+		{
+			ParallelRunner runner(std::make_shared<ThreadPoolExecutor>(3), 3);
+			std::mutex mutex;
+			std::set<std::thread::id> threads;
+
+			runner.Run(64, [&](size_t) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				std::lock_guard<std::mutex> lock(mutex);
+				threads.insert(std::this_thread::get_id());
+			});
+
+			EXPECT_GT(threads.size(), 1u);
+		}
+
+		TEST(ParallelRunnerTest, Run_DoesNotWaitForHelpersThatHaveNotStarted)
+		{
+			auto executor = std::make_shared<FakeExecutor>();
+			ParallelRunner runner(executor, 2);
+			int calls = 0;
+
+			runner.Run(10, [&](size_t) { ++calls; });
+
+			EXPECT_EQ(calls, 10);
+			EXPECT_EQ(executor->GetPendingCount(), 2u);
+
+			// Late helpers find the range done and do not call the item again.
+			executor->RunPending();
+			EXPECT_EQ(calls, 10);
+		}
+
+		TEST(ParallelRunnerTest, Run_RethrowsFirstExceptionAndSkipsRemainingItems)
+		{
+			ParallelRunner runner(std::make_shared<FakeExecutor>(), 2);
+			int calls = 0;
+
+			EXPECT_THROW(
+				runner.Run(10, [&](size_t i) {
+					++calls;
+					if (i == 3) {
+						throw std::runtime_error("failed");
+					}
+				}),
+				std::runtime_error);
+			EXPECT_EQ(calls, 4);
+		}
+
+		TEST(ParallelRunnerTest, Run_WorksWithoutExecutor)
+		{
+			ParallelRunner runner(nullptr, 4);
+			int calls = 0;
+
+			runner.Run(5, [&](size_t) { ++calls; });
+
+			EXPECT_EQ(runner.GetHelperCount(), 0u);
+			EXPECT_EQ(calls, 5);
+		}
+
+		TEST(ParallelRunnerTest, Run_CanBeCalledFromThreadOfItsOwnExecutor)
+		{
+			auto pool = std::make_shared<ThreadPoolExecutor>(1);
+			ParallelRunner runner(pool, 1);
+			std::promise<int> result;
+
+			// The pool's only thread runs Run(), so its helper cannot start until Run() returns.
+			pool->Post([&] {
+				int calls = 0;
+				runner.Run(8, [&](size_t) { ++calls; });
+				result.set_value(calls);
+			});
+
+			EXPECT_EQ(result.get_future().get(), 8);
+		}
+	}
+}
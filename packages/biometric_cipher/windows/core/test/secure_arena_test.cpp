@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Include the code under test
+#include "include/biometric_cipher/common/secure_allocator.h"
+#include "include/biometric_cipher/common/secure_arena.h"
+
+namespace biometric_cipher {
+	namespace test {
+
+		using namespace biometric_cipher;
+
+		TEST(SecureArenaTest, GetBlockSize_RoundsUpToSizeClasses)
+		{
+			EXPECT_EQ(SecureArena::GetBlockSize(1), SecureArena::MIN_BLOCK_SIZE);
+			EXPECT_EQ(SecureArena::GetBlockSize(32), 32u);
+			EXPECT_EQ(SecureArena::GetBlockSize(33), 64u);
+			EXPECT_EQ(SecureArena::GetBlockSize(1000), 1024u);
+			EXPECT_EQ(SecureArena::GetBlockSize(4096), SecureArena::MAX_BLOCK_SIZE);
+			EXPECT_EQ(SecureArena::GetBlockSize(4097), 4097u);
+		}
+
+		TEST(SecureArenaTest, Allocate_ReusesFreedBlockOfSameSizeClass)
+		{
+			// Arrange
+			SecureArena arena;
+			auto* first = arena.Allocate(40);
+			arena.Deallocate(first, 40);
+
+			// Act
+			auto* second = arena.Allocate(60);
+
+			// Assert
+			EXPECT_EQ(second, first);
+			EXPECT_EQ(arena.GetStats().bytesInUse, 64u);
+			arena.Deallocate(second, 60);
+			EXPECT_EQ(arena.GetStats().bytesInUse, 0u);
+		}
+
+		TEST(SecureArenaTest, Deallocate_ZeroesBlock)
+		{
+			// Arrange
+			SecureArena arena;
+			auto* block = static_cast<uint8_t*>(arena.Allocate(100));
+			std::memset(block, 0xAA, 100);
+
+			// Act
+			arena.Deallocate(block, 100);
+
+			// Assert: the region stays mapped, and only the free-list link is written back.
+			for (size_t i = sizeof(void*); i < SecureArena::GetBlockSize(100); ++i) {
+				ASSERT_EQ(block[i], 0) << i;
+			}
+		}
+
+		TEST(SecureArenaTest, Allocate_FallsBackToHeapWhenRegionIsUsedUp)
+		{
+			// Arrange
+			SecureArena arena(SecureArena::MAX_BLOCK_SIZE);
+			auto* regionBlock = arena.Allocate(SecureArena::MAX_BLOCK_SIZE);
+
+			// Act
+			auto* heapBlock = arena.Allocate(16);
+			std::memset(heapBlock, 0xAA, 16);
+
+			// Assert
+			auto stats = arena.GetStats();
+			EXPECT_EQ(stats.regionSize, SecureArena::MAX_BLOCK_SIZE);
+			EXPECT_EQ(stats.bytesInUse, SecureArena::MAX_BLOCK_SIZE);
+			EXPECT_EQ(stats.heapAllocations, 1u);
+
+			arena.Deallocate(heapBlock, 16);
+			arena.Deallocate(regionBlock, SecureArena::MAX_BLOCK_SIZE);
+		}
+
+		TEST(SecureArenaTest, Allocate_ServesLargeRequestsFromHeap)
+		{
+			// Arrange
+			SecureArena arena;
+
+			// Act
+			auto* block = arena.Allocate(SecureArena::MAX_BLOCK_SIZE + 1);
+			std::memset(block, 0xAA, SecureArena::MAX_BLOCK_SIZE + 1);
+
+			// Assert
+			EXPECT_EQ(arena.GetStats().heapAllocations, 1u);
+			EXPECT_EQ(arena.GetStats().bytesInUse, 0u);
+			arena.Deallocate(block, SecureArena::MAX_BLOCK_SIZE + 1);
+		}
+
+		TEST(SecureArenaTest, Allocate_HandsOutDisjointBlocksAcrossThreads)
+		{
+			// Arrange
+			const int threadCount = 4;
+			const int iterations = 2000;
+			SecureArena arena;
+			std::vector<std::thread> threads;
+			std::vector<int> failures(threadCount, 0);
+
+			// Act: every thread fills its blocks with its own byte and checks nobody else wrote
+			// to them before it frees them.
+			for (int t = 0; t < threadCount; ++t) {
+				threads.emplace_back([&arena, &failures, t]() {
+					for (int i = 0; i < iterations; ++i) {
+						auto size = static_cast<size_t>(32 + (i * 37 + t * 11) % 500);
+						auto* block = static_cast<uint8_t*>(arena.Allocate(size));
+						std::memset(block, t + 1, size);
+						std::this_thread::yield();
+						for (size_t j = 0; j < size; ++j) {
+							if (block[j] != t + 1) {
+								++failures[t];
+								break;
+							}
+						}
+						arena.Deallocate(block, size);
+					}
+				});
+			}
+			for (auto& thread : threads) {
+				thread.join();
+			}
+
+			// Assert
+			for (int t = 0; t < threadCount; ++t) {
+				EXPECT_EQ(failures[t], 0) << t;
+			}
+			EXPECT_EQ(arena.GetStats().bytesInUse, 0u);
+		}
+
+		TEST(SecureArenaTest, SecureBuffer_AllocatesFromSharedArena)
+		{
+			// Arrange
+			auto before = SecureArena::Get().GetStats().bytesInUse;
+
+			{
+				// Act
+				SecureBuffer buffer(200, 0x5A);
+
+				// Assert
+				EXPECT_EQ(SecureArena::Get().GetStats().bytesInUse, before + 256);
+			}
+			EXPECT_EQ(SecureArena::Get().GetStats().bytesInUse, before);
+		}
+
+		TEST(SecureArenaTest, SecureString_ComparesWithOrdinaryStrings)
+		{
+			// Arrange
+			SecureString string("a plaintext that does not fit in the object itself");
+
+			// Assert
+			EXPECT_EQ(string, std::string("a plaintext that does not fit in the object itself"));
+			EXPECT_EQ(string, "a plaintext that does not fit in the object itself");
+			EXPECT_EQ(std::string(string), "a plaintext that does not fit in the object itself");
+			EXPECT_FALSE(string == std::string("other"));
+		}
+	}  // namespace test
+}  // namespace biometric_cipher
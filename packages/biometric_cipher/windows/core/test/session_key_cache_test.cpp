@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+
+// Include the code under test
+#include "include/biometric_cipher/storages/session_key_cache.h"
+
+namespace biometric_cipher {
+	namespace test {
+
+		using namespace biometric_cipher;
+
+		class SessionKeyCacheTest : public ::testing::Test {
+		protected:
+			SessionKeyCache::Clock::time_point m_Now{};
+
+			std::shared_ptr<SymmetricKey> m_Key = std::make_shared<SymmetricKey>();
+
+			std::unique_ptr<SessionKeyCache> m_Cache;
+
+			void SetUp() override
+			{
+				m_Cache = std::make_unique<SessionKeyCache>([this] { return m_Now; });
+			}
+		};
+
+		TEST_F(SessionKeyCacheTest, IsDisabledByDefault)
+		{
+			m_Cache->Put("tag", m_Key, m_Cache->GetGeneration());
+
+			EXPECT_FALSE(m_Cache->IsEnabled());
+			EXPECT_EQ(m_Cache->Get("tag"), nullptr);
+		}
+
+		TEST_F(SessionKeyCacheTest, Get_ReturnsKeyWithinTtl)
+		{
+			m_Cache->Configure(std::chrono::seconds(30), 4);
+			m_Cache->Put("tag", m_Key, m_Cache->GetGeneration());
+
+			m_Now += std::chrono::seconds(29);
+
+			EXPECT_TRUE(m_Cache->IsEnabled());
+			EXPECT_EQ(m_Cache->Get("tag"), m_Key);
+		}
+
+		TEST_F(SessionKeyCacheTest, Get_DropsKeyAfterTtl)
+		{
+			m_Cache->Configure(std::chrono::seconds(30), 4);
+			m_Cache->Put("tag", m_Key, m_Cache->GetGeneration());
+
+			m_Now += std::chrono::seconds(30);
+
+			EXPECT_EQ(m_Cache->Get("tag"), nullptr);
+		}
+
+		TEST_F(SessionKeyCacheTest, Put_EvictsLeastRecentlyUsedWhenFull)
+		{
+			m_Cache->Configure(std::chrono::seconds(30), 2);
+			m_Cache->Put("first", m_Key, m_Cache->GetGeneration());
+			m_Cache->Put("second", m_Key, m_Cache->GetGeneration());
+
+			// Touch "first" so that "second" becomes the least recently used entry.
+			EXPECT_EQ(m_Cache->Get("first"), m_Key);
+
+			m_Cache->Put("third", m_Key, m_Cache->GetGeneration());
+
+			EXPECT_EQ(m_Cache->Get("first"), m_Key);
+			EXPECT_EQ(m_Cache->Get("second"), nullptr);
+			EXPECT_EQ(m_Cache->Get("third"), m_Key);
+		}
+
+		TEST_F(SessionKeyCacheTest, Invalidate_RemovesOnlyGivenTag)
+		{
+			m_Cache->Configure(std::chrono::seconds(30), 4);
+			m_Cache->Put("first", m_Key, m_Cache->GetGeneration());
+			m_Cache->Put("second", m_Key, m_Cache->GetGeneration());
+
+			m_Cache->Invalidate("first");
+
+			EXPECT_EQ(m_Cache->Get("first"), nullptr);
+			EXPECT_EQ(m_Cache->Get("second"), m_Key);
+		}
+
+		TEST_F(SessionKeyCacheTest, Lock_RemovesAllKeys)
+		{
+			m_Cache->Configure(std::chrono::seconds(30), 4);
+			m_Cache->Put("first", m_Key, m_Cache->GetGeneration());
+			m_Cache->Put("second", m_Key, m_Cache->GetGeneration());
+
+			m_Cache->Lock();
+
+			EXPECT_EQ(m_Cache->Get("first"), nullptr);
+			EXPECT_EQ(m_Cache->Get("second"), nullptr);
+			EXPECT_TRUE(m_Cache->IsEnabled());
+		}
+
+		TEST_F(SessionKeyCacheTest, Put_RefusesKeyDerivedBeforeLock)
+		{
+			m_Cache->Configure(std::chrono::seconds(30), 4);
+			auto generation = m_Cache->GetGeneration();
+
+			// The derivation was still signing when the cache was locked.
+			m_Cache->Lock();
+			m_Cache->Put("tag", m_Key, generation);
+
+			EXPECT_EQ(m_Cache->Get("tag"), nullptr);
+		}
+
+		TEST_F(SessionKeyCacheTest, Put_RefusesKeyDerivedBeforeInvalidateOrConfigure)
+		{
+			m_Cache->Configure(std::chrono::seconds(30), 4);
+			auto generation = m_Cache->GetGeneration();
+
+			m_Cache->Invalidate("tag");
+			m_Cache->Put("tag", m_Key, generation);
+			EXPECT_EQ(m_Cache->Get("tag"), nullptr);
+
+			generation = m_Cache->GetGeneration();
+			m_Cache->Configure(std::chrono::seconds(30), 4);
+			m_Cache->Put("tag", m_Key, generation);
+			EXPECT_EQ(m_Cache->Get("tag"), nullptr);
+		}
+
+		TEST_F(SessionKeyCacheTest, Configure_RemovesAllKeys)
+		{
+			m_Cache->Configure(std::chrono::seconds(30), 4);
+			m_Cache->Put("tag", m_Key, m_Cache->GetGeneration());
+
+			m_Cache->Configure(std::chrono::seconds(60), 4);
+
+			EXPECT_EQ(m_Cache->Get("tag"), nullptr);
+		}
+	}  // namespace test
+}  // namespace biometric_cipher
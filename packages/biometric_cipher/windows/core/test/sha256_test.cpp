@@ -0,0 +1,394 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+// Include the code under test
+#include "include/biometric_cipher/common/sha256.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+
+namespace biometric_cipher {
+	namespace test {
+
+		using namespace biometric_cipher;
+
+		// FIPS 180-4 examples (via the NIST CSRC example values).
+		struct Sha256TestVector {
+			std::string message;
+			const char* digest;
+		};
+
+		// RFC 4231 test cases 1-4, 6 and 7 (5 truncates the MAC).
+		struct HmacSha256TestVector {
+			std::string key;
+			std::string data;
+			const char* mac;
+		};
+
+		const Sha256TestVector kHashTestVectors[] = {
+			{
+				"",
+				"e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+			},
+			{
+				"abc",
+				"ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+			},
+			{
+				"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+				"248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1",
+			},
+			{
+				"abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu",
+				"cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1",
+			},
+			{
+				std::string(1000000, 'a'),
+				"cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0",
+			},
+		};
+
+		const HmacSha256TestVector kHmacTestVectors[] = {
+			{
+				std::string(20, '\x0b'),
+				"Hi There",
+				"b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7",
+			},
+			{
+				"Jefe",
+				"what do ya want for nothing?",
+				"5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843",
+			},
+			{
+				std::string(20, '\xaa'),
+				std::string(50, '\xdd'),
+				"773ea91e36800e46854db8ebd09181a72959098b3ef8c122d9635514ced565fe",
+			},
+			{
+				"\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19",
+				std::string(50, '\xcd'),
+				"82558a389a443c0ea4cc819899f2083a85f0faa3e578f8077a2e3ff46729665b",
+			},
+			{
+				std::string(131, '\xaa'),
+				"Test Using Larger Than Block-Size Key - Hash Key First",
+				"60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54",
+			},
+			{
+				std::string(131, '\xaa'),
+				"This is a test using a larger than block-size key and a larger than block-size data. "
+				"The key needs to be hashed before being used by the HMAC algorithm.",
+				"9b09ffa71b942fcb27635fbcd5b0e944bfdc63644f0713938a7f51535c3a35e2",
+			},
+		};
+
+		// Runs every test for each implementation; the ones the CPU does not support fall
+		// back to a narrower one and are still expected to pass.
+		class Sha256Test : public ::testing::TestWithParam<Sha256::Implementation> {
+		protected:
+			static std::string ToHex(const std::vector<uint8_t>& bytes)
+			{
+				static const char kDigits[] = "0123456789abcdef";
+				std::string hex;
+				for (auto byte : bytes) {
+					hex.push_back(kDigits[byte >> 4]);
+					hex.push_back(kDigits[byte & 0x0f]);
+				}
+
+				return hex;
+			}
+
+			static const uint8_t* Bytes(const std::string& string)
+			{
+				return reinterpret_cast<const uint8_t*>(string.data());
+			}
+
+			static std::vector<uint8_t> MakeData(size_t length, uint32_t seed)
+			{
+				std::mt19937 generator(seed);
+				std::vector<uint8_t> data(length);
+				for (auto& byte : data) {
+					byte = static_cast<uint8_t>(generator());
+				}
+
+				return data;
+			}
+
+			static std::vector<uint8_t> Hash(
+				const std::vector<uint8_t>& data,
+				Sha256::Implementation implementation)
+			{
+				std::vector<uint8_t> digest(Sha256::DIGEST_LENGTH);
+				Sha256::Hash(data.data(), data.size(), digest.data(), implementation);
+
+				return digest;
+			}
+		};
+
+		TEST_P(Sha256Test, Hash_MatchesTestVectors)
+		{
+			for (const auto& vector : kHashTestVectors) {
+				std::vector<uint8_t> digest(Sha256::DIGEST_LENGTH);
+				Sha256::Hash(Bytes(vector.message), vector.message.size(), digest.data(), GetParam());
+
+				EXPECT_EQ(ToHex(digest), vector.digest) << "Message length " << vector.message.size();
+			}
+		}
+
+		TEST_P(Sha256Test, Hash_MatchesScalarForAllLengths)
+		{
+			std::vector<size_t> lengths;
+			for (size_t length = 0; length <= 300; ++length) {
+				lengths.push_back(length);
+			}
+			lengths.insert(lengths.end(), { 447, 448, 511, 512, 513, 4095, 4096, 4097, 65537 });
+
+			for (auto length : lengths) {
+				auto data = MakeData(length, static_cast<uint32_t>(length));
+
+				EXPECT_EQ(Hash(data, GetParam()), Hash(data, Sha256::Implementation::kScalar)) << "Length " << length;
+			}
+		}
+
+		TEST_P(Sha256Test, Update_MatchesHashWhenSplitAnywhere)
+		{
+			auto data = MakeData(1000, 3);
+			auto expected = Hash(data, GetParam());
+			std::mt19937 generator(4);
+
+			for (int round = 0; round < 50; ++round) {
+				Sha256 context(GetParam());
+				size_t offset = 0;
+				while (offset < data.size()) {
+					size_t length = std::min<size_t>(generator() % 150, data.size() - offset);
+					context.Update(data.data() + offset, length);
+					offset += length;
+				}
+				std::vector<uint8_t> digest(Sha256::DIGEST_LENGTH);
+				context.Final(digest.data());
+
+				EXPECT_EQ(digest, expected);
+			}
+		}
+
+		TEST_P(Sha256Test, Final_StartsNewMessage)
+		{
+			auto first = MakeData(100, 5);
+			auto second = MakeData(70, 6);
+			Sha256 context(GetParam());
+
+			std::vector<uint8_t> digest(Sha256::DIGEST_LENGTH);
+			context.Update(first.data(), first.size());
+			context.Final(digest.data());
+			EXPECT_EQ(digest, Hash(first, GetParam()));
+
+			context.Update(second.data(), second.size());
+			context.Final(digest.data());
+			EXPECT_EQ(digest, Hash(second, GetParam()));
+		}
+
+		TEST_P(Sha256Test, HashMany_MatchesHash)
+		{
+			// Counts around the eight lanes of the AVX2 code, with mixed lengths so that
+			// lanes run out of blocks at different times.
+			for (size_t count : { 0, 1, 7, 8, 9, 23 }) {
+				std::vector<std::vector<uint8_t>> messages;
+				std::vector<const uint8_t*> data;
+				std::vector<size_t> lengths;
+				for (size_t i = 0; i < count; ++i) {
+					messages.push_back(MakeData((i * 37) % 300, static_cast<uint32_t>(i)));
+				}
+				for (const auto& message : messages) {
+					data.push_back(message.empty() ? nullptr : message.data());
+					lengths.push_back(message.size());
+				}
+
+				std::vector<uint8_t> digests(count * Sha256::DIGEST_LENGTH);
+				Sha256::HashMany(data.data(), lengths.data(), count, digests.data(), GetParam());
+
+				for (size_t i = 0; i < count; ++i) {
+					std::vector<uint8_t> digest(
+						digests.begin() + i * Sha256::DIGEST_LENGTH,
+						digests.begin() + (i + 1) * Sha256::DIGEST_LENGTH);
+					EXPECT_EQ(digest, Hash(messages[i], Sha256::Implementation::kScalar))
+						<< "Message " << i << " of " << count;
+				}
+			}
+		}
+
+		TEST_P(Sha256Test, Hmac_MatchesTestVectors)
+		{
+			for (const auto& vector : kHmacTestVectors) {
+				std::vector<uint8_t> mac(HmacSha256::MAC_LENGTH);
+				HmacSha256::Compute(
+					Bytes(vector.key), vector.key.size(), Bytes(vector.data), vector.data.size(), mac.data(), GetParam());
+
+				EXPECT_EQ(ToHex(mac), vector.mac) << "Key length " << vector.key.size();
+			}
+		}
+
+		TEST_P(Sha256Test, Hmac_PreparedKeyMatchesOneOffKeyAcrossMessages)
+		{
+			auto key = MakeData(32, 7);
+			HmacSha256 hmac(key.data(), key.size(), GetParam());
+
+			for (size_t length : { 0, 1, 63, 64, 65, 1000 }) {
+				auto data = MakeData(length, static_cast<uint32_t>(length));
+				std::vector<uint8_t> expected(HmacSha256::MAC_LENGTH);
+				HmacSha256::Compute(key.data(), key.size(), data.data(), data.size(), expected.data(), GetParam());
+
+				std::vector<uint8_t> mac(HmacSha256::MAC_LENGTH);
+				hmac.Update(data.data(), data.size());
+				hmac.Final(mac.data());
+
+				EXPECT_EQ(mac, expected) << "Length " << length;
+			}
+		}
+
+		TEST_P(Sha256Test, Hmac_VerifyRejectsTampering)
+		{
+			auto key = MakeData(32, 8);
+			auto data = MakeData(200, 9);
+			std::vector<uint8_t> mac(HmacSha256::MAC_LENGTH);
+			HmacSha256::Compute(key.data(), key.size(), data.data(), data.size(), mac.data(), GetParam());
+
+			EXPECT_TRUE(HmacSha256::Verify(key.data(), key.size(), data.data(), data.size(), mac.data(), GetParam()));
+
+			auto tamperedMac = mac;
+			tamperedMac[HmacSha256::MAC_LENGTH - 1] ^= 1;
+			EXPECT_FALSE(HmacSha256::Verify(key.data(), key.size(), data.data(), data.size(), tamperedMac.data(), GetParam()));
+
+			auto tamperedData = data;
+			tamperedData[0] ^= 1;
+			EXPECT_FALSE(HmacSha256::Verify(key.data(), key.size(), tamperedData.data(), tamperedData.size(), mac.data(), GetParam()));
+		}
+
+		TEST(Sha256ImplementationTest, Clamp_NeverExceedsBestImplementation)
+		{
+			auto best = Sha256::GetBestImplementation();
+
+			EXPECT_EQ(Sha256::Clamp(Sha256::Implementation::kScalar), Sha256::Implementation::kScalar);
+			EXPECT_LE(Sha256::Clamp(Sha256::Implementation::kAvx2), Sha256::Implementation::kAvx2);
+			EXPECT_EQ(Sha256::Clamp(Sha256::Implementation::kShaNi), best);
+			EXPECT_EQ(Sha256(Sha256::Implementation::kShaNi).GetImplementation(), best);
+		}
+
+		// RFC 5869 test cases 1-3.
+		struct HkdfSha256TestVector {
+			std::vector<uint8_t> secret;
+			std::vector<uint8_t> salt;
+			std::vector<uint8_t> info;
+			const char* prk;
+			const char* output;
+		};
+
+		class HkdfSha256Test : public ::testing::Test {
+		protected:
+			static std::vector<uint8_t> Range(int first, int last)
+			{
+				std::vector<uint8_t> bytes;
+				for (int byte = first; byte <= last; ++byte) {
+					bytes.push_back(static_cast<uint8_t>(byte));
+				}
+
+				return bytes;
+			}
+
+			static std::string ToHex(const std::vector<uint8_t>& bytes)
+			{
+				static const char kDigits[] = "0123456789abcdef";
+				std::string hex;
+				for (auto byte : bytes) {
+					hex.push_back(kDigits[byte >> 4]);
+					hex.push_back(kDigits[byte & 0x0f]);
+				}
+
+				return hex;
+			}
+
+			const std::vector<HkdfSha256TestVector> m_TestVectors = {
+				{
+					std::vector<uint8_t>(22, 0x0b),
+					Range(0x00, 0x0c),
+					Range(0xf0, 0xf9),
+					"077709362c2e32df0ddc3f0dc47bba6390b6c73bb50f9c3122ec844ad7c2b3e5",
+					"3cb25f25faacd57a90434f64d0362f2a2d2d0a90cf1a5a4c5db02d56ecc4c5bf34007208d5b887185865",
+				},
+				{
+					Range(0x00, 0x4f),
+					Range(0x60, 0xaf),
+					Range(0xb0, 0xff),
+					"06a6b88c5853361a06104c9ceb35b45cef760014904671014a193f40c15fc244",
+					"b11e398dc80327a1c8e7f78c596a49344f012eda2d4efad8a050cc4c19afa97c"
+					"59045a99cac7827271cb41c65e590e09da3275600c2f09b8367793a9aca3db71"
+					"cc30c58179ec3e87c14c01d5c1f3434f1d87",
+				},
+				{
+					std::vector<uint8_t>(22, 0x0b),
+					{},
+					{},
+					"19ef24a32c717b167f33a91d6f648bdf96596776afdb6377ac434c1c293ccb04",
+					"8da4e775a563c18f715f802a063c5a31b8a11f5c5ee1879ec3454e5f3c738d2d9d201395faa4b61a96c8",
+				},
+			};
+		};
+
+		TEST_F(HkdfSha256Test, ExtractExpand_MatchTestVectors)
+		{
+			for (const auto& vector : m_TestVectors) {
+				std::vector<uint8_t> prk(HkdfSha256::PRK_LENGTH);
+				HkdfSha256::Extract(vector.salt.data(), vector.salt.size(), vector.secret.data(), vector.secret.size(), prk.data());
+				EXPECT_EQ(ToHex(prk), vector.prk);
+
+				std::vector<uint8_t> output(std::string(vector.output).size() / 2);
+				HkdfSha256::Expand(prk.data(), vector.info.data(), vector.info.size(), output.data(), output.size());
+				EXPECT_EQ(ToHex(output), vector.output);
+
+				std::vector<uint8_t> derived(output.size());
+				HkdfSha256::Derive(vector.salt.data(), vector.salt.size(), vector.secret.data(), vector.secret.size(),
+					vector.info.data(), vector.info.size(), derived.data(), derived.size());
+				EXPECT_EQ(derived, output);
+			}
+		}
+
+		TEST_F(HkdfSha256Test, Expand_ShorterOutputIsPrefixOfLongerOne)
+		{
+			auto prk = Range(0x00, 0x1f);
+			auto info = Range(0x40, 0x47);
+			std::vector<uint8_t> longOutput(100);
+			HkdfSha256::Expand(prk.data(), info.data(), info.size(), longOutput.data(), longOutput.size());
+
+			for (size_t length : { size_t{ 0 }, size_t{ 1 }, size_t{ 32 }, size_t{ 33 }, size_t{ 64 } }) {
+				std::vector<uint8_t> output(length);
+				HkdfSha256::Expand(prk.data(), info.data(), info.size(), output.data(), output.size());
+				EXPECT_TRUE(std::equal(output.begin(), output.end(), longOutput.begin())) << length;
+			}
+		}
+
+		TEST_F(HkdfSha256Test, Expand_ThrowsIfOutputIsTooLong)
+		{
+			auto prk = Range(0x00, 0x1f);
+			std::vector<uint8_t> output(HkdfSha256::MAX_OUTPUT_LENGTH + 1);
+
+			EXPECT_NO_THROW(HkdfSha256::Expand(prk.data(), nullptr, 0, output.data(), HkdfSha256::MAX_OUTPUT_LENGTH));
+			try {
+				HkdfSha256::Expand(prk.data(), nullptr, 0, output.data(), output.size());
+				FAIL() << "Expected BiometricCipherException";
+			}
+			catch (const BiometricCipherException& e) {
+				EXPECT_EQ(e.Code(), error_invalid_argument);
+			}
+		}
+
+		INSTANTIATE_TEST_SUITE_P(
+			AllImplementations,
+			Sha256Test,
+			::testing::Values(
+				Sha256::Implementation::kScalar,
+				Sha256::Implementation::kAvx2,
+				Sha256::Implementation::kShaNi));
+	}
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "helpers/async_gate.h"
+
+// Include the code under test
+#include "include/biometric_cipher/common/single_flight.h"
+
+namespace biometric_cipher {
+	namespace test {
+
+		using namespace biometric_cipher;
+
+		class SingleFlightTest : public ::testing::Test {
+		protected:
+			SingleFlight<std::string> m_SingleFlight;
+			AsyncGate m_Gate;
+			int m_StartCount = 0;
+
+			Task<std::string> RunGated(const std::string key, const std::string value)
+			{
+				return m_SingleFlight.Run(key, [this, value]() -> Task<std::string> {
+					++m_StartCount;
+					co_await m_Gate;
+					co_return value;
+				});
+			}
+		};
+
+		TEST_F(SingleFlightTest, Run_ConcurrentCallsWithSameKeyShareOneOperation)
+		{
+			auto first = RunGated("tag", "first");
+			auto second = RunGated("tag", "second");
+			auto third = RunGated("tag", "third");
+
+			EXPECT_EQ(m_StartCount, 1);
+			EXPECT_FALSE(first.IsCompleted());
+			EXPECT_FALSE(second.IsCompleted());
+
+			m_Gate.Open();
+
+			EXPECT_EQ(first.get(), "first");
+			EXPECT_EQ(second.get(), "first");
+			EXPECT_EQ(third.get(), "first");
+			EXPECT_EQ(m_SingleFlight.GetInFlightCount(), 0u);
+		}
+
+		TEST_F(SingleFlightTest, Run_DifferentKeysRunIndependently)
+		{
+			auto first = RunGated("tag1", "first");
+			auto second = RunGated("tag2", "second");
+
+			EXPECT_EQ(m_StartCount, 2);
+			EXPECT_EQ(m_SingleFlight.GetInFlightCount(), 2u);
+
+			m_Gate.Open();
+
+			EXPECT_EQ(first.get(), "first");
+			EXPECT_EQ(second.get(), "second");
+		}
+
+		TEST_F(SingleFlightTest, Run_StartsNewOperationAfterPreviousCompleted)
+		{
+			m_Gate.Open();
+
+			EXPECT_EQ(RunGated("tag", "first").get(), "first");
+			EXPECT_EQ(RunGated("tag", "second").get(), "second");
+			EXPECT_EQ(m_StartCount, 2);
+		}
+
+		TEST_F(SingleFlightTest, Run_PropagatesExceptionToEveryWaiter)
+		{
+			auto run = [this]() {
+				return m_SingleFlight.Run("tag", [this]() -> Task<std::string> {
+					++m_StartCount;
+					co_await m_Gate;
+					throw std::runtime_error("canceled");
+				});
+			};
+
+			auto first = run();
+			auto second = run();
+
+			m_Gate.Open();
+
+			EXPECT_THROW(first.get(), std::runtime_error);
+			EXPECT_THROW(second.get(), std::runtime_error);
+			EXPECT_EQ(m_StartCount, 1);
+
+			// A failed operation is not remembered.
+			EXPECT_THROW(run().get(), std::runtime_error);
+			EXPECT_EQ(m_StartCount, 2);
+		}
+	}  // namespace test
+}  // namespace biometric_cipher
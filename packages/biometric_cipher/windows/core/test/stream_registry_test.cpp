@@ -0,0 +1,244 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "include/biometric_cipher/common/task.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+
+// Include the code under test
+#include "include/biometric_cipher/common/stream_registry.h"
+
+namespace biometric_cipher {
+	namespace test {
+
+		using namespace biometric_cipher;
+
+		struct CountingStream {
+			int updates = 0;
+			std::vector<uint32_t> indices;
+		};
+
+		// What the plugin does for a chunk: waits for its turn, then records its index.
+		Task<int> UseInTurn(StreamRegistry<CountingStream>& registry, uint32_t id, uint32_t index)
+		{
+			co_await registry.WaitForTurn(id, index);
+
+			co_return registry.Use(id, index, [index](CountingStream& stream) {
+				stream.indices.push_back(index);
+				return ++stream.updates;
+			});
+		}
+
+		Task<std::unique_ptr<CountingStream>> RemoveInTurn(StreamRegistry<CountingStream>& registry, uint32_t id, uint32_t count)
+		{
+			co_await registry.WaitForTurn(id, count);
+
+			co_return registry.Remove(id, count);
+		}
+
+		TEST(StreamRegistryTest, Use_RunsActionOnRegisteredStream)
+		{
+			StreamRegistry<CountingStream> registry;
+			auto id = registry.Add(std::make_unique<CountingStream>());
+
+			registry.Use(id, 0, [](CountingStream& stream) { ++stream.updates; });
+			auto updates = registry.Use(id, 1, [](CountingStream& stream) { return ++stream.updates; });
+
+			EXPECT_NE(id, 0u);
+			EXPECT_EQ(updates, 2);
+		}
+
+		TEST(StreamRegistryTest, Add_AssignsDistinctIds)
+		{
+			StreamRegistry<CountingStream> registry;
+
+			auto first = registry.Add(std::make_unique<CountingStream>());
+			auto second = registry.Add(std::make_unique<CountingStream>());
+
+			EXPECT_NE(first, second);
+			EXPECT_EQ(registry.GetOpenCount(), 2u);
+		}
+
+		TEST(StreamRegistryTest, Add_ThrowsWhenTooManyStreamsAreOpen)
+		{
+			StreamRegistry<CountingStream> registry(2);
+			registry.Add(std::make_unique<CountingStream>());
+			auto id = registry.Add(std::make_unique<CountingStream>());
+
+			EXPECT_THROW(registry.Add(std::make_unique<CountingStream>()), BiometricCipherException);
+
+			registry.Remove(id, 0);
+			EXPECT_NO_THROW(registry.Add(std::make_unique<CountingStream>()));
+		}
+
+		TEST(StreamRegistryTest, Remove_ReturnsStreamAndForgetsId)
+		{
+			StreamRegistry<CountingStream> registry;
+			auto id = registry.Add(std::make_unique<CountingStream>());
+			registry.Use(id, 0, [](CountingStream& stream) { ++stream.updates; });
+
+			auto stream = registry.Remove(id, 1);
+
+			ASSERT_NE(stream, nullptr);
+			EXPECT_EQ(stream->updates, 1);
+			EXPECT_EQ(registry.GetOpenCount(), 0u);
+			EXPECT_THROW(registry.Remove(id, 1), BiometricCipherException);
+		}
+
+		TEST(StreamRegistryTest, Use_ThrowsForUnknownId)
+		{
+			StreamRegistry<CountingStream> registry;
+
+			EXPECT_THROW(registry.Use(42, 0, [](CountingStream&) {}), BiometricCipherException);
+		}
+
+		TEST(StreamRegistryTest, Use_RemovesStreamWhenActionThrows)
+		{
+			StreamRegistry<CountingStream> registry;
+			auto id = registry.Add(std::make_unique<CountingStream>());
+
+			EXPECT_THROW(registry.Use(id, 0, [](CountingStream&) { throw std::runtime_error("failed"); }), std::runtime_error);
+
+			EXPECT_EQ(registry.GetOpenCount(), 0u);
+			EXPECT_THROW(registry.Use(id, 1, [](CountingStream&) {}), BiometricCipherException);
+		}
+
+		TEST(StreamRegistryTest, Clear_DropsEveryStream)
+		{
+			StreamRegistry<CountingStream> registry;
+			auto id = registry.Add(std::make_unique<CountingStream>());
+
+			registry.Clear();
+
+			EXPECT_EQ(registry.GetOpenCount(), 0u);
+			EXPECT_THROW(registry.Use(id, 0, [](CountingStream&) {}), BiometricCipherException);
+		}
+
+		TEST(StreamRegistryTest, Use_RejectsCallOutOfOrderAndDropsStream)
+		{
+			StreamRegistry<CountingStream> registry;
+			auto id = registry.Add(std::make_unique<CountingStream>());
+			registry.Use(id, 0, [](CountingStream& stream) { ++stream.updates; });
+
+			// Chunk 2 did not wait for chunk 1: it must not reach the stream.
+			bool ran = false;
+			EXPECT_THROW(registry.Use(id, 2, [&](CountingStream&) { ran = true; }), BiometricCipherException);
+
+			EXPECT_FALSE(ran);
+			EXPECT_EQ(registry.GetOpenCount(), 0u);
+			EXPECT_THROW(registry.Use(id, 1, [](CountingStream&) {}), BiometricCipherException);
+		}
+
+		TEST(StreamRegistryTest, Remove_RejectsEndBeforeLastChunk)
+		{
+			StreamRegistry<CountingStream> registry;
+			auto id = registry.Add(std::make_unique<CountingStream>());
+			registry.Use(id, 0, [](CountingStream& stream) { ++stream.updates; });
+
+			// The end was sent after two chunks but only one has been processed.
+			EXPECT_THROW(registry.Remove(id, 2), BiometricCipherException);
+
+			EXPECT_EQ(registry.GetOpenCount(), 0u);
+			EXPECT_THROW(registry.Use(id, 1, [](CountingStream&) {}), BiometricCipherException);
+		}
+
+		TEST(StreamRegistryTest, WaitForTurn_AppliesEarlyCallsInIndexOrder)
+		{
+			StreamRegistry<CountingStream> registry;
+			auto id = registry.Add(std::make_unique<CountingStream>());
+
+			auto end = RemoveInTurn(registry, id, 3);
+			auto third = UseInTurn(registry, id, 2);
+			auto second = UseInTurn(registry, id, 1);
+			EXPECT_FALSE(third.IsCompleted());
+			EXPECT_FALSE(second.IsCompleted());
+			EXPECT_FALSE(end.IsCompleted());
+
+			EXPECT_EQ(UseInTurn(registry, id, 0).get(), 1);
+
+			EXPECT_EQ(second.get(), 2);
+			EXPECT_EQ(third.get(), 3);
+			auto stream = end.get();
+			ASSERT_NE(stream, nullptr);
+			EXPECT_EQ(stream->indices, (std::vector<uint32_t>{ 0, 1, 2 }));
+			EXPECT_EQ(registry.GetOpenCount(), 0u);
+		}
+
+		TEST(StreamRegistryTest, WaitForTurn_KeepsOrderAcrossThreads)
+		{
+			const uint32_t chunkCount = 48;
+			StreamRegistry<CountingStream> registry;
+			auto id = registry.Add(std::make_unique<CountingStream>());
+
+			std::vector<uint32_t> submitOrder(chunkCount);
+			std::iota(submitOrder.begin(), submitOrder.end(), 0u);
+			std::shuffle(submitOrder.begin(), submitOrder.end(), std::mt19937(42));
+
+			std::mutex tasksMutex;
+			std::vector<Task<int>> tasks;
+			std::vector<std::thread> threads;
+			for (int t = 0; t < 4; ++t) {
+				threads.emplace_back([&, t]() {
+					for (uint32_t i = t; i < chunkCount; i += 4) {
+						auto task = UseInTurn(registry, id, submitOrder[i]);
+						std::lock_guard<std::mutex> lock(tasksMutex);
+						tasks.push_back(std::move(task));
+					}
+				});
+			}
+			for (auto& thread : threads) {
+				thread.join();
+			}
+			for (auto& task : tasks) {
+				task.get();
+			}
+
+			std::vector<uint32_t> expected(chunkCount);
+			std::iota(expected.begin(), expected.end(), 0u);
+			EXPECT_EQ(RemoveInTurn(registry, id, chunkCount).get()->indices, expected);
+		}
+
+		TEST(StreamRegistryTest, WaitForTurn_RepeatedIndexFailsAndEndsStream)
+		{
+			StreamRegistry<CountingStream> registry;
+			auto id = registry.Add(std::make_unique<CountingStream>());
+			auto waiting = UseInTurn(registry, id, 2);
+
+			EXPECT_EQ(UseInTurn(registry, id, 0).get(), 1);
+			EXPECT_THROW(UseInTurn(registry, id, 0).get(), BiometricCipherException);
+
+			// The call that was waiting finds the stream gone rather than hanging.
+			EXPECT_THROW(waiting.get(), BiometricCipherException);
+			EXPECT_EQ(registry.GetOpenCount(), 0u);
+		}
+
+		TEST(StreamRegistryTest, WaitForTurn_IndexTooFarAheadFails)
+		{
+			StreamRegistry<CountingStream> registry;
+			auto id = registry.Add(std::make_unique<CountingStream>());
+
+			auto skipped = UseInTurn(registry, id, StreamRegistry<CountingStream>::MAX_WAITING_CALLS + 1);
+
+			EXPECT_THROW(skipped.get(), BiometricCipherException);
+			EXPECT_EQ(registry.GetOpenCount(), 0u);
+		}
+
+		TEST(StreamRegistryTest, Clear_FailsWaitingCalls)
+		{
+			StreamRegistry<CountingStream> registry;
+			auto id = registry.Add(std::make_unique<CountingStream>());
+			auto waiting = UseInTurn(registry, id, 1);
+
+			registry.Clear();
+
+			EXPECT_THROW(waiting.get(), BiometricCipherException);
+		}
+	}
+}
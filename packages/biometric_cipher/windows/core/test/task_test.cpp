@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <coroutine>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+// Include the code under test
+#include "include/biometric_cipher/common/task.h"
+
+namespace biometric_cipher {
+	namespace test {
+
+		using namespace biometric_cipher;
+
+		// Resumes the awaiting coroutine on a new thread, the way a WinRT operation completes
+		// on a thread pool thread.
+		struct ResumeOnNewThread {
+			std::thread& thread;
+
+			bool await_ready() const noexcept { return false; }
+
+			void await_suspend(std::coroutine_handle<> continuation) const
+			{
+				// The coroutine frame, and this awaiter with it, may be gone as soon as the
+				// new thread starts, so the target is read first.
+				auto& target = thread;
+				target = std::thread([continuation] { continuation.resume(); });
+			}
+
+			void await_resume() const noexcept {}
+		};
+
+		class TaskTest : public ::testing::Test {
+		protected:
+			std::thread m_Thread;
+
+			void TearDown() override
+			{
+				if (m_Thread.joinable()) {
+					m_Thread.join();
+				}
+			}
+
+			Task<int> ComputeOnNewThreadAsync(int value)
+			{
+				co_await ResumeOnNewThread{ m_Thread };
+
+				co_return value;
+			}
+		};
+
+		TEST_F(TaskTest, CompletesSynchronouslyWhenNothingIsAwaited)
+		{
+			auto task = []() -> Task<std::string> { co_return "value"; }();
+
+			EXPECT_TRUE(task.IsCompleted());
+			EXPECT_EQ(task.get(), "value");
+		}
+
+		TEST_F(TaskTest, Get_WaitsForCompletionOnAnotherThread)
+		{
+			auto task = ComputeOnNewThreadAsync(42);
+
+			EXPECT_EQ(task.get(), 42);
+		}
+
+		TEST_F(TaskTest, CoAwait_ResumesCallerWithResult)
+		{
+			auto task = [this]() -> Task<int> {
+				auto value = co_await ComputeOnNewThreadAsync(41);
+				co_return value + 1;
+			}();
+
+			EXPECT_EQ(task.get(), 42);
+		}
+
+		TEST_F(TaskTest, Get_RethrowsException)
+		{
+			auto task = []() -> Task<> {
+				throw std::runtime_error("failure");
+				co_return;
+			}();
+
+			EXPECT_THROW(task.get(), std::runtime_error);
+		}
+
+		TEST_F(TaskTest, CoAwait_PropagatesExceptionToCaller)
+		{
+			auto task = [this]() -> Task<int> {
+				co_await ResumeOnNewThread{ m_Thread };
+				throw std::runtime_error("failure");
+			}();
+
+			auto outer = [&task]() -> Task<bool> {
+				try {
+					co_await task;
+				}
+				catch (const std::runtime_error&) {
+					co_return true;
+				}
+				co_return false;
+			}();
+
+			EXPECT_TRUE(outer.get());
+		}
+	}  // namespace test
+}  // namespace biometric_cipher
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "fakes/fake_executor.h"
+
+// Include the code under test
+#include "include/biometric_cipher/common/task.h"
+#include "include/biometric_cipher/common/thread_pool_executor.h"
+
+namespace biometric_cipher {
+	namespace test {
+
+		using namespace biometric_cipher;
+
+		TEST(ThreadPoolExecutorTest, Post_RunsWorkOnWorkerThreads)
+		{
+			ThreadPoolExecutor pool(2);
+			std::promise<std::thread::id> workerId;
+
+			pool.Post([&] { workerId.set_value(std::this_thread::get_id()); });
+
+			EXPECT_NE(workerId.get_future().get(), std::this_thread::get_id());
+		}
+
+		TEST(ThreadPoolExecutorTest, Post_RunsAllWorkAcrossThreads)
+		{
+			std::atomic<int> completed{ 0 };
+			std::mutex mutex;
+			std::set<std::thread::id> workerIds;
+			{
+				ThreadPoolExecutor pool(3);
+				EXPECT_EQ(pool.GetThreadCount(), 3u);
+
+				for (int i = 0; i < 100; ++i) {
+					pool.Post([&] {
+						{
+							std::lock_guard<std::mutex> lock(mutex);
+							workerIds.insert(std::this_thread::get_id());
+						}
+						++completed;
+					});
+				}
+			}
+
+			EXPECT_EQ(completed.load(), 100);
+			EXPECT_LE(workerIds.size(), 3u);
+		}
+
+		TEST(ThreadPoolExecutorTest, Destructor_RunsQueuedWorkBeforeJoining)
+		{
+			std::promise<void> release;
+			auto released = release.get_future().share();
+			std::atomic<int> completed{ 0 };
+			{
+				ThreadPoolExecutor pool(1);
+				pool.Post([released] { released.wait(); });
+				pool.Post([&] { ++completed; });
+				pool.Post([&] { ++completed; });
+
+				release.set_value();
+			}
+
+			EXPECT_EQ(completed.load(), 2);
+		}
+
+		TEST(ThreadPoolExecutorTest, Constructor_RunsThreadHooksOnEveryWorker)
+		{
+			std::atomic<int> started{ 0 };
+			std::atomic<int> exited{ 0 };
+			{
+				ThreadPoolExecutor pool(3, [&] { ++started; }, [&] { ++exited; });
+			}
+
+			EXPECT_EQ(started.load(), 3);
+			EXPECT_EQ(exited.load(), 3);
+		}
+
+		TEST(ThreadPoolExecutorTest, GetDefaultThreadCount_IsBounded)
+		{
+			auto threadCount = ThreadPoolExecutor::GetDefaultThreadCount();
+
+			EXPECT_GE(threadCount, 1u);
+			EXPECT_LE(threadCount, ThreadPoolExecutor::MAX_DEFAULT_THREAD_COUNT);
+		}
+
+		TEST(ThreadPoolExecutorTest, ResumeOn_MovesCoroutineToPoolAndBack)
+		{
+			ThreadPoolExecutor pool(2);
+			FakeExecutor platformThread;
+			const auto testThreadId = std::this_thread::get_id();
+			std::thread::id workerThreadId;
+			std::thread::id replyThreadId;
+
+			auto operation = [&]() -> Task<> {
+				auto toPool = ResumeOn(pool);
+				co_await toPool;
+				workerThreadId = std::this_thread::get_id();
+
+				auto toPlatformThread = ResumeOn(platformThread);
+				co_await toPlatformThread;
+				replyThreadId = std::this_thread::get_id();
+			};
+			auto task = operation();
+
+			while (platformThread.GetPendingCount() == 0) {
+				std::this_thread::yield();
+			}
+			EXPECT_FALSE(task.IsCompleted());
+
+			EXPECT_EQ(platformThread.RunPending(), 1u);
+			task.get();
+
+			EXPECT_NE(workerThreadId, testThreadId);
+			EXPECT_EQ(replyThreadId, testThreadId);
+		}
+	}
+}
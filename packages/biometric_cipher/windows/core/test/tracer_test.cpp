@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Include the code under test
+#include "include/biometric_cipher/common/tracer.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+
+namespace biometric_cipher {
+	namespace test {
+
+		using namespace biometric_cipher;
+
+		class TracerTest : public ::testing::Test {
+		protected:
+			static size_t CountOccurrences(const std::string& text, const std::string& pattern)
+			{
+				size_t count = 0;
+				for (auto position = text.find(pattern); position != std::string::npos; position = text.find(pattern, position + 1)) {
+					++count;
+				}
+
+				return count;
+			}
+
+			Tracer m_Tracer;
+		};
+
+		TEST_F(TracerTest, ExportChromeTrace_ContainsScopes)
+		{
+			// Arrange
+			{
+				TraceScope scope("Outer", m_Tracer);
+				TraceScope inner("Inner", m_Tracer);
+			}
+
+			// Act
+			auto trace = m_Tracer.ExportChromeTrace();
+
+			// Assert
+			EXPECT_EQ(trace.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0u);
+			EXPECT_EQ(trace.substr(trace.size() - 2), "]}");
+			EXPECT_EQ(CountOccurrences(trace, "\"ph\":\"X\""), 2u);
+			// Sorted by start, so the outer slice comes first even though it ended last.
+			EXPECT_LT(trace.find("\"name\":\"Outer\""), trace.find("\"name\":\"Inner\""));
+		}
+
+		TEST_F(TracerTest, TraceAwait_RecordsFlowAcrossThreads)
+		{
+			// Arrange
+			std::unique_ptr<TraceAwait> await;
+			await = std::make_unique<TraceAwait>("SignAsync", m_Tracer);
+
+			// Act: resume on another thread, as a WinRT completion would.
+			std::thread resumer([&] { await.reset(); });
+			resumer.join();
+			auto trace = m_Tracer.ExportChromeTrace();
+
+			// Assert
+			EXPECT_EQ(CountOccurrences(trace, "\"ph\":\"s\""), 1u);
+			EXPECT_EQ(CountOccurrences(trace, "\"ph\":\"f\""), 1u);
+			EXPECT_EQ(CountOccurrences(trace, "\"bp\":\"e\""), 1u);
+			EXPECT_EQ(CountOccurrences(trace, "\"ph\":\"b\""), 1u);
+			EXPECT_EQ(CountOccurrences(trace, "\"ph\":\"e\""), 1u);
+			EXPECT_EQ(CountOccurrences(trace, "\"tid\":1,"), 3u);
+			EXPECT_EQ(CountOccurrences(trace, "\"tid\":2,"), 3u);
+		}
+
+		TEST_F(TracerTest, TraceAsyncScope_MatchesBeginAndEndById)
+		{
+			{
+				TraceAsyncScope first("EncryptAsync", m_Tracer);
+				TraceAsyncScope second("EncryptAsync", m_Tracer);
+			}
+
+			auto trace = m_Tracer.ExportChromeTrace();
+
+			EXPECT_EQ(CountOccurrences(trace, "\"id\":1}"), 2u);
+			EXPECT_EQ(CountOccurrences(trace, "\"id\":2}"), 2u);
+		}
+
+		TEST_F(TracerTest, Record_KeepsOnlyTheNewestEventsOfAThread)
+		{
+			// Arrange
+			auto start = Tracer::Clock::now();
+
+			// Act
+			for (size_t i = 0; i < Tracer::EVENTS_PER_THREAD + 10; ++i) {
+				m_Tracer.RecordComplete(i < 10 ? "Old" : "New", start, start);
+			}
+			auto trace = m_Tracer.ExportChromeTrace();
+
+			// Assert
+			EXPECT_EQ(CountOccurrences(trace, "\"name\":\"Old\""), 0u);
+			EXPECT_EQ(CountOccurrences(trace, "\"name\":\"New\""), Tracer::EVENTS_PER_THREAD);
+		}
+
+		TEST_F(TracerTest, Clear_DropsEarlierEvents)
+		{
+			{
+				TraceScope scope("Before", m_Tracer);
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+			m_Tracer.Clear();
+			{
+				TraceScope scope("After", m_Tracer);
+			}
+
+			auto trace = m_Tracer.ExportChromeTrace();
+			EXPECT_EQ(CountOccurrences(trace, "Before"), 0u);
+			EXPECT_EQ(CountOccurrences(trace, "After"), 1u);
+		}
+
+		TEST_F(TracerTest, ExportChromeTrace_WhileThreadsRecord)
+		{
+			// Arrange
+			std::atomic<bool> stop{ false };
+			std::vector<std::thread> threads;
+			for (int t = 0; t < 4; ++t) {
+				threads.emplace_back([&] {
+					for (size_t i = 0; i < Tracer::EVENTS_PER_THREAD || !stop.load(); ++i) {
+						TraceScope scope("Work", m_Tracer);
+					}
+				});
+			}
+
+			// Act
+			for (int i = 0; i < 20; ++i) {
+				auto trace = m_Tracer.ExportChromeTrace();
+
+				// Assert
+				EXPECT_EQ(trace.substr(trace.size() - 2), "]}");
+			}
+			stop.store(true);
+			for (auto& thread : threads) {
+				thread.join();
+			}
+
+			auto trace = m_Tracer.ExportChromeTrace();
+			EXPECT_EQ(CountOccurrences(trace, "\"name\":\"Work\""), 4 * Tracer::EVENTS_PER_THREAD);
+		}
+
+		TEST_F(TracerTest, GetThreadBuffer_ReusesRingsOfExitedThreads)
+		{
+			// Act
+			for (size_t i = 0; i < Tracer::MAX_THREAD_BUFFERS * 2; ++i) {
+				std::thread thread([&] { TraceScope scope("Short", m_Tracer); });
+				thread.join();
+			}
+			auto trace = m_Tracer.ExportChromeTrace();
+
+			// Assert
+			EXPECT_EQ(CountOccurrences(trace, "\"name\":\"Short\""), Tracer::MAX_THREAD_BUFFERS * 2);
+		}
+
+		TEST_F(TracerTest, WriteChromeTrace_WritesTheExport)
+		{
+			// Arrange
+			{
+				TraceScope scope("Written", m_Tracer);
+			}
+			auto path = (std::filesystem::temp_directory_path() / "biometric_cipher_trace_test.json").string();
+
+			// Act
+			m_Tracer.WriteChromeTrace(path);
+
+			// Assert
+			std::ifstream file(path, std::ios::binary);
+			std::stringstream contents;
+			contents << file.rdbuf();
+			EXPECT_EQ(contents.str(), m_Tracer.ExportChromeTrace());
+			file.close();
+			std::filesystem::remove(path);
+		}
+
+		TEST_F(TracerTest, WriteChromeTrace_ThrowsForUnwritablePath)
+		{
+			auto path = (std::filesystem::temp_directory_path() / "no_such_directory" / "trace.json").string();
+
+			EXPECT_THROW(m_Tracer.WriteChromeTrace(path), BiometricCipherException);
+		}
+	}
+}
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+// Include the code under test
+#include "include/biometric_cipher/common/utf_converter.h"
+
+namespace biometric_cipher {
+	namespace test {
+
+		using namespace biometric_cipher;
+
+		TEST(UtfConverterTest, ConvertUtf8ToUtf16_ConvertsAllSequenceLengths)
+		{
+			// "a", U+00E9, U+20AC, U+1F600
+			auto result = UtfConverter::ConvertUtf8ToUtf16("a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80");
+
+			EXPECT_EQ(result, std::u16string(u"a\u00E9\u20AC\U0001F600"));
+		}
+
+		TEST(UtfConverterTest, ConvertUtf8ToUtf16_ReplacesMalformedSequences)
+		{
+			// Lone continuation byte, truncated 3-byte sequence, overlong encoding and an encoded surrogate.
+			auto result = UtfConverter::ConvertUtf8ToUtf16("\x80" "a" "\xE2\x82" "b" "\xC0\xAF" "\xED\xA0\x80");
+
+			EXPECT_EQ(result, std::u16string(u"\uFFFDa\uFFFDb\uFFFD\uFFFD\uFFFD\uFFFD\uFFFD"));
+		}
+
+		TEST(UtfConverterTest, ConvertUtf8ToUtf16LE_ReturnsLittleEndianBytes)
+		{
+			auto result = UtfConverter::ConvertUtf8ToUtf16LE("A\xE2\x82\xAC");
+
+			EXPECT_EQ(result, SecureBuffer({ 0x41, 0x00, 0xAC, 0x20 }));
+		}
+
+		TEST(UtfConverterTest, ConvertUtf16ToUtf8_ConvertsAllSequenceLengths)
+		{
+			auto result = UtfConverter::ConvertUtf16ToUtf8(u"a\u00E9\u20AC\U0001F600");
+
+			EXPECT_EQ(result, "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80");
+		}
+
+		TEST(UtfConverterTest, ConvertUtf16ToUtf8_ReplacesUnpairedSurrogates)
+		{
+			// Lone low surrogate, high surrogate followed by a non-surrogate, high surrogate at the end.
+			const char16_t input[] = { 0xDC00, u'a', 0xD800, u'b', 0xD83D };
+
+			auto result = UtfConverter::ConvertUtf16ToUtf8(std::u16string_view(input, 5));
+
+			EXPECT_EQ(result, "\xEF\xBF\xBD" "a" "\xEF\xBF\xBD" "b" "\xEF\xBF\xBD");
+		}
+
+		TEST(UtfConverterTest, ConvertUtf16ToUtf8_StaysWithinMaxLength)
+		{
+			std::u16string input(100, u'\u20AC');
+			std::string output(UtfConverter::GetMaxUtf8Length(input.size()), '\0');
+
+			EXPECT_EQ(UtfConverter::ConvertUtf16ToUtf8(input, output.data()), output.size());
+		}
+
+		// Runs the buffer API for each implementation the CPU supports; the others fall back
+		// to a narrower one and are still expected to pass.
+		class UtfConverterSimdTest : public ::testing::TestWithParam<SimdLevel> {
+		protected:
+			// ASCII runs of every length up to 70 separated by non-ASCII characters, so that
+			// each vector path sees blocks that end right before, on and after a non-ASCII byte.
+			static std::u16string MakeMixedText()
+			{
+				const std::u16string separators[] = { u"\u00E9", u"\u20AC", u"\U0001F600" };
+
+				std::u16string text;
+				for (size_t run = 0; run <= 70; ++run) {
+					for (size_t i = 0; i < run; ++i) {
+						text.push_back(static_cast<char16_t>(u'!' + (run + i) % 94));
+					}
+					text += separators[run % 3];
+				}
+
+				return text;
+			}
+
+			static std::string ToUtf8Scalar(std::u16string_view string)
+			{
+				std::string output(UtfConverter::GetMaxUtf8Length(string.size()), '\0');
+				output.resize(UtfConverter::ConvertUtf16ToUtf8(string, output.data(), SimdLevel::kScalar));
+
+				return output;
+			}
+		};
+
+		TEST_P(UtfConverterSimdTest, ConvertUtf16ToUtf8_MatchesScalar)
+		{
+			auto text = MakeMixedText();
+			for (size_t offset = 0; offset < 40; ++offset) {
+				std::u16string_view input(text.data() + offset, text.size() - offset);
+				std::string output(UtfConverter::GetMaxUtf8Length(input.size()), '\0');
+
+				output.resize(UtfConverter::ConvertUtf16ToUtf8(input, output.data(), GetParam()));
+
+				EXPECT_EQ(output, ToUtf8Scalar(input)) << "offset " << offset;
+			}
+		}
+
+		TEST_P(UtfConverterSimdTest, ConvertUtf8ToUtf16_RoundTrips)
+		{
+			auto text = MakeMixedText();
+			auto utf8 = ToUtf8Scalar(text);
+			for (size_t offset = 0; offset < 40; ++offset) {
+				// Starting inside a multi-byte sequence is fine: it is compared to the scalar result.
+				std::string_view input(utf8.data() + offset, utf8.size() - offset);
+				std::u16string output(UtfConverter::GetMaxUtf16Length(input.size()), u'\0');
+				std::u16string expected(UtfConverter::GetMaxUtf16Length(input.size()), u'\0');
+
+				output.resize(UtfConverter::ConvertUtf8ToUtf16(input, output.data(), GetParam()));
+				expected.resize(UtfConverter::ConvertUtf8ToUtf16(input, expected.data(), SimdLevel::kScalar));
+
+				EXPECT_EQ(output, expected) << "offset " << offset;
+			}
+
+			std::u16string output(UtfConverter::GetMaxUtf16Length(utf8.size()), u'\0');
+			output.resize(UtfConverter::ConvertUtf8ToUtf16(utf8, output.data(), GetParam()));
+			EXPECT_EQ(output, text);
+		}
+
+		TEST_P(UtfConverterSimdTest, ConvertUtf8ToUtf16_ReplacesMalformedBytesAfterAsciiBlocks)
+		{
+			std::string input(64, 'a');
+			input[33] = '\x80';
+			input[63] = '\xE2';
+
+			std::u16string output(UtfConverter::GetMaxUtf16Length(input.size()), u'\0');
+			output.resize(UtfConverter::ConvertUtf8ToUtf16(input, output.data(), GetParam()));
+
+			std::u16string expected(64, u'a');
+			expected[33] = 0xFFFD;
+			expected[63] = 0xFFFD;
+			EXPECT_EQ(output, expected);
+		}
+
+		INSTANTIATE_TEST_SUITE_P(
+			AllLevels,
+			UtfConverterSimdTest,
+			::testing::Values(SimdLevel::kScalar, SimdLevel::kSse41, SimdLevel::kAvx2));
+	}  // namespace test
+}  // namespace biometric_cipher
@@ -0,0 +1,84 @@
+#include "include/biometric_cipher/common/thread_pool_executor.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace biometric_cipher
+{
+	ThreadPoolExecutor::ThreadPoolExecutor(size_t threadCount, ThreadHook onThreadStart, ThreadHook onThreadExit)
+		: m_OnThreadStart(std::move(onThreadStart)),
+		m_OnThreadExit(std::move(onThreadExit))
+	{
+		if (threadCount == 0) {
+			threadCount = GetDefaultThreadCount();
+		}
+
+		m_Threads.reserve(threadCount);
+		for (size_t i = 0; i < threadCount; ++i) {
+			m_Threads.emplace_back([this] { RunWorker(); });
+		}
+	}
+
+	ThreadPoolExecutor::~ThreadPoolExecutor()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_IsStopping = true;
+		}
+
+		m_WorkAvailable.notify_all();
+
+		for (auto& thread : m_Threads) {
+			thread.join();
+		}
+	}
+
+	void ThreadPoolExecutor::Post(Work work)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Queue.push_back(std::move(work));
+		}
+
+		m_WorkAvailable.notify_one();
+	}
+
+	size_t ThreadPoolExecutor::GetThreadCount() const
+	{
+		return m_Threads.size();
+	}
+
+	size_t ThreadPoolExecutor::GetDefaultThreadCount()
+	{
+		size_t hardwareThreads = std::thread::hardware_concurrency();
+
+		return std::clamp<size_t>(hardwareThreads, 1, MAX_DEFAULT_THREAD_COUNT);
+	}
+
+	void ThreadPoolExecutor::RunWorker()
+	{
+		if (m_OnThreadStart) {
+			m_OnThreadStart();
+		}
+
+		while (true) {
+			Work work;
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				m_WorkAvailable.wait(lock, [this] { return m_IsStopping || !m_Queue.empty(); });
+				if (m_Queue.empty()) {
+					break;
+				}
+
+				work = std::move(m_Queue.front());
+				m_Queue.pop_front();
+			}
+
+			work();
+		}
+
+		if (m_OnThreadExit) {
+			m_OnThreadExit();
+		}
+	}
+}  // namespace biometric_cipher
@@ -1,19 +1,18 @@
 #include "include/biometric_cipher/enums/tpm_status.h"
-
-#include <winrt/base.h>
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
 
 namespace biometric_cipher
 {
-	const int TpmStatusToInteger(TpmStatus tmpStatus) {
+	int TpmStatusToInteger(TpmStatus tmpStatus) {
 		return static_cast<int>(tmpStatus);
 	}
 
-	const TpmStatus IntegerToTpmStatus(int value) {
+	TpmStatus IntegerToTpmStatus(int value) {
 		constexpr int kMinValue = static_cast<int>(TpmStatus::kSupported);
 		constexpr int kMaxValue = static_cast<int>(TpmStatus::kTPMVersionUnsupported);
 
 		if (value < kMinValue || value > kMaxValue) {
-			throw winrt::hresult_error(winrt::impl::error_invalid_argument, L"Invalid TPM status value");
+			throw BiometricCipherException(error_invalid_argument, "Invalid TPM status value");
 		}
 
 		return static_cast<TpmStatus>(value);
@@ -0,0 +1,278 @@
+#include "include/biometric_cipher/common/tracer.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace biometric_cipher
+{
+	namespace
+	{
+		std::atomic<uint64_t> g_NextGeneration{ 1 };
+
+		// Indexed like Tracer::EventType.
+		const char* GetPhase(uint32_t type)
+		{
+			switch (type)
+			{
+			case 0:
+				return "X";
+			case 1:
+				return "b";
+			case 2:
+				return "e";
+			case 3:
+				return "s";
+			default:
+				return "f";
+			}
+		}
+
+		// Trace-event timestamps are in microseconds; three decimals keep the nanoseconds.
+		void WriteMicroseconds(std::ostringstream& out, int64_t nanoseconds)
+		{
+			auto fraction = nanoseconds % 1000;
+			out << nanoseconds / 1000 << '.';
+			if (fraction < 100) {
+				out << '0';
+			}
+			if (fraction < 10) {
+				out << '0';
+			}
+			out << fraction;
+		}
+
+		void WriteString(std::ostringstream& out, const char* string)
+		{
+			out << '"';
+			for (const char* c = string; *c != '\0'; ++c) {
+				if (*c == '"' || *c == '\\') {
+					out << '\\';
+				}
+				out << *c;
+			}
+			out << '"';
+		}
+	}
+
+	// The calling thread's ring. Marked retired when the thread exits, so that the ring (and
+	// the events in it) can be handed to a new thread instead of growing the list forever.
+	struct ThreadRegistration
+	{
+		uint64_t generation = 0;
+		std::shared_ptr<Tracer::ThreadBuffer> buffer;
+
+		~ThreadRegistration()
+		{
+			if (buffer) {
+				buffer->retired.store(true, std::memory_order_release);
+			}
+		}
+	};
+
+	namespace
+	{
+		thread_local ThreadRegistration t_Registration;
+	}
+
+	Tracer::Tracer()
+		: m_Generation(g_NextGeneration.fetch_add(1, std::memory_order_relaxed)),
+		m_Epoch(Clock::now())
+	{
+	}
+
+	Tracer::~Tracer() = default;
+
+	Tracer& Tracer::Get()
+	{
+		static Tracer tracer;
+
+		return tracer;
+	}
+
+	uint64_t Tracer::NewId()
+	{
+		return m_NextId.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void Tracer::RecordComplete(const char* name, Clock::time_point start, Clock::time_point end)
+	{
+		Record(EventType::kComplete, name, start, end - start, 0);
+	}
+
+	void Tracer::RecordAsyncBegin(const char* name, uint64_t id)
+	{
+		Record(EventType::kAsyncBegin, name, Clock::now(), Clock::duration::zero(), id);
+	}
+
+	void Tracer::RecordAsyncEnd(const char* name, uint64_t id)
+	{
+		Record(EventType::kAsyncEnd, name, Clock::now(), Clock::duration::zero(), id);
+	}
+
+	void Tracer::RecordFlowStart(const char* name, uint64_t id, Clock::time_point timestamp)
+	{
+		Record(EventType::kFlowStart, name, timestamp, Clock::duration::zero(), id);
+	}
+
+	void Tracer::RecordFlowEnd(const char* name, uint64_t id, Clock::time_point timestamp)
+	{
+		Record(EventType::kFlowEnd, name, timestamp, Clock::duration::zero(), id);
+	}
+
+	void Tracer::Clear()
+	{
+		auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_Epoch).count();
+		m_ClearedAt.store(now, std::memory_order_relaxed);
+	}
+
+	std::string Tracer::ExportChromeTrace() const
+	{
+		auto events = CopyEvents();
+		std::stable_sort(events.begin(), events.end(), [](const EventCopy& left, const EventCopy& right) {
+			return left.timestamp < right.timestamp;
+		});
+
+		std::ostringstream out;
+		out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+		out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"biometric_cipher\"}}";
+		for (const auto& event : events) {
+			out << ",{\"name\":";
+			WriteString(out, event.name);
+			out << ",\"cat\":\"biometric_cipher\",\"ph\":\"" << GetPhase(static_cast<uint32_t>(event.type)) << '"';
+			out << ",\"pid\":1,\"tid\":" << event.threadId << ",\"ts\":";
+			WriteMicroseconds(out, event.timestamp);
+			if (event.type == EventType::kComplete) {
+				out << ",\"dur\":";
+				WriteMicroseconds(out, event.duration);
+			}
+			else {
+				out << ",\"id\":" << event.id;
+			}
+			if (event.type == EventType::kFlowEnd) {
+				// Attach to the slice enclosing the event rather than the next one.
+				out << ",\"bp\":\"e\"";
+			}
+			out << '}';
+		}
+		out << "]}";
+
+		return out.str();
+	}
+
+	void Tracer::WriteChromeTrace(const std::string& path) const
+	{
+		auto trace = ExportChromeTrace();
+
+		std::u8string utf8Path(path.begin(), path.end());
+		std::ofstream file(std::filesystem::path(utf8Path), std::ios::binary | std::ios::trunc);
+		file.write(trace.data(), static_cast<std::streamsize>(trace.size()));
+		file.close();
+		if (!file) {
+			throw BiometricCipherException(error_fail, "Could not write the trace file.");
+		}
+	}
+
+	Tracer::ThreadBuffer& Tracer::GetThreadBuffer()
+	{
+		auto& registration = t_Registration;
+		if (registration.generation == m_Generation) {
+			return *registration.buffer;
+		}
+
+		if (registration.buffer) {
+			registration.buffer->retired.store(true, std::memory_order_release);
+		}
+
+		std::shared_ptr<ThreadBuffer> buffer;
+		{
+			std::lock_guard<std::mutex> lock(m_BuffersMutex);
+			if (m_Buffers.size() >= MAX_THREAD_BUFFERS) {
+				auto it = std::find_if(m_Buffers.begin(), m_Buffers.end(), [](const auto& candidate) {
+					return candidate->retired.load(std::memory_order_acquire);
+				});
+				if (it != m_Buffers.end()) {
+					buffer = *it;
+					buffer->retired.store(false, std::memory_order_relaxed);
+				}
+			}
+			if (!buffer) {
+				buffer = std::make_shared<ThreadBuffer>();
+				m_Buffers.push_back(buffer);
+			}
+			buffer->threadId = m_NextThreadId++;
+		}
+
+		registration.generation = m_Generation;
+		registration.buffer = std::move(buffer);
+
+		return *registration.buffer;
+	}
+
+	void Tracer::Record(EventType type, const char* name, Clock::time_point timestamp, Clock::duration duration, uint64_t id)
+	{
+		auto& buffer = GetThreadBuffer();
+		auto index = buffer.writeIndex.load(std::memory_order_relaxed);
+		auto& event = buffer.events[index % EVENTS_PER_THREAD];
+
+		// A reader that sees any of the new fields also sees the zeroed sequence (the fields
+		// are released after it), and so drops the event instead of mixing two of them.
+		event.sequence.store(0, std::memory_order_relaxed);
+		event.type.store(static_cast<uint32_t>(type), std::memory_order_release);
+		event.threadId.store(buffer.threadId, std::memory_order_release);
+		event.name.store(name, std::memory_order_release);
+		event.timestamp.store(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp - m_Epoch).count(),
+			std::memory_order_release);
+		event.duration.store(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(),
+			std::memory_order_release);
+		event.id.store(id, std::memory_order_release);
+
+		event.sequence.store(index + 1, std::memory_order_release);
+		buffer.writeIndex.store(index + 1, std::memory_order_release);
+	}
+
+	std::vector<Tracer::EventCopy> Tracer::CopyEvents() const
+	{
+		std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+		{
+			std::lock_guard<std::mutex> lock(m_BuffersMutex);
+			buffers = m_Buffers;
+		}
+
+		auto clearedAt = m_ClearedAt.load(std::memory_order_relaxed);
+		std::vector<EventCopy> events;
+		for (const auto& buffer : buffers) {
+			auto end = buffer->writeIndex.load(std::memory_order_acquire);
+			auto begin = end > EVENTS_PER_THREAD ? end - EVENTS_PER_THREAD : 0;
+
+			for (auto index = begin; index < end; ++index) {
+				const auto& event = buffer->events[index % EVENTS_PER_THREAD];
+
+				auto sequence = event.sequence.load(std::memory_order_acquire);
+				EventCopy copy{
+					static_cast<EventType>(event.type.load(std::memory_order_acquire)),
+					event.threadId.load(std::memory_order_acquire),
+					event.name.load(std::memory_order_acquire),
+					event.timestamp.load(std::memory_order_acquire),
+					event.duration.load(std::memory_order_acquire),
+					event.id.load(std::memory_order_acquire),
+				};
+
+				// Overwritten by a newer event, or being overwritten right now.
+				if (sequence != index + 1 || event.sequence.load(std::memory_order_relaxed) != sequence) {
+					continue;
+				}
+				if (copy.timestamp < clearedAt || copy.name == nullptr) {
+					continue;
+				}
+				events.push_back(copy);
+			}
+		}
+
+		return events;
+	}
+}
@@ -0,0 +1,332 @@
+#include "include/biometric_cipher/common/utf_converter.h"
+
+#include <bit>
+
+#if defined(BIOMETRIC_CIPHER_X86)
+#include <immintrin.h>
+#endif
+
+namespace biometric_cipher
+{
+	namespace
+	{
+		constexpr char16_t kReplacementCharacter = 0xFFFD;
+
+		char16_t* AppendCodePoint(char16_t* output, uint32_t codePoint)
+		{
+			if (codePoint < 0x10000) {
+				*output++ = static_cast<char16_t>(codePoint);
+				return output;
+			}
+
+			codePoint -= 0x10000;
+			*output++ = static_cast<char16_t>(0xD800 + (codePoint >> 10));
+			*output++ = static_cast<char16_t>(0xDC00 + (codePoint & 0x3FF));
+
+			return output;
+		}
+
+		char* AppendCodePoint(char* output, uint32_t codePoint)
+		{
+			if (codePoint < 0x80) {
+				*output++ = static_cast<char>(codePoint);
+			}
+			else if (codePoint < 0x800) {
+				*output++ = static_cast<char>(0xC0 | (codePoint >> 6));
+				*output++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+			}
+			else if (codePoint < 0x10000) {
+				*output++ = static_cast<char>(0xE0 | (codePoint >> 12));
+				*output++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+				*output++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+			}
+			else {
+				*output++ = static_cast<char>(0xF0 | (codePoint >> 18));
+				*output++ = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+				*output++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+				*output++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+			}
+
+			return output;
+		}
+
+		// Converts one UTF-8 sequence starting with a non-ASCII lead byte; returns the
+		// number of bytes consumed.
+		size_t ConvertUtf8Sequence(const uint8_t* input, size_t length, char16_t*& output)
+		{
+			auto lead = input[0];
+
+			// Bounds of the second byte follow the well-formed sequences table of the Unicode
+			// standard, which rules out overlong forms, surrogates and values above U+10FFFF.
+			size_t sequenceLength = 0;
+			uint32_t codePoint = 0;
+			uint8_t lowerBound = 0x80;
+			uint8_t upperBound = 0xBF;
+			if (lead >= 0xC2 && lead <= 0xDF) {
+				sequenceLength = 2;
+				codePoint = lead & 0x1F;
+			}
+			else if (lead >= 0xE0 && lead <= 0xEF) {
+				sequenceLength = 3;
+				codePoint = lead & 0x0F;
+				lowerBound = lead == 0xE0 ? 0xA0 : 0x80;
+				upperBound = lead == 0xED ? 0x9F : 0xBF;
+			}
+			else if (lead >= 0xF0 && lead <= 0xF4) {
+				sequenceLength = 4;
+				codePoint = lead & 0x07;
+				lowerBound = lead == 0xF0 ? 0x90 : 0x80;
+				upperBound = lead == 0xF4 ? 0x8F : 0xBF;
+			}
+			else {
+				*output++ = kReplacementCharacter;
+				return 1;
+			}
+
+			size_t consumed = 1;
+			while (consumed < sequenceLength && consumed < length) {
+				auto trail = input[consumed];
+				if (trail < lowerBound || trail > upperBound) {
+					break;
+				}
+
+				codePoint = (codePoint << 6) | (trail & 0x3F);
+				lowerBound = 0x80;
+				upperBound = 0xBF;
+				++consumed;
+			}
+
+			if (consumed < sequenceLength) {
+				*output++ = kReplacementCharacter;
+			}
+			else {
+				output = AppendCodePoint(output, codePoint);
+			}
+
+			return consumed;
+		}
+
+		// Converts one UTF-16 code point starting with a non-ASCII unit; returns the number
+		// of units consumed.
+		size_t ConvertUtf16CodePoint(const char16_t* input, size_t length, char*& output)
+		{
+			uint32_t unit = input[0];
+			if (unit < 0xD800 || unit > 0xDFFF) {
+				output = AppendCodePoint(output, unit);
+				return 1;
+			}
+
+			if (unit <= 0xDBFF && length > 1 && input[1] >= 0xDC00 && input[1] <= 0xDFFF) {
+				uint32_t codePoint = 0x10000 + ((unit - 0xD800) << 10) + (input[1] - 0xDC00);
+				output = AppendCodePoint(output, codePoint);
+				return 2;
+			}
+
+			output = AppendCodePoint(output, kReplacementCharacter);
+			return 1;
+		}
+
+#if defined(BIOMETRIC_CIPHER_X86)
+		// Each returns the length of the ASCII prefix it converted, a multiple of the block size.
+
+		BIOMETRIC_CIPHER_TARGET("sse4.1")
+		size_t WidenAsciiSse(const uint8_t* input, size_t length, char16_t* output)
+		{
+			const __m128i zero = _mm_setzero_si128();
+
+			size_t i = 0;
+			for (; i + 16 <= length; i += 16) {
+				__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+				if (_mm_movemask_epi8(bytes) != 0) {
+					break;
+				}
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_unpacklo_epi8(bytes, zero));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(output + i + 8), _mm_unpackhi_epi8(bytes, zero));
+			}
+
+			return i;
+		}
+
+		BIOMETRIC_CIPHER_TARGET("avx2")
+		size_t WidenAsciiAvx2(const uint8_t* input, size_t length, char16_t* output)
+		{
+			size_t i = 0;
+			for (; i + 32 <= length; i += 32) {
+				__m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+				if (_mm256_movemask_epi8(bytes) != 0) {
+					break;
+				}
+
+				__m256i low = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(bytes));
+				__m256i high = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(bytes, 1));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), low);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i + 16), high);
+			}
+
+			return i;
+		}
+
+		BIOMETRIC_CIPHER_TARGET("sse4.1")
+		size_t NarrowAsciiSse(const char16_t* input, size_t length, char* output)
+		{
+			const __m128i nonAscii = _mm_set1_epi16(static_cast<short>(0xFF80));
+
+			size_t i = 0;
+			for (; i + 16 <= length; i += 16) {
+				__m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+				__m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i + 8));
+				if (!_mm_testz_si128(_mm_or_si128(low, high), nonAscii)) {
+					break;
+				}
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_packus_epi16(low, high));
+			}
+
+			return i;
+		}
+
+		BIOMETRIC_CIPHER_TARGET("avx2")
+		size_t NarrowAsciiAvx2(const char16_t* input, size_t length, char* output)
+		{
+			const __m256i nonAscii = _mm256_set1_epi16(static_cast<short>(0xFF80));
+
+			size_t i = 0;
+			for (; i + 32 <= length; i += 32) {
+				__m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+				__m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i + 16));
+				if (!_mm256_testz_si256(_mm256_or_si256(low, high), nonAscii)) {
+					break;
+				}
+
+				// packus works per 128-bit lane; restore the order of the 64-bit quarters.
+				__m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(low, high), 0xD8);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), packed);
+			}
+
+			return i;
+		}
+#endif
+
+		size_t WidenAscii(const uint8_t* input, size_t length, char16_t* output, SimdLevel level)
+		{
+			size_t i = 0;
+#if defined(BIOMETRIC_CIPHER_X86)
+			if (level >= SimdLevel::kAvx2) {
+				i = WidenAsciiAvx2(input, length, output);
+			}
+			else if (level >= SimdLevel::kSse41) {
+				i = WidenAsciiSse(input, length, output);
+			}
+#else
+			(void)level;
+#endif
+			while (i < length && input[i] < 0x80) {
+				output[i] = input[i];
+				++i;
+			}
+
+			return i;
+		}
+
+		size_t NarrowAscii(const char16_t* input, size_t length, char* output, SimdLevel level)
+		{
+			size_t i = 0;
+#if defined(BIOMETRIC_CIPHER_X86)
+			if (level >= SimdLevel::kAvx2) {
+				i = NarrowAsciiAvx2(input, length, output);
+			}
+			else if (level >= SimdLevel::kSse41) {
+				i = NarrowAsciiSse(input, length, output);
+			}
+#else
+			(void)level;
+#endif
+			while (i < length && input[i] < 0x80) {
+				output[i] = static_cast<char>(input[i]);
+				++i;
+			}
+
+			return i;
+		}
+	}
+
+	size_t UtfConverter::ConvertUtf8ToUtf16(std::string_view string, char16_t* output, SimdLevel level)
+	{
+		level = CpuFeatures::Clamp(level);
+
+		const auto* input = reinterpret_cast<const uint8_t*>(string.data());
+		const auto length = string.size();
+		char16_t* start = output;
+
+		size_t i = 0;
+		while (i < length) {
+			auto ascii = WidenAscii(input + i, length - i, output, level);
+			i += ascii;
+			output += ascii;
+
+			if (i < length) {
+				i += ConvertUtf8Sequence(input + i, length - i, output);
+			}
+		}
+
+		return static_cast<size_t>(output - start);
+	}
+
+	size_t UtfConverter::ConvertUtf16ToUtf8(std::u16string_view string, char* output, SimdLevel level)
+	{
+		level = CpuFeatures::Clamp(level);
+
+		const auto* input = string.data();
+		const auto length = string.size();
+		char* start = output;
+
+		size_t i = 0;
+		while (i < length) {
+			auto ascii = NarrowAscii(input + i, length - i, output, level);
+			i += ascii;
+			output += ascii;
+
+			if (i < length) {
+				i += ConvertUtf16CodePoint(input + i, length - i, output);
+			}
+		}
+
+		return static_cast<size_t>(output - start);
+	}
+
+	std::u16string UtfConverter::ConvertUtf8ToUtf16(std::string_view string)
+	{
+		std::u16string output(GetMaxUtf16Length(string.size()), u'\0');
+		output.resize(ConvertUtf8ToUtf16(string, output.data()));
+
+		return output;
+	}
+
+	SecureBuffer UtfConverter::ConvertUtf8ToUtf16LE(std::string_view string)
+	{
+		// Converted in place: the data to sign must not be left behind in a temporary.
+		SecureBuffer output(GetMaxUtf16Length(string.size()) * sizeof(char16_t));
+		auto* utf16 = reinterpret_cast<char16_t*>(output.data());
+		auto length = ConvertUtf8ToUtf16(string, utf16);
+
+		if constexpr (std::endian::native == std::endian::big) {
+			for (size_t i = 0; i < length; ++i) {
+				auto codeUnit = utf16[i];
+				output[i * 2] = static_cast<uint8_t>(codeUnit & 0xFF);
+				output[i * 2 + 1] = static_cast<uint8_t>(codeUnit >> 8);
+			}
+		}
+		output.resize(length * sizeof(char16_t));
+
+		return output;
+	}
+
+	std::string UtfConverter::ConvertUtf16ToUtf8(std::u16string_view string)
+	{
+		std::string output(GetMaxUtf8Length(string.size()), '\0');
+		output.resize(ConvertUtf16ToUtf8(string, output.data()));
+
+		return output;
+	}
+}  // namespace biometric_cipher
@@ -2,27 +2,247 @@
 
 #include "include/biometric_cipher/enums/argument_name.h"
 #include "include/biometric_cipher/enums/method_name.h"
+#include "include/biometric_cipher/enums/method_schema.h"
 
 #include <flutter/encodable_value.h>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
 #include <string>
-#include <exception>
-#include <unordered_map>
+#include <string_view>
+#include <vector>
 
 namespace biometric_cipher {
-	struct ParsedArguments {
-		std::string stringArgument;
+	// The parsed arguments of each method. They are views into the EncodableValue they were
+	// parsed from and must not outlive the method call: a handler copies what its operation
+	// needs out of them once, and that copy is then moved into the coroutine frame.
+
+	// An argument that may be a string or a byte array.
+	struct DataArgument {
+		std::string_view stringArgument;
+		std::span<const uint8_t> binaryArgument;
+		bool isBinary = false;
+
+		// The bytes of the argument; strings are taken as their UTF-8 bytes. Plaintext is
+		// copied into a SecureBuffer.
+		template <typename Buffer = std::vector<uint8_t>>
+		Buffer CopyBytes() const
+		{
+			if (isBinary) {
+				return Buffer(binaryArgument.begin(), binaryArgument.end());
+			}
+
+			return Buffer(stringArgument.begin(), stringArgument.end());
+		}
+	};
+
+	// generateKey, deleteKey, invalidateKeyCache and encryptStreamBegin.
+	struct TagArguments {
+		std::string_view tag;
+		// Empty if missing or the method takes none: the key of tag itself.
+		std::string_view context;
+	};
+
+	// encrypt, decrypt and decryptStreamBegin.
+	struct DataArguments {
+		std::string_view tag;
+		DataArgument data;
+		// Empty if missing: the key of tag itself.
+		std::string_view context;
 	};
 
+	// encryptBatch and decryptBatch. Every item of data has been checked to be a string.
+	struct BatchArguments {
+		std::string_view tag;
+		const flutter::EncodableList* data = nullptr;
+		// Empty if missing: the key of tag itself.
+		std::string_view context;
+
+		// Plaintext items are copied into SecureStrings.
+		template <typename String = std::string>
+		std::vector<String> CopyData() const
+		{
+			std::vector<String> items;
+			items.reserve(data->size());
+			for (const auto& item : *data) {
+				items.emplace_back(std::get<std::string>(item));
+			}
+
+			return items;
+		}
+	};
+
+	// encryptStreamChunk and decryptStreamChunk.
+	struct StreamChunkArguments {
+		uint32_t streamId = 0;
+		uint32_t chunkIndex = 0;
+		DataArgument data;
+	};
+
+	// encryptStreamEnd and decryptStreamEnd. chunkIndex is the number of chunks sent.
+	struct StreamArguments {
+		uint32_t streamId = 0;
+		uint32_t chunkIndex = 0;
+	};
+
+	struct ConfigureArguments {
+		std::string_view windowsDataToSign;
+		std::optional<uint32_t> windowsKeyCacheTtlSeconds;
+		std::optional<uint32_t> windowsKeyCacheMaxEntries;
+		std::optional<uint32_t> windowsBiometryStatusCacheTtlSeconds;
+		// Empty if missing.
+		std::string_view windowsTraceFilePath;
+	};
+
+	struct Sha256Arguments {
+		DataArgument data;
+	};
+
+	struct HmacSha256Arguments {
+		DataArgument key;
+		DataArgument data;
+	};
+
+	// One argument checked against its ArgumentType: kString, kStringOrBinary and
+	// kOptionalString fill data, kStringList fills list and kOptionalUInt and kUInt fill number.
+	struct ArgumentValue {
+		DataArgument data;
+		const flutter::EncodableList* list = nullptr;
+		std::optional<uint32_t> number;
+	};
+
+	// Indexed by ArgumentName; only the arguments of the parsed method are set.
+	using ArgumentValues = std::array<ArgumentValue, ARGUMENT_NAME_COUNT>;
+
+	// Checks the arguments of a method against its row in METHOD_SCHEMAS. The typed Parse*
+	// functions refuse to compile for a method whose schema lacks the arguments they return.
 	class ArgumentParser {
-	public: 
-		std::unordered_map<ArgumentName, ParsedArguments>
-			Parse(const MethodName methodName, const flutter::EncodableValue* args) const;
+	public:
+		ArgumentValues ParseArguments(MethodName method, const flutter::EncodableValue* args) const;
+
+		template <MethodName method>
+		TagArguments ParseTagArguments(const flutter::EncodableValue* args) const
+		{
+			static_assert(TakesArgument(method, ArgumentName::kTag, ArgumentType::kString));
+
+			auto values = ParseArguments(method, args);
+
+			return TagArguments{
+				Get(values, ArgumentName::kTag).data.stringArgument,
+				GetContext<method>(values),
+			};
+		}
+
+		template <MethodName method>
+		DataArguments ParseDataArguments(const flutter::EncodableValue* args) const
+		{
+			static_assert(TakesArgument(method, ArgumentName::kTag, ArgumentType::kString));
+			static_assert(TakesArgument(method, ArgumentName::kData, ArgumentType::kStringOrBinary));
+
+			auto values = ParseArguments(method, args);
+
+			return DataArguments{
+				Get(values, ArgumentName::kTag).data.stringArgument,
+				Get(values, ArgumentName::kData).data,
+				GetContext<method>(values),
+			};
+		}
+
+		template <MethodName method>
+		BatchArguments ParseBatchArguments(const flutter::EncodableValue* args) const
+		{
+			static_assert(TakesArgument(method, ArgumentName::kTag, ArgumentType::kString));
+			static_assert(TakesArgument(method, ArgumentName::kData, ArgumentType::kStringList));
+
+			auto values = ParseArguments(method, args);
+
+			return BatchArguments{
+				Get(values, ArgumentName::kTag).data.stringArgument,
+				Get(values, ArgumentName::kData).list,
+				GetContext<method>(values),
+			};
+		}
+
+		template <MethodName method>
+		StreamChunkArguments ParseStreamChunkArguments(const flutter::EncodableValue* args) const
+		{
+			static_assert(TakesArgument(method, ArgumentName::kStreamId, ArgumentType::kUInt));
+			static_assert(TakesArgument(method, ArgumentName::kChunkIndex, ArgumentType::kUInt));
+			static_assert(TakesArgument(method, ArgumentName::kData, ArgumentType::kStringOrBinary));
+
+			auto values = ParseArguments(method, args);
+
+			return StreamChunkArguments{
+				*Get(values, ArgumentName::kStreamId).number,
+				*Get(values, ArgumentName::kChunkIndex).number,
+				Get(values, ArgumentName::kData).data,
+			};
+		}
+
+		template <MethodName method>
+		StreamArguments ParseStreamArguments(const flutter::EncodableValue* args) const
+		{
+			static_assert(TakesArgument(method, ArgumentName::kStreamId, ArgumentType::kUInt));
+			static_assert(TakesArgument(method, ArgumentName::kChunkIndex, ArgumentType::kUInt));
+
+			auto values = ParseArguments(method, args);
+
+			return StreamArguments{
+				*Get(values, ArgumentName::kStreamId).number,
+				*Get(values, ArgumentName::kChunkIndex).number,
+			};
+		}
+
+		ConfigureArguments ParseConfigureArguments(const flutter::EncodableValue* args) const;
+
+		Sha256Arguments ParseSha256Arguments(const flutter::EncodableValue* args) const;
+
+		HmacSha256Arguments ParseHmacSha256Arguments(const flutter::EncodableValue* args) const;
 
 	private:
-		static ParsedArguments FetchAndValidateArgument(const flutter::EncodableMap& argumentMap, biometric_cipher::ArgumentName argumentName);
+		static const ArgumentValue& Get(const ArgumentValues& values, ArgumentName argumentName)
+		{
+			return values[static_cast<size_t>(argumentName)];
+		}
+
+		template <MethodName method>
+		static std::string_view GetContext(const ArgumentValues& values)
+		{
+			if constexpr (TakesArgument(method, ArgumentName::kContext, ArgumentType::kOptionalString)) {
+				return Get(values, ArgumentName::kContext).data.stringArgument;
+			}
+			else {
+				return {};
+			}
+		}
+
+		static const flutter::EncodableMap& GetArgumentMap(const flutter::EncodableValue* args);
+
+		// Returns null if the argument is missing. Compares the keys in place, without building
+		// an EncodableValue for the name.
+		static const flutter::EncodableValue* FindArgument(const flutter::EncodableMap& argumentMap, std::string_view argName);
+
+		static std::string_view FetchAndValidateArgument(const flutter::EncodableValue* value, std::string_view argName);
+
+		static DataArgument FetchAndValidateStringOrBinaryArgument(const flutter::EncodableValue* value, std::string_view argName);
+
+		static const flutter::EncodableList* FetchAndValidateListArgument(const flutter::EncodableValue* value, std::string_view argName);
+
+		static uint32_t FetchAndValidateUIntArgument(const flutter::EncodableValue* value, std::string_view argName);
+
+		static std::optional<uint32_t> FetchOptionalUIntArgument(const flutter::EncodableValue* value, std::string_view argName);
+
+		static std::string_view FetchOptionalStringArgument(const flutter::EncodableValue* value, std::string_view argName);
+
+		static std::string CreateMissingArgumentMessage(std::string_view argName);
+
+		static std::string CreateMissingArgumentTypeMessage(std::string_view argName);
+
+		static std::string CreateInvalidStringOrBinaryArgumentTypeMessage(std::string_view argName);
 
-		static std::wstring CreateMissingArgumentMessage(const std::string& argName);
+		static std::string CreateInvalidListArgumentTypeMessage(std::string_view argName);
 
-		static std::wstring CreateMissingArgumentTypeMessage(const std::string& argName);
+		static std::string CreateInvalidUIntArgumentMessage(std::string_view argName);
 	};
 }
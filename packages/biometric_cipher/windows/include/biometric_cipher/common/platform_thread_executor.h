@@ -0,0 +1,35 @@
+#pragma once
+
+#include "include/biometric_cipher/common/executor.h"
+
+#include <windows.h>
+#include <deque>
+#include <mutex>
+
+namespace biometric_cipher {
+	// Runs work on the Flutter platform thread, which is the only thread that may use
+	// flutter::MethodResult. Work is posted to a message-only window, so it runs from the
+	// runner's message loop. Must be created and destroyed on the platform thread; work
+	// that is still queued when it is destroyed is dropped.
+	class PlatformThreadExecutor : public Executor {
+	public:
+		PlatformThreadExecutor();
+
+		~PlatformThreadExecutor() override;
+
+		PlatformThreadExecutor(const PlatformThreadExecutor&) = delete;
+		PlatformThreadExecutor& operator=(const PlatformThreadExecutor&) = delete;
+
+		void Post(Work work) override;
+
+	private:
+		static LRESULT CALLBACK WindowProc(HWND window, UINT message, WPARAM wparam, LPARAM lparam);
+
+		void RunPending();
+
+		HWND m_Window = nullptr;
+
+		std::mutex m_Mutex;
+		std::deque<Work> m_Queue;
+	};
+}
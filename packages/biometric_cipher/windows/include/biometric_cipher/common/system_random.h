@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace biometric_cipher {
+	// The system-preferred CSPRNG (BCryptGenRandom), without the IBuffer round trip of
+	// CryptographicBuffer::GenerateRandom.
+	class SystemRandom {
+	public:
+		// Throws BiometricCipherException(error_fail) if the RNG fails.
+		static void Fill(uint8_t* output, size_t length);
+	};
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "include/biometric_cipher/common/secure_allocator.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <winrt/base.h>
+#include <winrt/windows.storage.streams.h>
+
+namespace biometric_cipher {
+	// Conversions between the portable core types and their WinRT counterparts.
+	class WinrtInterop {
+	public:
+		static winrt::Windows::Storage::Streams::IBuffer ConvertVectorToBuffer(std::span<const uint8_t> data);
+		static std::vector<uint8_t> ConvertBufferToVector(const winrt::Windows::Storage::Streams::IBuffer& buffer);
+		static SecureBuffer ConvertBufferToSecureBuffer(const winrt::Windows::Storage::Streams::IBuffer& buffer);
+
+		// Buffers handed to or returned by WinRT live on the ordinary heap; the ones that carry
+		// secrets are zeroed as soon as they have been copied.
+		static void ZeroBuffer(const winrt::Windows::Storage::Streams::IBuffer& buffer);
+		static BiometricCipherException ConvertHResultError(const winrt::hresult_error& error);
+	};
+}
@@ -1,9 +1,17 @@
 #pragma once
 
+#include "include/biometric_cipher/common/executor.h"
+#include "include/biometric_cipher/common/lru_cache.h"
+#include "include/biometric_cipher/common/metrics_registry.h"
 #include "include/biometric_cipher/repositories/windows_hello_repository.h"
+#include "include/biometric_cipher/storages/biometry_status_cache.h"
 #include "include/biometric_cipher/wrappers/windows_hello_wrapper_impl.h"
 
+#include <windows.h>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 #include <winrt/base.h>
 #include <winrt/windows.foundation.h>
 #include <winrt/windows.security.credentials.h>
@@ -12,30 +20,69 @@
 
 namespace biometric_cipher
 {
+	// The prompts of SignAsync, CreateCredentialAsync and DeleteCredentialAsync, and the hook
+	// that lets the Windows Hello dialog take the foreground, run on promptExecutor: the hook
+	// only sees windows of the thread that installs it, and the dialog takes its owner from
+	// the calling thread. The rest of each call resumes on workExecutor. Either may be null to
+	// stay on the calling thread. The executors are not owned and must outlive every call.
 	class WindowsHelloRepositoryImpl : public WindowsHelloRepository
 	{
 	public:
-		explicit WindowsHelloRepositoryImpl(std::shared_ptr<WindowsHelloWrapper> helloWrapper = nullptr)
-			: m_HelloWrapper(helloWrapper ? helloWrapper : std::make_shared<WindowsHelloWrapperImpl>()) { }
+		explicit WindowsHelloRepositoryImpl(
+			std::shared_ptr<WindowsHelloWrapper> helloWrapper = nullptr,
+			std::shared_ptr<BiometryStatusCache> biometryStatusCache = nullptr,
+			std::shared_ptr<MetricsRegistry> metrics = nullptr,
+			Executor* promptExecutor = nullptr,
+			Executor* workExecutor = nullptr)
+			: m_HelloWrapper(helloWrapper ? helloWrapper : std::make_shared<WindowsHelloWrapperImpl>()),
+			m_BiometryStatusCache(biometryStatusCache ? biometryStatusCache : std::make_shared<BiometryStatusCache>()),
+			m_Metrics(std::move(metrics)),
+			m_PromptExecutor(promptExecutor),
+			m_WorkExecutor(workExecutor) { }
 
-		winrt::Windows::Foundation::IAsyncOperation<int> GetWindowsHelloStatusAsync() const override;
+		Task<int> GetWindowsHelloStatusAsync() const override;
 
-		winrt::Windows::Foundation::IAsyncOperation<winrt::Windows::Storage::Streams::IBuffer> SignAsync(
-			const winrt::hstring tag,
-			const winrt::Windows::Storage::Streams::IBuffer data) const override;
+		Task<SecureBuffer> SignAsync(
+			const std::string tag,
+			const SecureBuffer data) const override;
 
-		winrt::Windows::Foundation::IAsyncAction CreateCredentialAsync(const winrt::hstring tag) const override;
+		Task<> CreateCredentialAsync(const std::string tag) const override;
 
-		winrt::Windows::Foundation::IAsyncAction DeleteCredentialAsync(const winrt::hstring tag) const override;
+		Task<> DeleteCredentialAsync(const std::string tag) const override;
 	private:
 		static const uint32_t NONCE_LENGTH = 12;
 
 		static const uint32_t TAG_LENGTH = 16;
 
-		static void CheckKeyCredentialStatus(winrt::Windows::Security::Credentials::KeyCredentialStatus status);
+		static const size_t MAX_CACHED_CREDENTIALS = 16;
+
+		// Throws for any status but Success. Statuses that may mean that Windows Hello is no
+		// longer available also drop the cached availability.
+		void CheckKeyCredentialStatus(winrt::Windows::Security::Credentials::KeyCredentialStatus status) const;
+
+		// Lets the Windows Hello dialog come to the foreground. Must be removed on the thread
+		// that installed it.
+		static HHOOK InstallForegroundHook();
+
+		static void RemoveForegroundHook(HHOOK hook);
 
 		std::shared_ptr<WindowsHelloWrapper> m_HelloWrapper;
+		std::shared_ptr<BiometryStatusCache> m_BiometryStatusCache;
+		// Times the status check and the prompt of each sign; may be null.
+		std::shared_ptr<MetricsRegistry> m_Metrics;
+		Executor* m_PromptExecutor;
+		Executor* m_WorkExecutor;
+
+		// Opened credentials by tag, so that a sign does not have to look the key up in the
+		// key storage again. Only the handle is kept; every sign still prompts the user.
+		mutable LruCache<std::string, winrt::Windows::Security::Credentials::KeyCredential> m_CredentialCache{ MAX_CACHED_CREDENTIALS };
+
+		Task<winrt::Windows::Security::Credentials::KeyCredential> OpenCredentialAsync(const std::string tag) const;
+
+		Task<int> QueryWindowsHelloStatusAsync() const;
 
-		winrt::Windows::Foundation::IAsyncAction CheckWindowsHelloIsStatusAsync() const;
+		// Uses the cached availability when there is one, so a sign does not cost two extra
+		// WinRT round trips.
+		Task<> CheckWindowsHelloIsStatusAsync() const;
 	};
 }
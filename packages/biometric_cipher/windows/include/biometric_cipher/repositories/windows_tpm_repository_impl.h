@@ -1,10 +1,12 @@
 #pragma once
 
 #include "include/biometric_cipher/repositories/windows_tpm_repository.h"
+#include "include/biometric_cipher/errors/error_codes.h"
 #include "include/biometric_cipher/wrappers/ncrypt_wrapper_impl.h"
 
 #include <string>
 #include <memory>
+#include <mutex>
 
 namespace biometric_cipher
 {
@@ -16,11 +18,23 @@ namespace biometric_cipher
 
 		int GetWindowsTpmVersion() const override;
 
+		void Refresh() const override;
+
 	private:
-		static void CheckStatus(const winrt::hresult hr, const std::wstring& message, const int errorCode);
+		// Opens the Platform Crypto Provider on first use and keeps it open for the next
+		// queries. Must be called with m_ProviderMutex held.
+		const NCryptHandleFree& GetProviderHandle() const;
+
+		void CloseProviderHandle() const;
+
+		static void CheckStatus(const ErrorCode code, const std::string& message, const int errorCode);
 
 		static const std::wstring ParsePlatformType(const std::wstring& platformVersion);
 
 		std::shared_ptr<NCryptWrapper> m_NCryptWrapper;
+
+		mutable std::mutex m_ProviderMutex;
+		mutable NCryptHandleFree m_ProviderHandle;
+		mutable bool m_IsProviderOpen = false;
 	};
 }  // namespace biometric_cipher
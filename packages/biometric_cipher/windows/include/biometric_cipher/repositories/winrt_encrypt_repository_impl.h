@@ -1,30 +1,105 @@
 #pragma once
 
+#include "include/biometric_cipher/common/aead_key.h"
+#include "include/biometric_cipher/common/metrics_registry.h"
+#include "include/biometric_cipher/common/parallel_runner.h"
+#include "include/biometric_cipher/common/random_source.h"
+#include "include/biometric_cipher/enums/aead_suite.h"
 #include "include/biometric_cipher/repositories/winrt_encrypt_repository.h"
 
+#include <cstdint>
 #include <memory>
-#include <winrt/base.h>
-#include <winrt/windows.foundation.h>
-#include <winrt/windows.security.cryptography.core.h>
-#include <winrt/windows.storage.streams.h>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace biometric_cipher
 {
+	// The 256-bit key derived from a Windows Hello signature, prepared once for every
+	// Encrypt/Decrypt made with it (see AeadKey); wiped when the last reference is dropped.
+	struct AesGcmSymmetricKey : SymmetricKey
+	{
+		explicit AesGcmSymmetricKey(const uint8_t* keyMaterial)
+			: key(keyMaterial) {}
+
+		AeadKey key;
+	};
+
 	class WinrtEncryptRepositoryImpl : public WinrtEncryptRepository
 	{
 	public:
-		winrt::Windows::Security::Cryptography::Core::CryptographicKey CreateAESKey(const winrt::Windows::Storage::Streams::IBuffer signature) const override;
+		// Nonces come from nonceSource; by default the system RNG, buffered per thread.
+		// metrics, if given, times key derivation, AES-GCM and Base64. segmentRunner, if
+		// given, seals and opens the segments of large stream chunks in parallel. New
+		// envelopes are sealed with suite; by default the one AeadSuiteSelector measures
+		// fastest on this device. Every suite opens regardless.
+		explicit WinrtEncryptRepositoryImpl(
+			std::shared_ptr<RandomSource> nonceSource = nullptr,
+			std::shared_ptr<MetricsRegistry> metrics = nullptr,
+			std::shared_ptr<const ParallelRunner> segmentRunner = nullptr,
+			std::optional<AeadSuite> suite = std::nullopt);
+
+		std::shared_ptr<SymmetricKey> CreateAESKey(const SecureBuffer& signature) const override;
+
+		// HKDF-SHA256 over the key, under a versioned label followed by the UTF-8 context.
+		std::shared_ptr<SymmetricKey> DeriveSubkey(
+			const std::shared_ptr<SymmetricKey>& key,
+			std::string_view context) const override;
+
+		std::string Encrypt(
+			const std::shared_ptr<SymmetricKey>& key,
+			const SecureString& data) const override;
+
+		SecureString Decrypt(
+			const std::shared_ptr<SymmetricKey>& key,
+			const std::string& data) const override;
 
-		winrt::hstring Encrypt(
-			const winrt::Windows::Security::Cryptography::Core::CryptographicKey key,
-			const winrt::hstring data) const override;
+		std::vector<uint8_t> EncryptBinary(
+			const std::shared_ptr<SymmetricKey>& key,
+			const SecureBuffer& data) const override;
 
-		winrt::hstring Decrypt(
-			const winrt::Windows::Security::Cryptography::Core::CryptographicKey key,
-			const winrt::hstring data) const override;
+		SecureBuffer DecryptBinary(
+			const std::shared_ptr<SymmetricKey>& key,
+			const std::vector<uint8_t>& data) const override;
+
+		// The base nonce comes from the nonce source.
+		std::unique_ptr<EncryptStream> CreateEncryptStream(
+			const std::shared_ptr<SymmetricKey>& key) const override;
+
+		std::unique_ptr<DecryptStream> CreateDecryptStream(
+			const std::shared_ptr<SymmetricKey>& key,
+			std::span<const uint8_t> header) const override;
 	private:
-		static const uint32_t NONCE_LENGTH = 12;
+		// The UTF-16 form of a string payload, which is what gets encrypted.
+		using SecureUtf16Buffer = std::vector<char16_t, SecureAllocator<char16_t>>;
+
+		static const uint32_t NONCE_LENGTH = static_cast<uint32_t>(AeadKey::NONCE_LENGTH);
+
+		static const AesGcmSymmetricKey& GetAesGcmKey(const std::shared_ptr<SymmetricKey>& key);
+
+		// The prepared key of key, sharing its ownership.
+		static std::shared_ptr<const AesGcmKey> GetStreamKey(const std::shared_ptr<SymmetricKey>& key);
+
+		// The envelope layout is CiphertextEnvelope's.
+		std::vector<uint8_t> EncryptEnvelope(
+			const AesGcmSymmetricKey& key,
+			const uint8_t* data,
+			size_t length) const;
+
+		// output must hold CiphertextEnvelope::GetMaxPlaintextLength bytes; returns how many
+		// it got. Throws error_decrypt if the envelope does not authenticate.
+		size_t DecryptEnvelope(
+			const AesGcmSymmetricKey& key,
+			const std::vector<uint8_t>& envelope,
+			uint8_t* output) const;
+
+		AeadSuite GetSuite() const;
 
-		static const uint32_t TAG_LENGTH = 16;
+		std::shared_ptr<RandomSource> m_NonceSource;
+		std::shared_ptr<MetricsRegistry> m_Metrics;
+		std::shared_ptr<const ParallelRunner> m_SegmentRunner;
+		std::optional<AeadSuite> m_Suite;
 	};
 }
@@ -0,0 +1,87 @@
+#include "include/biometric_cipher/common/platform_thread_executor.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+
+#include <utility>
+
+namespace biometric_cipher
+{
+	namespace
+	{
+		const wchar_t* WINDOW_CLASS_NAME = L"BiometricCipherPlatformThreadExecutor";
+		const UINT WM_RUN_PENDING = WM_APP + 1;
+	}
+
+	PlatformThreadExecutor::PlatformThreadExecutor()
+	{
+		WNDCLASSEXW windowClass{};
+		windowClass.cbSize = sizeof(windowClass);
+		windowClass.lpfnWndProc = &PlatformThreadExecutor::WindowProc;
+		windowClass.hInstance = GetModuleHandleW(nullptr);
+		windowClass.lpszClassName = WINDOW_CLASS_NAME;
+		if (!RegisterClassExW(&windowClass) && GetLastError() != ERROR_CLASS_ALREADY_EXISTS) {
+			throw BiometricCipherException(error_fail, "Failed to register the platform thread window class.");
+		}
+
+		m_Window = CreateWindowExW(0, WINDOW_CLASS_NAME, L"", 0, 0, 0, 0, 0, HWND_MESSAGE, nullptr, windowClass.hInstance, nullptr);
+		if (m_Window == nullptr) {
+			throw BiometricCipherException(error_fail, "Failed to create the platform thread window.");
+		}
+
+		SetWindowLongPtrW(m_Window, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(this));
+	}
+
+	PlatformThreadExecutor::~PlatformThreadExecutor()
+	{
+		HWND window = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			window = std::exchange(m_Window, nullptr);
+			m_Queue.clear();
+		}
+
+		SetWindowLongPtrW(window, GWLP_USERDATA, 0);
+		DestroyWindow(window);
+	}
+
+	void PlatformThreadExecutor::Post(Work work)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		if (m_Window == nullptr) {
+			return;
+		}
+
+		// One message per work item keeps the message loop responsive between items.
+		m_Queue.push_back(std::move(work));
+		PostMessageW(m_Window, WM_RUN_PENDING, 0, 0);
+	}
+
+	LRESULT CALLBACK PlatformThreadExecutor::WindowProc(HWND window, UINT message, WPARAM wparam, LPARAM lparam)
+	{
+		if (message == WM_RUN_PENDING) {
+			auto* executor = reinterpret_cast<PlatformThreadExecutor*>(GetWindowLongPtrW(window, GWLP_USERDATA));
+			if (executor != nullptr) {
+				executor->RunPending();
+			}
+
+			return 0;
+		}
+
+		return DefWindowProcW(window, message, wparam, lparam);
+	}
+
+	void PlatformThreadExecutor::RunPending()
+	{
+		Work work;
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			if (m_Queue.empty()) {
+				return;
+			}
+
+			work = std::move(m_Queue.front());
+			m_Queue.pop_front();
+		}
+
+		work();
+	}
+}
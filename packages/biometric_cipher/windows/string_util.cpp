@@ -1,79 +1,63 @@
 #include "include/biometric_cipher/common/string_util.h"
-#include "include/biometric_cipher/errors/error_codes.h"
+#include "include/biometric_cipher/common/utf_converter.h"
 
-#include <windows.h>
-#include <wincrypt.h>
-
-using namespace winrt;
-using namespace winrt::impl;
+#include <string_view>
 
 namespace biometric_cipher 
 {
-	std::string StringUtil::ConvertWideStringToString(const std::wstring& wideString)
+	static_assert(sizeof(wchar_t) == sizeof(char16_t), "Windows wide strings are UTF-16.");
+
+	namespace
 	{
-		if (wideString.empty())
+		std::u16string_view AsUtf16(const wchar_t* string, size_t length)
 		{
-			return std::string();
+			return std::u16string_view(reinterpret_cast<const char16_t*>(string), length);
 		}
 
-		auto size_needed = WideCharToMultiByte(CP_UTF8, 0, wideString.c_str(), (int)wideString.size(), nullptr, 0, nullptr, nullptr);
-		if (size_needed == 0) {
-			throw hresult_error(error_converting_string, L"WideCharToMultiByte failed to calculate size.");
-		}
+		std::string ConvertToString(std::u16string_view string)
+		{
+			std::string result(UtfConverter::GetMaxUtf8Length(string.size()), '\0');
+			result.resize(UtfConverter::ConvertUtf16ToUtf8(string, result.data()));
 
-		std::string strTo(size_needed, 0);
-		auto bytes_written = WideCharToMultiByte(CP_UTF8, 0, wideString.c_str(), (int)wideString.size(), strTo.data(), size_needed, nullptr, nullptr);
-		if (bytes_written == 0) {
-			throw hresult_error(error_converting_string, L"WideCharToMultiByte failed to convert.");
+			return result;
 		}
+	}
 
-		return strTo;
+	std::string StringUtil::ConvertWideStringToString(const std::wstring& wideString)
+	{
+		return ConvertToString(AsUtf16(wideString.data(), wideString.size()));
 	}
 
 	std::wstring StringUtil::ConvertStringToWideString(const std::string& string)
 	{
-		if (string.empty())
-		{
-			return std::wstring();
-		}
-
-		auto size_needed = MultiByteToWideChar(CP_UTF8, 0, string.c_str(), (int)string.size(), nullptr, 0);
-		if (size_needed == 0) {
-			throw hresult_error(error_converting_string, L"MultiByteToWideChar failed to calculate size.");
-		}
+		std::wstring result(UtfConverter::GetMaxUtf16Length(string.size()), L'\0');
+		result.resize(UtfConverter::ConvertUtf8ToUtf16(string, reinterpret_cast<char16_t*>(result.data())));
 
-		std::wstring wstrTo(size_needed, 0);
-		auto bytes_written = MultiByteToWideChar(CP_UTF8, 0, string.c_str(), (int)string.size(), wstrTo.data(), size_needed);
-		if (bytes_written == 0) {
-			throw hresult_error(error_converting_string, L"MultiByteToWideChar failed to convert.");
-		}
-
-		return wstrTo;
+		return result;
 	}
 
 	std::string StringUtil::ConvertHStringToString(const winrt::hstring& hstring)
 	{
-		if (hstring.empty())
-		{
-			return std::string();
-		}
+		return ConvertToString(AsUtf16(hstring.c_str(), hstring.size()));
+	}
 
-		auto size_needed = WideCharToMultiByte(CP_UTF8, 0, hstring.c_str(), (int)hstring.size(), nullptr, 0, nullptr, nullptr);
-		if (size_needed == 0) {
-			throw hresult_error(error_converting_string, L"WideCharToMultiByte failed to calculate size.");
-		}
+	winrt::hstring StringUtil::ConvertStringToHString(const std::string& string) 
+	{
+		// An HSTRING must be created with its exact length, so short strings (tags, mostly)
+		// are converted on the stack and only longer ones need a temporary buffer.
+		const size_t STACK_BUFFER_LENGTH = 256;
+
+		auto maxLength = UtfConverter::GetMaxUtf16Length(string.size());
+		if (maxLength <= STACK_BUFFER_LENGTH) {
+			char16_t buffer[STACK_BUFFER_LENGTH];
+			auto length = UtfConverter::ConvertUtf8ToUtf16(string, buffer);
 
-		std::string strTo(size_needed, 0);
-		auto bytes_written = WideCharToMultiByte(CP_UTF8, 0, hstring.c_str(), (int)hstring.size(), strTo.data(), size_needed, nullptr, nullptr);
-		if (bytes_written == 0) {
-			throw hresult_error(error_converting_string, L"WideCharToMultiByte failed to convert.");
+			return winrt::hstring(std::wstring_view(reinterpret_cast<const wchar_t*>(buffer), length));
 		}
 
-		return strTo;
-	}
+		std::wstring buffer(maxLength, L'\0');
+		auto length = UtfConverter::ConvertUtf8ToUtf16(string, reinterpret_cast<char16_t*>(buffer.data()));
 
-	winrt::hstring StringUtil::ConvertStringToHString(const std::string& string) 
-	{
-		return winrt::to_hstring(string);
+		return winrt::hstring(std::wstring_view(buffer.data(), length));
 	}
 }
@@ -0,0 +1,25 @@
+#include "include/biometric_cipher/common/system_random.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+
+#include <windows.h>
+#include <bcrypt.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace biometric_cipher
+{
+	void SystemRandom::Fill(uint8_t* output, size_t length)
+	{
+		while (length > 0) {
+			auto chunkLength = static_cast<ULONG>((std::min)(length, static_cast<size_t>((std::numeric_limits<ULONG>::max)())));
+			NTSTATUS status = BCryptGenRandom(nullptr, output, chunkLength, BCRYPT_USE_SYSTEM_PREFERRED_RNG);
+			if (!BCRYPT_SUCCESS(status)) {
+				throw BiometricCipherException(error_fail, "BCryptGenRandom failed.");
+			}
+
+			output += chunkLength;
+			length -= chunkLength;
+		}
+	}
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+// Include the code under test
+#include "include/biometric_cipher/common/string_util.h"
+
+namespace biometric_cipher {
+	namespace test {
+
+		using namespace biometric_cipher;
+
+		// winrt::to_hstring and winrt::to_string use MultiByteToWideChar and WideCharToMultiByte,
+		// which StringUtil used to call directly.
+		class StringUtilTest : public ::testing::Test {
+		protected:
+			static std::string MakeMixedText(size_t length)
+			{
+				static const std::string kChunk = "abcdefghij\xD0\xB4\xE2\x82\xAC\xF0\x9F\x98\x80!";
+
+				std::string text;
+				while (text.size() < length) {
+					text += kChunk;
+				}
+
+				return text;
+			}
+		};
+
+		TEST_F(StringUtilTest, ConvertStringToHString_MatchesWindows)
+		{
+			for (size_t length : { 0, 1, 17, 255, 256, 257, 4096 }) {
+				auto text = MakeMixedText(length);
+
+				EXPECT_EQ(StringUtil::ConvertStringToHString(text), winrt::to_hstring(text)) << "length " << length;
+				EXPECT_EQ(StringUtil::ConvertStringToWideString(text), std::wstring(winrt::to_hstring(text))) << "length " << length;
+			}
+		}
+
+		TEST_F(StringUtilTest, ConvertHStringToString_MatchesWindows)
+		{
+			for (size_t length : { 0, 1, 17, 255, 256, 257, 4096 }) {
+				auto text = winrt::to_hstring(MakeMixedText(length));
+
+				EXPECT_EQ(StringUtil::ConvertHStringToString(text), winrt::to_string(text)) << "length " << length;
+				EXPECT_EQ(StringUtil::ConvertWideStringToString(std::wstring(text)), winrt::to_string(text)) << "length " << length;
+			}
+		}
+
+		TEST_F(StringUtilTest, ConvertStringToHString_ReplacesMalformedInputLikeWindows)
+		{
+			const std::string malformed = "\x80" "a" "\xE2\x82" "b" "\xC0\xAF" "\xED\xA0\x80";
+
+			EXPECT_EQ(StringUtil::ConvertStringToHString(malformed), winrt::to_hstring(malformed));
+		}
+
+		TEST_F(StringUtilTest, ConvertWideStringToString_ReplacesUnpairedSurrogatesLikeWindows)
+		{
+			const std::wstring malformed = { 0xDC00, L'a', 0xD800, L'b', 0xD83D };
+
+			EXPECT_EQ(StringUtil::ConvertWideStringToString(malformed), winrt::to_string(malformed));
+		}
+	}
+}
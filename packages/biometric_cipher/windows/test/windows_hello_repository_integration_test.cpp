@@ -2,6 +2,7 @@
 
 #include "include/biometric_cipher/repositories/windows_hello_repository_impl.h"
 #include "include/biometric_cipher/enums/tpm_status.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
 
 namespace biometric_cipher
 {
@@ -28,6 +29,9 @@ namespace biometric_cipher
 				EXPECT_EQ(status, TpmStatusToInteger(TpmStatus::kSupported)) << "Expected Windows Hello to be supported";
 
 			}
+			catch (const BiometricCipherException & ex) {
+				ADD_FAILURE() << "Exception thrown: " << ex.what();
+			}
 			catch (const winrt::hresult_error & ex) {
 				ADD_FAILURE() << "Exception thrown: " << winrt::to_string(ex.message());
 			}
@@ -39,7 +43,7 @@ namespace biometric_cipher
 		// It's disabled by default. For manual testing only. (Remove DISABLED_ to enable or run whit flag `--gtest_also_run_disabled_tests`) 
 		TEST_F(WindowsHelloRepositoryIntegrationTest, DISABLED_CreateAndDeleteCredential_SmokeTest) {
 			try {
-				winrt::hstring tag = L"integration_test_tag";
+				std::string tag = "integration_test_tag";
 
 				// Create a credential
 				auto createOp = m_Repository.CreateCredentialAsync(tag);
@@ -54,6 +58,9 @@ namespace biometric_cipher
 				// If we got here, the test passed.
 				SUCCEED() << "Credential deleted successfully.";
 			}
+			catch (const BiometricCipherException & ex) {
+				ADD_FAILURE() << "Exception thrown: " << ex.what();
+			}
 			catch (const winrt::hresult_error & ex) {
 				ADD_FAILURE() << "Exception thrown: " << winrt::to_string(ex.message());
 			}
@@ -3,6 +3,9 @@
 
 #include "include/biometric_cipher/enums/tpm_status.h"
 #include "include/biometric_cipher/enums/biometry_status.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+
+#include "fakes/fake_executor.h"
 
 // Include mock
 #include "mocks/mock_windows_hello_wrapper.h"
@@ -37,6 +40,59 @@ namespace biometric_cipher {
 			}
 		};
 
+		struct FakeKeyCredentialOperationResult
+			: winrt::implements<FakeKeyCredentialOperationResult, KeyCredentialOperationResult>
+		{
+		public:
+			KeyCredentialStatus m_status = KeyCredentialStatus::Success;
+
+			IBuffer Result() const
+			{
+				return nullptr;
+			}
+
+			KeyCredentialStatus Status() const
+			{
+				return m_status;
+			}
+		};
+
+		// Signs without any UI and reports the configured status.
+		struct FakeKeyCredential
+			: winrt::implements<FakeKeyCredential, KeyCredential>
+		{
+		public:
+			KeyCredentialStatus m_signStatus = KeyCredentialStatus::Success;
+
+			winrt::hstring Name() const
+			{
+				return L"fake";
+			}
+
+			IBuffer RetrievePublicKey() const
+			{
+				return nullptr;
+			}
+
+			IBuffer RetrievePublicKey(CryptographicPublicKeyBlobType) const
+			{
+				return nullptr;
+			}
+
+			IAsyncOperation<KeyCredentialAttestationResult> GetAttestationAsync() const
+			{
+				co_return nullptr;
+			}
+
+			IAsyncOperation<KeyCredentialOperationResult> RequestSignAsync(IBuffer const&) const
+			{
+				auto result = winrt::make<FakeKeyCredentialOperationResult>();
+				result.as<FakeKeyCredentialOperationResult>()->m_status = m_signStatus;
+
+				co_return result.as<KeyCredentialOperationResult>();
+			}
+		};
+
 		class WindowsHelloRepositoryTest : public ::testing::Test {
 		protected:
 			inline IAsyncOperation<bool> MakeCompletedAsyncBool(bool value)
@@ -132,7 +188,7 @@ namespace biometric_cipher {
 
 			// Act
 			// WindowsHelloRepositoryImpl::CreateCredentialAsync co_awaits -> no direct result
-			m_Repository->CreateCredentialAsync(L"myCredential").get();
+			m_Repository->CreateCredentialAsync("myCredential").get();
 
 			// If no exception is thrown, we consider it a pass
 			SUCCEED();
@@ -154,9 +210,137 @@ namespace biometric_cipher {
 			// Act & Assert
 			EXPECT_THROW(
 				{
-					m_Repository->SignAsync(L"nonexistent", nullptr).get();
+					m_Repository->SignAsync("nonexistent", {}).get();
 				},
-				winrt::hresult_error);
+				BiometricCipherException);
+		}
+
+		TEST_F(WindowsHelloRepositoryTest, SignAsync_UsesCachedAvailability)
+		{
+			auto biometryStatusCache = std::make_shared<BiometryStatusCache>();
+			biometryStatusCache->Configure(std::chrono::seconds(60));
+			m_Repository = std::make_unique<WindowsHelloRepositoryImpl>(m_mockHelloWrapper, biometryStatusCache);
+
+			auto fakeResult = winrt::make<FakeKeyCredentialRetrievalResult>();
+			fakeResult.as<FakeKeyCredentialRetrievalResult>()->m_status = KeyCredentialStatus::NotFound;
+
+			// Only the first sign asks Windows whether Hello is available.
+			EXPECT_CALL(*m_mockHelloWrapper, IsSupportedAsync())
+				.Times(1)
+				.WillOnce(testing::Return(MakeCompletedAsyncBool(true)));
+
+			EXPECT_CALL(*m_mockHelloWrapper, OpenAsync)
+				.Times(2)
+				.WillRepeatedly([&](auto) { return MakeCompletedAsyncKeyCredentialResult(fakeResult.as<KeyCredentialRetrievalResult>()); });
+
+			EXPECT_THROW(m_Repository->SignAsync("nonexistent", {}).get(), BiometricCipherException);
+			EXPECT_THROW(m_Repository->SignAsync("nonexistent", {}).get(), BiometricCipherException);
+		}
+
+		TEST_F(WindowsHelloRepositoryTest, SignAsync_InvalidatesCachedAvailabilityIfDeviceLocked)
+		{
+			auto biometryStatusCache = std::make_shared<BiometryStatusCache>();
+			biometryStatusCache->Configure(std::chrono::seconds(60));
+			m_Repository = std::make_unique<WindowsHelloRepositoryImpl>(m_mockHelloWrapper, biometryStatusCache);
+
+			auto fakeResult = winrt::make<FakeKeyCredentialRetrievalResult>();
+			fakeResult.as<FakeKeyCredentialRetrievalResult>()->m_status = KeyCredentialStatus::SecurityDeviceLocked;
+
+			EXPECT_CALL(*m_mockHelloWrapper, IsSupportedAsync())
+				.Times(2)
+				.WillRepeatedly([&]() { return MakeCompletedAsyncBool(true); });
+
+			EXPECT_CALL(*m_mockHelloWrapper, OpenAsync)
+				.Times(2)
+				.WillRepeatedly([&](auto) { return MakeCompletedAsyncKeyCredentialResult(fakeResult.as<KeyCredentialRetrievalResult>()); });
+
+			EXPECT_THROW(m_Repository->SignAsync("tag", {}).get(), BiometricCipherException);
+			EXPECT_EQ(biometryStatusCache->Get(), std::nullopt);
+			EXPECT_THROW(m_Repository->SignAsync("tag", {}).get(), BiometricCipherException);
+		}
+
+		TEST_F(WindowsHelloRepositoryTest, SignAsync_ReusesOpenedCredential)
+		{
+			auto fakeCredential = winrt::make<FakeKeyCredential>();
+			auto fakeResult = winrt::make<FakeKeyCredentialRetrievalResult>();
+			fakeResult.as<FakeKeyCredentialRetrievalResult>()->m_credential = fakeCredential.as<KeyCredential>();
+
+			EXPECT_CALL(*m_mockHelloWrapper, IsSupportedAsync())
+				.WillRepeatedly([&]() { return MakeCompletedAsyncBool(true); });
+
+			EXPECT_CALL(*m_mockHelloWrapper, OpenAsync)
+				.Times(1)
+				.WillOnce(testing::Return(MakeCompletedAsyncKeyCredentialResult(fakeResult.as<KeyCredentialRetrievalResult>())));
+
+			m_Repository->SignAsync("tag", { 1, 2, 3 }).get();
+			m_Repository->SignAsync("tag", { 1, 2, 3 }).get();
+		}
+
+		TEST_F(WindowsHelloRepositoryTest, SignAsync_PromptsFromPromptExecutor)
+		{
+			FakeExecutor promptThread;
+			FakeExecutor workerPool;
+			m_Repository = std::make_unique<WindowsHelloRepositoryImpl>(m_mockHelloWrapper, nullptr, nullptr, &promptThread, &workerPool);
+
+			auto fakeCredential = winrt::make<FakeKeyCredential>();
+			auto fakeResult = winrt::make<FakeKeyCredentialRetrievalResult>();
+			fakeResult.as<FakeKeyCredentialRetrievalResult>()->m_credential = fakeCredential.as<KeyCredential>();
+
+			EXPECT_CALL(*m_mockHelloWrapper, IsSupportedAsync())
+				.WillOnce(testing::Return(MakeCompletedAsyncBool(true)));
+			EXPECT_CALL(*m_mockHelloWrapper, OpenAsync)
+				.WillOnce(testing::Return(MakeCompletedAsyncKeyCredentialResult(fakeResult.as<KeyCredentialRetrievalResult>())));
+
+			auto sign = m_Repository->SignAsync("tag", { 1, 2, 3 });
+
+			// Waits for the prompt thread to show the prompt and to remove the hook, then for
+			// the pool.
+			EXPECT_FALSE(sign.IsCompleted());
+			EXPECT_EQ(promptThread.RunPending(), 1u);
+			EXPECT_EQ(promptThread.RunPending(), 1u);
+			EXPECT_FALSE(sign.IsCompleted());
+			EXPECT_EQ(workerPool.RunPending(), 1u);
+			sign.get();
+		}
+
+		TEST_F(WindowsHelloRepositoryTest, SignAsync_ReopensCredentialAfterNotFound)
+		{
+			auto fakeCredential = winrt::make<FakeKeyCredential>();
+			fakeCredential.as<FakeKeyCredential>()->m_signStatus = KeyCredentialStatus::NotFound;
+			auto fakeResult = winrt::make<FakeKeyCredentialRetrievalResult>();
+			fakeResult.as<FakeKeyCredentialRetrievalResult>()->m_credential = fakeCredential.as<KeyCredential>();
+
+			EXPECT_CALL(*m_mockHelloWrapper, IsSupportedAsync())
+				.WillRepeatedly([&]() { return MakeCompletedAsyncBool(true); });
+
+			EXPECT_CALL(*m_mockHelloWrapper, OpenAsync)
+				.Times(2)
+				.WillRepeatedly([&](auto) { return MakeCompletedAsyncKeyCredentialResult(fakeResult.as<KeyCredentialRetrievalResult>()); });
+
+			EXPECT_THROW(m_Repository->SignAsync("tag", {}).get(), BiometricCipherException);
+			EXPECT_THROW(m_Repository->SignAsync("tag", {}).get(), BiometricCipherException);
+		}
+
+		TEST_F(WindowsHelloRepositoryTest, DeleteCredentialAsync_EvictsOpenedCredential)
+		{
+			auto fakeCredential = winrt::make<FakeKeyCredential>();
+			auto fakeResult = winrt::make<FakeKeyCredentialRetrievalResult>();
+			fakeResult.as<FakeKeyCredentialRetrievalResult>()->m_credential = fakeCredential.as<KeyCredential>();
+
+			EXPECT_CALL(*m_mockHelloWrapper, IsSupportedAsync())
+				.WillRepeatedly([&]() { return MakeCompletedAsyncBool(true); });
+
+			EXPECT_CALL(*m_mockHelloWrapper, OpenAsync)
+				.Times(2)
+				.WillRepeatedly([&](auto) { return MakeCompletedAsyncKeyCredentialResult(fakeResult.as<KeyCredentialRetrievalResult>()); });
+
+			EXPECT_CALL(*m_mockHelloWrapper, DeleteAsync)
+				.Times(1)
+				.WillOnce([&](auto) { return MakeCompletedAsyncAction(); });
+
+			m_Repository->SignAsync("tag", {}).get();
+			m_Repository->DeleteCredentialAsync("tag").get();
+			m_Repository->SignAsync("tag", {}).get();
 		}
 	}
 }
@@ -1,7 +1,6 @@
 #include <gtest/gtest.h>
 
-#include <winrt/base.h>
-
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
 #include "include/biometric_cipher/repositories/windows_tpm_repository_impl.h"
 
 namespace biometric_cipher {
@@ -23,10 +22,10 @@ namespace biometric_cipher {
 				// Adjust expectations as appropriate for your environment.
 				EXPECT_GE(version, 1) << "Expected TPM version >= 1";
 			}
-			catch (const winrt::hresult_error &e) {
+			catch (const BiometricCipherException &e) {
 				// If your system doesn't have TPM or if something else went wrong,
 				// you can check the exception message, but typically you'd fail the test.
-				ADD_FAILURE() << L"TpmRepositoryException thrown: " << e.message().c_str();
+				ADD_FAILURE() << "TpmRepositoryException thrown: " << e.what();
 			}
 		}
 	} // namespace test
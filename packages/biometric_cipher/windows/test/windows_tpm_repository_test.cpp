@@ -2,6 +2,7 @@
 #include <gmock/gmock.h>
 
 #include "include/biometric_cipher/enums/tpm_status.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
 
 #include <winrt/base.h>
 
@@ -30,6 +31,20 @@ namespace biometric_cipher {
 				// Inject the mock into the repository
 				m_Repository = std::make_unique<WindowsTpmRepositoryImpl>(m_mockNCryptWrapper);
 			}
+
+			// Answers both the size query and the data query for the platform type property.
+			static SECURITY_STATUS ReturnPlatformType(NCryptHandleFree const&, LPCWSTR, PBYTE pbOutput, DWORD, DWORD* pcbResult, DWORD)
+			{
+				const std::wstring fakeData = L"TPM-Version:2.0";
+				const size_t sizeInBytes = (fakeData.size() + 1) * sizeof(wchar_t);
+
+				if (pbOutput != nullptr) {
+					memcpy(pbOutput, fakeData.c_str(), sizeInBytes);
+				}
+				*pcbResult = static_cast<DWORD>(sizeInBytes);
+
+				return ERROR_SUCCESS;
+			}
 		};
 
 		TEST_F(WindowsTpmRepositoryTest, GetTPMStatusAsync_ReturnsNotSupportedIfWindowsHelloNotSupported)
@@ -129,7 +144,7 @@ namespace biometric_cipher {
 			// Act & Assert
 			EXPECT_THROW(
 				m_Repository->GetWindowsTpmVersion(),
-				winrt::hresult_error
+				BiometricCipherException
 			);
 		}
 
@@ -151,8 +166,49 @@ namespace biometric_cipher {
 			// Act & Assert
 			EXPECT_THROW(
 				m_Repository->GetWindowsTpmVersion(),
-				winrt::hresult_error
+				BiometricCipherException
 			);
 		}
+
+		TEST_F(WindowsTpmRepositoryTest, GetWindowsTpmVersion_ReusesProviderHandle)
+		{
+			EXPECT_CALL(*m_mockNCryptWrapper, OpenStorageProvider)
+				.Times(1)
+				.WillOnce(testing::Return(ERROR_SUCCESS));
+			EXPECT_CALL(*m_mockNCryptWrapper, GetProperty)
+				.Times(4)
+				.WillRepeatedly(ReturnPlatformType);
+
+			EXPECT_EQ(m_Repository->GetWindowsTpmVersion(), 2);
+			EXPECT_EQ(m_Repository->GetWindowsTpmVersion(), 2);
+		}
+
+		TEST_F(WindowsTpmRepositoryTest, Refresh_ReopensProvider)
+		{
+			EXPECT_CALL(*m_mockNCryptWrapper, OpenStorageProvider)
+				.Times(2)
+				.WillRepeatedly(testing::Return(ERROR_SUCCESS));
+			EXPECT_CALL(*m_mockNCryptWrapper, GetProperty)
+				.Times(4)
+				.WillRepeatedly(ReturnPlatformType);
+
+			EXPECT_EQ(m_Repository->GetWindowsTpmVersion(), 2);
+			m_Repository->Refresh();
+			EXPECT_EQ(m_Repository->GetWindowsTpmVersion(), 2);
+		}
+
+		TEST_F(WindowsTpmRepositoryTest, GetWindowsTpmVersion_ReopensProviderAfterGetPropertyFailure)
+		{
+			EXPECT_CALL(*m_mockNCryptWrapper, OpenStorageProvider)
+				.Times(2)
+				.WillRepeatedly(testing::Return(ERROR_SUCCESS));
+			EXPECT_CALL(*m_mockNCryptWrapper, GetProperty)
+				.Times(3)
+				.WillOnce(testing::Return(NTE_INVALID_HANDLE))
+				.WillRepeatedly(ReturnPlatformType);
+
+			EXPECT_THROW(m_Repository->GetWindowsTpmVersion(), BiometricCipherException);
+			EXPECT_EQ(m_Repository->GetWindowsTpmVersion(), 2);
+		}
 	}
 }
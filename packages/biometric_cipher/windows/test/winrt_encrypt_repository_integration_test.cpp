@@ -5,6 +5,15 @@
 #include <winrt/windows.security.cryptography.h>
 #include <winrt/windows.security.cryptography.core.h>
 
+#include "include/biometric_cipher/common/base64.h"
+#include "include/biometric_cipher/common/ciphertext_envelope.h"
+#include "include/biometric_cipher/common/metrics_registry.h"
+#include "include/biometric_cipher/common/sha256.h"
+#include "include/biometric_cipher/common/tracer.h"
+#include "include/biometric_cipher/common/winrt_interop.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+#include "fakes/fake_random_source.h"
+
 // Include the code under test
 #include "include/biometric_cipher/repositories/winrt_encrypt_repository_impl.h"
 
@@ -20,6 +29,12 @@ namespace biometric_cipher {
 		class WinrtEncryptRepositoryTest : public ::testing::Test {
 		protected:
 			WinrtEncryptRepositoryImpl m_Repository;
+
+			// Signatures and plaintext, which the repository takes as SecureBuffers.
+			static SecureBuffer GenerateRandom(uint32_t length)
+			{
+				return WinrtInterop::ConvertBufferToSecureBuffer(CryptographicBuffer::GenerateRandom(length));
+			}
 		};
 
         //
@@ -32,15 +47,14 @@ namespace biometric_cipher {
         {
             // Arrange
             // Let's create a 10-byte random buffer (though any size is fine).
-            auto randomSignature = CryptographicBuffer::GenerateRandom(10);
+            auto randomSignature = GenerateRandom(10);
 
             // Act
             auto key = m_Repository.CreateAESKey(randomSignature);
 
             // Assert
             // If it doesn't throw, we consider this a pass. 
-            // We might also verify that 'key' is not null, but CryptographicKey is a value object.
-            SUCCEED();
+            EXPECT_NE(key, nullptr);
         }
 
         //
@@ -50,11 +64,11 @@ namespace biometric_cipher {
         TEST_F(WinrtEncryptRepositoryTest, EncryptDecrypt_RoundTrip)
         {
             // Arrange: create a random signature => create the AES key
-            auto randomSignature = CryptographicBuffer::GenerateRandom(10);
+            auto randomSignature = GenerateRandom(10);
             auto key = m_Repository.CreateAESKey(randomSignature);
 
             // Some sample text
-            winrt::hstring original = L"Hello, World! This is a test.";
+            SecureString original = "Hello, World! This is a test.";
 
             // Act: encrypt and then decrypt
             auto ciphertext = m_Repository.Encrypt(key, original);
@@ -71,14 +85,14 @@ namespace biometric_cipher {
         TEST_F(WinrtEncryptRepositoryTest, Decrypt_ThrowsIfCiphertextCorrupted)
         {
             // Arrange
-            auto randomSignature = CryptographicBuffer::GenerateRandom(10);
+            auto randomSignature = GenerateRandom(10);
             auto key = m_Repository.CreateAESKey(randomSignature);
 
-            winrt::hstring original = L"Corruption test data";
+            SecureString original = "Corruption test data";
             auto validCiphertext = m_Repository.Encrypt(key, original);
 
             // Convert from base64 back to a buffer
-            auto buffer = CryptographicBuffer::DecodeFromBase64String(validCiphertext);
+            auto buffer = CryptographicBuffer::DecodeFromBase64String(winrt::to_hstring(validCiphertext));
 
             // Copy to a winrt::com_array to tamper
             winrt::com_array<uint8_t> data{};
@@ -92,13 +106,16 @@ namespace biometric_cipher {
 
             // Re-encode the tampered buffer
             IBuffer tamperedBuffer = CryptographicBuffer::CreateFromByteArray(data);
-            auto tamperedCiphertext = CryptographicBuffer::EncodeToBase64String(tamperedBuffer);
+            auto tamperedCiphertext = winrt::to_string(CryptographicBuffer::EncodeToBase64String(tamperedBuffer));
 
-            // Act & Assert: we expect an exception (e.g., hresult_error)
-            EXPECT_THROW(
-                m_Repository.Decrypt(key, tamperedCiphertext),
-                winrt::hresult_error
-            );
+            // Act & Assert: authentication fails
+            try {
+                m_Repository.Decrypt(key, tamperedCiphertext);
+                FAIL() << "Expected BiometricCipherException";
+            }
+            catch (const BiometricCipherException& e) {
+                EXPECT_EQ(e.Code(), error_decrypt);
+            }
         }
 
         // Test 4: Verify non-deterministic encryption.
@@ -106,9 +123,9 @@ namespace biometric_cipher {
         // and decrypting each returns the original plaintext.
         TEST_F(WinrtEncryptRepositoryTest, Encrypt_NonDeterministicEncryption) {
             // Arrange
-            auto randomSignature = CryptographicBuffer::GenerateRandom(10);
+            auto randomSignature = GenerateRandom(10);
             auto key = m_Repository.CreateAESKey(randomSignature);
-            hstring original = L"Test non-deterministic encryption";
+            SecureString original = "Test non-deterministic encryption";
 
             // Act: Encrypt the same plaintext twice.
             auto ciphertext1 = m_Repository.Encrypt(key, original);
@@ -129,5 +146,302 @@ namespace biometric_cipher {
             EXPECT_EQ(decrypted1, original);
             EXPECT_EQ(decrypted2, original);
         }
+
+        // Test 5: Binary round trip.
+        // The binary envelope is header(5) | nonce(12) | ciphertext | tag(16) and the plaintext is
+        // not widened, so the ciphertext is exactly as long as the input.
+        TEST_F(WinrtEncryptRepositoryTest, EncryptDecryptBinary_RoundTripWithCompactEnvelope)
+        {
+            // Arrange
+            auto randomSignature = GenerateRandom(10);
+            auto key = m_Repository.CreateAESKey(randomSignature);
+            auto original = GenerateRandom(64);
+
+            // Act
+            auto ciphertext = m_Repository.EncryptBinary(key, original);
+            auto roundTripResult = m_Repository.DecryptBinary(key, ciphertext);
+
+            // Assert
+            EXPECT_EQ(ciphertext.size(), 5u + 12u + original.size() + 16u);
+            EXPECT_EQ(roundTripResult, original);
+        }
+
+        // Test 6: The string API still produces envelopes the binary API can open.
+        TEST_F(WinrtEncryptRepositoryTest, DecryptBinary_OpensStringEnvelope)
+        {
+            // Arrange
+            auto randomSignature = GenerateRandom(10);
+            auto key = m_Repository.CreateAESKey(randomSignature);
+            SecureString original = "Shared envelope";
+
+            // Act
+            auto ciphertext = m_Repository.Encrypt(key, original);
+            auto envelope = CryptographicBuffer::DecodeFromBase64String(winrt::to_hstring(ciphertext));
+            auto decrypted = m_Repository.DecryptBinary(key, WinrtInterop::ConvertBufferToVector(envelope));
+
+            // Assert
+            auto decryptedString = CryptographicBuffer::ConvertBinaryToString(
+                BinaryStringEncoding::Utf16LE,
+                WinrtInterop::ConvertVectorToBuffer(decrypted));
+            EXPECT_EQ(decryptedString, winrt::to_hstring(std::string_view(original)));
+        }
+
+        // Test 7: Binary decrypt rejects envelopes shorter than nonce + tag.
+        TEST_F(WinrtEncryptRepositoryTest, DecryptBinary_ThrowsIfEnvelopeTooShort)
+        {
+            // Arrange
+            auto randomSignature = GenerateRandom(10);
+            auto key = m_Repository.CreateAESKey(randomSignature);
+            auto tooShort = WinrtInterop::ConvertBufferToVector(CryptographicBuffer::GenerateRandom(27));
+
+            // Act & Assert
+            EXPECT_THROW(
+                m_Repository.DecryptBinary(key, tooShort),
+                BiometricCipherException
+            );
+        }
+
+        // Test 8: The native Base64 codec matches CryptographicBuffer byte for byte.
+        TEST_F(WinrtEncryptRepositoryTest, Base64_MatchesCryptographicBuffer)
+        {
+            for (uint32_t length = 0; length < 200; ++length) {
+                auto data = WinrtInterop::ConvertBufferToVector(CryptographicBuffer::GenerateRandom(length));
+
+                auto expected = winrt::to_string(
+                    CryptographicBuffer::EncodeToBase64String(WinrtInterop::ConvertVectorToBuffer(data)));
+
+                EXPECT_EQ(Base64::Encode(data.data(), data.size()), expected) << "length " << length;
+                EXPECT_EQ(Base64::Decode(expected), data) << "length " << length;
+            }
+        }
+
+        // Test 9: String decrypt rejects ciphertext that is not Base64.
+        TEST_F(WinrtEncryptRepositoryTest, Decrypt_ThrowsIfNotBase64)
+        {
+            // Arrange
+            auto randomSignature = GenerateRandom(10);
+            auto key = m_Repository.CreateAESKey(randomSignature);
+            auto ciphertext = m_Repository.Encrypt(key, "Not Base64 anymore");
+            ciphertext[5] = '!';
+
+            // Act & Assert
+            try {
+                m_Repository.Decrypt(key, ciphertext);
+                FAIL() << "Expected BiometricCipherException";
+            }
+            catch (const BiometricCipherException& e) {
+                EXPECT_EQ(e.Code(), error_decrypt);
+            }
+        }
+
+        // Test 10: Headerless envelopes written by CryptographicEngine before the native AES-GCM
+        // still open, and CryptographicEngine opens AES-256-GCM envelopes given the header as AAD.
+        TEST_F(WinrtEncryptRepositoryTest, NativeAesGcm_InteroperatesWithCryptographicEngine)
+        {
+            // Arrange
+            WinrtEncryptRepositoryImpl repository(nullptr, nullptr, nullptr, AeadSuite::kAes256Gcm);
+            auto signature = GenerateRandom(10);
+            auto key = repository.CreateAESKey(signature);
+
+            auto sha256 = HashAlgorithmProvider::OpenAlgorithm(HashAlgorithmNames::Sha256());
+            auto keyMaterial = sha256.HashData(WinrtInterop::ConvertVectorToBuffer(signature));
+            auto winrtKey = SymmetricKeyAlgorithmProvider::OpenAlgorithm(SymmetricAlgorithmNames::AesGcm())
+                .CreateSymmetricKey(keyMaterial);
+
+            for (uint32_t length : { 0u, 1u, 15u, 16u, 17u, 300u, 5000u }) {
+                auto original = GenerateRandom(length);
+
+                // Act: CryptographicEngine -> native
+                auto nonce = CryptographicBuffer::GenerateRandom(12);
+                auto sealed = CryptographicEngine::EncryptAndAuthenticate(
+                    winrtKey, WinrtInterop::ConvertVectorToBuffer(original), nonce, nullptr);
+                auto envelope = WinrtInterop::ConvertBufferToVector(nonce);
+                auto encrypted = WinrtInterop::ConvertBufferToVector(sealed.EncryptedData());
+                auto tag = WinrtInterop::ConvertBufferToVector(sealed.AuthenticationTag());
+                envelope.insert(envelope.end(), encrypted.begin(), encrypted.end());
+                envelope.insert(envelope.end(), tag.begin(), tag.end());
+
+                EXPECT_EQ(repository.DecryptBinary(key, envelope), original) << "length " << length;
+
+                // Act: native -> CryptographicEngine
+                auto nativeEnvelope = repository.EncryptBinary(key, original);
+                std::vector<uint8_t> nativeHeader(nativeEnvelope.begin(), nativeEnvelope.begin() + 5);
+                std::vector<uint8_t> nativeNonce(nativeEnvelope.begin() + 5, nativeEnvelope.begin() + 17);
+                std::vector<uint8_t> nativeCiphertext(nativeEnvelope.begin() + 17, nativeEnvelope.end() - 16);
+                std::vector<uint8_t> nativeTag(nativeEnvelope.end() - 16, nativeEnvelope.end());
+                auto opened = CryptographicEngine::DecryptAndAuthenticate(
+                    winrtKey,
+                    WinrtInterop::ConvertVectorToBuffer(nativeCiphertext),
+                    WinrtInterop::ConvertVectorToBuffer(nativeNonce),
+                    WinrtInterop::ConvertVectorToBuffer(nativeTag),
+                    WinrtInterop::ConvertVectorToBuffer(nativeHeader));
+
+                EXPECT_EQ(WinrtInterop::ConvertBufferToSecureBuffer(opened), original) << "length " << length;
+            }
+        }
+
+        // Test 11: A string envelope with an odd payload length cannot be UTF-16.
+        TEST_F(WinrtEncryptRepositoryTest, Decrypt_ThrowsIfPayloadIsNotUtf16)
+        {
+            // Arrange
+            auto randomSignature = GenerateRandom(10);
+            auto key = m_Repository.CreateAESKey(randomSignature);
+            auto envelope = m_Repository.EncryptBinary(key, GenerateRandom(5));
+
+            // Act & Assert
+            try {
+                m_Repository.Decrypt(key, Base64::Encode(envelope.data(), envelope.size()));
+                FAIL() << "Expected BiometricCipherException";
+            }
+            catch (const BiometricCipherException& e) {
+                EXPECT_EQ(e.Code(), error_decrypt);
+            }
+        }
+
+        // Test 12: CreateAESKey prepares the key once for the best implementation the CPU has.
+        TEST_F(WinrtEncryptRepositoryTest, CreateAESKey_PreparesKeyForBestImplementation)
+        {
+            // Arrange & Act
+            auto key = m_Repository.CreateAESKey(GenerateRandom(10));
+
+            // Assert
+            auto* aesKey = dynamic_cast<AesGcmSymmetricKey*>(key.get());
+            ASSERT_NE(aesKey, nullptr);
+            EXPECT_EQ(aesKey->key.GetAesGcmKey().GetImplementation(), AesGcm::GetBestImplementation());
+
+            // The prepared key serves any number of messages.
+            for (int i = 0; i < 100; ++i) {
+                auto original = GenerateRandom(static_cast<uint32_t>(i));
+                EXPECT_EQ(m_Repository.DecryptBinary(key, m_Repository.EncryptBinary(key, original)), original);
+            }
+        }
+
+        // Test 13: Nonces come from the injected random source, one NONCE_LENGTH slice per message.
+        TEST_F(WinrtEncryptRepositoryTest, EncryptBinary_TakesNoncesFromRandomSource)
+        {
+            // Arrange
+            auto nonceSource = std::make_shared<FakeRandomSource>();
+            WinrtEncryptRepositoryImpl repository(nonceSource);
+            auto key = repository.CreateAESKey(GenerateRandom(10));
+            auto original = GenerateRandom(32);
+
+            // Act
+            auto first = repository.EncryptBinary(key, original);
+            auto second = repository.EncryptBinary(key, original);
+
+            // Assert
+            for (size_t i = 0; i < AesGcm::NONCE_LENGTH; ++i) {
+                EXPECT_EQ(first[CiphertextEnvelope::HEADER_LENGTH + i], nonceSource->GetByte(i));
+                EXPECT_EQ(second[CiphertextEnvelope::HEADER_LENGTH + i], nonceSource->GetByte(AesGcm::NONCE_LENGTH + i));
+            }
+            EXPECT_EQ(repository.DecryptBinary(key, first), original);
+            EXPECT_EQ(repository.DecryptBinary(key, second), original);
+        }
+
+        // Test 14: The native SHA-256 and HMAC-SHA256 agree with CNG.
+        TEST_F(WinrtEncryptRepositoryTest, Sha256_MatchesHashAlgorithmProvider)
+        {
+            // Arrange
+            auto sha256 = HashAlgorithmProvider::OpenAlgorithm(HashAlgorithmNames::Sha256());
+            auto hmacSha256 = MacAlgorithmProvider::OpenAlgorithm(MacAlgorithmNames::HmacSha256());
+            auto key = GenerateRandom(32);
+            auto winrtKey = hmacSha256.CreateKey(WinrtInterop::ConvertVectorToBuffer(key));
+
+            for (uint32_t length : { 0u, 1u, 55u, 56u, 64u, 256u, 5000u }) {
+                auto data = GenerateRandom(length);
+
+                // Act
+                std::vector<uint8_t> digest(Sha256::DIGEST_LENGTH);
+                Sha256::Hash(data.data(), data.size(), digest.data());
+                std::vector<uint8_t> mac(HmacSha256::MAC_LENGTH);
+                HmacSha256::Compute(key.data(), key.size(), data.data(), data.size(), mac.data());
+
+                // Assert
+                auto expectedDigest = sha256.HashData(WinrtInterop::ConvertVectorToBuffer(data));
+                auto expectedMac = CryptographicEngine::Sign(winrtKey, WinrtInterop::ConvertVectorToBuffer(data));
+                EXPECT_EQ(digest, WinrtInterop::ConvertBufferToVector(expectedDigest)) << "length " << length;
+                EXPECT_EQ(mac, WinrtInterop::ConvertBufferToVector(expectedMac)) << "length " << length;
+            }
+        }
+
+        // Test 15: The repository times key derivation, AES-GCM and Base64 into the metrics.
+        TEST_F(WinrtEncryptRepositoryTest, Encrypt_RecordsPhasesIntoMetrics)
+        {
+            // Arrange
+            auto metrics = std::make_shared<MetricsRegistry>();
+            WinrtEncryptRepositoryImpl repository(nullptr, metrics);
+            auto key = repository.CreateAESKey(GenerateRandom(10));
+
+            // Act
+            auto encrypted = repository.Encrypt(key, "phases");
+            repository.Decrypt(key, encrypted);
+
+            // Assert
+            auto snapshot = metrics->GetSnapshot();
+            EXPECT_EQ(snapshot.phases[static_cast<size_t>(MetricsPhase::kKeyDerivation)].count, 1u);
+            EXPECT_EQ(snapshot.phases[static_cast<size_t>(MetricsPhase::kAesGcm)].count, 2u);
+            EXPECT_EQ(snapshot.phases[static_cast<size_t>(MetricsPhase::kEncodingAndReply)].count, 2u);
+            EXPECT_EQ(snapshot.phases[static_cast<size_t>(MetricsPhase::kSignPrompt)].count, 0u);
+        }
+
+        // Test 16: Each stage of an encryption shows up as a slice in the trace.
+        TEST_F(WinrtEncryptRepositoryTest, Encrypt_RecordsStagesIntoTrace)
+        {
+            // Arrange
+            WinrtEncryptRepositoryImpl repository;
+            Tracer::Get().Clear();
+
+            // Act
+            auto key = repository.CreateAESKey(GenerateRandom(10));
+            auto encrypted = repository.Encrypt(key, "stages");
+            repository.Decrypt(key, encrypted);
+
+            // Assert
+            auto trace = Tracer::Get().ExportChromeTrace();
+            for (const char* name : { "CreateAESKey", "AesGcmEncrypt", "Base64Encode", "Base64Decode", "AesGcmDecrypt" }) {
+                auto slice = std::string("\"name\":\"") + name + "\",\"cat\":\"biometric_cipher\",\"ph\":\"X\"";
+                EXPECT_NE(trace.find(slice), std::string::npos) << name;
+            }
+        }
+
+        // Test 17: New envelopes carry the configured suite, and a repository that would pick
+        // either suite opens them.
+        TEST_F(WinrtEncryptRepositoryTest, EncryptBinary_SealsWithConfiguredSuite)
+        {
+            for (auto suite : { AeadSuite::kAes256Gcm, AeadSuite::kChaCha20Poly1305 }) {
+                // Arrange
+                WinrtEncryptRepositoryImpl repository(nullptr, nullptr, nullptr, suite);
+                auto signature = GenerateRandom(10);
+                auto key = repository.CreateAESKey(signature);
+                SecureString original = "Sealed with either suite";
+
+                // Act
+                auto envelope = repository.EncryptBinary(key, GenerateRandom(64));
+                auto encrypted = repository.Encrypt(key, original);
+
+                // Assert
+                EXPECT_EQ(CiphertextEnvelope::ParseHeader(envelope), suite);
+                EXPECT_EQ(m_Repository.Decrypt(m_Repository.CreateAESKey(signature), encrypted), original);
+            }
+        }
+
+        // Test 18: A subkey is the same for the same context, and data sealed under one
+        // context does not open under another context or under the tag key.
+        TEST_F(WinrtEncryptRepositoryTest, DeriveSubkey_BindsKeyToContext)
+        {
+            // Arrange
+            auto signature = GenerateRandom(10);
+            auto key = m_Repository.CreateAESKey(signature);
+            SecureString original = "Bound to a context";
+
+            // Act
+            auto encrypted = m_Repository.Encrypt(m_Repository.DeriveSubkey(key, "vault/1"), original);
+
+            // Assert
+            auto sameSubkey = m_Repository.DeriveSubkey(m_Repository.CreateAESKey(signature), "vault/1");
+            EXPECT_EQ(m_Repository.Decrypt(sameSubkey, encrypted), original);
+            EXPECT_THROW(m_Repository.Decrypt(m_Repository.DeriveSubkey(key, "vault/2"), encrypted), BiometricCipherException);
+            EXPECT_THROW(m_Repository.Decrypt(key, encrypted), BiometricCipherException);
+        }
 	}
 }
@@ -1,8 +1,12 @@
 #include "include/biometric_cipher/repositories/windows_hello_repository_impl.h"
-#include "include/biometric_cipher/errors/error_codes.h"
+#include "include/biometric_cipher/common/string_util.h"
+#include "include/biometric_cipher/common/tracer.h"
+#include "include/biometric_cipher/common/winrt_interop.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
 #include "include/biometric_cipher/enums/biometry_status.h"
 
 #include <windows.h>
+#include <optional>
 #include <winrt/windows.security.credentials.ui.h>
 
 #ifdef DEBUG
@@ -12,7 +16,6 @@
 #endif
 
 using namespace winrt;
-using namespace winrt::impl;
 using namespace Windows::Foundation;
 using namespace Windows::Security::Cryptography;
 using namespace Windows::Security::Cryptography::Core;
@@ -22,7 +25,16 @@ using namespace Windows::Security::Credentials::UI;
 
 namespace biometric_cipher
 {
-	IAsyncOperation<int> WindowsHelloRepositoryImpl::GetWindowsHelloStatusAsync() const
+	Task<int> WindowsHelloRepositoryImpl::GetWindowsHelloStatusAsync() const
+	{
+		auto biometryStatus = co_await QueryWindowsHelloStatusAsync();
+
+		m_BiometryStatusCache->Put(biometryStatus);
+
+		co_return biometryStatus;
+	}
+
+	Task<int> WindowsHelloRepositoryImpl::QueryWindowsHelloStatusAsync() const
 	{
 		auto isSupported = co_await m_HelloWrapper->IsSupportedAsync();
 
@@ -48,96 +60,207 @@ namespace biometric_cipher
 			co_return BiometryStatusToInteger(BiometryStatus::kDeviceBusy);
 		}
 
-		throw hresult_error(error_fail, L"Unknown error occurred.");
+		throw BiometricCipherException(error_fail, "Unknown error occurred.");
 	}
 
-	IAsyncOperation<IBuffer> WindowsHelloRepositoryImpl::SignAsync(const winrt::hstring tag, const IBuffer data) const
+	Task<SecureBuffer> WindowsHelloRepositoryImpl::SignAsync(const std::string tag, const SecureBuffer data) const
 	{
-		co_await CheckWindowsHelloIsStatusAsync();
+		{
+			MetricsRegistry::PhaseTimer statusCheckTimer(m_Metrics.get(), MetricsPhase::kHelloStatusCheck);
+			TraceAsyncScope trace("CheckWindowsHelloStatus");
+			co_await CheckWindowsHelloIsStatusAsync();
+		}
 
-		auto&& keyCredentialRetrievalResult = co_await m_HelloWrapper->OpenAsync(tag);
-		CheckKeyCredentialStatus(keyCredentialRetrievalResult.Status());
+		auto dataBuffer = WinrtInterop::ConvertVectorToBuffer(data);
 
-		auto&& keyCredential = keyCredentialRetrievalResult.Credential();
+		auto keyCredential = co_await OpenCredentialAsync(tag);
 
-		AllowSetForegroundWindow(ASFW_ANY);
+		if (m_PromptExecutor) {
+			co_await ResumeOn(*m_PromptExecutor);
+		}
 
-		HHOOK hook = SetWindowsHookEx(WH_CBT, [](int nCode, WPARAM wParam, LPARAM lParam) -> LRESULT {
-			if (nCode == HCBT_ACTIVATE || nCode == HCBT_CREATEWND) {
-				AllowSetForegroundWindow(ASFW_ANY);
-			}
-			return CallNextHookEx(nullptr, nCode, wParam, lParam);
-		}, nullptr, GetCurrentThreadId());
+		HHOOK hook = InstallForegroundHook();
+
+		KeyCredentialOperationResult signatureResult{ nullptr };
+		{
+			MetricsRegistry::PhaseTimer promptTimer(m_Metrics.get(), MetricsPhase::kSignPrompt);
+			TraceAwait trace("RequestSignAsync");
+			signatureResult = co_await keyCredential.RequestSignAsync(dataBuffer);
+		}
+		WinrtInterop::ZeroBuffer(dataBuffer);
 
-		auto&& signatureResult = co_await keyCredential.RequestSignAsync(data);
+		// The WinRT call may have completed on another thread.
+		if (m_PromptExecutor) {
+			co_await ResumeOn(*m_PromptExecutor);
+		}
 
-		if (hook) {
-			UnhookWindowsHookEx(hook);
+		RemoveForegroundHook(hook);
+
+		if (m_WorkExecutor) {
+			co_await ResumeOn(*m_WorkExecutor);
 		}
 
+		if (signatureResult.Status() == KeyCredentialStatus::NotFound) {
+			// The credential was deleted behind our back (e.g. from Windows settings).
+			m_CredentialCache.Erase(tag);
+		}
 		CheckKeyCredentialStatus(signatureResult.Status());
 
-		co_return signatureResult.Result();
+		// The signature is the key material, so it only leaves the WinRT buffer for the arena.
+		auto signature = WinrtInterop::ConvertBufferToSecureBuffer(signatureResult.Result());
+		WinrtInterop::ZeroBuffer(signatureResult.Result());
+
+		co_return signature;
 	}
 
-	IAsyncAction WindowsHelloRepositoryImpl::CreateCredentialAsync(const winrt::hstring tag) const
+	Task<> WindowsHelloRepositoryImpl::CreateCredentialAsync(const std::string tag) const
 	{
 		co_await CheckWindowsHelloIsStatusAsync();
 
-		AllowSetForegroundWindow(ASFW_ANY);
+		auto hTag = StringUtil::ConvertStringToHString(tag);
 
-		HHOOK hook = SetWindowsHookEx(WH_CBT, [](int nCode, WPARAM wParam, LPARAM lParam) -> LRESULT {
-			if (nCode == HCBT_ACTIVATE || nCode == HCBT_CREATEWND) {
-				AllowSetForegroundWindow(ASFW_ANY);
-			}
-			return CallNextHookEx(nullptr, nCode, wParam, lParam);
-		}, nullptr, GetCurrentThreadId());
+		if (m_PromptExecutor) {
+			co_await ResumeOn(*m_PromptExecutor);
+		}
 
-		auto&& keyCredentialResult = co_await m_HelloWrapper->RequestCreateAsync(tag, KeyCredentialCreationOption::FailIfExists);
+		HHOOK hook = InstallForegroundHook();
 
-		if (hook) {
-			UnhookWindowsHookEx(hook);
+		KeyCredentialRetrievalResult keyCredentialResult{ nullptr };
+		{
+			TraceAwait trace("RequestCreateAsync");
+			keyCredentialResult = co_await m_HelloWrapper->RequestCreateAsync(hTag, KeyCredentialCreationOption::FailIfExists);
+		}
+
+		if (m_PromptExecutor) {
+			co_await ResumeOn(*m_PromptExecutor);
+		}
+
+		RemoveForegroundHook(hook);
+
+		if (m_WorkExecutor) {
+			co_await ResumeOn(*m_WorkExecutor);
 		}
 
 		CheckKeyCredentialStatus(keyCredentialResult.Status());
 
+		if (auto keyCredential = keyCredentialResult.Credential()) {
+			m_CredentialCache.Put(tag, keyCredential);
+		}
+
 		co_return;
 	}
 
-	IAsyncAction WindowsHelloRepositoryImpl::DeleteCredentialAsync(const winrt::hstring tag) const
+	Task<> WindowsHelloRepositoryImpl::DeleteCredentialAsync(const std::string tag) const
 	{
 		co_await CheckWindowsHelloIsStatusAsync();
 
+		auto hTag = StringUtil::ConvertStringToHString(tag);
+
+		m_CredentialCache.Erase(tag);
+
+		if (m_PromptExecutor) {
+			co_await ResumeOn(*m_PromptExecutor);
+		}
+
+		HHOOK hook = InstallForegroundHook();
+
+		std::optional<BiometricCipherException> deleteError;
+		try {
+			co_await m_HelloWrapper->DeleteAsync(hTag);
+		}
+		catch (const hresult_error& e) {
+			// The service treats a missing key as already deleted, so it has to see the code.
+			deleteError = WinrtInterop::ConvertHResultError(e);
+		}
+
+		if (m_PromptExecutor) {
+			co_await ResumeOn(*m_PromptExecutor);
+		}
+
+		RemoveForegroundHook(hook);
+
+		if (m_WorkExecutor) {
+			co_await ResumeOn(*m_WorkExecutor);
+		}
+
+		if (deleteError) {
+			throw *deleteError;
+		}
+
+		co_return;
+	}
+
+	HHOOK WindowsHelloRepositoryImpl::InstallForegroundHook()
+	{
 		AllowSetForegroundWindow(ASFW_ANY);
 
-		HHOOK hook = SetWindowsHookEx(WH_CBT, [](int nCode, WPARAM wParam, LPARAM lParam) -> LRESULT {
+		return SetWindowsHookEx(WH_CBT, [](int nCode, WPARAM wParam, LPARAM lParam) -> LRESULT {
 			if (nCode == HCBT_ACTIVATE || nCode == HCBT_CREATEWND) {
 				AllowSetForegroundWindow(ASFW_ANY);
 			}
 			return CallNextHookEx(nullptr, nCode, wParam, lParam);
 		}, nullptr, GetCurrentThreadId());
+	}
 
-		co_await m_HelloWrapper->DeleteAsync(tag);
-
+	void WindowsHelloRepositoryImpl::RemoveForegroundHook(HHOOK hook)
+	{
 		if (hook) {
 			UnhookWindowsHookEx(hook);
 		}
+	}
 
-		co_return;
+	Task<KeyCredential> WindowsHelloRepositoryImpl::OpenCredentialAsync(const std::string tag) const
+	{
+		if (auto cachedCredential = m_CredentialCache.Get(tag)) {
+			co_return *cachedCredential;
+		}
+
+		auto hTag = StringUtil::ConvertStringToHString(tag);
+
+		KeyCredentialRetrievalResult keyCredentialRetrievalResult{ nullptr };
+		{
+			TraceAwait trace("OpenAsync");
+			keyCredentialRetrievalResult = co_await m_HelloWrapper->OpenAsync(hTag);
+		}
+		CheckKeyCredentialStatus(keyCredentialRetrievalResult.Status());
+
+		auto keyCredential = keyCredentialRetrievalResult.Credential();
+		if (keyCredential) {
+			m_CredentialCache.Put(tag, keyCredential);
+		}
+
+		co_return keyCredential;
 	}
 
-	IAsyncAction WindowsHelloRepositoryImpl::CheckWindowsHelloIsStatusAsync() const
+	Task<> WindowsHelloRepositoryImpl::CheckWindowsHelloIsStatusAsync() const
 	{
-		auto biometryStatusValue = co_await GetWindowsHelloStatusAsync();
+		int biometryStatusValue = 0;
+		if (auto cachedStatus = m_BiometryStatusCache->Get()) {
+			biometryStatusValue = *cachedStatus;
+		}
+		else {
+			biometryStatusValue = co_await GetWindowsHelloStatusAsync();
+		}
+
 		if (IntegerToBiometryStatus(biometryStatusValue) != BiometryStatus::kSupported) {
-			throw hresult_error(error_biometry_not_supported, L"Windows Hello is not supported.");
+			throw BiometricCipherException(error_biometry_not_supported, "Windows Hello is not supported.");
 		}
 
 		co_return;
 	}
 
-	void WindowsHelloRepositoryImpl::CheckKeyCredentialStatus(KeyCredentialStatus status)
+	void WindowsHelloRepositoryImpl::CheckKeyCredentialStatus(KeyCredentialStatus status) const
 	{
+		switch (status) {
+		case KeyCredentialStatus::UnknownError:
+		case KeyCredentialStatus::SecurityDeviceLocked:
+			m_BiometryStatusCache->Invalidate();
+			break;
+
+		default:
+			break;
+		}
+
 		switch (status) {
 		case KeyCredentialStatus::Success:
 			DEBUG_OUTPUT(L"Key credential create/open successfully.\n");
@@ -146,32 +269,32 @@ namespace biometric_cipher
 
 		case KeyCredentialStatus::NotFound:
 			DEBUG_OUTPUT(L"Key credential not found.\n");
-			throw hresult_error(error_key_not_found, L"Key credential not found.");
+			throw BiometricCipherException(error_key_not_found, "Key credential not found.");
 
 
 		case KeyCredentialStatus::UserCanceled:
 			DEBUG_OUTPUT(L"User canceled the operation.\n");
-			throw hresult_error(error_authentication_canceled, L"User canceled the operation.");
+			throw BiometricCipherException(error_authentication_canceled, "User canceled the operation.");
 
 		case KeyCredentialStatus::UnknownError:
 			DEBUG_OUTPUT(L"An unknown error occurred.\n");
-			throw hresult_error(error_fail, L"An unknown error occurred.");
+			throw BiometricCipherException(error_fail, "An unknown error occurred.");
 
 		case KeyCredentialStatus::UserPrefersPassword:
 			DEBUG_OUTPUT(L"User prefers password.\n");
-			throw hresult_error(error_user_prefers_password, L"User prefers password.");
+			throw BiometricCipherException(error_user_prefers_password, "User prefers password.");
 
 		case KeyCredentialStatus::CredentialAlreadyExists:
 			DEBUG_OUTPUT(L"Key credential already exists.\n");
-			throw hresult_error(error_key_already_exists, L"Key credential already exists.");
+			throw BiometricCipherException(error_key_already_exists, "Key credential already exists.");
 
 		case KeyCredentialStatus::SecurityDeviceLocked:
 			DEBUG_OUTPUT(L"Security device is locked.\n");
-			throw hresult_error(error_secure_device_locked, L"Security device is locked.");
+			throw BiometricCipherException(error_secure_device_locked, "Security device is locked.");
 
 		default:
 			DEBUG_OUTPUT(L"Unknown key credential status.\n");
-			throw hresult_error(error_fail, L"Unknown key credential status.");
+			throw BiometricCipherException(error_fail, "Unknown key credential status.");
 		}
 	}
 }
\ No newline at end of file
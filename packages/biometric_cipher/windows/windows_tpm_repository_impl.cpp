@@ -1,7 +1,7 @@
 #include "include/biometric_cipher/repositories/windows_tpm_repository_impl.h"
 #include "include/biometric_cipher/common/memory_deallocation.h"
 #include "include/biometric_cipher/enums/tpm_status.h"
-#include "include/biometric_cipher/errors/error_codes.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
 
 #include <windows.h>
 #include <winrt/base.h>
@@ -12,9 +12,6 @@
 
 #pragma comment(lib, "ncrypt.lib")
 
-using namespace winrt;
-using namespace winrt::impl;
-
 
 namespace biometric_cipher
 {
@@ -22,20 +19,26 @@ namespace biometric_cipher
 	{
 		SECURITY_STATUS status = ERROR_SUCCESS;
 
-		NCryptHandleFree providerHandle;
+		std::lock_guard<std::mutex> lock(m_ProviderMutex);
 
-		status = m_NCryptWrapper->OpenStorageProvider(providerHandle, MS_PLATFORM_CRYPTO_PROVIDER, 0);
-		CheckStatus(error_tpm_unsupported,  L"NCryptOpenStorageProvider failed", status);
+		auto& providerHandle = GetProviderHandle();
 
 		//// If we have successfully opened the Platform Crypto Provider, it means TPM is present.
 		//// Now, let's check the TPM version.
 		DWORD cbPlatformType = 0;
 		status = m_NCryptWrapper->GetProperty(providerHandle, NCRYPT_PCP_PLATFORM_TYPE_PROPERTY, NULL, NULL, &cbPlatformType, 0);
-		CheckStatus(error_tpm_version, L"NCryptGetProperty failed", status);
+		if (status != ERROR_SUCCESS) {
+			// The handle may have gone stale (e.g. the TPM was reset); reopen it next time.
+			CloseProviderHandle();
+		}
+		CheckStatus(error_tpm_version, "NCryptGetProperty failed", status);
 
 		std::vector<BYTE> platformType(cbPlatformType);
 		status = m_NCryptWrapper->GetProperty(providerHandle, NCRYPT_PCP_PLATFORM_TYPE_PROPERTY, platformType.data(), (DWORD)platformType.size(), &cbPlatformType, 0);
-		CheckStatus(error_tpm_version, L"NCryptGetProperty failed", status);
+		if (status != ERROR_SUCCESS) {
+			CloseProviderHandle();
+		}
+		CheckStatus(error_tpm_version, "NCryptGetProperty failed", status);
 
 		auto version = std::wstring(reinterpret_cast<wchar_t*>(platformType.data()), cbPlatformType / sizeof(wchar_t));
 		auto type = ParsePlatformType(version);
@@ -45,8 +48,33 @@ namespace biometric_cipher
 			return result;
 		}
 		catch (const std::exception) {
-			throw hresult_error(error_tpm_version, L"Incorrect TPM version");
+			throw BiometricCipherException(error_tpm_version, "Incorrect TPM version");
+		}
+	}
+
+	void WindowsTpmRepositoryImpl::Refresh() const
+	{
+		std::lock_guard<std::mutex> lock(m_ProviderMutex);
+
+		CloseProviderHandle();
+	}
+
+	const NCryptHandleFree& WindowsTpmRepositoryImpl::GetProviderHandle() const
+	{
+		if (!m_IsProviderOpen) {
+			auto status = m_NCryptWrapper->OpenStorageProvider(m_ProviderHandle, MS_PLATFORM_CRYPTO_PROVIDER, 0);
+			CheckStatus(error_tpm_unsupported, "NCryptOpenStorageProvider failed", status);
+
+			m_IsProviderOpen = true;
 		}
+
+		return m_ProviderHandle;
+	}
+
+	void WindowsTpmRepositoryImpl::CloseProviderHandle() const
+	{
+		m_ProviderHandle.close();
+		m_IsProviderOpen = false;
 	}
 
 	const std::wstring WindowsTpmRepositoryImpl::ParsePlatformType(const std::wstring& platformVersion)
@@ -54,7 +82,7 @@ namespace biometric_cipher
 		const std::wstring key = L"TPM-Version:";
 		auto start = platformVersion.find(key);
 		if (start == std::wstring::npos) {
-			throw hresult_error(error_tpm_version, L"TPM version not found");
+			throw BiometricCipherException(error_tpm_version, "TPM version not found");
 		}
 		start += key.size();
 		auto end = platformVersion.find(L".", start);
@@ -62,13 +90,13 @@ namespace biometric_cipher
 		return platformVersion.substr(start, end - start);
 	}
 
-	void WindowsTpmRepositoryImpl::CheckStatus(const hresult hr, const std::wstring& message, const int errorCode)
+	void WindowsTpmRepositoryImpl::CheckStatus(const ErrorCode code, const std::string& message, const int errorCode)
 	{
 		if (errorCode != ERROR_SUCCESS) {
-			std::wostringstream woss;
-			woss << message << L": 0x" << std::hex << std::uppercase << errorCode;
+			std::ostringstream oss;
+			oss << message << ": 0x" << std::hex << std::uppercase << errorCode;
 
-			throw hresult_error(hr, woss.str());
+			throw BiometricCipherException(code, oss.str());
 		}
 	}
 }  // namespace biometric_cipher
@@ -1,72 +1,203 @@
 #include "include/biometric_cipher/repositories/winrt_encrypt_repository_impl.h"
-#include "include/biometric_cipher/errors/error_codes.h"
-#include "include/biometric_cipher/enums/tpm_status.h"
-
-#include <windows.h>
-#include <winrt/windows.security.credentials.ui.h>
-
-using namespace winrt;
-using namespace winrt::impl;
-using namespace Windows::Foundation;
-using namespace Windows::Security::Cryptography;
-using namespace Windows::Security::Cryptography::Core;
-using namespace Windows::Security::Credentials;
-using namespace Windows::Storage::Streams;
-using namespace Windows::Security::Credentials::UI;
+#include "include/biometric_cipher/common/aead_suite_selector.h"
+#include "include/biometric_cipher/common/base64.h"
+#include "include/biometric_cipher/common/buffered_random_source.h"
+#include "include/biometric_cipher/common/ciphertext_envelope.h"
+#include "include/biometric_cipher/common/secure_memory.h"
+#include "include/biometric_cipher/common/sha256.h"
+#include "include/biometric_cipher/common/system_random.h"
+#include "include/biometric_cipher/common/tracer.h"
+#include "include/biometric_cipher/common/utf_converter.h"
+#include "include/biometric_cipher/errors/biometric_cipher_exception.h"
+
+#include <bit>
+#include <utility>
 
 namespace biometric_cipher
 {
-	CryptographicKey WinrtEncryptRepositoryImpl::CreateAESKey(const IBuffer signature) const
+	// String payloads are encrypted as UTF-16LE, which is what char16_t is in memory here.
+	static_assert(std::endian::native == std::endian::little, "The UTF-16 payload is little-endian.");
+
+	static_assert(Sha256::DIGEST_LENGTH == AeadKey::KEY_LENGTH, "The key is the SHA-256 of the signature.");
+
+	// Prefixed to the context of every subkey, so that no other use of HKDF over the same key
+	// can produce one. Changing it changes every subkey.
+	static constexpr std::string_view SUBKEY_LABEL = "biometric_cipher subkey v1:";
+
+	WinrtEncryptRepositoryImpl::WinrtEncryptRepositoryImpl(
+		std::shared_ptr<RandomSource> nonceSource,
+		std::shared_ptr<MetricsRegistry> metrics,
+		std::shared_ptr<const ParallelRunner> segmentRunner,
+		std::optional<AeadSuite> suite)
+		: m_NonceSource(nonceSource ? std::move(nonceSource) : std::make_shared<BufferedRandomSource>(SystemRandom::Fill)),
+		m_Metrics(std::move(metrics)),
+		m_SegmentRunner(std::move(segmentRunner)),
+		m_Suite(suite)
 	{
-		auto sha256Provider = HashAlgorithmProvider::OpenAlgorithm(HashAlgorithmNames::Sha256());
-		auto sha256Hash = sha256Provider.HashData(signature);
-		if (sha256Hash.Length() != 32) {
-			throw hresult_error(error_fail, L"Hash length is not 32 bytes.");
-		}
+	}
+
+	std::shared_ptr<SymmetricKey> WinrtEncryptRepositoryImpl::CreateAESKey(const SecureBuffer& signature) const
+	{
+		MetricsRegistry::PhaseTimer timer(m_Metrics.get(), MetricsPhase::kKeyDerivation);
+		TraceScope trace("CreateAESKey");
 
-		auto aesProvider = SymmetricKeyAlgorithmProvider::OpenAlgorithm(SymmetricAlgorithmNames::AesGcm());
-		auto aesKey = aesProvider.CreateSymmetricKey(sha256Hash);
+		// The same SHA-256 that CNG computed before, so existing ciphertexts still decrypt.
+		uint8_t sha256Hash[Sha256::DIGEST_LENGTH];
+		Sha256::Hash(signature.data(), signature.size(), sha256Hash);
+
+		auto aesKey = std::make_shared<AesGcmSymmetricKey>(sha256Hash);
+		SecureMemory::Zero(sha256Hash, sizeof(sha256Hash));
 
 		return aesKey;
 	}
 
-	winrt::hstring WinrtEncryptRepositoryImpl::Encrypt(const CryptographicKey key, const winrt::hstring data) const
+	std::shared_ptr<SymmetricKey> WinrtEncryptRepositoryImpl::DeriveSubkey(
+		const std::shared_ptr<SymmetricKey>& key,
+		std::string_view context) const
+	{
+		MetricsRegistry::PhaseTimer timer(m_Metrics.get(), MetricsPhase::kKeyDerivation);
+		TraceScope trace("DeriveSubkey");
+
+		std::vector<uint8_t> info(SUBKEY_LABEL.begin(), SUBKEY_LABEL.end());
+		info.insert(info.end(), context.begin(), context.end());
+
+		uint8_t keyMaterial[AeadKey::KEY_LENGTH];
+		GetAesGcmKey(key).key.DeriveKey(info.data(), info.size(), keyMaterial);
+
+		auto subkey = std::make_shared<AesGcmSymmetricKey>(keyMaterial);
+		SecureMemory::Zero(keyMaterial, sizeof(keyMaterial));
+
+		return subkey;
+	}
+
+	std::string WinrtEncryptRepositoryImpl::Encrypt(const std::shared_ptr<SymmetricKey>& key, const SecureString& data) const
+	{
+		SecureUtf16Buffer plaintext(UtfConverter::GetMaxUtf16Length(data.size()));
+		auto plaintextLength = UtfConverter::ConvertUtf8ToUtf16(data, plaintext.data());
+		auto envelope = EncryptEnvelope(
+			GetAesGcmKey(key),
+			reinterpret_cast<const uint8_t*>(plaintext.data()),
+			plaintextLength * sizeof(char16_t));
+
+		MetricsRegistry::PhaseTimer timer(m_Metrics.get(), MetricsPhase::kEncodingAndReply);
+		TraceScope trace("Base64Encode");
+
+		return Base64::Encode(envelope.data(), envelope.size());
+	}
+
+	SecureString WinrtEncryptRepositoryImpl::Decrypt(const std::shared_ptr<SymmetricKey>& key, const std::string& data) const
 	{
-		auto nonce = CryptographicBuffer::GenerateRandom(NONCE_LENGTH);
+		std::vector<uint8_t> envelope;
+		{
+			MetricsRegistry::PhaseTimer timer(m_Metrics.get(), MetricsPhase::kEncodingAndReply);
+			TraceScope trace("Base64Decode");
+
+			auto envelopeLength = Base64::GetDecodedLength(data);
+			if (!envelopeLength) {
+				throw BiometricCipherException(error_decrypt, "Encrypted data is not valid Base64.");
+			}
+
+			envelope.resize(*envelopeLength);
+			if (!Base64::Decode(data, envelope.data())) {
+				throw BiometricCipherException(error_decrypt, "Encrypted data is not valid Base64.");
+			}
+		}
+
+		// Which format the envelope is in, and so the exact length, is only known once it
+		// has been authenticated.
+		auto maxPlaintextLength = CiphertextEnvelope::GetMaxPlaintextLength(envelope.size());
+		SecureUtf16Buffer plaintext((maxPlaintextLength + 1) / sizeof(char16_t));
+		auto plaintextLength = DecryptEnvelope(GetAesGcmKey(key), envelope, reinterpret_cast<uint8_t*>(plaintext.data()));
+		if (plaintextLength % sizeof(char16_t) != 0) {
+			throw BiometricCipherException(error_decrypt, "Encrypted data is too short or corrupted.");
+		}
+		plaintext.resize(plaintextLength / sizeof(char16_t));
+
+		// Sized for the worst case up front, so the string never reallocates while it holds
+		// the plaintext.
+		SecureString result(UtfConverter::GetMaxUtf8Length(plaintext.size()), '\0');
+		result.resize(UtfConverter::ConvertUtf16ToUtf8(
+			std::u16string_view(plaintext.data(), plaintext.size()),
+			result.data()));
+
+		return result;
+	}
 
-		auto dataToEncrypt = CryptographicBuffer::ConvertStringToBinary(data, BinaryStringEncoding::Utf16LE);
-		auto encryptedAndAuthData = CryptographicEngine::EncryptAndAuthenticate(key, dataToEncrypt, nonce, nullptr);
+	std::vector<uint8_t> WinrtEncryptRepositoryImpl::EncryptBinary(const std::shared_ptr<SymmetricKey>& key, const SecureBuffer& data) const
+	{
+		return EncryptEnvelope(GetAesGcmKey(key), data.data(), data.size());
+	}
 
-		auto encryptedData = encryptedAndAuthData.EncryptedData();
-		auto authTag = encryptedAndAuthData.AuthenticationTag();
+	SecureBuffer WinrtEncryptRepositoryImpl::DecryptBinary(const std::shared_ptr<SymmetricKey>& key, const std::vector<uint8_t>& data) const
+	{
+		SecureBuffer plaintext(CiphertextEnvelope::GetMaxPlaintextLength(data.size()));
+		plaintext.resize(DecryptEnvelope(GetAesGcmKey(key), data, plaintext.data()));
 
-		DataWriter writer;
-		writer.WriteBuffer(nonce);
-		writer.WriteBuffer(encryptedData);
-		writer.WriteBuffer(authTag);
-		auto combineBuffer = writer.DetachBuffer();
+		return plaintext;
+	}
 
-		auto encryptedBase64String = CryptographicBuffer::EncodeToBase64String(combineBuffer);
+	std::unique_ptr<EncryptStream> WinrtEncryptRepositoryImpl::CreateEncryptStream(const std::shared_ptr<SymmetricKey>& key) const
+	{
+		uint8_t baseNonce[NONCE_LENGTH];
+		m_NonceSource->Fill(baseNonce, NONCE_LENGTH);
 
-		return encryptedBase64String;
+		return std::make_unique<EncryptStream>(GetStreamKey(key), baseNonce, AesGcmStream::DEFAULT_SEGMENT_LENGTH, m_SegmentRunner);
 	}
 
-	winrt::hstring WinrtEncryptRepositoryImpl::Decrypt(const CryptographicKey key, const winrt::hstring data) const
+	std::unique_ptr<DecryptStream> WinrtEncryptRepositoryImpl::CreateDecryptStream(
+		const std::shared_ptr<SymmetricKey>& key,
+		std::span<const uint8_t> header) const
 	{
-		auto combineBuffer = CryptographicBuffer::DecodeFromBase64String(data);
+		return std::make_unique<DecryptStream>(GetStreamKey(key), header, m_SegmentRunner);
+	}
 
-		if (combineBuffer.Length() < NONCE_LENGTH + TAG_LENGTH) {
-			throw hresult_error(error_decrypt, L"Encrypted data is too short or corrupted.");
+	const AesGcmSymmetricKey& WinrtEncryptRepositoryImpl::GetAesGcmKey(const std::shared_ptr<SymmetricKey>& key)
+	{
+		auto* aesKey = dynamic_cast<AesGcmSymmetricKey*>(key.get());
+		if (aesKey == nullptr) {
+			throw BiometricCipherException(error_invalid_argument, "Key was not created by this repository.");
 		}
 
-		auto reader = DataReader::FromBuffer(combineBuffer);
-		auto nonce = reader.ReadBuffer(NONCE_LENGTH);
-		auto encryptedData = reader.ReadBuffer(combineBuffer.Length() - NONCE_LENGTH - TAG_LENGTH);
-		auto authTag = reader.ReadBuffer(TAG_LENGTH);
+		return *aesKey;
+	}
+
+	std::shared_ptr<const AesGcmKey> WinrtEncryptRepositoryImpl::GetStreamKey(const std::shared_ptr<SymmetricKey>& key)
+	{
+		return std::shared_ptr<const AesGcmKey>(key, &GetAesGcmKey(key).key.GetAesGcmKey());
+	}
+
+	std::vector<uint8_t> WinrtEncryptRepositoryImpl::EncryptEnvelope(const AesGcmSymmetricKey& key, const uint8_t* data, size_t length) const
+	{
+		auto suite = GetSuite();
+		std::vector<uint8_t> envelope(CiphertextEnvelope::GetSealedLength(length));
+
+		// Timed as the AES-GCM phase whichever suite seals it, so that metrics stay comparable
+		// across devices.
+		MetricsRegistry::PhaseTimer timer(m_Metrics.get(), MetricsPhase::kAesGcm);
+		TraceScope trace("AesGcmEncrypt");
+
+		uint8_t nonce[NONCE_LENGTH];
+		m_NonceSource->Fill(nonce, NONCE_LENGTH);
+		CiphertextEnvelope::Seal(suite, key.key, nonce, data, length, envelope.data());
+
+		return envelope;
+	}
+
+	size_t WinrtEncryptRepositoryImpl::DecryptEnvelope(const AesGcmSymmetricKey& key, const std::vector<uint8_t>& envelope, uint8_t* output) const
+	{
+		MetricsRegistry::PhaseTimer timer(m_Metrics.get(), MetricsPhase::kAesGcm);
+		TraceScope trace("AesGcmDecrypt");
+
+		auto length = CiphertextEnvelope::Open(key.key, envelope, output);
+		if (!length) {
+			throw BiometricCipherException(error_decrypt, "Encrypted data could not be authenticated.");
+		}
 
-		auto decryptedData = CryptographicEngine::DecryptAndAuthenticate(key, encryptedData, nonce, authTag, nullptr);
-		auto decryptedDataString = CryptographicBuffer::ConvertBinaryToString(BinaryStringEncoding::Utf16LE, decryptedData);
+		return *length;
+	}
 
-		return decryptedDataString;
+	AeadSuite WinrtEncryptRepositoryImpl::GetSuite() const
+	{
+		return m_Suite ? *m_Suite : AeadSuiteSelector::GetPreferredSuite();
 	}
 }
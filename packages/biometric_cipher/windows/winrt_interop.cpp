@@ -0,0 +1,55 @@
+#include "include/biometric_cipher/common/winrt_interop.h"
+#include "include/biometric_cipher/common/secure_memory.h"
+#include "include/biometric_cipher/common/string_util.h"
+
+#include <cstring>
+
+using namespace winrt;
+using namespace Windows::Storage::Streams;
+
+namespace biometric_cipher
+{
+	IBuffer WinrtInterop::ConvertVectorToBuffer(std::span<const uint8_t> data)
+	{
+		auto length = static_cast<uint32_t>(data.size());
+		Buffer buffer(length);
+		if (length > 0) {
+			std::memcpy(buffer.data(), data.data(), length);
+		}
+		buffer.Length(length);
+
+		return buffer;
+	}
+
+	std::vector<uint8_t> WinrtInterop::ConvertBufferToVector(const IBuffer& buffer)
+	{
+		if (buffer == nullptr) {
+			return {};
+		}
+
+		return std::vector<uint8_t>(buffer.data(), buffer.data() + buffer.Length());
+	}
+
+	SecureBuffer WinrtInterop::ConvertBufferToSecureBuffer(const IBuffer& buffer)
+	{
+		if (buffer == nullptr) {
+			return {};
+		}
+
+		return SecureBuffer(buffer.data(), buffer.data() + buffer.Length());
+	}
+
+	void WinrtInterop::ZeroBuffer(const IBuffer& buffer)
+	{
+		if (buffer != nullptr) {
+			SecureMemory::Zero(buffer.data(), buffer.Capacity());
+		}
+	}
+
+	BiometricCipherException WinrtInterop::ConvertHResultError(const hresult_error& error)
+	{
+		return BiometricCipherException(
+			static_cast<ErrorCode>(error.code().value),
+			StringUtil::ConvertHStringToString(error.message()));
+	}
+}